@@ -113,6 +113,10 @@ if (LITE_WITH_X86)
     add_definitions("-DLITE_WITH_X86")
 endif()
 
+if (LITE_WITH_X86 AND WITH_X86_SGEMM AND NOT WITH_MKLML)
+    add_definitions("-DLITE_WITH_X86_SGEMM")
+endif()
+
 if (LITE_WITH_ARM)
     add_definitions("-DLITE_WITH_ARM")
 endif()
@@ -122,8 +126,8 @@ if(LITE_WITH_ARM82_FP16)
 endif()
 
 if (LITE_WITH_CV)
-    if(NOT LITE_WITH_ARM)
-        message(FATAL_ERROR "CV functions uses the ARM instructions, so LITE_WITH_ARM must be turned on")
+    if(NOT LITE_WITH_ARM AND NOT LITE_WITH_X86)
+        message(FATAL_ERROR "CV functions uses the ARM or x86 SIMD instructions, so LITE_WITH_ARM or LITE_WITH_X86 must be turned on")
     endif()
     add_definitions("-DLITE_WITH_CV")
 endif()
@@ -11,6 +11,16 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+IF(WITH_X86_SGEMM AND NOT WITH_MKLML)
+    # float GEMM comes from lite/backends/x86/math/packed_sgemm.cc, only keep
+    # an empty cblas target for the libraries that depend on it.
+    MESSAGE(STATUS "BLAS library: built-in x86 sgemm")
+    SET(dummyfile ${CMAKE_CURRENT_BINARY_DIR}/cblas_dummy.c)
+    FILE(WRITE ${dummyfile} "const char *dummy_cblas = \"${dummyfile}\";")
+    ADD_LIBRARY(cblas STATIC ${dummyfile})
+    RETURN()
+ENDIF()
+
 INCLUDE(cblas)
 
 IF(NOT ${CBLAS_FOUND})
@@ -16,6 +16,8 @@ if(CMAKE_COMPILER_IS_GNUCC OR CMAKE_COMPILER_IS_GNUCXX OR CMAKE_CXX_COMPILER_ID
     set(AVX_FLAG "-mavx")
     set(AVX2_FLAG "-mavx2")
     set(AVX512F_FLAG "-mavx512f")
+    set(AVX512BW_FLAG "-mavx512f -mavx512bw -mavx512vl")
+    set(AVX512_VNNI_FLAG "${AVX512BW_FLAG} -mavx512vnni")
 elseif(MSVC)
     set(MMX_FLAG "/arch:MMX")
     set(SSE2_FLAG "/arch:SSE2")
@@ -114,8 +116,32 @@ int main()
     return 0;
 }" AVX512F_FOUND)
 
+# Check AVX512BW and AVX512-VNNI, only the compiler: the kernels built with
+# them are picked at runtime by the cpu.
+if(AVX512BW_FLAG)
+  set(CMAKE_REQUIRED_FLAGS ${AVX512BW_FLAG})
+  CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m512i a = _mm512_set1_epi8(1);
+    __m512i b = _mm512_maddubs_epi16(a, a);
+    return _mm_cvtsi128_si32(_mm512_cvtsepi32_epi8(b));
+}" AVX512BW_FOUND)
+
+  set(CMAKE_REQUIRED_FLAGS ${AVX512_VNNI_FLAG})
+  CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m512i a = _mm512_set1_epi8(1);
+    __m512i b = _mm512_dpbusd_epi32(_mm512_setzero_si512(), a, a);
+    return _mm_cvtsi128_si32(_mm512_cvtsepi32_epi8(b));
+}" AVX512_VNNI_FOUND)
+endif()
+
 set(CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS_RETAINED})
-mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND)
+mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND AVX512BW_FOUND AVX512_VNNI_FOUND)
 
 if(WITH_AVX AND AVX_FOUND)
     add_definitions(-DLITE_WITH_AVX)
@@ -0,0 +1,165 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/async_runner.h"
+#include <cstring>
+#include <memory>
+#include <utility>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+int AsyncOutputs::size() const {
+  return data_ ? static_cast<int>(data_->tensors.size()) : 0;
+}
+
+std::unique_ptr<const Tensor> AsyncOutputs::Get(int i) const {
+  CHECK_GE(i, 0);
+  CHECK_LT(i, size()) << "The output index is out of range";
+  return std::unique_ptr<const Tensor>(new Tensor(&data_->tensors[i]));
+}
+
+}  // namespace lite_api
+
+namespace lite {
+
+namespace {
+
+void SwapTensors(Tensor* a, Tensor* b) {
+  Tensor tmp;
+  tmp.ShareDataWith(*a);
+  a->ShareDataWith(*b);
+  b->ShareDataWith(tmp);
+}
+
+void CopyOutput(const Tensor& src, Tensor* dst) {
+  auto target = src.target();
+  if (target != TARGET(kHost) && target != TARGET(kX86) &&
+      target != TARGET(kARM)) {
+    dst->CopyDataFrom(src);
+    return;
+  }
+  // raw_data() takes the offset of a tensor sharing a larger buffer into
+  // account, unlike CopyDataFrom.
+  size_t bytes = src.numel() * PrecisionTypeLength(src.precision());
+  dst->Resize(src.dims());
+  dst->set_lod(src.lod());
+  dst->set_precision(src.precision());
+  void* data = dst->mutable_data(target, bytes);
+  if (bytes) memcpy(data, src.raw_data(), bytes);
+}
+
+}  // namespace
+
+const int AsyncRunner::kNumSlots;
+
+AsyncRunner::AsyncRunner(int num_inputs,
+                         int num_outputs,
+                         const std::function<Tensor*(int)>& feed,
+                         const std::function<const Tensor*(int)>& fetch,
+                         const std::function<void()>& run)
+    : num_inputs_(num_inputs),
+      num_outputs_(num_outputs),
+      feed_(feed),
+      fetch_(fetch),
+      run_(run) {
+  for (auto& slot : slots_) slot.inputs.resize(num_inputs_);
+  worker_ = std::thread(&AsyncRunner::WorkerLoop, this);
+}
+
+AsyncRunner::~AsyncRunner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  worker_.join();
+}
+
+AsyncRunner::Slot* AsyncRunner::FillingSlot(
+    std::unique_lock<std::mutex>* lock) {
+  cond_.wait(*lock, [this] { return !slots_[filling_].queued; });
+  return &slots_[filling_];
+}
+
+Tensor* AsyncRunner::NextInput(int i) {
+  CHECK_GE(i, 0);
+  CHECK_LT(i, num_inputs_) << "The input index is out of range";
+  std::unique_lock<std::mutex> lock(mutex_);
+  return &FillingSlot(&lock)->inputs[i];
+}
+
+std::future<lite_api::AsyncOutputs> AsyncRunner::Submit(
+    const lite_api::PaddlePredictor::AsyncCallback& callback) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto* slot = FillingSlot(&lock);
+  slot->queued = true;
+  slot->callback = callback;
+  slot->promise = std::promise<lite_api::AsyncOutputs>();
+  auto future = slot->promise.get_future();
+  queue_.push_back(filling_);
+  filling_ = (filling_ + 1) % kNumSlots;
+  lock.unlock();
+  cond_.notify_all();
+  return future;
+}
+
+void AsyncRunner::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [this] { return queue_.empty() && !running_; });
+}
+
+void AsyncRunner::WorkerLoop() {
+  while (true) {
+    lite_api::PaddlePredictor::AsyncCallback callback;
+    std::promise<lite_api::AsyncOutputs> promise;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) break;
+      auto& slot = slots_[queue_.front()];
+      queue_.pop_front();
+      running_ = true;
+      for (int i = 0; i < num_inputs_; i++) {
+        SwapTensors(feed_(i), &slot.inputs[i]);
+      }
+      callback = std::move(slot.callback);
+      slot.callback = nullptr;
+      promise = std::move(slot.promise);
+      slot.queued = false;
+    }
+    // The slot is free for the caller while this request runs.
+    cond_.notify_all();
+
+    run_();
+    auto data = std::make_shared<lite_api::AsyncOutputsData>();
+    data->tensors.resize(num_outputs_);
+    for (int i = 0; i < num_outputs_; i++) {
+      CopyOutput(*fetch_(i), &data->tensors[i]);
+    }
+    lite_api::AsyncOutputs outputs(data);
+    if (callback) callback(outputs);
+    promise.set_value(outputs);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cond_.notify_all();
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
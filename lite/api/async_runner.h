@@ -0,0 +1,98 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+struct AsyncOutputsData {
+  std::vector<lite::Tensor> tensors;
+};
+
+}  // namespace lite_api
+
+namespace lite {
+
+/*
+ * The executor behind PaddlePredictor::RunAsync, one thread per predictor
+ * running the queued requests in order.
+ *
+ * The caller fills the inputs of a request into one of two staging slots.
+ * When the executor picks a request, it swaps the buffers of the slot with
+ * the feed tensors, which costs no copy, and frees the slot at once. So the
+ * caller fills the next request while the previous one runs, and blocks only
+ * when both slots are queued. After the run the outputs are copied into
+ * tensors owned by the request, since they may share buffers with the
+ * activations the next run overwrites.
+ */
+class AsyncRunner {
+ public:
+  // `feed(i)` and `fetch(i)` are the i-th input and output tensors of the
+  // predictor, `run` runs it on the feed tensors.
+  AsyncRunner(int num_inputs,
+              int num_outputs,
+              const std::function<Tensor*(int)>& feed,
+              const std::function<const Tensor*(int)>& fetch,
+              const std::function<void()>& run);
+  // Finishes the queued requests first.
+  ~AsyncRunner();
+
+  // The i-th input of the next request.
+  Tensor* NextInput(int i);
+  std::future<lite_api::AsyncOutputs> Submit(
+      const lite_api::PaddlePredictor::AsyncCallback& callback);
+  void Wait();
+
+ private:
+  struct Slot {
+    std::vector<Tensor> inputs;
+    bool queued{false};
+    lite_api::PaddlePredictor::AsyncCallback callback;
+    std::promise<lite_api::AsyncOutputs> promise;
+  };
+  static const int kNumSlots = 2;
+
+  void WorkerLoop();
+  // Waits for the slot being filled to be free, with `lock` held.
+  Slot* FillingSlot(std::unique_lock<std::mutex>* lock);
+
+  int num_inputs_;
+  int num_outputs_;
+  std::function<Tensor*(int)> feed_;
+  std::function<const Tensor*(int)> fetch_;
+  std::function<void()> run_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  Slot slots_[kNumSlots];
+  int filling_{0};
+  std::deque<int> queue_;
+  bool running_{false};
+  bool stop_{false};
+  std::thread worker_;
+};
+
+}  // namespace lite
+}  // namespace paddle
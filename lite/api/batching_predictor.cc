@@ -0,0 +1,286 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/batching_predictor.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <future>  // NOLINT
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+typedef std::chrono::steady_clock Clock;
+
+struct BatchingPredictor::Request {
+  const std::vector<Input>* inputs{nullptr};
+  std::vector<Output>* outputs{nullptr};
+  int batch_size{0};
+  Clock::time_point enqueue_time;
+  std::promise<void> done;
+};
+
+namespace {
+
+// The bytes of one sample of a tensor batched along dim 0.
+size_t SampleBytes(const shape_t& shape, PrecisionType precision) {
+  size_t bytes = PrecisionTypeLength(precision);
+  for (size_t i = 1; i < shape.size(); i++) {
+    bytes *= static_cast<size_t>(shape[i]);
+  }
+  return bytes;
+}
+
+// Whether two requests have the same inputs apart from the batch size.
+bool SameSamples(const std::vector<BatchingPredictor::Input>& a,
+                 const std::vector<BatchingPredictor::Input>& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].precision != b[i].precision ||
+        a[i].shape.size() != b[i].shape.size() ||
+        !std::equal(a[i].shape.begin() + 1,
+                    a[i].shape.end(),
+                    b[i].shape.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void* MutableData(Tensor* tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kFP64:
+      return tensor->mutable_data<double>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int32_t>();
+    case PrecisionType::kInt16:
+      return tensor->mutable_data<int16_t>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kUInt8:
+      return tensor->mutable_data<uint8_t>();
+    case PrecisionType::kBool:
+      return tensor->mutable_data<bool>();
+    default:
+      LOG(FATAL) << "Unsupported input precision for batching: "
+                 << PrecisionToStr(precision);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+BatchingPredictor::BatchingPredictor(
+    const std::vector<std::shared_ptr<PaddlePredictor>>& predictors,
+    const BatchingConfig& config)
+    : config_(config) {
+  Start(predictors);
+}
+
+BatchingPredictor::BatchingPredictor(
+    const std::shared_ptr<PaddlePredictor>& predictor,
+    int num_workers,
+    const BatchingConfig& config)
+    : config_(config) {
+  CHECK(predictor);
+  CHECK_GT(num_workers, 0);
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors{predictor};
+  for (int i = 1; i < num_workers; i++) {
+    predictors.push_back(predictor->Clone());
+  }
+  Start(predictors);
+}
+
+BatchingPredictor::~BatchingPredictor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void BatchingPredictor::Start(
+    const std::vector<std::shared_ptr<PaddlePredictor>>& predictors) {
+  CHECK(!predictors.empty()) << "At least one predictor is needed";
+  CHECK_GT(config_.max_batch_size, 0);
+  CHECK_GE(config_.max_wait_us, 0);
+  std::sort(config_.batch_buckets.begin(), config_.batch_buckets.end());
+  predictors_ = predictors;
+  for (auto& predictor : predictors_) {
+    CHECK(predictor);
+    workers_.emplace_back(
+        &BatchingPredictor::WorkerLoop, this, predictor.get());
+  }
+}
+
+void BatchingPredictor::Run(const std::vector<Input>& inputs,
+                            std::vector<Output>* outputs) {
+  CHECK(!inputs.empty());
+  CHECK(outputs);
+  Request request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  for (auto& input : inputs) {
+    CHECK(!input.shape.empty()) << "The inputs must have a batch dimension";
+    CHECK(input.data);
+    CHECK_GT(PrecisionTypeLength(input.precision), 0u);
+    if (request.batch_size == 0) request.batch_size = input.shape[0];
+    CHECK_EQ(input.shape[0], request.batch_size)
+        << "All the inputs of a request must have the same batch size";
+  }
+  CHECK_GT(request.batch_size, 0);
+
+  auto done = request.done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(!stop_);
+    request.enqueue_time = Clock::now();
+    queue_.push_back(&request);
+  }
+  cond_.notify_all();
+  done.wait();
+}
+
+uint64_t BatchingPredictor::num_batches() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_batches_;
+}
+
+uint64_t BatchingPredictor::num_samples() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_samples_;
+}
+
+void BatchingPredictor::WorkerLoop(PaddlePredictor* predictor) {
+  while (true) {
+    auto batch = NextBatch();
+    if (batch.empty()) break;
+    RunBatch(predictor, batch);
+    for (auto* request : batch) {
+      request->done.set_value();
+    }
+  }
+}
+
+std::vector<BatchingPredictor::Request*> BatchingPredictor::NextBatch() {
+  std::vector<Request*> batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+  // The queued requests are still served after stop.
+  cond_.wait(lock, [this] {
+    return (!collecting_ && !queue_.empty()) || (stop_ && queue_.empty());
+  });
+  if (queue_.empty()) return batch;
+
+  collecting_ = true;
+  auto deadline = queue_.front()->enqueue_time +
+                  std::chrono::microseconds(config_.max_wait_us);
+  int size = 0;
+  while (true) {
+    // The oldest request leads, the others join in the order they came if
+    // their samples match and there is room left.
+    for (auto it = queue_.begin(); it != queue_.end();) {
+      auto* request = *it;
+      if (batch.empty() ||
+          (size + request->batch_size <= config_.max_batch_size &&
+           SameSamples(*batch[0]->inputs, *request->inputs))) {
+        batch.push_back(request);
+        size += request->batch_size;
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (size >= config_.max_batch_size || stop_ || Clock::now() >= deadline) {
+      break;
+    }
+    cond_.wait_until(lock, deadline);
+  }
+  collecting_ = false;
+  num_batches_++;
+  num_samples_ += size;
+  lock.unlock();
+  // Let the next idle worker collect from the rest of the queue.
+  cond_.notify_all();
+  return batch;
+}
+
+int BatchingPredictor::PaddedSize(int batch_size) const {
+  for (auto bucket : config_.batch_buckets) {
+    if (bucket >= batch_size) return bucket;
+  }
+  return batch_size;
+}
+
+void BatchingPredictor::RunBatch(PaddlePredictor* predictor,
+                                 const std::vector<Request*>& batch) {
+  int size = 0;
+  for (auto* request : batch) {
+    size += request->batch_size;
+  }
+  int padded = PaddedSize(size);
+
+  // Concat the inputs along dim 0 and zero the padding.
+  auto& first = *batch[0]->inputs;
+  for (size_t i = 0; i < first.size(); i++) {
+    auto tensor = predictor->GetInput(static_cast<int>(i));
+    shape_t shape = first[i].shape;
+    shape[0] = padded;
+    tensor->Resize(shape);
+    auto* dst =
+        static_cast<char*>(MutableData(tensor.get(), first[i].precision));
+    size_t sample_bytes = SampleBytes(shape, first[i].precision);
+    for (auto* request : batch) {
+      size_t bytes = sample_bytes * request->batch_size;
+      std::memcpy(dst, (*request->inputs)[i].data, bytes);
+      dst += bytes;
+    }
+    std::memset(dst, 0, sample_bytes * (padded - size));
+  }
+
+  predictor->Run();
+
+  // Split the outputs back by rows, the padding is dropped.
+  size_t num_outputs = predictor->GetOutputNames().size();
+  for (auto* request : batch) {
+    request->outputs->resize(num_outputs);
+  }
+  for (size_t i = 0; i < num_outputs; i++) {
+    auto tensor = predictor->GetOutput(static_cast<int>(i));
+    auto shape = tensor->shape();
+    CHECK(!shape.empty() && shape[0] == padded)
+        << "Output " << i << " is not batched along dim 0, can't split it";
+    size_t sample_bytes = SampleBytes(shape, tensor->precision());
+    auto* src = static_cast<const char*>(tensor->data<void>());
+    for (auto* request : batch) {
+      auto& output = (*request->outputs)[i];
+      size_t bytes = sample_bytes * request->batch_size;
+      output.shape = shape;
+      output.shape[0] = request->batch_size;
+      output.precision = tensor->precision();
+      output.data.assign(src, src + bytes);
+      src += bytes;
+    }
+  }
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite_api {
+
+struct LITE_API BatchingConfig {
+  // The most samples run at once. A single request larger than this is run
+  // on its own.
+  int max_batch_size{8};
+  // How long the oldest queued request waits for others to join its batch.
+  int max_wait_us{1000};
+  // The batch sizes the model is run with, e.g. {1, 2, 4, 8}. A batch is
+  // padded with zeros up to the smallest bucket holding it, so that the
+  // predictor only sees a few shapes. Empty means no padding.
+  std::vector<int> batch_buckets;
+};
+
+/*
+ * Serves concurrent callers with a set of predictors, usually clones of one
+ * another, by coalescing their requests along the batch dimension.
+ *
+ * Each predictor has a worker thread. A worker takes the oldest queued
+ * request and joins the queued requests of the same sample shapes until
+ * `max_batch_size` samples are collected or `max_wait_us` has passed since
+ * the oldest one was queued. The inputs are concatenated along dim 0, the
+ * model runs once and every output is split back by rows, so all the inputs
+ * and outputs of the model must have the batch as their first dimension.
+ * LoD is not supported.
+ */
+class LITE_API BatchingPredictor {
+ public:
+  struct Input {
+    shape_t shape;
+    PrecisionType precision{PrecisionType::kFloat};
+    // Read until Run returns.
+    const void* data{nullptr};
+  };
+
+  struct Output {
+    shape_t shape;
+    PrecisionType precision{PrecisionType::kUnk};
+    std::vector<char> data;
+
+    template <typename T>
+    const T* as() const {
+      return reinterpret_cast<const T*>(data.data());
+    }
+  };
+
+  BatchingPredictor(
+      const std::vector<std::shared_ptr<PaddlePredictor>>& predictors,
+      const BatchingConfig& config);
+  // Serves with `predictor` and `num_workers - 1` clones of it.
+  BatchingPredictor(const std::shared_ptr<PaddlePredictor>& predictor,
+                    int num_workers,
+                    const BatchingConfig& config);
+  ~BatchingPredictor();
+
+  // Runs the inputs of one caller, blocking until its outputs are ready.
+  // Thread safe.
+  void Run(const std::vector<Input>& inputs, std::vector<Output>* outputs);
+
+  // The number of model runs and samples so far, padding excluded.
+  uint64_t num_batches() const;
+  uint64_t num_samples() const;
+
+ private:
+  struct Request;
+
+  void Start(const std::vector<std::shared_ptr<PaddlePredictor>>& predictors);
+  void WorkerLoop(PaddlePredictor* predictor);
+  // Collects the next batch from the queue, empty once stopped.
+  std::vector<Request*> NextBatch();
+  void RunBatch(PaddlePredictor* predictor,
+                const std::vector<Request*>& batch);
+  int PaddedSize(int batch_size) const;
+
+  BatchingConfig config_;
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Request*> queue_;
+  // Only one worker collects a batch at a time, the others wait for it so
+  // that they don't split the queue into small batches.
+  bool collecting_{false};
+  bool stop_{false};
+  uint64_t num_batches_{0};
+  uint64_t num_samples_{0};
+};
+
+}  // namespace lite_api
+}  // namespace paddle
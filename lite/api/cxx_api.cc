@@ -82,7 +82,8 @@ bool IsQuantizedMode(const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
 
 void Predictor::SaveModel(const std::string &dir,
                           lite_api::LiteModelType model_type,
-                          bool record_info) {
+                          bool record_info,
+                          int model_meta_version) {
   if (!program_) {
     GenRuntimeProgram();
   }
@@ -91,7 +92,10 @@ void Predictor::SaveModel(const std::string &dir,
       SaveModelPb(dir, *program_->exec_scope(), *program_desc_.get(), true);
       break;
     case lite_api::LiteModelType::kNaiveBuffer:
-      SaveModelNaive(dir, *program_->exec_scope(), *program_desc_.get());
+      SaveModelNaive(dir,
+                     *program_->exec_scope(),
+                     *program_desc_.get(),
+                     model_meta_version);
       break;
     default:
       LOG(FATAL) << "Unknown model type";
@@ -608,6 +612,7 @@ bool Predictor::TryShrinkMemory() {
   // Clear ArmL3Cache
   lite::DeviceInfo::Global().ClearArmL3Cache();
 #endif
+  program_->ReleaseMemoryArena();
   const std::vector<std::string> &local_var_names =
       program_->exec_scope()->LocalVarNames();
   for (auto &var_name : local_var_names) {
@@ -19,10 +19,12 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_runner.h"
 #include "lite/api/paddle_api.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer/optimizer.h"
 #include "lite/core/program.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -105,7 +107,8 @@ class LITE_API Predictor {
   // Function: Clone
   // Usage: Create a Predictor from an existed one,
   // the cloned predictor will share persistable variables
-  // in scope_ with the original predictor.
+  // in scope_ with the original predictor, and the weights
+  // transformed by its kernels through PreparedWeights.
   //////////////////////////////////////////////////////////
   std::shared_ptr<Predictor> Clone() {
     // step 1. Generate runtime_program, update op_info and var_info in
@@ -176,6 +179,25 @@ class LITE_API Predictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  void SetUseMemoryArena(bool flag) { program_->set_use_memory_arena(flag); }
+  void SetCacheStableShapes(bool flag) { program_->set_cache_shapes(flag); }
+  void SetShapeCacheCapacity(int capacity) {
+    program_->set_shape_plan_capacity(capacity);
+  }
+  void SetInterOpThreads(int threads) {
+    program_->set_inter_op_threads(threads);
+  }
+  lite_api::ShapeCacheStats GetShapeCacheStats() const {
+    lite_api::ShapeCacheStats stats;
+    stats.hits = program_->shape_cache_hits();
+    stats.misses = program_->shape_cache_misses();
+    return stats;
+  }
+
+  RuntimeProfiler* runtime_profiler() {
+    return program_->mutable_runtime_profiler();
+  }
+
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
   // get input by name.
@@ -207,7 +229,8 @@ class LITE_API Predictor {
   void SaveModel(
       const std::string& dir,
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
-      bool record_info = false);
+      bool record_info = false,
+      int model_meta_version = 2);
   void SaveOpKernelInfo(const std::string& model_dir);
 
   /////////////////////////////////////////////////////////////////////////////
@@ -311,6 +334,18 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       bool record_info = false) override;
 
   void SetStream(TargetType target, void* stream) override;
+
+  void SetRuntimeProfile(int sample_every, bool perf_counters) override;
+  std::string GetRuntimeProfileTrace() override;
+  std::string GetRuntimeProfileSummary() override;
+  void ResetRuntimeProfile() override;
+  lite_api::ShapeCacheStats GetShapeCacheStats() override;
+
+  std::unique_ptr<lite_api::Tensor> GetAsyncInput(int i) override;
+  std::future<lite_api::AsyncOutputs> RunAsync(
+      AsyncCallback callback = nullptr) override;
+  void WaitAsync() override;
+
   void Synchronize() {
 #ifdef LITE_WITH_XPU
     XPU_CALL(xpu_wait());
@@ -318,10 +353,18 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
   }
 
  private:
+  AsyncRunner* async_runner();
+
   std::shared_ptr<Predictor> raw_predictor_;
   lite_api::CxxConfig config_;
   std::mutex mutex_;
   bool status_is_cloned_;
+  // The pool running the parallel loops of this predictor, nullptr if it
+  // runs with a single thread.
+  std::shared_ptr<ThreadPool> thread_pool_;
+  // Created by the first async call. Declared last to finish the queued runs
+  // before the rest of the predictor goes.
+  std::unique_ptr<AsyncRunner> async_runner_;
 };
 
 /*
@@ -22,10 +22,6 @@
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
 #include "lite/core/version.h"
-#ifdef LITE_USE_THREAD_POOL
-#include "lite/core/parallel_defines.h"
-#include "lite/core/thread_pool.h"
-#endif
 #ifndef LITE_ON_TINY_PUBLISH
 #include "lite/api/paddle_use_passes.h"
 #endif
@@ -53,10 +49,7 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
           config.target_configs().at(TARGET(kXPU)).get()));
 #endif
 #ifdef LITE_USE_THREAD_POOL
-  int thread_num = ThreadPool::Init(threads_);
-  if (thread_num > 1) {
-    ThreadPool::AcquireThreadPool();
-  }
+  thread_pool_ = ThreadPool::Create(threads_, config.thread_cpu_ids());
 #endif
   if (!status_is_cloned_) {
     auto places = config.valid_places();
@@ -131,6 +124,14 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
 #ifdef LITE_WITH_METAL
   raw_predictor_->ConfigMetalContext(config);
 #endif
+  raw_predictor_->SetUseMemoryArena(config.use_memory_arena());
+  raw_predictor_->SetCacheStableShapes(config.cache_stable_shapes());
+  raw_predictor_->SetShapeCacheCapacity(config.shape_cache_capacity());
+  raw_predictor_->SetInterOpThreads(config.inter_op_threads());
+  raw_predictor_->runtime_profiler()->set_use_perf_counters(
+      config.runtime_profile_perf_counters());
+  raw_predictor_->runtime_profiler()->set_sample_every(
+      config.runtime_profile());
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
@@ -197,11 +198,7 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
 #endif
 }
 
-CxxPaddleApiImpl::~CxxPaddleApiImpl() {
-#ifdef LITE_USE_THREAD_POOL
-  ThreadPool::ReleaseThreadPool();
-#endif
-}
+CxxPaddleApiImpl::~CxxPaddleApiImpl() {}
 
 std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInputByName(
     const std::string &name) {
@@ -242,6 +239,7 @@ void CxxPaddleApiImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
   raw_predictor_->Run();
 }
 
@@ -279,7 +277,8 @@ std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetMutableTensor(
 void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
                                           lite_api::LiteModelType model_type,
                                           bool record_info) {
-  raw_predictor_->SaveModel(model_dir, model_type, record_info);
+  raw_predictor_->SaveModel(
+      model_dir, model_type, record_info, config_.model_meta_version());
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
@@ -290,6 +289,60 @@ void CxxPaddleApiImpl::SetStream(TargetType target, void *stream) {
   raw_predictor_->SetStream(target, stream);
 }
 
+void CxxPaddleApiImpl::SetRuntimeProfile(int sample_every, bool perf_counters) {
+  raw_predictor_->runtime_profiler()->set_use_perf_counters(perf_counters);
+  raw_predictor_->runtime_profiler()->set_sample_every(sample_every);
+}
+
+std::string CxxPaddleApiImpl::GetRuntimeProfileTrace() {
+  return raw_predictor_->runtime_profiler()->ChromeTrace();
+}
+
+std::string CxxPaddleApiImpl::GetRuntimeProfileSummary() {
+  return raw_predictor_->runtime_profiler()->Summary();
+}
+
+void CxxPaddleApiImpl::ResetRuntimeProfile() {
+  raw_predictor_->runtime_profiler()->Reset();
+}
+
+lite_api::ShapeCacheStats CxxPaddleApiImpl::GetShapeCacheStats() {
+  return raw_predictor_->GetShapeCacheStats();
+}
+
+std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetAsyncInput(int i) {
+  return std::unique_ptr<lite_api::Tensor>(
+      new lite_api::Tensor(async_runner()->NextInput(i)));
+}
+
+std::future<lite_api::AsyncOutputs> CxxPaddleApiImpl::RunAsync(
+    AsyncCallback callback) {
+  return async_runner()->Submit(callback);
+}
+
+void CxxPaddleApiImpl::WaitAsync() {
+  AsyncRunner *runner = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    runner = async_runner_.get();
+  }
+  if (runner) runner->Wait();
+}
+
+AsyncRunner *CxxPaddleApiImpl::async_runner() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!async_runner_) {
+    auto *raw = raw_predictor_.get();
+    async_runner_.reset(new AsyncRunner(
+        static_cast<int>(raw->GetInputNames().size()),
+        static_cast<int>(raw->GetOutputNames().size()),
+        [raw](int i) { return raw->GetInput(i); },
+        [raw](int i) { return raw->GetOutput(i); },
+        [this] { Run(); }));
+  }
+  return async_runner_.get();
+}
+
 }  // namespace lite
 
 namespace lite_api {
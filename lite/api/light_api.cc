@@ -47,7 +47,8 @@ void LightPredictor::Run() {
 }
 
 void LightPredictor::Build(const std::string& lite_model_file) {
-  LoadModelNaiveFromFile(lite_model_file, scope_.get(), program_desc_.get());
+  LoadModelNaiveFromFile(
+      lite_model_file, scope_.get(), program_desc_.get(), use_mmap_);
   // For weight quantization of post training, load the int8/16 weights
   // for optimized model, and dequant it to fp32.
   DequantizeWeight();
@@ -514,6 +515,7 @@ bool LightPredictor::TryShrinkMemory() {
   // Clear ArmL3Cache
   lite::DeviceInfo::Global().ClearArmL3Cache();
 #endif
+  program_->ReleaseMemoryArena();
   const std::vector<std::string>& local_var_names =
       program_->exec_scope()->LocalVarNames();
   for (auto& var_name : local_var_names) {
@@ -21,13 +21,16 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_runner.h"
 #include "lite/api/paddle_api.h"
 #include "lite/core/context.h"
 #include "lite/core/program.h"
 #include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -44,8 +47,10 @@ class LITE_API LightPredictor {
   // model file or buffer,`model_from_memory` refers to whther to load model
   // from memory.
   LightPredictor(const std::string& lite_model_file,
-                 bool use_low_precision = false) {
+                 bool use_low_precision = false,
+                 bool use_mmap = false) {
     use_low_precision_ = use_low_precision;
+    use_mmap_ = use_mmap;
     scope_ = std::make_shared<Scope>();
     program_desc_ = std::make_shared<cpp::ProgramDesc>();
     Build(lite_model_file);
@@ -82,7 +87,28 @@ class LITE_API LightPredictor {
   ///
   /// \return a boolean variable.
   bool TryShrinkMemory();
+
+  void SetUseMemoryArena(bool flag) { program_->set_use_memory_arena(flag); }
+  void SetCacheStableShapes(bool flag) { program_->set_cache_shapes(flag); }
+  void SetShapeCacheCapacity(int capacity) {
+    program_->set_shape_plan_capacity(capacity);
+  }
+  void SetInterOpThreads(int threads) {
+    program_->set_inter_op_threads(threads);
+  }
+  lite_api::ShapeCacheStats GetShapeCacheStats() const {
+    lite_api::ShapeCacheStats stats;
+    stats.hits = program_->shape_cache_hits();
+    stats.misses = program_->shape_cache_misses();
+    return stats;
+  }
+
+  RuntimeProfiler* runtime_profiler() {
+    return program_->mutable_runtime_profiler();
+  }
+
   bool use_low_precision_ = false;
+  bool use_mmap_ = false;
 
   // Get offset-th col of feed inputs.
   Tensor* GetInput(size_t offset);
@@ -192,6 +218,17 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   /// \return a boolean variable.
   bool TryShrinkMemory() override;
 
+  void SetRuntimeProfile(int sample_every, bool perf_counters) override;
+  std::string GetRuntimeProfileTrace() override;
+  std::string GetRuntimeProfileSummary() override;
+  void ResetRuntimeProfile() override;
+  lite_api::ShapeCacheStats GetShapeCacheStats() override;
+
+  std::unique_ptr<lite_api::Tensor> GetAsyncInput(int i) override;
+  std::future<lite_api::AsyncOutputs> RunAsync(
+      AsyncCallback callback = nullptr) override;
+  void WaitAsync() override;
+
   void SetStream(TargetType target, void* stream) override;
   void Synchronize() {
 #ifdef LITE_WITH_XPU
@@ -202,7 +239,17 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   bool use_low_precision_ = false;
 
  private:
+  AsyncRunner* async_runner();
+
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+  // Guards the creation of `async_runner_`.
+  std::mutex mutex_;
+  // The pool running the parallel loops of this predictor, nullptr if it
+  // runs with a single thread.
+  std::shared_ptr<ThreadPool> thread_pool_;
+  // Created by the first async call. Declared last to finish the queued runs
+  // before the rest of the predictor goes.
+  std::unique_ptr<AsyncRunner> async_runner_;
 };
 
 }  // namespace lite
@@ -21,8 +21,6 @@
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #endif
-#include "lite/core/parallel_defines.h"
-#include "lite/core/thread_pool.h"
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
@@ -36,6 +34,13 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
   // LightPredictor Only support NaiveBuffer backend in publish lib
   auto use_low_precision =
       config.precision_mode() == lite_api::LITE_PRECISION_LOW ? true : false;
+  mode_ = config.power_mode();
+  threads_ = config.threads();
+#ifdef LITE_USE_THREAD_POOL
+  thread_pool_ = ThreadPool::Create(threads_, config.thread_cpu_ids());
+#endif
+  // The params of an indexed model are loaded by the threads of the pool.
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
   if (config.lite_model_file().empty() && !config.lite_model_buffer_ptr()) {
     raw_predictor_.reset(
         new LightPredictor(config.model_dir(),
@@ -46,8 +51,8 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                            use_low_precision));
   } else if (!config.lite_model_file().empty() &&
              !config.is_model_from_memory()) {
-    raw_predictor_.reset(
-        new LightPredictor(config.lite_model_file(), use_low_precision));
+    raw_predictor_.reset(new LightPredictor(
+        config.lite_model_file(), use_low_precision, config.use_mmap()));
   } else if (!config.lite_model_file().empty() &&
              config.is_model_from_memory()) {
     raw_predictor_.reset(new LightPredictor(config.lite_model_file().c_str(),
@@ -59,8 +64,6 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                                             use_low_precision));
   }
 
-  mode_ = config.power_mode();
-  threads_ = config.threads();
   raw_predictor_->SetTargetConfigs(config.target_configs());
 #ifdef LITE_WITH_XPU
   CHECK(config.target_configs().count(TARGET(kXPU)))
@@ -69,16 +72,17 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
       reinterpret_cast<paddle::lite::XPURunTimeOption*>(
           config.target_configs().at(TARGET(kXPU)).get()));
 #endif
-#ifdef LITE_USE_THREAD_POOL
-  int thread_num = ThreadPool::Init(threads_);
-  if (thread_num > 1) {
-    ThreadPool::AcquireThreadPool();
-  }
-#endif
-
 #ifdef LITE_WITH_METAL
   raw_predictor_->ConfigMetalContext(config);
 #endif
+  raw_predictor_->SetUseMemoryArena(config.use_memory_arena());
+  raw_predictor_->SetCacheStableShapes(config.cache_stable_shapes());
+  raw_predictor_->SetShapeCacheCapacity(config.shape_cache_capacity());
+  raw_predictor_->SetInterOpThreads(config.inter_op_threads());
+  raw_predictor_->runtime_profiler()->set_use_perf_counters(
+      config.runtime_profile_perf_counters());
+  raw_predictor_->runtime_profiler()->set_sample_every(
+      config.runtime_profile());
 
 #if defined(LITE_ON_MODEL_OPTIMIZE_TOOL) || defined(LITE_WITH_PYTHON) || \
     defined(LITE_WITH_NNADAPTER)
@@ -112,11 +116,7 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
 #endif
 }
 
-LightPredictorImpl::~LightPredictorImpl() {
-#ifdef LITE_USE_THREAD_POOL
-  ThreadPool::ReleaseThreadPool();
-#endif
-}
+LightPredictorImpl::~LightPredictorImpl() {}
 
 std::unique_ptr<lite_api::Tensor> LightPredictorImpl::GetInputByName(
     const std::string& name) {
@@ -145,6 +145,7 @@ void LightPredictorImpl::Run() {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
 #endif
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
   raw_predictor_->Run();
 }
 
@@ -183,6 +184,61 @@ void LightPredictorImpl::SetStream(TargetType target, void* stream) {
   raw_predictor_->SetStream(target, stream);
 }
 
+void LightPredictorImpl::SetRuntimeProfile(int sample_every,
+                                           bool perf_counters) {
+  raw_predictor_->runtime_profiler()->set_use_perf_counters(perf_counters);
+  raw_predictor_->runtime_profiler()->set_sample_every(sample_every);
+}
+
+std::string LightPredictorImpl::GetRuntimeProfileTrace() {
+  return raw_predictor_->runtime_profiler()->ChromeTrace();
+}
+
+std::string LightPredictorImpl::GetRuntimeProfileSummary() {
+  return raw_predictor_->runtime_profiler()->Summary();
+}
+
+void LightPredictorImpl::ResetRuntimeProfile() {
+  raw_predictor_->runtime_profiler()->Reset();
+}
+
+lite_api::ShapeCacheStats LightPredictorImpl::GetShapeCacheStats() {
+  return raw_predictor_->GetShapeCacheStats();
+}
+
+std::unique_ptr<lite_api::Tensor> LightPredictorImpl::GetAsyncInput(int i) {
+  return std::unique_ptr<lite_api::Tensor>(
+      new lite_api::Tensor(async_runner()->NextInput(i)));
+}
+
+std::future<lite_api::AsyncOutputs> LightPredictorImpl::RunAsync(
+    AsyncCallback callback) {
+  return async_runner()->Submit(callback);
+}
+
+void LightPredictorImpl::WaitAsync() {
+  AsyncRunner *runner = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    runner = async_runner_.get();
+  }
+  if (runner) runner->Wait();
+}
+
+AsyncRunner *LightPredictorImpl::async_runner() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!async_runner_) {
+    auto *raw = raw_predictor_.get();
+    async_runner_.reset(new AsyncRunner(
+        static_cast<int>(raw->GetInputNames().size()),
+        static_cast<int>(raw->GetOutputNames().size()),
+        [raw](int i) { return raw->GetInput(i); },
+        [raw](int i) { return raw->GetOutput(i); },
+        [this] { Run(); }));
+  }
+  return async_runner_.get();
+}
+
 }  // namespace lite
 
 namespace lite_api {
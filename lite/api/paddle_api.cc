@@ -14,10 +14,12 @@
 
 #include "lite/api/paddle_api.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
 
@@ -95,6 +97,64 @@ void Tensor::ShareExternalMemory(void *data,
   tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
 }
 
+namespace {
+
+// Memory owned by someone else, alive as long as `holder`.
+class HeldBuffer : public lite::Buffer {
+ public:
+  HeldBuffer(void *data,
+             TargetType target,
+             size_t size,
+             std::shared_ptr<void> holder)
+      : lite::Buffer(data, target, size), holder_(std::move(holder)) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (!holder_) {
+      lite::Buffer::ResetLazy(target, size);
+      return;
+    }
+    // Never write into the memory of the holder, move the data to memory of
+    // our own. The holder is released on the calling thread.
+    void *data = lite::TargetMalloc(target, size);
+    if (target == target_) {
+      lite::TargetCopy(target, data, data_, (std::min)(space_, size));
+    }
+    holder_.reset();
+    data_ = data;
+    target_ = target;
+    space_ = size;
+    own_data_ = true;
+  }
+
+ private:
+  std::shared_ptr<void> holder_;
+};
+
+}  // namespace
+
+void Tensor::ShareExternalMemory(void *data,
+                                 size_t memory_size,
+                                 TargetType target,
+                                 std::shared_ptr<void> holder) {
+  auto *t = tensor(raw_tensor_);
+  // Start from a fresh tensor, ResetBuffer requires the previous size and
+  // offset to fit the new buffer.
+  lite::Tensor shared;
+  shared.Resize(t->dims());
+  shared.set_lod(t->lod());
+  shared.set_precision(t->precision());
+  shared.ResetBuffer(
+      std::make_shared<HeldBuffer>(data, target, memory_size, holder),
+      memory_size);
+  t->ShareDataWith(shared);
+}
+
+std::shared_ptr<const void> Tensor::DataHolder() const {
+  auto holder = std::make_shared<lite::Tensor>();
+  holder->ShareDataWith(*ctensor(raw_tensor_));
+  return holder;
+}
+
 template <typename T>
 T *Tensor::mutable_data(TargetType type) const {
   return tensor(raw_tensor_)->mutable_data<T>(type);
@@ -229,6 +289,43 @@ std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
   return nullptr;
 }
 
+void PaddlePredictor::SetRuntimeProfile(int sample_every, bool perf_counters) {
+  LOG(FATAL) << "The runtime profiler is not supported by this predictor.";
+}
+
+std::string PaddlePredictor::GetRuntimeProfileTrace() {
+  LOG(FATAL) << "The runtime profiler is not supported by this predictor.";
+  return "";
+}
+
+std::string PaddlePredictor::GetRuntimeProfileSummary() {
+  LOG(FATAL) << "The runtime profiler is not supported by this predictor.";
+  return "";
+}
+
+void PaddlePredictor::ResetRuntimeProfile() {
+  LOG(FATAL) << "The runtime profiler is not supported by this predictor.";
+}
+
+ShapeCacheStats PaddlePredictor::GetShapeCacheStats() {
+  LOG(FATAL) << "The shape cache is not supported by this predictor.";
+  return ShapeCacheStats();
+}
+
+std::unique_ptr<Tensor> PaddlePredictor::GetAsyncInput(int i) {
+  LOG(FATAL) << "RunAsync is not supported by this predictor.";
+  return nullptr;
+}
+
+std::future<AsyncOutputs> PaddlePredictor::RunAsync(AsyncCallback callback) {
+  LOG(FATAL) << "RunAsync is not supported by this predictor.";
+  return std::future<AsyncOutputs>();
+}
+
+void PaddlePredictor::WaitAsync() {
+  LOG(FATAL) << "RunAsync is not supported by this predictor.";
+}
+
 std::vector<std::string> PaddlePredictor::GetParamNames() {
   std::vector<std::string> null_result = {};
   LOG(FATAL)
@@ -254,6 +351,8 @@ ConfigBase::ConfigBase(PowerMode mode, int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  threads_ = threads > 1 ? threads : 1;
 #endif
 #ifdef LITE_WITH_XPU
   std::shared_ptr<void> runtime_option =
@@ -297,6 +396,20 @@ void ConfigBase::set_opencl_tune(CLTuneMode tune_mode,
 #endif
 }
 
+void ConfigBase::set_cpu_tune(bool enable,
+                              const std::string &path,
+                              const std::string &name) {
+  cpu_tune_ = enable;
+  std::string file;
+  if (!name.empty()) {
+    file = path.empty() ? name : path + "/" + name;
+  }
+  lite::KernelTuner::Global().Enable(enable, file);
+#ifdef LITE_WITH_LOG
+  LOG(INFO) << "set cpu_tune: " << enable << ", tuning file: " << file;
+#endif
+}
+
 void ConfigBase::set_opencl_precision(CLPrecisionType p) {
 #ifdef LITE_WITH_OPENCL
   if (paddle::lite_api::IsOpenCLBackendValid()) {
@@ -324,6 +437,8 @@ void ConfigBase::set_threads(int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode_, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  threads_ = threads > 1 ? threads : 1;
 #endif
 }
 
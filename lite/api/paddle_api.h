@@ -20,6 +20,7 @@
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
 #include <functional>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -73,6 +74,17 @@ struct LITE_API Tensor {
   // state
   // during the prediction process.
   void ShareExternalMemory(void* data, size_t memory_size, TargetType target);
+  // Share external memory as above, keeping `holder` until no tensor uses the
+  // memory any more. Writing the tensor through mutable_data copies the data
+  // to memory of its own and releases `holder`, leaving the external memory
+  // untouched.
+  void ShareExternalMemory(void* data,
+                           size_t memory_size,
+                           TargetType target,
+                           std::shared_ptr<void> holder);
+  // Keeps the current memory of the tensor from being freed, e.g. for a view
+  // of the data which outlives the predictor.
+  std::shared_ptr<const void> DataHolder() const;
 
   template <typename T, TargetType type = TargetType::kHost>
   void CopyFromCpu(const T* data);
@@ -96,6 +108,32 @@ struct LITE_API Tensor {
   void* raw_tensor_;
 };
 
+/// The runs whose input shapes were found in the shape plans of the
+/// predictor, and the others, see ConfigBase::set_shape_cache_capacity.
+struct LITE_API ShapeCacheStats {
+  int64_t hits{0};
+  int64_t misses{0};
+};
+
+struct AsyncOutputsData;
+
+/// The outputs of a run queued by PaddlePredictor::RunAsync. They are copies
+/// owned by this object, so they stay valid while the predictor runs the next
+/// requests. Copying an AsyncOutputs shares the tensors.
+class LITE_API AsyncOutputs {
+ public:
+  AsyncOutputs() = default;
+  explicit AsyncOutputs(std::shared_ptr<AsyncOutputsData> data)
+      : data_(data) {}
+
+  int size() const;
+  /// Get i-th output, valid while this object or a copy of it lives.
+  std::unique_ptr<const Tensor> Get(int i) const;
+
+ private:
+  std::shared_ptr<AsyncOutputsData> data_;
+};
+
 /// The PaddlePredictor defines the basic interfaces for different kinds of
 /// predictors.
 class LITE_API PaddlePredictor {
@@ -143,6 +181,34 @@ class LITE_API PaddlePredictor {
       bool record_info = false);
   virtual void SetStream(TargetType target, void* stream) {}
 
+  /// Profile one run in every `sample_every`, 0 turns the profiler off. It
+  /// works in the release builds, see ConfigBase::set_runtime_profile.
+  virtual void SetRuntimeProfile(int sample_every,
+                                 bool perf_counters = false);
+  /// The timings of the latest profiled runs as Chrome trace events.
+  virtual std::string GetRuntimeProfileTrace();
+  /// The per-instruction and per-op-type aggregates in JSON.
+  virtual std::string GetRuntimeProfileSummary();
+  /// Drop the timings recorded so far.
+  virtual void ResetRuntimeProfile();
+
+  /// The hits and misses of the shape plans.
+  virtual ShapeCacheStats GetShapeCacheStats();
+
+  typedef std::function<void(const AsyncOutputs&)> AsyncCallback;
+  /// Get i-th input of the next RunAsync, filled like GetInput. The inputs
+  /// are double buffered, so the next request can be filled while the
+  /// previous one runs. It blocks while both buffers are queued.
+  virtual std::unique_ptr<Tensor> GetAsyncInput(int i);
+  /// Queue a run on the inputs filled by GetAsyncInput and return at once.
+  /// The runs are done in order on the executor thread of the predictor,
+  /// which calls `callback` with the outputs, if any, then makes the future
+  /// ready. The callback must not queue other runs. Don't call Run while
+  /// async runs are pending.
+  virtual std::future<AsyncOutputs> RunAsync(AsyncCallback callback = nullptr);
+  /// Block until all the queued runs are done.
+  virtual void WaitAsync();
+
   virtual ~PaddlePredictor() = default;
 
  protected:
@@ -210,11 +276,15 @@ class LITE_API ConfigBase {
   std::string model_dir_;
   int threads_{1};
   PowerMode mode_{LITE_POWER_NO_BIND};
+  // The cpus to pin the worker threads of the predictor's thread pool
+  std::vector<int> thread_cpu_ids_{};
   // gpu opencl
   CLTuneMode opencl_tune_mode_{CL_TUNE_NONE};
   std::string opencl_bin_path_{""};
   std::string opencl_bin_name_{""};
   CLPrecisionType opencl_precision_{CL_PRECISION_AUTO};
+  // cpu kernel tuning
+  bool cpu_tune_{false};
   // Where to cache the npu/xpu/rknpu/apu offline model to the binary files
   std::string subgraph_model_cache_dir_{""};
   // Set the cached npu/xpu/rknpu/apu offline model from the buffers
@@ -242,6 +312,16 @@ class LITE_API ConfigBase {
   bool metal_use_aggressive_{false};
   void* metal_device_{nullptr};
   bool metal_use_memory_reuse_{false};
+  // Pack the host activations into one preallocated arena
+  bool use_memory_arena_{false};
+  // Skip the shape inference when the input shapes are unchanged
+  bool cache_stable_shapes_{true};
+  int shape_cache_capacity_{1};
+  // Run the independent ops on inter_op_threads_ threads
+  int inter_op_threads_{1};
+  // Profile one run in every runtime_profile_ runs
+  int runtime_profile_{0};
+  bool runtime_profile_perf_counters_{false};
 
   std::vector<std::string> discarded_passes_{};
   std::map<TargetType, std::shared_ptr<void>> target_configs_;
@@ -257,6 +337,12 @@ class LITE_API ConfigBase {
   // set Power_mode
   void set_power_mode(PowerMode mode);
   PowerMode power_mode() const { return mode_; }
+  // Pin the worker threads of the predictor's own thread pool to the given
+  // cpus, only takes effect with LITE_THREAD_POOL=ON on Linux.
+  void set_thread_cpu_ids(const std::vector<int>& cpu_ids) {
+    thread_cpu_ids_ = cpu_ids;
+  }
+  const std::vector<int>& thread_cpu_ids() const { return thread_cpu_ids_; }
 
   /// \brief Set path and file name of generated OpenCL compiled kernel binary.
   ///
@@ -295,6 +381,27 @@ class LITE_API ConfigBase {
                        const std::string& name = "",
                        size_t lws_repeats = 4);
 
+  /// \brief Set whether to tune the algorithms of the CPU kernels.
+  ///
+  /// The kernels with several algorithms for one op, e.g. the x86 conv2d with
+  /// direct, depthwise and im2col+gemm implementations, time them on the real
+  /// input shapes at the first run and keep the fastest. The first run takes
+  /// longer, so a tuning file is recommended: the winners are saved to it,
+  /// keyed by the CPU model, the number of threads and the op, and the later
+  /// loads reuse them.
+  ///
+  /// \param enable  Whether to tune. It applies to the whole process, like
+  /// the OpenCL tuning.
+  /// \param path  Path that the tuning file stores in. Make sure the path
+  /// exist and you have Read&Write permission.
+  /// \param name  File name of the tuning file, empty to keep the winners
+  /// in memory only.
+  /// \return void
+  void set_cpu_tune(bool enable,
+                    const std::string& path = "",
+                    const std::string& name = "");
+  bool cpu_tune() const { return cpu_tune_; }
+
   /// \brief Set runtime precision on GPU using OpenCL backend.
   ///
   /// \param p
@@ -431,6 +538,63 @@ class LITE_API ConfigBase {
   void* metal_device() const { return metal_device_; }
   bool metal_use_memory_reuse() const { return metal_use_memory_reuse_; }
 
+  // Pack the non-persistable host tensors into one arena laid out by the
+  // sizes and lifetimes recorded in the first run. A tensor that outgrows its
+  // slot falls back to its own buffer and the arena is planned again.
+  void set_use_memory_arena(bool flag) { use_memory_arena_ = flag; }
+  bool use_memory_arena() const { return use_memory_arena_; }
+
+  // Reuse the shapes inferred by the last run when the shapes and LoDs of
+  // all the inputs are unchanged, skipping the InferShape of every op. The
+  // programs with control flow or non-CPU kernels always infer the shapes.
+  // On by default.
+  void set_cache_stable_shapes(bool flag) { cache_stable_shapes_ = flag; }
+  bool cache_stable_shapes() const { return cache_stable_shapes_; }
+  // Keep the inferred shapes and the kernel states of the `capacity` latest
+  // input shapes, evicting the least recently used ones, so that alternating
+  // between a few input shapes, e.g. the resolutions of OCR or the sequence
+  // lengths of NLP, re-infers nothing after the warmup. Every plan beyond
+  // the first creates the kernels again, which share the prepared weights
+  // but have workspaces of their own. Defaults to 1.
+  void set_shape_cache_capacity(int capacity) {
+    shape_cache_capacity_ = capacity;
+  }
+  int shape_cache_capacity() const { return shape_cache_capacity_; }
+  // Run the ops of independent branches, e.g. the towers of an Inception
+  // block or the heads of a detector, concurrently on `threads` of the
+  // threads set by set_threads, each of them running the kernels on its
+  // share of the rest. The ops are ordered by the variables and the buffers
+  // they share, so the results are the same as running them in order. The
+  // programs with control flow or non-CPU kernels always run in order.
+  // Defaults to 1, which runs the ops in order.
+  void set_inter_op_threads(int threads) { inter_op_threads_ = threads; }
+  int inter_op_threads() const { return inter_op_threads_; }
+
+  /// \brief Set whether to profile the runs of the predictor.
+  ///
+  /// Unlike LITE_WITH_PROFILE, the profiler is built in all the libraries
+  /// and costs nothing until turned on. Each instruction of a profiled run is
+  /// timed and described by its op, kernel, shapes and FLOPs, get them by
+  /// PaddlePredictor::GetRuntimeProfileTrace as a Chrome trace, or by
+  /// PaddlePredictor::GetRuntimeProfileSummary as aggregates in JSON.
+  ///
+  /// \param sample_every  Profile one run in every `sample_every` runs, 0
+  /// turns the profiler off. It can be changed later by
+  /// PaddlePredictor::SetRuntimeProfile.
+  /// \param perf_counters  Whether to read the cycles, instructions, cache
+  /// misses and branch misses of each instruction by perf_event_open, which
+  /// gives the IPC and the percentage of the peak FLOPs. Linux only, and
+  /// only the thread calling Run is counted.
+  /// \return void
+  void set_runtime_profile(int sample_every, bool perf_counters = false) {
+    runtime_profile_ = sample_every;
+    runtime_profile_perf_counters_ = perf_counters;
+  }
+  int runtime_profile() const { return runtime_profile_; }
+  bool runtime_profile_perf_counters() const {
+    return runtime_profile_perf_counters_;
+  }
+
   void add_discarded_pass(const std::string pass);
   const std::vector<std::string> get_discarded_passes() const {
     return discarded_passes_;
@@ -475,6 +639,8 @@ class LITE_API CxxConfig : public ConfigBase {
   QuantType quant_type_{QuantType::QUANT_INT16};
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
+  // The meta_version of the naive buffer model saved by SaveOptimizedModel
+  int model_meta_version_{2};
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
   // The custom configuration file or buffer for the NNAdapter subgraph
@@ -549,6 +715,14 @@ class LITE_API CxxConfig : public ConfigBase {
   }
   float sparse_threshold() const { return sparse_threshold_; }
 
+  // 3 saves the params of the naive buffer model behind an index, the model
+  // is loaded in parallel and can be mapped in place, but it can't be loaded
+  // by the previous versions of Paddle-Lite.
+  void set_model_meta_version(int meta_version) {
+    model_meta_version_ = meta_version;
+  }
+  int model_meta_version() const { return model_meta_version_; }
+
   // Enable the custom subgraph partition for NNAdapter by providing the
   // configuration file or buffer
   void set_nnadapter_subgraph_partition_config_path(
@@ -598,6 +772,8 @@ class LITE_API MobileConfig : public ConfigBase {
 
   // model data readed from file in combined format.
   std::string lite_model_file_;
+  // map the model file and use the params in place.
+  bool use_mmap_{false};
   // model data readed from memory buffer in combined format.
   const char* lite_model_buffer_ptr_ = nullptr;
   size_t lite_model_buffer_size_{0};
@@ -618,6 +794,11 @@ class LITE_API MobileConfig : public ConfigBase {
   PrecisionMode precision_mode() const { return precision_mode_; }
   // return model file path.
   const std::string& lite_model_file() const { return lite_model_file_; }
+  // Map the model file set by `set_model_from_file` into memory and let the
+  // params point into it instead of copying them. The processes loading the
+  // same model share one copy of the params in the page cache.
+  void set_use_mmap(bool flag) { use_mmap_ = flag; }
+  bool use_mmap() const { return use_mmap_; }
   // return model buffer data, which is in combined format.
   const char* lite_model_buffer_ptr() const { return lite_model_buffer_ptr_; }
   size_t lite_model_buffer_size() const { return lite_model_buffer_size_; }
@@ -176,6 +176,9 @@ static size_t PrecisionTypeLength(PrecisionType type) {
 enum class QuantType : int {
   QUANT_INT8,
   QUANT_INT16,
+  // int8 weights, the x86 fc quantizes its input per row at runtime and runs
+  // the int8 gemm instead of dequantizing the weights at load time
+  QUANT_INT8_DYNAMIC,
 };
 
 template <typename T>
@@ -15,7 +15,9 @@
 #include "lite/api/python/pybind/pybind.h"
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <chrono>  // NOLINT
 #include <cstring>
+#include <future>  // NOLINT
 #include <iostream>
 #include <map>
 #include <memory>
@@ -33,6 +35,7 @@
 #include "lite/api/paddle_api.h"
 #include "lite/api/python/pybind/tensor_py.h"
 #include "lite/core/tensor.h"
+#include "lite/utils/log/cp_logging.h"
 
 namespace py = pybind11;
 
@@ -56,6 +59,7 @@ using lite_api::CLTuneMode;
 using lite_api::CLPrecisionType;
 using lite_api::Tensor;
 using lite_api::CxxModelBuffer;
+using lite_api::AsyncOutputs;
 
 #ifndef LITE_ON_TINY_PUBLISH
 using lite::CxxPaddleApiImpl;
@@ -71,6 +75,7 @@ void BindLiteOpt(py::module *m) {
       .def("enable_fp16", &OptBase::EnableFloat16)
       .def("set_optimize_out", &OptBase::SetOptimizeOut)
       .def("set_model_type", &OptBase::SetModelType)
+      .def("set_model_meta_version", &OptBase::SetModelMetaVersion)
       .def("set_quant_model", &OptBase::SetQuantModel)
       .def("set_quant_type", &OptBase::SetQuantType)
       .def("set_sparse_model", &OptBase::SetSparseModel)
@@ -99,6 +104,57 @@ static void BindLitePlace(py::module *m);
 static void BindLiteCLTuneMode(py::module *m);
 static void BindLiteCLPrecisionType(py::module *m);
 static void BindLiteTensor(py::module *m);
+static void BindLiteAsyncRun(py::module *m);
+
+// The result of run_async, waited for without the GIL so that the executor
+// thread can call the Python callback meanwhile.
+class AsyncFuture {
+ public:
+  explicit AsyncFuture(std::future<AsyncOutputs> future)
+      : future_(future.share()) {}
+  bool done() const {
+    return future_.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+  AsyncOutputs result() const {
+    py::gil_scoped_release release;
+    return future_.get();
+  }
+
+ private:
+  std::shared_future<AsyncOutputs> future_;
+};
+
+// Deletes a predictor with the GIL released, its destructor waits for the
+// queued run_async requests whose callbacks take the GIL.
+template <typename T>
+struct GilReleasedDelete {
+  void operator()(T *p) const {
+    py::gil_scoped_release release;
+    delete p;
+  }
+};
+template <typename T>
+using PredictorHolder = std::unique_ptr<T, GilReleasedDelete<T>>;
+
+// Wraps a Python callable, called and released on the executor thread of the
+// predictor, which takes the GIL for it.
+static lite_api::PaddlePredictor::AsyncCallback PyAsyncCallback(
+    py::object callback) {
+  if (callback.is_none()) return nullptr;
+  std::shared_ptr<py::object> fn(new py::object(callback), [](py::object *p) {
+    py::gil_scoped_acquire acquire;
+    delete p;
+  });
+  return [fn](const AsyncOutputs &outputs) {
+    py::gil_scoped_acquire acquire;
+    try {
+      (*fn)(outputs);
+    } catch (py::error_already_set &e) {
+      LOG(ERROR) << "The run_async callback raised: " << e.what();
+    }
+  };
+}
 
 void BindLiteApi(py::module *m) {
   BindLiteCxxConfig(m);
@@ -108,6 +164,7 @@ void BindLiteApi(py::module *m) {
   BindLiteCLTuneMode(m);
   BindLiteCLPrecisionType(m);
   BindLiteTensor(m);
+  BindLiteAsyncRun(m);
 #ifndef LITE_ON_TINY_PUBLISH
   BindLiteCxxPredictor(m);
 #endif
@@ -115,19 +172,19 @@ void BindLiteApi(py::module *m) {
 // Global helper methods
 #ifndef LITE_ON_TINY_PUBLISH
   m->def("create_paddle_predictor",
-         [](const CxxConfig &config) -> std::unique_ptr<CxxPaddleApiImpl> {
-           auto x = std::unique_ptr<CxxPaddleApiImpl>(new CxxPaddleApiImpl());
+         [](const CxxConfig &config) -> PredictorHolder<CxxPaddleApiImpl> {
+           auto x = PredictorHolder<CxxPaddleApiImpl>(new CxxPaddleApiImpl());
            x->Init(config);
            return std::move(x);
          });
 #endif
-  m->def("create_paddle_predictor",
-         [](const MobileConfig &config) -> std::unique_ptr<LightPredictorImpl> {
-           auto x =
-               std::unique_ptr<LightPredictorImpl>(new LightPredictorImpl());
-           x->Init(config);
-           return std::move(x);
-         });
+  m->def(
+      "create_paddle_predictor",
+      [](const MobileConfig &config) -> PredictorHolder<LightPredictorImpl> {
+        auto x = PredictorHolder<LightPredictorImpl>(new LightPredictorImpl());
+        x->Init(config);
+        return std::move(x);
+      });
 }
 
 void BindLiteCxxConfig(py::module *m) {
@@ -168,6 +225,29 @@ void BindLiteCxxConfig(py::module *m) {
       .def("set_metal_use_memory_reuse", &CxxConfig::set_metal_use_memory_reuse)
       .def("set_metal_lib_path", &CxxConfig::set_metal_lib_path);
 
+  cxx_config.def("set_use_memory_arena", &CxxConfig::set_use_memory_arena)
+      .def("use_memory_arena", &CxxConfig::use_memory_arena)
+      .def("set_cache_stable_shapes", &CxxConfig::set_cache_stable_shapes)
+      .def("cache_stable_shapes", &CxxConfig::cache_stable_shapes)
+      .def("set_shape_cache_capacity", &CxxConfig::set_shape_cache_capacity)
+      .def("shape_cache_capacity", &CxxConfig::shape_cache_capacity)
+      .def("set_inter_op_threads", &CxxConfig::set_inter_op_threads)
+      .def("inter_op_threads", &CxxConfig::inter_op_threads);
+  cxx_config
+      .def("set_runtime_profile",
+           &CxxConfig::set_runtime_profile,
+           py::arg("sample_every"),
+           py::arg("perf_counters") = false)
+      .def("runtime_profile", &CxxConfig::runtime_profile);
+
+  cxx_config
+      .def("set_cpu_tune",
+           &CxxConfig::set_cpu_tune,
+           py::arg("enable"),
+           py::arg("path") = "",
+           py::arg("name") = "")
+      .def("cpu_tune", &CxxConfig::cpu_tune);
+
   cxx_config
       .def("set_nnadapter_device_names", &CxxConfig::set_nnadapter_device_names)
       .def("set_nnadapter_context_properties",
@@ -200,7 +280,15 @@ void BindLiteMobileConfig(py::module *m) {
       .def("set_model_dir", &MobileConfig::set_model_dir)
       .def("model_dir", &MobileConfig::model_dir)
       .def("set_model_buffer", &MobileConfig::set_model_buffer)
-      .def("is_model_from_memory", &MobileConfig::is_model_from_memory);
+      .def("is_model_from_memory", &MobileConfig::is_model_from_memory)
+      .def("set_use_mmap", &MobileConfig::set_use_mmap)
+      .def("use_mmap", &MobileConfig::use_mmap)
+      .def("set_cpu_tune",
+           &MobileConfig::set_cpu_tune,
+           py::arg("enable"),
+           py::arg("path") = "",
+           py::arg("name") = "")
+      .def("cpu_tune", &MobileConfig::cpu_tune);
 #ifdef LITE_WITH_ARM
   mobile_config.def("set_threads", &MobileConfig::set_threads)
       .def("threads", &MobileConfig::threads)
@@ -219,6 +307,21 @@ void BindLiteMobileConfig(py::module *m) {
       .def("set_metal_use_memory_reuse",
            &MobileConfig::set_metal_use_memory_reuse)
       .def("set_metal_lib_path", &MobileConfig::set_metal_lib_path);
+  mobile_config
+      .def("set_use_memory_arena", &MobileConfig::set_use_memory_arena)
+      .def("use_memory_arena", &MobileConfig::use_memory_arena)
+      .def("set_cache_stable_shapes", &MobileConfig::set_cache_stable_shapes)
+      .def("cache_stable_shapes", &MobileConfig::cache_stable_shapes)
+      .def("set_shape_cache_capacity", &MobileConfig::set_shape_cache_capacity)
+      .def("shape_cache_capacity", &MobileConfig::shape_cache_capacity)
+      .def("set_inter_op_threads", &MobileConfig::set_inter_op_threads)
+      .def("inter_op_threads", &MobileConfig::inter_op_threads);
+  mobile_config
+      .def("set_runtime_profile",
+           &MobileConfig::set_runtime_profile,
+           py::arg("sample_every"),
+           py::arg("perf_counters") = false)
+      .def("runtime_profile", &MobileConfig::runtime_profile);
   mobile_config
       .def("set_nnadapter_device_names",
            &MobileConfig::set_nnadapter_device_names)
@@ -326,7 +429,9 @@ void BindLiteTensor(py::module *m) {
   py::class_<Tensor> tensor(*m, "Tensor");
 
   tensor.def("resize", &Tensor::Resize)
-      .def("numpy", [](Tensor &self) { return TensorToPyArray(self); })
+      .def("numpy",
+           [](Tensor &self, bool copy) { return TensorToPyArray(self, copy); },
+           py::arg("copy") = false)
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
@@ -335,7 +440,8 @@ void BindLiteTensor(py::module *m) {
       .def("from_numpy",
            SetTensorFromPyArray,
            py::arg("array"),
-           py::arg("place") = TargetType::kHost);
+           py::arg("place") = TargetType::kHost,
+           py::arg("copy") = false);
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
   tensor.def(#name__, [=](Tensor &self) -> std::vector<data_type__> { \
@@ -373,9 +479,20 @@ void BindLiteTensor(py::module *m) {
 #undef DATA_GETTER_SETTER_ONCE
 }
 
+void BindLiteAsyncRun(py::module *m) {
+  py::class_<AsyncOutputs>(*m, "AsyncOutputs")
+      .def("size", &AsyncOutputs::size)
+      .def("__len__", &AsyncOutputs::size)
+      .def("get", &AsyncOutputs::Get, py::keep_alive<0, 1>());
+  py::class_<AsyncFuture>(*m, "AsyncFuture")
+      .def("done", &AsyncFuture::done)
+      .def("result", &AsyncFuture::result);
+}
+
 #ifndef LITE_ON_TINY_PUBLISH
 void BindLiteCxxPredictor(py::module *m) {
-  py::class_<CxxPaddleApiImpl>(*m, "CxxPredictor")
+  py::class_<CxxPaddleApiImpl, PredictorHolder<CxxPaddleApiImpl>>(
+      *m, "CxxPredictor")
       .def(py::init<>())
       .def("get_input", &CxxPaddleApiImpl::GetInput)
       .def("get_output", &CxxPaddleApiImpl::GetOutput)
@@ -385,6 +502,36 @@ void BindLiteCxxPredictor(py::module *m) {
       .def("get_output_by_name", &CxxPaddleApiImpl::GetOutputByName)
       .def("run", &CxxPaddleApiImpl::Run)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
+      .def("set_runtime_profile",
+           &CxxPaddleApiImpl::SetRuntimeProfile,
+           py::arg("sample_every"),
+           py::arg("perf_counters") = false)
+      .def("get_runtime_profile_trace",
+           &CxxPaddleApiImpl::GetRuntimeProfileTrace)
+      .def("get_runtime_profile_summary",
+           &CxxPaddleApiImpl::GetRuntimeProfileSummary)
+      .def("reset_runtime_profile", &CxxPaddleApiImpl::ResetRuntimeProfile)
+      .def("get_async_input",
+           &CxxPaddleApiImpl::GetAsyncInput,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async",
+           [](CxxPaddleApiImpl &self, py::object callback) {
+             auto fn = PyAsyncCallback(callback);
+             py::gil_scoped_release release;
+             return AsyncFuture(self.RunAsync(fn));
+           },
+           py::arg("callback") = py::none())
+      .def("wait_async",
+           &CxxPaddleApiImpl::WaitAsync,
+           py::call_guard<py::gil_scoped_release>())
+      .def("get_shape_cache_stats",
+           [](CxxPaddleApiImpl &self) {
+             auto stats = self.GetShapeCacheStats();
+             py::dict res;
+             res["hits"] = stats.hits;
+             res["misses"] = stats.misses;
+             return res;
+           })
       .def("save_optimized_pb_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
              self.SaveOptimizedModel(output_dir,
@@ -400,7 +547,8 @@ void BindLiteCxxPredictor(py::module *m) {
 #endif
 
 void BindLiteLightPredictor(py::module *m) {
-  py::class_<LightPredictorImpl>(*m, "LightPredictor")
+  py::class_<LightPredictorImpl, PredictorHolder<LightPredictorImpl>>(
+      *m, "LightPredictor")
       .def(py::init<>())
       .def("get_input", &LightPredictorImpl::GetInput)
       .def("get_output", &LightPredictorImpl::GetOutput)
@@ -409,7 +557,37 @@ void BindLiteLightPredictor(py::module *m) {
       .def("get_input_by_name", &LightPredictorImpl::GetInputByName)
       .def("get_output_by_name", &LightPredictorImpl::GetOutputByName)
       .def("run", &LightPredictorImpl::Run)
-      .def("get_version", &LightPredictorImpl::GetVersion);
+      .def("get_version", &LightPredictorImpl::GetVersion)
+      .def("set_runtime_profile",
+           &LightPredictorImpl::SetRuntimeProfile,
+           py::arg("sample_every"),
+           py::arg("perf_counters") = false)
+      .def("get_runtime_profile_trace",
+           &LightPredictorImpl::GetRuntimeProfileTrace)
+      .def("get_runtime_profile_summary",
+           &LightPredictorImpl::GetRuntimeProfileSummary)
+      .def("reset_runtime_profile", &LightPredictorImpl::ResetRuntimeProfile)
+      .def("get_async_input",
+           &LightPredictorImpl::GetAsyncInput,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async",
+           [](LightPredictorImpl &self, py::object callback) {
+             auto fn = PyAsyncCallback(callback);
+             py::gil_scoped_release release;
+             return AsyncFuture(self.RunAsync(fn));
+           },
+           py::arg("callback") = py::none())
+      .def("wait_async",
+           &LightPredictorImpl::WaitAsync,
+           py::call_guard<py::gil_scoped_release>())
+      .def("get_shape_cache_stats",
+           [](LightPredictorImpl &self) {
+             auto stats = self.GetShapeCacheStats();
+             py::dict res;
+             res["hits"] = stats.hits;
+             res["misses"] = stats.misses;
+             return res;
+           });
 }
 
 }  // namespace pybind
@@ -16,10 +16,12 @@
 #define LITE_API_PYTHON_PYBIND_TENSOR_PY_H_
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <set>
 #include <string>
 #include <utility>
@@ -119,7 +121,18 @@ inline py::array TensorToPyArray(const Tensor &tensor,
   }
 
   tensor_buf_ptr = static_cast<const void *>(tensor.data<int8_t>());
-  auto base = py::cast(std::move(tensor));
+  if (need_deep_copy) {
+    return py::array(py::dtype(py_dtype_str.c_str()),
+                     py_dims,
+                     py_strides,
+                     tensor_buf_ptr);
+  }
+  // A view on the memory of the tensor, which it keeps from being freed. The
+  // next run of the predictor writes the same memory.
+  auto *holder = new std::shared_ptr<const void>(tensor.DataHolder());
+  auto base = py::capsule(holder, [](void *p) {
+    delete static_cast<std::shared_ptr<const void> *>(p);
+  });
   return py::array(py::dtype(py_dtype_str.c_str()),
                    py_dims,
                    py_strides,
@@ -127,6 +140,47 @@ inline py::array TensorToPyArray(const Tensor &tensor,
                    base);
 }
 
+// The memory of the numpy arrays aligned to this is shared by the tensors
+// rather than copied, as much as the host kernels take.
+const size_t kZeroCopyAlignment = 16;
+
+// The numpy arrays shared by the tensors are released on the thread dropping
+// the last tensor using them. Taking the GIL there, e.g. on a lane of the
+// thread pool or on the executor of run_async, may deadlock with a caller
+// holding it, so a thread without the GIL leaves the array to the next
+// from_numpy.
+class SharedArrays {
+ public:
+  static void Release(py::object *array) {
+    if (PyGILState_Check()) {
+      delete array;
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex());
+    pending().push_back(array);
+  }
+
+  // Called with the GIL held.
+  static void ReleasePending() {
+    std::vector<py::object *> arrays;
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      arrays.swap(pending());
+    }
+    for (auto *array : arrays) delete array;
+  }
+
+ private:
+  static std::mutex &mutex() {
+    static std::mutex x;
+    return x;
+  }
+  static std::vector<py::object *> &pending() {
+    static std::vector<py::object *> x;
+    return x;
+  }
+};
+
 ////////////////////////////////////////////////////////////////
 // Function Name: SetTensorFromPyArrayT
 // Usage: Transform numpy of specified precision into tensor
@@ -135,7 +189,9 @@ template <typename T>
 void SetTensorFromPyArrayT(
     Tensor *self,
     const py::array_t<T, py::array::c_style | py::array::forcecast> &array,
-    const TargetType &place) {
+    const TargetType &place,
+    bool copy) {
+  SharedArrays::ReleasePending();
   std::vector<int64_t> dims;
   dims.reserve(array.ndim());
   for (decltype(array.ndim()) i = 0; i < array.ndim(); ++i) {
@@ -143,6 +199,20 @@ void SetTensorFromPyArrayT(
   }
   self->Resize(dims);
 
+  // `array` is contiguous already, converted from the input if needed.
+  bool on_host = place == TargetType::kHost || place == TargetType::kX86 ||
+                 place == TargetType::kARM;
+  auto addr = reinterpret_cast<uintptr_t>(array.data());
+  if (!copy && on_host && addr % kZeroCopyAlignment == 0) {
+    std::shared_ptr<void> holder(new py::object(array), [](void *p) {
+      SharedArrays::Release(static_cast<py::object *>(p));
+    });
+    self->ShareExternalMemory(
+        const_cast<T *>(array.data()), array.nbytes(), place, holder);
+    self->SetPrecision(lite_api::PrecisionTypeTrait<T>::Type());
+    return;
+  }
+
   auto dst = self->mutable_data<T>(place);
   if (TargetType::kXPU == place) {
 #ifdef LITE_WITH_XPU
@@ -162,24 +232,25 @@ void SetTensorFromPyArrayT(
 ////////////////////////////////////////////////////////////////
 void SetTensorFromPyArray(Tensor *self,
                           const py::object &obj,
-                          const TargetType &place) {
+                          const TargetType &place,
+                          bool copy) {
   auto array = obj.cast<py::array>();
   if (py::isinstance<py::array_t<float>>(array)) {
-    SetTensorFromPyArrayT<float>(self, array, place);
+    SetTensorFromPyArrayT<float>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<int>>(array)) {
-    SetTensorFromPyArrayT<int>(self, array, place);
+    SetTensorFromPyArrayT<int>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<int64_t>>(array)) {
-    SetTensorFromPyArrayT<int64_t>(self, array, place);
+    SetTensorFromPyArrayT<int64_t>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<double>>(array)) {
-    SetTensorFromPyArrayT<double>(self, array, place);
+    SetTensorFromPyArrayT<double>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<int8_t>>(array)) {
-    SetTensorFromPyArrayT<int8_t>(self, array, place);
+    SetTensorFromPyArrayT<int8_t>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<int16_t>>(array)) {
-    SetTensorFromPyArrayT<int16_t>(self, array, place);
+    SetTensorFromPyArrayT<int16_t>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<uint8_t>>(array)) {
-    SetTensorFromPyArrayT<uint8_t>(self, array, place);
+    SetTensorFromPyArrayT<uint8_t>(self, array, place, copy);
   } else if (py::isinstance<py::array_t<bool>>(array)) {
-    SetTensorFromPyArrayT<bool>(self, array, place);
+    SetTensorFromPyArrayT<bool>(self, array, place, copy);
   } else {
     // obj may be any type, obj.cast<py::array>() may be failed,
     // then the array.dtype will be string of unknown meaning,
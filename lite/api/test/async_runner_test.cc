@@ -0,0 +1,102 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/async_runner.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// A fake model doubling its only input, slow enough for the requests to
+// overlap.
+class DoubleModel {
+ public:
+  AsyncRunner* runner() {
+    if (!runner_) {
+      runner_.reset(new AsyncRunner(1,
+                                    1,
+                                    [this](int) { return &feed_; },
+                                    [this](int) { return &fetch_; },
+                                    [this] { Run(); }));
+    }
+    return runner_.get();
+  }
+
+  std::atomic<int> runs{0};
+
+ private:
+  void Run() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    fetch_.Resize(feed_.dims());
+    auto* dst = fetch_.mutable_data<float>();
+    for (int64_t i = 0; i < feed_.numel(); i++) {
+      dst[i] = feed_.data<float>()[i] * 2.f;
+    }
+    runs++;
+  }
+
+  Tensor feed_;
+  Tensor fetch_;
+  std::unique_ptr<AsyncRunner> runner_;
+};
+
+TEST(async_runner, run) {
+  DoubleModel model;
+  std::vector<std::future<lite_api::AsyncOutputs>> futures;
+  std::vector<int> order;
+  for (int n = 0; n < 8; n++) {
+    // The next request is filled while the previous ones run.
+    auto* input = model.runner()->NextInput(0);
+    input->Resize({n + 1});
+    auto* data = input->mutable_data<float>();
+    for (int i = 0; i <= n; i++) data[i] = static_cast<float>(n);
+    futures.push_back(model.runner()->Submit(
+        [&order, n](const lite_api::AsyncOutputs& outputs) {
+          order.push_back(n);
+          EXPECT_EQ(outputs.size(), 1);
+        }));
+  }
+  for (int n = 0; n < 8; n++) {
+    auto outputs = futures[n].get();
+    auto output = outputs.Get(0);
+    ASSERT_EQ(output->shape(), lite_api::shape_t({n + 1}));
+    for (int i = 0; i <= n; i++) {
+      EXPECT_EQ(output->data<float>()[i], 2.f * n);
+    }
+  }
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(model.runs.load(), 8);
+}
+
+TEST(async_runner, wait) {
+  DoubleModel model;
+  for (int n = 0; n < 4; n++) {
+    auto* input = model.runner()->NextInput(0);
+    input->Resize({4});
+    input->mutable_data<float>();
+    model.runner()->Submit(nullptr);
+  }
+  model.runner()->Wait();
+  EXPECT_EQ(model.runs.load(), 4);
+  // Nothing queued.
+  model.runner()->Wait();
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,154 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/batching_predictor.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+// Doubles its only input, and records the batch sizes it was run with.
+class DoublePredictor : public PaddlePredictor {
+ public:
+  std::unique_ptr<Tensor> GetInput(int i) override {
+    return std::unique_ptr<Tensor>(new Tensor(&input_));
+  }
+  std::unique_ptr<const Tensor> GetOutput(int i) const override {
+    return std::unique_ptr<const Tensor>(new Tensor(&output_));
+  }
+  void Run() override {
+    output_.Resize(input_.dims());
+    auto* dst = output_.mutable_data<float>();
+    for (int64_t i = 0; i < input_.numel(); i++) {
+      dst[i] = input_.data<float>()[i] * 2.f;
+    }
+    std::lock_guard<std::mutex> lock(*mutex_);
+    batch_sizes_->push_back(input_.dims()[0]);
+  }
+  std::shared_ptr<PaddlePredictor> Clone() override {
+    auto clone = std::make_shared<DoublePredictor>();
+    clone->mutex_ = mutex_;
+    clone->batch_sizes_ = batch_sizes_;
+    return clone;
+  }
+  std::shared_ptr<PaddlePredictor> Clone(
+      const std::vector<std::string>& var_names) override {
+    return Clone();
+  }
+  std::string GetVersion() const override { return "test"; }
+  std::vector<std::string> GetInputNames() override { return {"x"}; }
+  std::vector<std::string> GetOutputNames() override { return {"out"}; }
+  bool TryShrinkMemory() override { return true; }
+  std::unique_ptr<Tensor> GetInputByName(const std::string& name) override {
+    return GetInput(0);
+  }
+  std::unique_ptr<const Tensor> GetTensor(
+      const std::string& name) const override {
+    return GetOutput(0);
+  }
+
+  std::vector<int64_t> batch_sizes() {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    return *batch_sizes_;
+  }
+
+ private:
+  lite::Tensor input_;
+  mutable lite::Tensor output_;
+  std::shared_ptr<std::mutex> mutex_{std::make_shared<std::mutex>()};
+  std::shared_ptr<std::vector<int64_t>> batch_sizes_{
+      std::make_shared<std::vector<int64_t>>()};
+};
+
+static void RunClient(BatchingPredictor* predictor,
+                      int client,
+                      int batch_size,
+                      int width,
+                      int repeats) {
+  for (int r = 0; r < repeats; r++) {
+    std::vector<float> data(batch_size * width);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = client * 10000 + r * 100 + i;
+    }
+    std::vector<BatchingPredictor::Input> inputs(1);
+    inputs[0].shape = {batch_size, width};
+    inputs[0].data = data.data();
+    std::vector<BatchingPredictor::Output> outputs;
+    predictor->Run(inputs, &outputs);
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(outputs[0].shape, shape_t({batch_size, width}));
+    EXPECT_EQ(outputs[0].precision, PrecisionType::kFloat);
+    for (size_t i = 0; i < data.size(); i++) {
+      EXPECT_EQ(outputs[0].as<float>()[i], data[i] * 2.f);
+    }
+  }
+}
+
+TEST(batching_predictor, coalesce) {
+  auto base = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 8;
+  config.max_wait_us = 2000;
+  std::unique_ptr<BatchingPredictor> predictor(
+      new BatchingPredictor(base, 2, config));
+
+  std::vector<std::thread> clients;
+  for (int c = 0; c < 8; c++) {
+    // Clients of different widths are never batched together.
+    clients.emplace_back(
+        RunClient, predictor.get(), c, 1 + c % 2, 3 + c % 2, 20);
+  }
+  for (auto& c : clients) c.join();
+
+  EXPECT_EQ(predictor->num_samples(), 4u * 20u + 4u * 2u * 20u);
+  // Requests of the same width were merged, but no batch exceeded 8 samples:
+  // at least 80 / 8 batches of width 3 and 160 / 8 of width 4.
+  EXPECT_LT(predictor->num_batches(), 8u * 20u);
+  EXPECT_GE(predictor->num_batches(), 80u / 8u + 160u / 8u);
+  for (auto size : base->batch_sizes()) {
+    EXPECT_LE(size, 8);
+  }
+}
+
+TEST(batching_predictor, buckets) {
+  auto base = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 8;
+  config.max_wait_us = 1000;
+  config.batch_buckets = {8, 2, 4};
+  std::unique_ptr<BatchingPredictor> predictor(
+      new BatchingPredictor(base, 1, config));
+
+  std::vector<std::thread> clients;
+  for (int c = 0; c < 3; c++) {
+    clients.emplace_back(RunClient, predictor.get(), c, 1, 5, 10);
+  }
+  // Larger than the largest bucket, runs on its own and unpadded.
+  clients.emplace_back(RunClient, predictor.get(), 3, 9, 5, 2);
+  for (auto& c : clients) c.join();
+
+  EXPECT_EQ(predictor->num_samples(), 3u * 10u + 9u * 2u);
+  for (auto size : base->batch_sizes()) {
+    EXPECT_TRUE(size == 2 || size == 4 || size == 8 || size == 9) << size;
+  }
+}
+
+}  // namespace lite_api
+}  // namespace paddle
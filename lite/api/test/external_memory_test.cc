@@ -0,0 +1,97 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/paddle_api.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+// External memory of 8 floats, `released` is set when the holder goes.
+class ExternalMemory {
+ public:
+  ExternalMemory() : data(8) {
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<float>(i);
+  }
+
+  // Shares the memory with `tensor` of shape [2, 4].
+  void ShareWith(Tensor* tensor) {
+    std::shared_ptr<void> holder(&released, [](void* p) {
+      *static_cast<bool*>(p) = true;
+    });
+    tensor->Resize({2, 4});
+    tensor->ShareExternalMemory(
+        data.data(), data.size() * sizeof(float), TargetType::kHost, holder);
+    tensor->SetPrecision(PrecisionType::kFloat);
+  }
+
+  std::vector<float> data;
+  bool released{false};
+};
+
+TEST(ExternalMemory, holder) {
+  ExternalMemory memory;
+  lite::Tensor raw;
+  Tensor tensor(&raw);
+  memory.ShareWith(&tensor);
+  EXPECT_EQ(tensor.data<float>(), memory.data.data());
+  EXPECT_FALSE(memory.released);
+
+  // The views of the tensor keep the holder.
+  auto view = tensor.DataHolder();
+  lite::Tensor copy;
+  copy.ShareDataWith(raw);
+  raw = lite::Tensor();
+  EXPECT_FALSE(memory.released);
+  view.reset();
+  EXPECT_FALSE(memory.released);
+  copy = lite::Tensor();
+  EXPECT_TRUE(memory.released);
+}
+
+TEST(ExternalMemory, mutable_data) {
+  ExternalMemory memory;
+  lite::Tensor raw;
+  Tensor tensor(&raw);
+  memory.ShareWith(&tensor);
+
+  // Writing moves the data to memory of the tensor, the external memory is
+  // left untouched and its holder released on the writing thread.
+  float* data = tensor.mutable_data<float>();
+  EXPECT_NE(data, memory.data.data());
+  EXPECT_TRUE(memory.released);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(data[i], static_cast<float>(i));
+    data[i] = -1.f;
+  }
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(memory.data[i], static_cast<float>(i));
+  }
+
+  // Growing the tensor keeps the data so far.
+  ExternalMemory grown;
+  grown.ShareWith(&tensor);
+  tensor.Resize({4, 4});
+  data = tensor.mutable_data<float>();
+  EXPECT_TRUE(grown.released);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(data[i], static_cast<float>(i));
+  }
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -21,8 +21,10 @@
 #include <memory>
 #include <numeric>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
+#include "lite/api/batching_predictor.h"
 #ifdef __ANDROID__
 #include "lite/api/tools/benchmark/precision_evaluation/imagenet_image_classification/prepost_process.h"
 #endif
@@ -360,9 +362,115 @@ void Run(const std::string& model_file,
   }
   if (FLAGS_enable_memory_profile) resource_monter.Stop();
 #endif
+  if (FLAGS_batching_clients > 0) {
+    ss << RunBatching(predictor, input_shapes);
+  }
   std::cout << ss.str() << std::endl;
   StoreBenchmarkResult(ss.str());
 }
 
+std::string RunBatching(std::shared_ptr<PaddlePredictor> predictor,
+                        const std::vector<std::vector<int64_t>>& input_shapes) {
+  BatchingConfig config;
+  config.max_batch_size = FLAGS_batching_max_batch_size;
+  config.max_wait_us = FLAGS_batching_max_wait_us;
+  if (!FLAGS_batching_buckets.empty()) {
+    config.batch_buckets = lite::Split<int>(FLAGS_batching_buckets, ",");
+  }
+  BatchingPredictor batching(predictor, FLAGS_batching_workers, config);
+
+  // Every client sends the same inputs of --input_shape, all ones.
+  auto input_types = lite::Split(FLAGS_input_data_type, ":");
+  std::vector<std::vector<char>> buffers(input_shapes.size());
+  std::vector<BatchingPredictor::Input> inputs(input_shapes.size());
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    int64_t numel = lite::ShapeProduction(input_shapes[i]);
+    auto& input = inputs[i];
+    input.shape = input_shapes[i];
+    if ((i < input_types.size()) && (input_types[i] == "int64")) {
+      input.precision = PrecisionType::kInt64;
+      std::vector<int64_t> data(numel, 1);
+      buffers[i].assign(reinterpret_cast<char*>(data.data()),
+                        reinterpret_cast<char*>(data.data() + numel));
+    } else if ((i < input_types.size()) && (input_types[i] == "int32")) {
+      input.precision = PrecisionType::kInt32;
+      std::vector<int32_t> data(numel, 1);
+      buffers[i].assign(reinterpret_cast<char*>(data.data()),
+                        reinterpret_cast<char*>(data.data() + numel));
+    } else {
+      input.precision = PrecisionType::kFloat;
+      std::vector<float> data(numel, 1.f);
+      buffers[i].assign(reinterpret_cast<char*>(data.data()),
+                        reinterpret_cast<char*>(data.data() + numel));
+    }
+    input.data = buffers[i].data();
+  }
+
+  int num_clients = FLAGS_batching_clients;
+  std::vector<std::vector<float>> latencies(num_clients);
+  std::vector<BatchingPredictor::Output> warmup_outputs;
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    batching.Run(inputs, &warmup_outputs);
+  }
+  uint64_t warmup_batches = batching.num_batches();
+  uint64_t warmup_samples = batching.num_samples();
+
+  auto client = [&](int id) {
+    std::vector<BatchingPredictor::Output> outputs;
+    lite::Timer timer;
+    for (int i = 0; i < FLAGS_repeats; ++i) {
+      timer.Start();
+      batching.Run(inputs, &outputs);
+      latencies[id].push_back(timer.Stop());
+    }
+  };
+  lite::Timer timer;
+  timer.Start();
+  std::vector<std::thread> clients;
+  for (int id = 0; id < num_clients; ++id) {
+    clients.emplace_back(client, id);
+  }
+  for (auto& t : clients) {
+    t.join();
+  }
+  float total_ms = timer.Stop();
+
+  std::vector<float> all;
+  for (auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  std::sort(all.begin(), all.end());
+  auto percentile = [&all](float p) {
+    if (all.empty()) return 0.f;
+    size_t idx = static_cast<size_t>(p * (all.size() - 1) + 0.5f);
+    return all[idx];
+  };
+  uint64_t batches = batching.num_batches() - warmup_batches;
+  uint64_t samples = batching.num_samples() - warmup_samples;
+
+  std::stringstream ss;
+  ss.precision(3);
+  ss << std::fixed << std::left;
+  ss << "\n======= Batching Info =======\n";
+  ss << "clients: " << num_clients << std::endl;
+  ss << "workers: " << FLAGS_batching_workers << std::endl;
+  ss << "max_batch_size: " << FLAGS_batching_max_batch_size << std::endl;
+  ss << "max_wait_us: " << FLAGS_batching_max_wait_us << std::endl;
+  if (!FLAGS_batching_buckets.empty()) {
+    ss << "buckets: " << FLAGS_batching_buckets << std::endl;
+  }
+  ss << "avg batch: " << std::setw(12)
+     << static_cast<float>(samples) / std::max<uint64_t>(batches, 1)
+     << std::endl;
+  ss << "throughput(samples/s): " << std::setw(12)
+     << (total_ms > 0.f ? samples * 1000.f / total_ms : 0.f) << std::endl;
+  ss << "Latency(unit: ms):\n";
+  ss << "p50   = " << std::setw(12) << percentile(0.5f) << std::endl;
+  ss << "p99   = " << std::setw(12) << percentile(0.99f) << std::endl;
+  ss << "max   = " << std::setw(12) << (all.empty() ? 0.f : all.back())
+     << std::endl;
+  return ss.str();
+}
+
 }  // namespace lite_api
 }  // namespace paddle
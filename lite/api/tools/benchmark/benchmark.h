@@ -96,6 +96,10 @@ class PerfData {
 int Benchmark(int argc, char** argv);
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shape);
+// Stress tests a BatchingPredictor over `predictor` and returns a report of
+// its throughput and latency.
+std::string RunBatching(std::shared_ptr<PaddlePredictor> predictor,
+                        const std::vector<std::vector<int64_t>>& input_shapes);
 
 #ifdef __ANDROID__
 std::string GetDeviceInfo() {
@@ -62,6 +62,13 @@ DEFINE_int32(memory_check_interval_ms, 5, memory_check_interval_ms_msg);
 // Configuration options
 DEFINE_string(config_path, "", config_path_msg);
 
+// Batching options
+DEFINE_int32(batching_clients, 0, batching_clients_msg);
+DEFINE_int32(batching_workers, 1, batching_workers_msg);
+DEFINE_int32(batching_max_batch_size, 8, batching_max_batch_size_msg);
+DEFINE_int32(batching_max_wait_us, 1000, batching_max_wait_us_msg);
+DEFINE_string(batching_buckets, "", batching_buckets_msg);
+
 // Others
 
 }  // namespace lite_api
@@ -123,6 +123,21 @@ static const char memory_check_interval_ms_msg[] =
 // Configuration options
 static const char config_path_msg[] = "Configuration options.";
 
+// Batching options
+static const char batching_clients_msg[] =
+    "Run a stress test of the batching predictor with this many concurrent "
+    "clients after the benchmark, each sending --repeats requests of "
+    "--input_shape. Non-positive values mean no stress test.";
+static const char batching_workers_msg[] =
+    "The number of predictors serving the clients of the stress test.";
+static const char batching_max_batch_size_msg[] =
+    "The most samples run at once in the stress test.";
+static const char batching_max_wait_us_msg[] =
+    "How long in microseconds a request waits for others to join its batch.";
+static const char batching_buckets_msg[] =
+    "The batch sizes to pad to in the stress test, e.g. 1,2,4,8. "
+    "Empty means no padding.";
+
 // Others
 
 // Model options
@@ -164,6 +179,13 @@ DECLARE_int32(memory_check_interval_ms);
 // Configuration options
 DECLARE_string(config_path);
 
+// Batching options
+DECLARE_int32(batching_clients);
+DECLARE_int32(batching_workers);
+DECLARE_int32(batching_max_batch_size);
+DECLARE_int32(batching_max_wait_us);
+DECLARE_string(batching_buckets);
+
 // Others
 
 }  // namespace lite_api
@@ -46,13 +46,18 @@ DEFINE_bool(quant_model,
 DEFINE_string(quant_type,
               "QUANT_INT16",
               "Set the quant_type for post_quant_dynamic, "
-              "and it should be QUANT_INT8 or QUANT_INT16 for now.");
+              "and it should be QUANT_INT8, QUANT_INT16 or "
+              "QUANT_INT8_DYNAMIC for now.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
 DEFINE_bool(record_tailoring_info,
             false,
             "Record kernels and operators information of the optimized model "
             "for tailoring compiling, information are stored into optimized "
             "model path as hidden files");
+DEFINE_int32(model_meta_version,
+             2,
+             "meta_version of the naive_buffer model, 3 indexes the params "
+             "to load them in parallel or in place.");
 DEFINE_string(optimize_out, "", "path of the output optimized model");
 DEFINE_string(valid_targets,
               "arm",
@@ -114,6 +119,7 @@ int main(int argc, char** argv) {
   if (FLAGS_optimize_out != "") {
     opt.SetOptimizeOut(FLAGS_optimize_out);
   }
+  opt.SetModelMetaVersion(FLAGS_model_meta_version);
   if (FLAGS_valid_targets != "") {
     if (FLAGS_enable_fp16) opt.EnableFloat16();
     opt.SetValidPlaces(FLAGS_valid_targets);
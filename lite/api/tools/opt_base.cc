@@ -44,6 +44,13 @@ void OptBase::SetModelType(std::string optimize_out_type) {
   }
 }
 
+void OptBase::SetModelMetaVersion(int meta_version) {
+  if (meta_version != 2 && meta_version != 3) {
+    OPT_LOG_FATAL << "Unsupported model meta_version: " << meta_version;
+  }
+  opt_config_.set_model_meta_version(meta_version);
+}
+
 void OptBase::SetQuantModel(bool quant_model) {
   opt_config_.set_quant_model(quant_model);
 }
@@ -53,6 +60,8 @@ void OptBase::SetQuantType(const std::string& quant_type) {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT8);
   } else if (quant_type == "QUANT_INT16") {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT16);
+  } else if (quant_type == "QUANT_INT8_DYNAMIC") {
+    opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT8_DYNAMIC);
   } else {
     OPT_LOG_FATAL << "Unsupported quant type: " << quant_type;
   }
@@ -400,6 +409,7 @@ void OptBase::PrintHelpInfo() {
       "        `set_param_file(param_file_path)`\n"
       "        `set_model_type(protobuf|naive_buffer)`: naive_buffer by "
       "default\n"
+      "        `set_model_meta_version(2|3)`: 2 by default\n"
       "        `set_lite_out(output_optimize_model_dir)`\n"
       "        "
       "`set_valid_places(arm|opencl|x86|metal|xpu|host|cambricon_mlu|huawei_"
@@ -445,6 +455,7 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--model_file=<model_path>`\n"
       "        `--param_file=<param_path>`\n"
       "        `--optimize_out_type=(protobuf|naive_buffer)`\n"
+      "        `--model_meta_version=(2|3)`\n"
       "        `--optimize_out=<output_optimize_model_dir>`\n"
       "        "
       "`--valid_targets=(arm|opencl|x86|metal|xpu|host|cambricon_mlu|huawei_"
@@ -454,7 +465,7 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--record_tailoring_info=(true|false)`\n"
       "  Arguments of mode quantization in opt:\n"
       "        `--quant_model=(true|false)`\n"
-      "        `--quant_type=(QUANT_INT8|QUANT_INT16)`\n"
+      "        `--quant_type=(QUANT_INT8|QUANT_INT16|QUANT_INT8_DYNAMIC)`\n"
       "  Arguements of sparse convolution in opt: \n"
       "        `--sparse_model=(true|false)`\n"
       "        `--sparse_threshold=(float)`\n"
@@ -60,6 +60,8 @@ class LITE_API OptBase {
       const std::string &nnadapter_mixed_precision_quantization_config_path);
   // set optimized_model type
   void SetModelType(std::string model_type = "naive_buffer");
+  // set meta_version of the naive_buffer model, 2 or 3
+  void SetModelMetaVersion(int meta_version = 2);
   // internal inference for developer, not recommanded.
   // choose methods of model optimizing.
   void SetPassesInternal(const std::vector<std::string> &passes_internal = {});
@@ -0,0 +1,331 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/transpose.h"
+#include <string.h>
+#include <algorithm>
+#include <numeric>
+#ifdef __AVX__
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// a 32x32 tile of floats is 4KB on each side and stays in L1
+static const int kTile = 32;
+
+// dst[c * ldd + r] = src[r * lds + c] for r < rows, c < cols
+template <typename T>
+static void transpose_tile(
+    const T* src, int64_t lds, T* dst, int64_t ldd, int rows, int cols) {
+  for (int c = 0; c < cols; c++) {
+    for (int r = 0; r < rows; r++) {
+      dst[c * ldd + r] = src[r * lds + c];
+    }
+  }
+}
+
+#ifdef __AVX__
+static inline void transpose_8x8(const float* src,
+                                 int64_t lds,
+                                 float* dst,
+                                 int64_t ldd) {
+  __m256 r0 = _mm256_loadu_ps(src);
+  __m256 r1 = _mm256_loadu_ps(src + lds);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * lds);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * lds);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * lds);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * lds);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * lds);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * lds);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(dst, _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps(dst + ldd, _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps(dst + 2 * ldd, _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps(dst + 3 * ldd, _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps(dst + 4 * ldd, _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps(dst + 5 * ldd, _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps(dst + 6 * ldd, _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps(dst + 7 * ldd, _mm256_permute2f128_ps(r3, r7, 0x31));
+}
+static const int kBlock = 8;
+#elif defined(__SSE__)
+static inline void transpose_4x4(const float* src,
+                                 int64_t lds,
+                                 float* dst,
+                                 int64_t ldd) {
+  __m128 r0 = _mm_loadu_ps(src);
+  __m128 r1 = _mm_loadu_ps(src + lds);
+  __m128 r2 = _mm_loadu_ps(src + 2 * lds);
+  __m128 r3 = _mm_loadu_ps(src + 3 * lds);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst, r0);
+  _mm_storeu_ps(dst + ldd, r1);
+  _mm_storeu_ps(dst + 2 * ldd, r2);
+  _mm_storeu_ps(dst + 3 * ldd, r3);
+}
+static const int kBlock = 4;
+#endif
+
+// 4 byte elements go through the float micro-kernel, the edges of the tile
+// fall back to the scalar copy.
+static void transpose_tile(const uint32_t* src,
+                           int64_t lds,
+                           uint32_t* dst,
+                           int64_t ldd,
+                           int rows,
+                           int cols) {
+  int r = 0;
+#if defined(__AVX__) || defined(__SSE__)
+  const float* fsrc = reinterpret_cast<const float*>(src);
+  float* fdst = reinterpret_cast<float*>(dst);
+  int full_cols = cols / kBlock * kBlock;
+  for (; r + kBlock <= rows; r += kBlock) {
+    for (int c = 0; c < full_cols; c += kBlock) {
+#ifdef __AVX__
+      transpose_8x8(fsrc + r * lds + c, lds, fdst + c * ldd + r, ldd);
+#else
+      transpose_4x4(fsrc + r * lds + c, lds, fdst + c * ldd + r, ldd);
+#endif
+    }
+    transpose_tile<uint32_t>(src + r * lds + full_cols,
+                             lds,
+                             dst + full_cols * ldd + r,
+                             ldd,
+                             kBlock,
+                             cols - full_cols);
+  }
+#endif
+  transpose_tile<uint32_t>(
+      src + r * lds, lds, dst + r, ldd, rows - r, cols);
+}
+
+// Drops the unit axes and merges the input axes which stay adjacent in the
+// output, dims and axis are rewritten in place.
+static void simplify_axes(std::vector<int64_t>* dims, std::vector<int>* axis) {
+  int rank = dims->size();
+  std::vector<int> index(rank, -1);
+  std::vector<int64_t> kept_dims;
+  for (int i = 0; i < rank; i++) {
+    if ((*dims)[i] != 1) {
+      index[i] = kept_dims.size();
+      kept_dims.push_back((*dims)[i]);
+    }
+  }
+  // [begin, end) input axes of each group, in the output order
+  std::vector<int> begin;
+  std::vector<int> end;
+  for (int i = 0; i < rank; i++) {
+    int a = index[(*axis)[i]];
+    if (a < 0) continue;
+    if (!end.empty() && end.back() == a) {
+      end.back()++;
+    } else {
+      begin.push_back(a);
+      end.push_back(a + 1);
+    }
+  }
+  int groups = begin.size();
+  std::vector<int> order(groups);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int x, int y) {
+    return begin[x] < begin[y];
+  });
+  dims->resize(groups);
+  axis->resize(groups);
+  for (int g = 0; g < groups; g++) {
+    int o = order[g];
+    int64_t d = 1;
+    for (int a = begin[o]; a < end[o]; a++) {
+      d *= kept_dims[a];
+    }
+    (*dims)[g] = d;
+    (*axis)[o] = g;
+  }
+}
+
+template <typename T>
+static void transpose_impl(const T* din,
+                           T* dout,
+                           std::vector<int64_t> dims,
+                           std::vector<int> axis) {
+  int64_t count = 1;
+  for (auto d : dims) {
+    count *= d;
+  }
+  if (count == 0) return;
+  simplify_axes(&dims, &axis);
+  int rank = dims.size();
+  if (rank <= 1) {
+    memcpy(dout, din, count * sizeof(T));
+    return;
+  }
+  std::vector<int64_t> in_stride(rank, 1);
+  std::vector<int64_t> out_stride(rank, 1);
+  for (int i = rank - 2; i >= 0; i--) {
+    in_stride[i] = in_stride[i + 1] * dims[i + 1];
+    out_stride[i] = out_stride[i + 1] * dims[axis[i + 1]];
+  }
+
+  if (axis[rank - 1] == rank - 1) {
+    // the innermost axis stays, rows of it are copied
+    int64_t inner = dims[rank - 1];
+    int outer = static_cast<int>(count / inner);
+    LITE_PARALLEL_BEGIN(i, tid, outer) {
+      int64_t idx = i;
+      int64_t offset = 0;
+      for (int j = rank - 2; j >= 0; j--) {
+        int64_t n = dims[axis[j]];
+        offset += idx % n * in_stride[axis[j]];
+        idx /= n;
+      }
+      memcpy(dout + i * inner, din + offset, inner * sizeof(T));
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
+
+  // The input axis `a` becomes the innermost one and the innermost input axis
+  // lands on the output axis `k`: a 2-D transpose of rows x cols for every
+  // index of the other axes, split in kTile x kTile tiles.
+  int a = axis[rank - 1];
+  int k = std::find(axis.begin(), axis.end(), rank - 1) - axis.begin();
+  int64_t rows = dims[a];
+  int64_t cols = dims[rank - 1];
+  int64_t lds = in_stride[a];
+  int64_t ldd = out_stride[k];
+  int row_tiles = static_cast<int>((rows + kTile - 1) / kTile);
+  int col_tiles = static_cast<int>((cols + kTile - 1) / kTile);
+  int tiles = row_tiles * col_tiles;
+  int outer = static_cast<int>(count / (rows * cols));
+  LITE_PARALLEL_BEGIN(i, tid, outer * tiles) {
+    int64_t idx = i / tiles;
+    int64_t r0 = static_cast<int64_t>(i % tiles / col_tiles) * kTile;
+    int64_t c0 = static_cast<int64_t>(i % col_tiles) * kTile;
+    int64_t src = r0 * lds + c0;
+    int64_t dst = c0 * ldd + r0;
+    for (int j = rank - 2; j >= 0; j--) {
+      if (j == k) continue;
+      int64_t n = dims[axis[j]];
+      src += idx % n * in_stride[axis[j]];
+      dst += idx % n * out_stride[j];
+      idx /= n;
+    }
+    transpose_tile(din + src,
+                   lds,
+                   dout + dst,
+                   ldd,
+                   static_cast<int>((std::min)(rows - r0, int64_t(kTile))),
+                   static_cast<int>((std::min)(cols - c0, int64_t(kTile))));
+  }
+  LITE_PARALLEL_END();
+}
+
+template <typename T>
+void transpose(const T* din,
+               T* dout,
+               const std::vector<int64_t>& dims,
+               const std::vector<int>& axis) {
+  CHECK_EQ(dims.size(), axis.size());
+  // only the element size matters to the copy
+  switch (sizeof(T)) {
+    case 1:
+      transpose_impl(reinterpret_cast<const uint8_t*>(din),
+                     reinterpret_cast<uint8_t*>(dout),
+                     dims,
+                     axis);
+      break;
+    case 2:
+      transpose_impl(reinterpret_cast<const uint16_t*>(din),
+                     reinterpret_cast<uint16_t*>(dout),
+                     dims,
+                     axis);
+      break;
+    case 4:
+      transpose_impl(reinterpret_cast<const uint32_t*>(din),
+                     reinterpret_cast<uint32_t*>(dout),
+                     dims,
+                     axis);
+      break;
+    case 8:
+      transpose_impl(reinterpret_cast<const uint64_t*>(din),
+                     reinterpret_cast<uint64_t*>(dout),
+                     dims,
+                     axis);
+      break;
+    default:
+      LOG(FATAL) << "transpose doesn't support the element size "
+                 << sizeof(T);
+  }
+}
+
+template void transpose<float>(const float* din,
+                               float* dout,
+                               const std::vector<int64_t>& dims,
+                               const std::vector<int>& axis);
+template void transpose<double>(const double* din,
+                                double* dout,
+                                const std::vector<int64_t>& dims,
+                                const std::vector<int>& axis);
+template void transpose<int8_t>(const int8_t* din,
+                                int8_t* dout,
+                                const std::vector<int64_t>& dims,
+                                const std::vector<int>& axis);
+template void transpose<uint8_t>(const uint8_t* din,
+                                 uint8_t* dout,
+                                 const std::vector<int64_t>& dims,
+                                 const std::vector<int>& axis);
+template void transpose<int16_t>(const int16_t* din,
+                                 int16_t* dout,
+                                 const std::vector<int64_t>& dims,
+                                 const std::vector<int>& axis);
+template void transpose<int32_t>(const int32_t* din,
+                                 int32_t* dout,
+                                 const std::vector<int64_t>& dims,
+                                 const std::vector<int>& axis);
+template void transpose<int64_t>(const int64_t* din,
+                                 int64_t* dout,
+                                 const std::vector<int64_t>& dims,
+                                 const std::vector<int>& axis);
+template void transpose<bool>(const bool* din,
+                              bool* dout,
+                              const std::vector<int64_t>& dims,
+                              const std::vector<int>& axis);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
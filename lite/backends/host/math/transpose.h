@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <stdint.h>
 #include <vector>
 #include "lite/core/tensor.h"
 
@@ -21,38 +22,29 @@ namespace lite {
 namespace host {
 namespace math {
 
+/*
+ * N-D transpose, output axis i is input axis axis[i].
+ *
+ * The unit axes are dropped and the axes which stay adjacent are merged, so
+ * e.g. [B, S, H, D] -> [B, H, S, D] runs as a [B, S, H] -> [B, H, S] copy of
+ * D-long rows. When the innermost axis moves, the two innermost axes are
+ * transposed in cache tiles with SIMD micro-kernels. The work is split over
+ * the outer axes and the tiles.
+ */
 template <typename T>
-void Transpose(const Tensor &input,
-               Tensor *output,
-               const std::vector<int> &orders) {
-  auto in_dims = input.dims();
-  auto out_dims = output->dims();
-  int num_axes = in_dims.size();
-  int count = in_dims.production();
+void transpose(const T* din,
+               T* dout,
+               const std::vector<int64_t>& dims,
+               const std::vector<int>& axis);
 
-  const T *din = input.data<T>();
-  T *dout = output->mutable_data<T>();
-  std::vector<int> old_steps(
-      {static_cast<int>(in_dims[1] * in_dims[2] * in_dims[3]),
-       static_cast<int>(in_dims[2] * in_dims[3]),
-       static_cast<int>(in_dims[3]),
-       1});
-  std::vector<int> new_steps(
-      {static_cast<int>(out_dims[1] * out_dims[2] * out_dims[3]),
-       static_cast<int>(out_dims[2] * out_dims[3]),
-       static_cast<int>(out_dims[3]),
-       1});
-
-  for (int i = 0; i < count; ++i) {
-    int old_idx = 0;
-    int idx = i;
-    for (int j = 0; j < num_axes; ++j) {
-      int order = orders[j];
-      old_idx += (idx / new_steps[j]) * old_steps[order];
-      idx %= new_steps[j];
-    }
-    dout[i] = din[old_idx];
-  }
+template <typename T>
+void Transpose(const Tensor& input,
+               Tensor* output,
+               const std::vector<int>& orders) {
+  transpose<T>(input.data<T>(),
+               output->mutable_data<T>(),
+               input.dims().Vectorize(),
+               orders);
 }
 
 }  // namespace math
@@ -14,6 +14,7 @@ limitations under the License. */
 
 #include "lite/backends/x86/math/avx/conv_utils.h"
 #include <algorithm>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -1148,8 +1149,7 @@ void im2col_s1<float>(const float* data_im,
   size_t tmp_size = static_cast<size_t>(output_plane_size);
   size_t mem_size = tmp_size * channels * sizeof(float);
   memset(data_col, 0, mem_size);
-#pragma omp parallel for
-  for (int c = 0; c < channels; c++) {
+  LITE_PARALLEL_BEGIN(c, tid, channels) {
     unsigned int data_im_z = static_cast<unsigned int>(c * in_channel_size);
     int data_col_z1 = c * output_plane_size;
     for (int ky = 0, h_offset = 0; ky < kernel_h;
@@ -1192,6 +1192,7 @@ void im2col_s1<float>(const float* data_im,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -1220,8 +1221,7 @@ void im2col_s2<float>(const float* data_im,
   size_t tmp_size = static_cast<size_t>(output_plane_size);
   size_t mem_size = tmp_size * channels * sizeof(float);
   memset(data_col, 0, mem_size);
-#pragma omp parallel for
-  for (int c = 0; c < channels; c++) {
+  LITE_PARALLEL_BEGIN(c, tid, channels) {
     unsigned int data_im_z = static_cast<unsigned int>(c * in_channel_size);
     int data_col_z1 = c * output_plane_size;
     for (int ky = 0, h_offset = 0; ky < kernel_h;
@@ -1264,6 +1264,7 @@ void im2col_s2<float>(const float* data_im,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 /**
@@ -16,6 +16,7 @@
 #include <immintrin.h>
 #include <stdio.h>
 #include <cmath>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -40,8 +41,7 @@ void group_norm(const float* in,
                    1;  // equal to instance_norm if the groups value equals to c
 
 // compute saved_mean and saved_variance
-#pragma omp parallel for
-  for (int i = 0; i < nb; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, nb) {
     for (int gid = 0; gid < groups; gid++) {
       float sum_spatial = 0.f;
       float summ_spatial = 0.f;
@@ -190,6 +190,7 @@ void group_norm(const float* in,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 }  // namespace math
 }  // namespace x86
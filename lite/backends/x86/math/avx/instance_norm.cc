@@ -15,6 +15,7 @@
 #include "lite/backends/x86/math/avx/instance_norm.h"
 #include <immintrin.h>
 #include <cmath>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -36,8 +37,7 @@ void instance_norm(const float* in,
   int spatial_size = height * width;
 
 // compute saved_mean and saved_variance
-#pragma omp parallel for
-  for (int i = 0; i < nc; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, nc) {
     const float* in_p = in + i * spatial_size;
     float sum_spatial = 0.f;
     float summ_spatial = 0.f;
@@ -120,9 +120,9 @@ void instance_norm(const float* in,
     saved_mean[i] = mean;
     saved_variance[i] = std;
   }
+  LITE_PARALLEL_END();
 // compute instance_norm result: out = scale * (in - mean) / std + bias
-#pragma omp parallel for
-  for (int i = 0; i < nc; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, nc) {
     const float* in_p = in + i * spatial_size;
     float* out_p = out + i * spatial_size;
     int j = spatial_size;
@@ -165,6 +165,7 @@ void instance_norm(const float* in,
       out_p++;
     }
   }
+  LITE_PARALLEL_END();
 }
 
 }  // namespace math
@@ -29,6 +29,19 @@
 #include <cblas.h>
 #endif
 
+#ifdef LITE_WITH_X86_SGEMM
+#include "lite/backends/x86/math/packed_sgemm.h"
+#if !defined(PADDLE_WITH_MKLML) && !defined(PADDLE_USE_OPENBLAS)
+// No cblas header is available, keep the cblas enums used by Blas.
+enum CBLAS_ORDER { CblasRowMajor = 101, CblasColMajor = 102 };
+enum CBLAS_TRANSPOSE {
+  CblasNoTrans = 111,
+  CblasTrans = 112,
+  CblasConjTrans = 113
+};
+#endif
+#endif
+
 namespace paddle {
 namespace lite {
 namespace x86 {
@@ -241,6 +241,158 @@ struct CBlas<double> {
   }
 };
 
+#elif defined(LITE_WITH_X86_SGEMM)
+
+// Built-in backend: float GEMM/GEMV run on packed_sgemm, the rest are plain
+// loops since they are memory bound.
+template <>
+struct CBlas<float> {
+  static void GEMM(CBLAS_ORDER order,
+                   CBLAS_TRANSPOSE transA,
+                   CBLAS_TRANSPOSE transB,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float *A,
+                   int lda,
+                   const float *B,
+                   int ldb,
+                   float beta,
+                   float *C,
+                   int ldc) {
+    CHECK_EQ(order, CblasRowMajor) << "only row major sgemm is supported";
+    sgemm(transA != CblasNoTrans,
+          transB != CblasNoTrans,
+          M,
+          N,
+          K,
+          alpha,
+          A,
+          lda,
+          B,
+          ldb,
+          beta,
+          C,
+          ldc);
+  }
+
+  static void AXPY(
+      int n, float alpha, const float *x, int incx, float *y, int incy) {
+    for (int i = 0; i < n; ++i) {
+      y[i * incy] += alpha * x[i * incx];
+    }
+  }
+
+  static void VCOPY(int n, const float *x, int incx, float *y, int incy) {
+    for (int i = 0; i < n; ++i) {
+      y[i * incy] = x[i * incx];
+    }
+  }
+
+  static void GEMV(CBLAS_ORDER order,
+                   CBLAS_TRANSPOSE trans,
+                   int M,
+                   int N,
+                   float alpha,
+                   const float *A,
+                   int lda,
+                   const float *x,
+                   int incx,
+                   float beta,
+                   float *y,
+                   int incy) {
+    CHECK_EQ(order, CblasRowMajor) << "only row major sgemv is supported";
+    sgemv(trans != CblasNoTrans,
+          M,
+          N,
+          alpha,
+          A,
+          lda,
+          x,
+          incx,
+          beta,
+          y,
+          incy);
+  }
+};
+
+// double is only used by a few training kernels, keep a reference version.
+template <>
+struct CBlas<double> {
+  static void GEMM(CBLAS_ORDER order,
+                   CBLAS_TRANSPOSE transA,
+                   CBLAS_TRANSPOSE transB,
+                   int M,
+                   int N,
+                   int K,
+                   double alpha,
+                   const double *A,
+                   int lda,
+                   const double *B,
+                   int ldb,
+                   double beta,
+                   double *C,
+                   int ldc) {
+    CHECK_EQ(order, CblasRowMajor) << "only row major dgemm is supported";
+    bool trans_a = transA != CblasNoTrans;
+    bool trans_b = transB != CblasNoTrans;
+    for (int i = 0; i < M; ++i) {
+      for (int j = 0; j < N; ++j) {
+        double sum = 0;
+        for (int k = 0; k < K; ++k) {
+          double a = trans_a ? A[k * lda + i] : A[i * lda + k];
+          double b = trans_b ? B[j * ldb + k] : B[k * ldb + j];
+          sum += a * b;
+        }
+        double *c = C + i * ldc + j;
+        *c = beta == 0 ? alpha * sum : alpha * sum + beta * *c;
+      }
+    }
+  }
+
+  static void AXPY(
+      int n, double alpha, const double *x, int incx, double *y, int incy) {
+    for (int i = 0; i < n; ++i) {
+      y[i * incy] += alpha * x[i * incx];
+    }
+  }
+
+  static void VCOPY(int n, const double *x, int incx, double *y, int incy) {
+    for (int i = 0; i < n; ++i) {
+      y[i * incy] = x[i * incx];
+    }
+  }
+
+  static void GEMV(CBLAS_ORDER order,
+                   CBLAS_TRANSPOSE trans,
+                   int M,
+                   int N,
+                   double alpha,
+                   const double *A,
+                   int lda,
+                   const double *x,
+                   int incx,
+                   double beta,
+                   double *y,
+                   int incy) {
+    CBlas<double>::GEMM(order,
+                        trans,
+                        CblasNoTrans,
+                        trans == CblasNoTrans ? M : N,
+                        1,
+                        trans == CblasNoTrans ? N : M,
+                        alpha,
+                        A,
+                        lda,
+                        x,
+                        incx,
+                        beta,
+                        y,
+                        incy);
+  }
+};
+
 #else
 
 template <>
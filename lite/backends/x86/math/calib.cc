@@ -17,6 +17,7 @@
 #include <vector>
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #include "lite/backends/x86/math/saturate.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -38,8 +39,7 @@ void fp32_to_int8(const float* din,
   int rem_cnt = remain >> 3;
   int rem_rem = remain & 7;
   int64_t loop_size = outer_size * axis_size;
-#pragma omp parallel for
-  for (int j = 0; j < loop_size; ++j) {
+  LITE_PARALLEL_BEGIN(j, tid, loop_size) {
     float inv_scale = 1.f / scale[j % axis_size];
     __m128 vzero = _mm_set1_ps(-127.f);
     __m128 vscale = _mm_set1_ps(inv_scale);
@@ -148,6 +148,7 @@ void fp32_to_int8(const float* din,
       dout_c[i] = dout_c[i] < -127 ? -127 : dout_c[i];
     }
   }
+  LITE_PARALLEL_END();
 }
 
 void int8_to_fp32(const int8_t* in,
@@ -166,8 +167,7 @@ void int8_to_fp32(const int8_t* in,
   int rem_cnt = remain >> 2;
   int rem_rem = remain & 3;
   int64_t loop_size = axis_size * outer_size;
-#pragma omp parallel for
-  for (int64_t n = 0; n < loop_size; ++n) {
+  LITE_PARALLEL_BEGIN(n, tid, loop_size) {
     float in_scale = scale[n % axis_size];
     const int8_t* din_c = in + n * inner_size;
     float* dout_c = out + n * inner_size;
@@ -236,6 +236,47 @@ void int8_to_fp32(const int8_t* in,
       dout_c[i] = in_scale * din_c[i];
     }
   }
+  LITE_PARALLEL_END();
+}
+
+void int8_to_int8(const int8_t* in,
+                  int8_t* out,
+                  const float* scale,
+                  int axis_size,
+                  int64_t outer_size,
+                  int64_t inner_size) {
+  int64_t loop_size = axis_size * outer_size;
+  LITE_PARALLEL_BEGIN(n, tid, loop_size) {
+    float ratio = scale[n % axis_size];
+    const int8_t* din_c = in + n * inner_size;
+    int8_t* dout_c = out + n * inner_size;
+    int64_t i = 0;
+#ifdef __AVX2__
+    __m256 vscale = _mm256_set1_ps(ratio);
+    __m128i vmin = _mm_set1_epi8(-127);
+    for (; i + 16 <= inner_size; i += 16) {
+      __m128i vin = _mm_loadu_si128(reinterpret_cast<const __m128i*>(din_c));
+      // 8bits x 16 -> 32bits x 8 x 2
+      __m256i v0 = _mm256_cvtepi8_epi32(vin);
+      __m256i v1 = _mm256_cvtepi8_epi32(_mm_srli_si128(vin, 8));
+      v0 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(v0), vscale));
+      v1 = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(v1), vscale));
+      // 32bits -> 8bits with saturation, then clip to -127
+      __m256i v16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(v0, v1), 0xd8);
+      __m128i v8 = _mm_packs_epi16(_mm256_castsi256_si128(v16),
+                                   _mm256_extracti128_si256(v16, 1));
+      v8 = _mm_max_epi8(v8, vmin);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dout_c), v8);
+      din_c += 16;
+      dout_c += 16;
+    }
+#endif
+    for (; i < inner_size; ++i) {
+      int8_t v = saturate_cast<int8_t>(roundf(*din_c++ * ratio));
+      *dout_c++ = v < -127 ? -127 : v;
+    }
+  }
+  LITE_PARALLEL_END();
 }
 
 }  // namespace math
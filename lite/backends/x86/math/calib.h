@@ -37,6 +37,14 @@ void int8_to_fp32(const int8_t* in,
                   int64_t outer_size,
                   int64_t inner_size);
 
+// Requantizes int8 data, scale is in_scale / out_scale of each axis
+void int8_to_int8(const int8_t* in,
+                  int8_t* out,
+                  const float* scale,
+                  int axis_size,
+                  int64_t outer_size,
+                  int64_t inner_size);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -16,6 +16,7 @@ limitations under the License. */
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #include "lite/backends/x86/math/conv_depthwise_int8.h"
 #include "lite/backends/x86/math/saturate.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -853,8 +854,7 @@ void conv_3x3s1_dw_int8(Dtype* dout,
 // auto end = clock();
 // LOG(INFO) << "im2col duration: " << (end-start) * 1000.0 /CLOCKS_PER_SEC;
 // start = clock();
-#pragma omp parallel for
-  for (int n = 0; n < omp_num; ++n) {
+  LITE_PARALLEL_BEGIN(n, tid, omp_num) {
     int8_t* pre_din_ptr0 = pre_din + n * pre_in_size;
     Dtype* dout_batch = dout + n * size_out_channel;
     int now_c = n % chin;
@@ -958,6 +958,7 @@ void conv_3x3s1_dw_int8(Dtype* dout,
       dout_batch += wout;
     }
   }
+  LITE_PARALLEL_END();
   // end = clock();
   // LOG(INFO) << "compute duration: " << (end-start) * 1000.0 /CLOCKS_PER_SEC;
   TargetFree(TARGET(kX86), pre_din);
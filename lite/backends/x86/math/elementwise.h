@@ -13,14 +13,56 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
+// Contiguous elementwise ranges are split into blocks of this many elements
+// for the worker threads, a multiple of the widest SIMD width.
+constexpr int kElementwiseBlockSize = 16384;
+
+template <class Config>
+void elementwise_range_to_range_parallel(const typename Config::T* dinx,
+                                         const typename Config::T* diny,
+                                         typename Config::T* dout,
+                                         int num) {
+  int blocks = (num + kElementwiseBlockSize - 1) / kElementwiseBlockSize;
+  LITE_PARALLEL_BEGIN(b, tid, blocks) {
+    int offset = b * kElementwiseBlockSize;
+    int len = (std::min)(kElementwiseBlockSize, num - offset);
+    elementwise_range_to_range<Config>(
+        dinx + offset, diny + offset, dout + offset, len);
+  }
+  LITE_PARALLEL_END();
+}
+
+template <class Config>
+void elementwise_broadcast_parallel(const typename Config::T* dinx,
+                                    const typename Config::T* diny,
+                                    typename Config::T* dout,
+                                    int batch,
+                                    int channels,
+                                    int num,
+                                    bool inv) {
+  LITE_PARALLEL_BEGIN(i, tid, batch * channels) {
+    int j = i % channels;
+    int offset = i * num;
+    auto* dout_ptr = dout + offset;
+    if (inv) {
+      elementwise_one_to_range<Config>(dinx + j, diny + offset, dout_ptr, num);
+    } else {
+      elementwise_range_to_one<Config>(dinx + offset, diny + j, dout_ptr, num);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
 #define ElementWiseFunc(op)                                                    \
   template <typename T>                                                        \
   void Elementwise_##op(const T* dinx,                                         \
@@ -30,124 +72,52 @@ namespace math {
                         bool has_active,                                       \
                         std::string act_type) {                                \
     if (act_type == "tanh") {                                                  \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "relu") {                                           \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "sigmoid") {                                        \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
           dinx, diny, dout, num);                                              \
     } else {                                                                   \
-      lite::x86::math::elementwise_range_to_range<                             \
+      lite::x86::math::elementwise_range_to_range_parallel<                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
           dinx, diny, dout, num);                                              \
     }                                                                          \
   }
 
-#define ElementWiseFuncBCast(op)                                      \
-  template <typename T>                                               \
-  void Elementwise_Broadcast_##op(const T* dinx,                      \
-                                  const T* diny,                      \
-                                  T* dout,                            \
-                                  int batch,                          \
-                                  int channels,                       \
-                                  int num,                            \
-                                  bool has_active,                    \
-                                  std::string act_type,               \
-                                  bool inv) {                         \
-    if (act_type == "tanh") {                                         \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "relu") {                                  \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "sigmoid") {                               \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else {                                                          \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    }                                                                 \
+#define ElementWiseFuncBCast(op)                                               \
+  template <typename T>                                                        \
+  void Elementwise_Broadcast_##op(const T* dinx,                               \
+                                  const T* diny,                               \
+                                  T* dout,                                     \
+                                  int batch,                                   \
+                                  int channels,                                \
+                                  int num,                                     \
+                                  bool has_active,                             \
+                                  std::string act_type,                        \
+                                  bool inv) {                                  \
+    if (act_type == "tanh") {                                                  \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "relu") {                                           \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "sigmoid") {                                        \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else {                                                                   \
+      lite::x86::math::elementwise_broadcast_parallel<                         \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    }                                                                          \
   }
 
 // clang-format off
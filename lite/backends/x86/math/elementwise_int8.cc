@@ -0,0 +1,240 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/elementwise_int8.h"
+#include <math.h>
+#include <algorithm>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "lite/backends/x86/math/saturate.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// rows longer than this are split, so that a same shape add still runs in
+// parallel
+static const int64_t kRowBlock = 4096;
+
+static inline void store_int8(float v, int8_t* out) {
+  int8_t res = saturate_cast<int8_t>(roundf(v));
+  *out = res < -127 ? -127 : res;
+}
+
+static inline void store_int8(float v, float* out) { *out = v; }
+
+#ifdef __AVX2__
+// 8 values of x at a step of 1, or x[0] 8 times at a step of 0
+static inline __m256 load8(const int8_t* x, int step) {
+  if (step == 0) {
+    return _mm256_set1_ps(x[0]);
+  }
+  __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x));
+  return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v));
+}
+
+static inline void store8(__m256 v, int8_t* out) {
+  __m256i v32 = _mm256_cvtps_epi32(v);
+  __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v32),
+                                _mm256_extracti128_si256(v32, 1));
+  __m128i v8 = _mm_max_epi8(_mm_packs_epi16(v16, v16), _mm_set1_epi8(-127));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(out), v8);
+}
+
+static inline void store8(__m256 v, float* out) { _mm256_storeu_ps(out, v); }
+#endif
+
+// n outputs of one row, x and y move by x_step and y_step (0 or 1)
+template <bool kMul, typename T>
+static void elementwise_row(const int8_t* x,
+                            int x_step,
+                            const int8_t* y,
+                            int y_step,
+                            T* out,
+                            int64_t n,
+                            float x_scale,
+                            float y_scale) {
+  int64_t i = 0;
+#ifdef __AVX2__
+  __m256 vxs = _mm256_set1_ps(x_scale);
+  __m256 vys = _mm256_set1_ps(y_scale);
+  for (; i + 8 <= n; i += 8) {
+    __m256 vx = load8(x + i * x_step, x_step);
+    __m256 vy = load8(y + i * y_step, y_step);
+    __m256 v = kMul ? _mm256_mul_ps(_mm256_mul_ps(vx, vy), vxs)
+                    : _mm256_add_ps(_mm256_mul_ps(vx, vxs),
+                                    _mm256_mul_ps(vy, vys));
+    store8(v, out + i);
+  }
+#endif
+  for (; i < n; ++i) {
+    float vx = x[i * x_step];
+    float vy = y[i * y_step];
+    store_int8(kMul ? vx * vy * x_scale : vx * x_scale + vy * y_scale,
+               out + i);
+  }
+}
+
+/*
+ * Drops the dims of out which are 1 and merges the neighbouring dims that
+ * x and y broadcast alike, then gives the strides of x and y in the merged
+ * dims, 0 where they broadcast.
+ */
+static void merge_broadcast_dims(const std::vector<int64_t>& x_dims,
+                                 const std::vector<int64_t>& y_dims,
+                                 const std::vector<int64_t>& out_dims,
+                                 std::vector<int64_t>* dims,
+                                 std::vector<int64_t>* x_strides,
+                                 std::vector<int64_t>* y_strides) {
+  std::vector<bool> x_bcast;
+  std::vector<bool> y_bcast;
+  for (size_t i = 0; i < out_dims.size(); ++i) {
+    if (out_dims[i] == 1) continue;
+    bool xb = x_dims[i] == 1;
+    bool yb = y_dims[i] == 1;
+    if (!dims->empty() && x_bcast.back() == xb && y_bcast.back() == yb) {
+      dims->back() *= out_dims[i];
+    } else {
+      dims->push_back(out_dims[i]);
+      x_bcast.push_back(xb);
+      y_bcast.push_back(yb);
+    }
+  }
+  if (dims->empty()) {
+    dims->push_back(1);
+    x_bcast.push_back(false);
+    y_bcast.push_back(false);
+  }
+  int rank = dims->size();
+  x_strides->resize(rank);
+  y_strides->resize(rank);
+  int64_t x_size = 1;
+  int64_t y_size = 1;
+  for (int i = rank - 1; i >= 0; --i) {
+    (*x_strides)[i] = x_bcast[i] ? 0 : x_size;
+    (*y_strides)[i] = y_bcast[i] ? 0 : y_size;
+    x_size *= x_bcast[i] ? 1 : (*dims)[i];
+    y_size *= y_bcast[i] ? 1 : (*dims)[i];
+  }
+}
+
+template <bool kMul, typename T>
+static void elementwise_int8(const int8_t* x,
+                             const int8_t* y,
+                             T* out,
+                             const std::vector<int64_t>& x_dims,
+                             const std::vector<int64_t>& y_dims,
+                             const std::vector<int64_t>& out_dims,
+                             float x_scale,
+                             float y_scale,
+                             float out_scale) {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> x_strides;
+  std::vector<int64_t> y_strides;
+  merge_broadcast_dims(
+      x_dims, y_dims, out_dims, &dims, &x_strides, &y_strides);
+  const int rank = dims.size();
+  const int64_t len = dims[rank - 1];
+  const int x_step = x_strides[rank - 1];
+  const int y_step = y_strides[rank - 1];
+  int64_t rows = 1;
+  for (int i = 0; i < rank - 1; ++i) {
+    rows *= dims[i];
+  }
+  const int64_t blocks = (len + kRowBlock - 1) / kRowBlock;
+  // the scales of the row op, the mul one only uses the first
+  const float xs = kMul ? x_scale * y_scale / out_scale : x_scale / out_scale;
+  const float ys = y_scale / out_scale;
+  LITE_PARALLEL_BEGIN(j, tid, rows * blocks) {
+    int64_t row = j / blocks;
+    int64_t start = (j % blocks) * kRowBlock;
+    int64_t x_offset = start * x_step;
+    int64_t y_offset = start * y_step;
+    int64_t idx = row;
+    for (int i = rank - 2; i >= 0; --i) {
+      x_offset += (idx % dims[i]) * x_strides[i];
+      y_offset += (idx % dims[i]) * y_strides[i];
+      idx /= dims[i];
+    }
+    elementwise_row<kMul>(x + x_offset,
+                          x_step,
+                          y + y_offset,
+                          y_step,
+                          out + row * len + start,
+                          (std::min)(kRowBlock, len - start),
+                          xs,
+                          ys);
+  }
+  LITE_PARALLEL_END();
+}
+
+void elementwise_add_int8(const int8_t* x,
+                          const int8_t* y,
+                          int8_t* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale) {
+  elementwise_int8<false>(
+      x, y, out, x_dims, y_dims, out_dims, x_scale, y_scale, out_scale);
+}
+
+void elementwise_add_int8(const int8_t* x,
+                          const int8_t* y,
+                          float* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale) {
+  elementwise_int8<false>(
+      x, y, out, x_dims, y_dims, out_dims, x_scale, y_scale, out_scale);
+}
+
+void elementwise_mul_int8(const int8_t* x,
+                          const int8_t* y,
+                          int8_t* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale) {
+  elementwise_int8<true>(
+      x, y, out, x_dims, y_dims, out_dims, x_scale, y_scale, out_scale);
+}
+
+void elementwise_mul_int8(const int8_t* x,
+                          const int8_t* y,
+                          float* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale) {
+  elementwise_int8<true>(
+      x, y, out, x_dims, y_dims, out_dims, x_scale, y_scale, out_scale);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * Int8 elementwise add and mul with broadcast. x_dims, y_dims and out_dims
+ * have the same rank and every dim of x and y is either 1 or the one of
+ * out, as given by host::fix_x_y_dims.
+ *   add: out = (x * x_scale + y * y_scale) / out_scale
+ *   mul: out = x * y * x_scale * y_scale / out_scale
+ * An int8 out is rounded and clipped to [-127, 127], a float out takes
+ * out_scale 1.
+ */
+void elementwise_add_int8(const int8_t* x,
+                          const int8_t* y,
+                          int8_t* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale);
+
+void elementwise_add_int8(const int8_t* x,
+                          const int8_t* y,
+                          float* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale);
+
+void elementwise_mul_int8(const int8_t* x,
+                          const int8_t* y,
+                          int8_t* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale);
+
+void elementwise_mul_int8(const int8_t* x,
+                          const int8_t* y,
+                          float* out,
+                          const std::vector<int64_t>& x_dims,
+                          const std::vector<int64_t>& y_dims,
+                          const std::vector<int64_t>& out_dims,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -15,6 +15,7 @@ limitations under the License. */
 #include "lite/backends/x86/math/fill_bias_activate.h"
 #include <string.h>
 #include <algorithm>
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/op_registry.h"
 
 #ifdef __AVX__
@@ -474,12 +475,12 @@ static void activate_none_inplace_bias(float *data,
   }
 }
 
-void fill_bias_act(float *tensor,
-                   const float *bias,
-                   int channel,
-                   int channel_size,
-                   bool flag_bias,
-                   const operators::ActivationParam *act_param) {
+static void fill_bias_act_block(float *tensor,
+                                const float *bias,
+                                int channel,
+                                int channel_size,
+                                bool flag_bias,
+                                const operators::ActivationParam *act_param) {
   auto act_type = act_param->active_type;
   float local_alpha = 0.f;
   int len = channel * channel_size;
@@ -534,6 +535,25 @@ void fill_bias_act(float *tensor,
   }
 }
 
+void fill_bias_act(float *tensor,
+                   const float *bias,
+                   int channel,
+                   int channel_size,
+                   bool flag_bias,
+                   const operators::ActivationParam *act_param) {
+  bool has_bias = flag_bias && (bias != nullptr);
+  // channels are independent, split them across threads
+  lite::x86::RunParallelFor(
+      0, channel, [&](const int64_t begin, const int64_t end) {
+        fill_bias_act_block(tensor + begin * channel_size,
+                            has_bias ? bias + begin : nullptr,
+                            static_cast<int>(end - begin),
+                            channel_size,
+                            flag_bias,
+                            act_param);
+      });
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
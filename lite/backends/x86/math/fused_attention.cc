@@ -0,0 +1,314 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/fused_attention.h"
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#ifdef __AVX__
+#include <immintrin.h>
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
+#endif
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// 32 queries against 64 keys: with a head_dim of 64 the k tile, the v tile,
+// the scores and the accumulators take 48KB and stay in L2.
+static const int kBlockQ = 32;
+static const int kBlockK = 64;
+
+// s[r][0:n] += sum_d q[r][d] * kt[d][0:n] for R rows of q, q has a row
+// stride of head_dim, kt and s of kBlockK. Two rows share the loads of kt and
+// keep 8 accumulators to hide the fma latency.
+template <int R>
+static void dot_tile(
+    const float* q, const float* kt, float* s, int n, int head_dim) {
+  int j = 0;
+#ifdef __AVX__
+  for (; j + 32 <= n; j += 32) {
+    __m256 acc[R][4];
+    for (int r = 0; r < R; r++) {
+      for (int u = 0; u < 4; u++) {
+        acc[r][u] = _mm256_loadu_ps(s + r * kBlockK + j + u * 8);
+      }
+    }
+    const float* kd = kt + j;
+    for (int d = 0; d < head_dim; d++) {
+      __m256 k0 = _mm256_loadu_ps(kd);
+      __m256 k1 = _mm256_loadu_ps(kd + 8);
+      __m256 k2 = _mm256_loadu_ps(kd + 16);
+      __m256 k3 = _mm256_loadu_ps(kd + 24);
+      for (int r = 0; r < R; r++) {
+        __m256 vq = _mm256_set1_ps(q[r * head_dim + d]);
+        acc[r][0] = _mm256_fmadd_ps(vq, k0, acc[r][0]);
+        acc[r][1] = _mm256_fmadd_ps(vq, k1, acc[r][1]);
+        acc[r][2] = _mm256_fmadd_ps(vq, k2, acc[r][2]);
+        acc[r][3] = _mm256_fmadd_ps(vq, k3, acc[r][3]);
+      }
+      kd += kBlockK;
+    }
+    for (int r = 0; r < R; r++) {
+      for (int u = 0; u < 4; u++) {
+        _mm256_storeu_ps(s + r * kBlockK + j + u * 8, acc[r][u]);
+      }
+    }
+  }
+#endif
+  for (int r = 0; r < R; r++) {
+    for (int d = 0; d < head_dim; d++) {
+      float vq = q[r * head_dim + d];
+      const float* kd = kt + d * kBlockK;
+      float* sr = s + r * kBlockK;
+      for (int jj = j; jj < n; jj++) {
+        sr[jj] += vq * kd[jj];
+      }
+    }
+  }
+}
+
+// x[0:n] = exp(x[0:n] - max), returns the sum
+static float exp_sum(float* x, float max, int n) {
+  int i = 0;
+  float sum = 0.f;
+#ifdef __AVX__
+  __m256 vmax = _mm256_set1_ps(max);
+  __m256 vsum = _mm256_setzero_ps();
+  for (; i + 8 <= n; i += 8) {
+    __m256 e = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), vmax));
+    _mm256_storeu_ps(x + i, e);
+    vsum = _mm256_add_ps(vsum, e);
+  }
+  float buf[8];
+  _mm256_storeu_ps(buf, vsum);
+  for (int k = 0; k < 8; k++) {
+    sum += buf[k];
+  }
+#endif
+  for (; i < n; i++) {
+    x[i] = std::exp(x[i] - max);
+    sum += x[i];
+  }
+  return sum;
+}
+
+// o[r][0:head_dim] = o[r] * correction[r] + sum_j p[r][j] * v[j][0:head_dim]
+// for R rows, p has a row stride of kBlockK and o of head_dim
+template <int R>
+static void accumulate_pv(const float* p,
+                          const float* v,
+                          int ld,
+                          int n,
+                          const float* correction,
+                          float* o,
+                          int head_dim) {
+  int d = 0;
+#ifdef __AVX__
+  for (; d + 32 <= head_dim; d += 32) {
+    __m256 acc[R][4];
+    for (int r = 0; r < R; r++) {
+      __m256 vc = _mm256_set1_ps(correction[r]);
+      for (int u = 0; u < 4; u++) {
+        acc[r][u] =
+            _mm256_mul_ps(_mm256_loadu_ps(o + r * head_dim + d + u * 8), vc);
+      }
+    }
+    const float* vj = v + d;
+    for (int j = 0; j < n; j++) {
+      __m256 v0 = _mm256_loadu_ps(vj);
+      __m256 v1 = _mm256_loadu_ps(vj + 8);
+      __m256 v2 = _mm256_loadu_ps(vj + 16);
+      __m256 v3 = _mm256_loadu_ps(vj + 24);
+      for (int r = 0; r < R; r++) {
+        __m256 vp = _mm256_set1_ps(p[r * kBlockK + j]);
+        acc[r][0] = _mm256_fmadd_ps(vp, v0, acc[r][0]);
+        acc[r][1] = _mm256_fmadd_ps(vp, v1, acc[r][1]);
+        acc[r][2] = _mm256_fmadd_ps(vp, v2, acc[r][2]);
+        acc[r][3] = _mm256_fmadd_ps(vp, v3, acc[r][3]);
+      }
+      vj += ld;
+    }
+    for (int r = 0; r < R; r++) {
+      for (int u = 0; u < 4; u++) {
+        _mm256_storeu_ps(o + r * head_dim + d + u * 8, acc[r][u]);
+      }
+    }
+  }
+#endif
+  for (int r = 0; r < R; r++) {
+    float* orow = o + r * head_dim;
+    const float* prow = p + r * kBlockK;
+    for (int dd = d; dd < head_dim; dd++) {
+      orow[dd] *= correction[r];
+    }
+    for (int j = 0; j < n; j++) {
+      const float* vj = v + j * ld;
+      for (int dd = d; dd < head_dim; dd++) {
+        orow[dd] += prow[j] * vj[dd];
+      }
+    }
+  }
+}
+
+/*
+ * The attention of `rows` queries of one head. Each key tile is transposed
+ * once, then the scores of the tile are computed for all the queries, folded
+ * into the running max and sum of each row, and the accumulators are
+ * rescaled by exp(old_max - new_max) while the tile of v is added.
+ */
+static void attention_block(const float* q,
+                            const float* k,
+                            const float* v,
+                            int ld,
+                            const float* mask,
+                            int64_t mask_stride,
+                            float* out,
+                            int rows,
+                            int seq_len,
+                            int head_dim,
+                            float scale) {
+  const float lowest = -std::numeric_limits<float>::infinity();
+  std::vector<float> buffer(head_dim * kBlockK + rows * kBlockK +
+                            2 * rows * head_dim + 3 * rows);
+  float* qs = buffer.data();
+  float* kt = qs + rows * head_dim;
+  float* scores = kt + head_dim * kBlockK;
+  float* acc = scores + rows * kBlockK;
+  float* row_max = acc + rows * head_dim;
+  float* row_sum = row_max + rows;
+  float* correction = row_sum + rows;
+  memset(acc, 0, rows * head_dim * sizeof(float));
+  for (int i = 0; i < rows; i++) {
+    row_max[i] = lowest;
+    row_sum[i] = 0.f;
+    // the scale is folded into the packed queries once for all the tiles
+    for (int d = 0; d < head_dim; d++) {
+      qs[i * head_dim + d] = q[i * ld + d] * scale;
+    }
+  }
+
+  for (int j0 = 0; j0 < seq_len; j0 += kBlockK) {
+    int n = (std::min)(kBlockK, seq_len - j0);
+    for (int j = 0; j < n; j++) {
+      const float* kj = k + (j0 + j) * ld;
+      for (int d = 0; d < head_dim; d++) {
+        kt[d * kBlockK + j] = kj[d];
+      }
+    }
+    for (int i = 0; i < rows; i++) {
+      float* s = scores + i * kBlockK;
+      if (mask) {
+        memcpy(s, mask + i * mask_stride + j0, n * sizeof(float));
+      } else {
+        memset(s, 0, n * sizeof(float));
+      }
+    }
+    int i = 0;
+    for (; i + 2 <= rows; i += 2) {
+      dot_tile<2>(qs + i * head_dim, kt, scores + i * kBlockK, n, head_dim);
+    }
+    if (i < rows) {
+      dot_tile<1>(qs + i * head_dim, kt, scores + i * kBlockK, n, head_dim);
+    }
+    for (i = 0; i < rows; i++) {
+      float* s = scores + i * kBlockK;
+      float new_max = *std::max_element(s, s + n);
+      new_max = (std::max)(new_max, row_max[i]);
+      if (new_max == lowest) {
+        // every key so far is masked out with -inf
+        memset(s, 0, n * sizeof(float));
+        correction[i] = 1.f;
+        continue;
+      }
+      correction[i] = std::exp(row_max[i] - new_max);
+      row_sum[i] = row_sum[i] * correction[i] + exp_sum(s, new_max, n);
+      row_max[i] = new_max;
+    }
+    const float* vt = v + j0 * ld;
+    for (i = 0; i + 2 <= rows; i += 2) {
+      accumulate_pv<2>(scores + i * kBlockK,
+                       vt,
+                       ld,
+                       n,
+                       correction + i,
+                       acc + i * head_dim,
+                       head_dim);
+    }
+    if (i < rows) {
+      accumulate_pv<1>(scores + i * kBlockK,
+                       vt,
+                       ld,
+                       n,
+                       correction + i,
+                       acc + i * head_dim,
+                       head_dim);
+    }
+  }
+
+  for (int i = 0; i < rows; i++) {
+    float inv = row_sum[i] > 0.f ? 1.f / row_sum[i] : 0.f;
+    const float* a = acc + i * head_dim;
+    float* o = out + i * head_dim;
+    for (int d = 0; d < head_dim; d++) {
+      o[d] = a[d] * inv;
+    }
+  }
+}
+
+void fused_attention(const float* qkv,
+                     const float* mask,
+                     const int64_t* mask_strides,
+                     float* out,
+                     int batch,
+                     int seq_len,
+                     int head_num,
+                     int head_dim,
+                     float scale) {
+  const int hidden = head_num * head_dim;
+  const int ld = 3 * hidden;
+  const int blocks = (seq_len + kBlockQ - 1) / kBlockQ;
+  LITE_PARALLEL_BEGIN(idx, tid, batch * head_num * blocks) {
+    int b = idx / (head_num * blocks);
+    int h = idx / blocks % head_num;
+    int i0 = idx % blocks * kBlockQ;
+    int rows = (std::min)(kBlockQ, seq_len - i0);
+    const float* base = qkv + b * seq_len * ld + h * head_dim;
+    const float* mask_rows =
+        mask ? mask + b * mask_strides[0] + h * mask_strides[1] +
+                   i0 * mask_strides[2]
+             : nullptr;
+    attention_block(base + i0 * ld,
+                    base + hidden,
+                    base + 2 * hidden,
+                    ld,
+                    mask_rows,
+                    mask ? mask_strides[2] : 0,
+                    out + ((b * head_num + h) * seq_len + i0) * head_dim,
+                    rows,
+                    seq_len,
+                    head_dim,
+                    scale);
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
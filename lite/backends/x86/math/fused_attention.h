@@ -0,0 +1,49 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * Multi-head attention, out = softmax(q * k^T * scale + mask) * v.
+ *
+ * qkv is the output of the fused q/k/v fc, [batch, seq_len, 3, head_num,
+ * head_dim], and out is [batch, head_num, seq_len, head_dim].
+ * The mask element (b, h, i, j) is at
+ *   mask[b * mask_strides[0] + h * mask_strides[1] + i * mask_strides[2] + j]
+ * so a stride of 0 broadcasts it, and a null mask adds nothing.
+ *
+ * The keys are visited in tiles with an online softmax, the seq_len x seq_len
+ * scores are never stored.
+ */
+void fused_attention(const float* qkv,
+                     const float* mask,
+                     const int64_t* mask_strides,
+                     float* out,
+                     int batch,
+                     int seq_len,
+                     int head_num,
+                     int head_dim,
+                     float scale);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -15,7 +15,11 @@ limitations under the License. */
 #ifdef __AVX2__
 
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
+#include <immintrin.h>
 #include <cmath>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -142,6 +146,136 @@ void generate_gemm_s8u8_x86_kern<float>::calc_block(
   *blk_n = block_n;
 }
 
+int64_t gemm_s8u8_packed_b_size(int N, int K) {
+  return static_cast<int64_t>(N) * ((K + 3) / 4 * 4);
+}
+
+void gemm_s8u8_prepack_b(
+    bool is_trans, int N, int K, const int8_t *B, uint8_t *packed_B) {
+  gemm_s8u8s8_runpackB(N, K, is_trans ? K : N, B, packed_B, is_trans);
+}
+
+// The rows of A use 7 bits: maddubs adds two products of the uint8 B (up to
+// 255) and the int8 A into an int16, which overflows with |A| up to 127.
+static const float kDynamicQuantRange = 63.f;
+// The columns of C one task of gemm_s8u8_dynamic computes at most.
+static const int kDynamicBlockN = 512;
+
+// q[0:K] = round(a[0:K] / scale), returns scale = max|a| / 63
+static float quantize_row(const float *a, int K, int8_t *q) {
+  int k = 0;
+  float amax = 0.f;
+  __m256 vabs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 vmax = _mm256_setzero_ps();
+  for (; k + 8 <= K; k += 8) {
+    vmax = _mm256_max_ps(vmax, _mm256_and_ps(_mm256_loadu_ps(a + k), vabs));
+  }
+  __m128 vmax4 =
+      _mm_max_ps(_mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1));
+  vmax4 = _mm_max_ps(vmax4, _mm_movehl_ps(vmax4, vmax4));
+  vmax4 = _mm_max_ss(vmax4, _mm_shuffle_ps(vmax4, vmax4, 1));
+  amax = _mm_cvtss_f32(vmax4);
+  for (; k < K; k++) {
+    amax = (std::max)(amax, std::fabs(a[k]));
+  }
+  float inv = amax > 0.f ? kDynamicQuantRange / amax : 0.f;
+
+  __m256 vinv = _mm256_set1_ps(inv);
+  for (k = 0; k + 8 <= K; k += 8) {
+    __m256i v = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(a + k), vinv));
+    __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v),
+                                  _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(q + k),
+                     _mm_packs_epi16(v16, v16));
+  }
+  for (; k < K; k++) {
+    q[k] = static_cast<int8_t>(std::nearbyint(a[k] * inv));
+  }
+  return amax / kDynamicQuantRange;
+}
+
+// c[0:n] = c[0:n] * scale[0:n] + bias[0:n], then relu
+static void scale_bias_row(
+    float *c, int n, const float *scale, const float *bias, bool relu) {
+  int j = 0;
+  __m256 vzero = _mm256_setzero_ps();
+  for (; j + 8 <= n; j += 8) {
+    __m256 v =
+        _mm256_mul_ps(_mm256_loadu_ps(c + j), _mm256_loadu_ps(scale + j));
+    if (bias) {
+      v = _mm256_add_ps(v, _mm256_loadu_ps(bias + j));
+    }
+    if (relu) {
+      v = _mm256_max_ps(v, vzero);
+    }
+    _mm256_storeu_ps(c + j, v);
+  }
+  for (; j < n; j++) {
+    float v = c[j] * scale[j] + (bias ? bias[j] : 0.f);
+    c[j] = relu && v < 0.f ? 0.f : v;
+  }
+}
+
+void gemm_s8u8_dynamic(int M,
+                       int N,
+                       int K,
+                       const float *A,
+                       const uint8_t *packed_B,
+                       const float *scale_b,
+                       const float *bias,
+                       float *C,
+                       bool relu) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  const int k_align4 = (K + 3) / 4 * 4;
+  std::vector<int8_t> a_int8(static_cast<int64_t>(M) * K);
+  std::vector<float> scale_a(M);
+  LITE_PARALLEL_BEGIN(i, tid, M) {
+    scale_a[i] = quantize_row(A + static_cast<int64_t>(i) * K,
+                              K,
+                              a_int8.data() + static_cast<int64_t>(i) * K);
+  }
+  LITE_PARALLEL_END();
+
+  // Column blocks start on a panel of 32, where a slice of the packed B
+  // equals B of these columns packed on its own.
+  const int threads = static_cast<int>(lite::x86::GetMaxThreads());
+  int nblock = (std::min)(kDynamicBlockN, (N + 31) / 32 * 32);
+  if (threads > 1) {
+    nblock = (std::min)(nblock, ((N + threads - 1) / threads + 31) / 32 * 32);
+  }
+  const int n_tiles = (N + nblock - 1) / nblock;
+  LITE_PARALLEL_BEGIN(tile, tid, n_tiles) {
+    const int j0 = tile * nblock;
+    const int cols = (std::min)(nblock, N - j0);
+    // no bias and Sb = 1: C = scale_a[i] * (A_int8 * B)
+    generate_gemm_s8u8_x86_kern<float> gemm(false,
+                                            false,
+                                            M,
+                                            cols,
+                                            K,
+                                            a_int8.data(),
+                                            N,
+                                            scale_a.data(),
+                                            1.f,
+                                            1.f,
+                                            nullptr,
+                                            0,
+                                            1.f);
+    gemm.compute_packed_b(packed_B + static_cast<int64_t>(j0) * k_align4,
+                          C + j0);
+    for (int i = 0; i < M; i++) {
+      scale_bias_row(C + static_cast<int64_t>(i) * N + j0,
+                     cols,
+                     scale_b + j0,
+                     bias ? bias + j0 : nullptr,
+                     relu);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
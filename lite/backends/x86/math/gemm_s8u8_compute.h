@@ -105,6 +105,38 @@ class generate_gemm_s8u8_x86_kern {
     }
   }
 
+  // Same as compute(), B is not transposed and packed once for all the calls
+  // by gemm_s8u8_prepack_b. The panels of B are laid out one after another,
+  // so a block of columns starts at loop_n * _k_align4.
+  void compute_packed_b(const uint8_t *packed_B, TYPE_C *C) {
+    if (_relu_type < 0 || _relu_type > 3) {
+      LOG(FATAL) << "relu_type: 1 for relu, 2 for relu6, 3 for leakyrelu, but "
+                    "receive is "
+                 << _relu_type;
+    }
+
+    int block_m, block_n;
+    calc_block(_M, _N, _K, &block_m, &block_n);
+    for (int loop_n = 0; loop_n < _N; loop_n += block_n) {
+      int min_n = ((_N - loop_n) >= block_n) ? block_n : (_N - loop_n);
+      uint8_t *cur_b = const_cast<uint8_t *>(packed_B) + loop_n * _k_align4;
+      for (int loop_m = 0; loop_m < _M; loop_m += block_m) {
+        int min_m = ((_M - loop_m) >= block_m) ? block_m : (_M - loop_m);
+        gemm_kernel_loop_int8(min_m,
+                              min_n,
+                              _K,
+                              _pack_A + loop_m * _k_align4,
+                              cur_b,
+                              C + loop_m * _ldc + loop_n,
+                              _ldc,
+                              _scale + loop_m,
+                              _re_bias + loop_m,
+                              _relu_type,
+                              _relu_alpha);
+      }
+    }
+  }
+
  private:
   // inner param
   int _k_align4;
@@ -213,6 +245,33 @@ class generate_gemm_s8u8_x86_kern {
 
 #undef PARAM_INIT
 
+// The size in bytes of B[K, N] packed by gemm_s8u8_prepack_b.
+int64_t gemm_s8u8_packed_b_size(int N, int K);
+
+// Packs the int8 B[K, N] (B[N, K] if is_trans) to the uint8 panels of the
+// s8u8 gemm, once for generate_gemm_s8u8_x86_kern::compute_packed_b.
+void gemm_s8u8_prepack_b(
+    bool is_trans, int N, int K, const int8_t *B, uint8_t *packed_B);
+
+/*
+ * C[M, N] = A[M, K] * B[K, N] * scale_b[N] + bias[N] for a fp32 A and an int8
+ * B quantized per column.
+ *
+ * Each row of A is quantized to int8 with its own abs max, so no calibration
+ * is needed. The int8 gemm dequantizes the rows, the columns are scaled and
+ * the bias (may be null) and the relu are added while C is still in cache.
+ * The work is split over the columns of B.
+ */
+void gemm_s8u8_dynamic(int M,
+                       int N,
+                       int K,
+                       const float *A,
+                       const uint8_t *packed_B,
+                       const float *scale_b,
+                       const float *bias,
+                       float *C,
+                       bool relu);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -21,6 +21,8 @@ limitations under the License. */
 #include <stdint.h>
 #include <tmmintrin.h>
 #include <algorithm>
+#include <atomic>
+#include "lite/backends/x86/cpu_info.h"
 
 namespace paddle {
 namespace lite {
@@ -350,17 +352,17 @@ void gemm_fuse_relu_bias_f32(float* data,
     *(c_ptr + i * ldc + 1) = CLIP_S8(in0_int);               \
   }
 
-void gemm_kernel_loop_int8(int M,
-                           int N,
-                           int K,
-                           int8_t* A,
-                           uint8_t* B,
-                           int8_t* C,
-                           int ldc,
-                           const float* scale,
-                           const float* bias,
-                           int relu_type,
-                           float relu_alpha) {
+static void gemm_kernel_loop_int8_avx2(int M,
+                                       int N,
+                                       int K,
+                                       int8_t* A,
+                                       uint8_t* B,
+                                       int8_t* C,
+                                       int ldc,
+                                       const float* scale,
+                                       const float* bias,
+                                       int relu_type,
+                                       float relu_alpha) {
   int8_t* a_ptr = A;
   int8_t* c_ptr = C;
   uint8_t* b_ptr = B;
@@ -665,17 +667,17 @@ void gemm_kernel_loop_int8(int M,
     *(c_ptr + i * ldc + 1) = in0_f32;                        \
   }
 
-void gemm_kernel_loop_int8(int M,
-                           int N,
-                           int K,
-                           int8_t* A,
-                           uint8_t* B,
-                           float* C,
-                           int ldc,
-                           const float* scale,
-                           const float* bias,
-                           int relu_type,
-                           float relu_alpha) {
+static void gemm_kernel_loop_int8_avx2(int M,
+                                       int N,
+                                       int K,
+                                       int8_t* A,
+                                       uint8_t* B,
+                                       float* C,
+                                       int ldc,
+                                       const float* scale,
+                                       const float* bias,
+                                       int relu_type,
+                                       float relu_alpha) {
   int8_t* a_ptr = A;
   float* c_ptr = C;
   uint8_t* b_ptr = B;
@@ -933,6 +935,174 @@ void gemm_kernel_loop_int8(int M,
 #undef STORE_4_float
 #undef STORE_2_float
 
+static inline void store_ref(float val, float* c) { *c = val; }
+
+static inline void store_ref(float val, int8_t* c) {
+  int v = val > 0 ? static_cast<int>(val + 0.5f)
+                  : static_cast<int>(val - 0.5f);
+  *c = static_cast<int8_t>(std::min(std::max(v, -127), 127));
+}
+
+// One column of the packed B and one row of the packed A, see
+// gemm_s8u8s8_runpackB and the pairs of rows of gemm_s8u8s8_prepackA.
+template <typename TYPE_C>
+static void gemm_kernel_loop_int8_ref(int M,
+                                      int N,
+                                      int K,
+                                      const int8_t* A,
+                                      const uint8_t* B,
+                                      TYPE_C* C,
+                                      int ldc,
+                                      const float* scale,
+                                      const float* bias,
+                                      int relu_type,
+                                      float relu_alpha) {
+  const int k_loop = (K + 3) >> 2;
+  const int pack_k = k_loop << 2;
+  const int pairs = M / 2;
+  for (int m = 0; m < M; m++) {
+    const int8_t* a_row = A + m * pack_k;
+    int a_step = 4;
+    if (m < pairs * 2) {
+      a_row = A + (m / 2) * 2 * pack_k + (m % 2) * 4;
+      a_step = 8;
+    }
+    const uint8_t* b_panel = B;
+    int n = 0;
+    while (n < N) {
+      int width = 32;
+      if (N - n < 32) {
+        for (int w : {24, 16, 8, 4, 2, 1}) {
+          if (w <= N - n) {
+            width = w;
+            break;
+          }
+        }
+      }
+      for (int col = 0; col < width; col++) {
+        int sum = 0;
+        for (int k = 0; k < k_loop; k++) {
+          const int8_t* a = a_row + k * a_step;
+          const uint8_t* b = b_panel + (k * width + col) * 4;
+          for (int i = 0; i < 4; i++) {
+            sum += static_cast<int>(a[i]) * static_cast<int>(b[i]);
+          }
+        }
+        float val = sum * scale[m];
+        gemm_fuse_relu_bias_f32(&val, bias[m], relu_alpha, relu_type);
+        store_ref(val, C + m * ldc + n + col);
+      }
+      b_panel += width * pack_k;
+      n += width;
+    }
+  }
+}
+
+static std::atomic<int> forced_isa(-1);
+
+gemm_s8u8_isa_t gemm_s8u8_best_isa() {
+  static const gemm_s8u8_isa_t best = []() {
+    if (gemm_s8u8_avx512_built(true) && MayIUse(avx512_core_vnni)) {
+      return gemm_s8u8_avx512_vnni;
+    }
+    if (gemm_s8u8_avx512_built(false) && MayIUse(avx512_core)) {
+      return gemm_s8u8_avx512bw;
+    }
+    return gemm_s8u8_avx2;
+  }();
+  return best;
+}
+
+gemm_s8u8_isa_t gemm_s8u8_isa() {
+  int isa = forced_isa.load(std::memory_order_relaxed);
+  return isa < 0 ? gemm_s8u8_best_isa() : static_cast<gemm_s8u8_isa_t>(isa);
+}
+
+bool gemm_s8u8_force_isa(gemm_s8u8_isa_t isa) {
+  // the kernels up to the best one run on this cpu
+  if (isa > gemm_s8u8_best_isa()) {
+    return false;
+  }
+  if (isa == gemm_s8u8_avx512_vnni && !gemm_s8u8_avx512_built(true)) {
+    return false;
+  }
+  if (isa == gemm_s8u8_avx512bw && !gemm_s8u8_avx512_built(false)) {
+    return false;
+  }
+  forced_isa.store(isa, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename TYPE_C>
+static void gemm_kernel_loop_int8_impl(int M,
+                                       int N,
+                                       int K,
+                                       int8_t* A,
+                                       uint8_t* B,
+                                       TYPE_C* C,
+                                       int ldc,
+                                       const float* scale,
+                                       const float* bias,
+                                       int relu_type,
+                                       float relu_alpha) {
+  gemm_s8u8_isa_t isa = gemm_s8u8_isa();
+  switch (isa) {
+    case gemm_s8u8_avx512_vnni:
+    case gemm_s8u8_avx512bw:
+      gemm_kernel_loop_int8_avx512(M,
+                                   N,
+                                   K,
+                                   A,
+                                   B,
+                                   C,
+                                   ldc,
+                                   scale,
+                                   bias,
+                                   relu_type,
+                                   relu_alpha,
+                                   isa == gemm_s8u8_avx512_vnni);
+      break;
+    case gemm_s8u8_ref:
+      gemm_kernel_loop_int8_ref(
+          M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+      break;
+    default:
+      gemm_kernel_loop_int8_avx2(
+          M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+      break;
+  }
+}
+
+void gemm_kernel_loop_int8(int M,
+                           int N,
+                           int K,
+                           int8_t* A,
+                           uint8_t* B,
+                           int8_t* C,
+                           int ldc,
+                           const float* scale,
+                           const float* bias,
+                           int relu_type,
+                           float relu_alpha) {
+  gemm_kernel_loop_int8_impl(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+}
+
+void gemm_kernel_loop_int8(int M,
+                           int N,
+                           int K,
+                           int8_t* A,
+                           uint8_t* B,
+                           float* C,
+                           int ldc,
+                           const float* scale,
+                           const float* bias,
+                           int relu_type,
+                           float relu_alpha) {
+  gemm_kernel_loop_int8_impl(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
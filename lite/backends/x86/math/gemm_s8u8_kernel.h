@@ -21,6 +21,55 @@ namespace lite {
 namespace x86 {
 namespace math {
 
+// The micro-kernels behind gemm_kernel_loop_int8, picked at runtime.
+typedef enum {
+  gemm_s8u8_ref,          // scalar, exact int32 sums like vpdpbusd
+  gemm_s8u8_avx2,         // vpmaddubsw, the pairs of products saturate to int16
+  gemm_s8u8_avx512bw,     // vpmaddubsw on zmm, same results as avx2
+  gemm_s8u8_avx512_vnni,  // vpdpbusd
+} gemm_s8u8_isa_t;
+
+// The best micro-kernels both the cpu and the build support.
+gemm_s8u8_isa_t gemm_s8u8_best_isa();
+
+// The micro-kernels in use, the best ones unless forced.
+gemm_s8u8_isa_t gemm_s8u8_isa();
+
+// Forces the micro-kernels, e.g. to test each path against gemm_s8u8_ref.
+// Returns false and keeps the current ones if the cpu or the build does not
+// support them.
+bool gemm_s8u8_force_isa(gemm_s8u8_isa_t isa);
+
+// Whether gemm_s8u8_kernel_avx512.cc was built with AVX-512BW, and VNNI.
+bool gemm_s8u8_avx512_built(bool vnni);
+
+// The AVX-512 micro-kernels, the same packed A and B as the AVX2 ones.
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  int8_t* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni);
+
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  float* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni);
+
 void gemm_kernel_loop_int8(int M,
                            int N,
                            int K,
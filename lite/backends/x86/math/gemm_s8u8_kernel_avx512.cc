@@ -0,0 +1,384 @@
+/* Copyright (c) 2023 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+// Built with the AVX-512 flags of its own (see lite/backends/x86/CMakeLists),
+// only run when the cpu has them. Only the kernel header is included, so no
+// inline function of another header is emitted with AVX-512 instructions
+// and picked by the linker for the code which runs everywhere.
+
+#include "lite/backends/x86/math/gemm_s8u8_kernel.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+#include <immintrin.h>
+#define LITE_GEMM_S8U8_AVX512
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#ifdef LITE_GEMM_S8U8_AVX512
+
+bool gemm_s8u8_avx512_built(bool vnni) {
+#ifdef __AVX512VNNI__
+  return true;
+#else
+  return !vnni;
+#endif
+}
+
+// acc += sum of 4 products of the uint8 b and the int8 a in each int32 lane
+template <bool kVnni>
+static inline __m512i dot_u8s8(__m512i acc, __m512i b, __m512i a) {
+#ifdef __AVX512VNNI__
+  if (kVnni) {
+    return _mm512_dpbusd_epi32(acc, b, a);
+  }
+#endif
+  __m512i sum16 = _mm512_maddubs_epi16(b, a);
+  return _mm512_add_epi32(acc,
+                          _mm512_madd_epi16(sum16, _mm512_set1_epi16(1)));
+}
+
+static inline __m512 scale_bias_act(__m512i acc,
+                                    float scale,
+                                    float bias,
+                                    int relu_type,
+                                    float relu_alpha) {
+  __m512 v = _mm512_mul_ps(_mm512_cvtepi32_ps(acc), _mm512_set1_ps(scale));
+  v = _mm512_add_ps(v, _mm512_set1_ps(bias));
+  __m512 zero = _mm512_setzero_ps();
+  switch (relu_type) {
+    case 1:
+      v = _mm512_max_ps(v, zero);
+      break;
+    case 2:
+      v = _mm512_min_ps(_mm512_max_ps(v, zero), _mm512_set1_ps(relu_alpha));
+      break;
+    case 3:
+      v = _mm512_mask_mul_ps(v,
+                             _mm512_cmp_ps_mask(v, zero, _CMP_LE_OS),
+                             v,
+                             _mm512_set1_ps(relu_alpha));
+      break;
+    default:
+      break;
+  }
+  return v;
+}
+
+static inline void store_row(__m512 v, float* c, __mmask16 mask) {
+  _mm512_mask_storeu_ps(c, mask, v);
+}
+
+static inline void store_row(__m512 v, int8_t* c, __mmask16 mask) {
+  __m128i v8 = _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(v));
+  v8 = _mm_max_epi8(v8, _mm_set1_epi8(-127));
+  _mm_mask_storeu_epi8(c, mask, v8);
+}
+
+/*
+ * R rows of C against one panel of B, NZ zmm of 16 columns wide with the
+ * last one masked by `mask`. The rows come in the pairs of the packed A,
+ * 8 bytes per k4 step at a stride of pair_stride, or alone with 4 bytes.
+ * B has `width` columns of 4 bytes per k4 step.
+ */
+template <int R, int NZ, bool kVnni, typename TYPE_C>
+static void gemm_tile(int k_loop,
+                      const int8_t* a,
+                      int a_step,
+                      int pair_stride,
+                      const uint8_t* b,
+                      int width,
+                      __mmask16 mask,
+                      TYPE_C* c,
+                      int ldc,
+                      const float* scale,
+                      const float* bias,
+                      int relu_type,
+                      float relu_alpha) {
+  const int8_t* rows[R];
+  for (int r = 0; r < R; r++) {
+    rows[r] = a + (r >> 1) * pair_stride + (r & 1) * 4;
+  }
+  __m512i acc[R][NZ];
+  for (int r = 0; r < R; r++) {
+    for (int z = 0; z < NZ; z++) {
+      acc[r][z] = _mm512_setzero_si512();
+    }
+  }
+  const int b_step = width * 4;
+  for (int k = 0; k < k_loop; k++) {
+    __m512i vb[NZ];
+    for (int z = 0; z < NZ; z++) {
+      __mmask16 m = z == NZ - 1 ? mask : 0xffff;
+      vb[z] = _mm512_maskz_loadu_epi32(m, b + z * 64);
+    }
+    for (int r = 0; r < R; r++) {
+      __m512i va = _mm512_set1_epi32(
+          *reinterpret_cast<const int32_t*>(rows[r] + k * a_step));
+      for (int z = 0; z < NZ; z++) {
+        acc[r][z] = dot_u8s8<kVnni>(acc[r][z], vb[z], va);
+      }
+    }
+    b += b_step;
+  }
+  for (int r = 0; r < R; r++) {
+    for (int z = 0; z < NZ; z++) {
+      __mmask16 m = z == NZ - 1 ? mask : 0xffff;
+      store_row(
+          scale_bias_act(acc[r][z], scale[r], bias[r], relu_type, relu_alpha),
+          c + r * ldc + z * 16,
+          m);
+    }
+  }
+}
+
+// R rows of C against all the panels of B: 32 columns wide, then one of
+// 24, 16, 8, 4, 2 and 1 for the rest, as packed by gemm_s8u8s8_runpackB.
+template <int R, bool kVnni, typename TYPE_C>
+static void gemm_rows(int N,
+                      int k_loop,
+                      const int8_t* a,
+                      int a_step,
+                      int pair_stride,
+                      const uint8_t* b,
+                      TYPE_C* c,
+                      int ldc,
+                      const float* scale,
+                      const float* bias,
+                      int relu_type,
+                      float relu_alpha) {
+  const int pack_k = k_loop * 4;
+  int n = 0;
+  for (; n + 32 <= N; n += 32) {
+    gemm_tile<R, 2, kVnni>(k_loop,
+                           a,
+                           a_step,
+                           pair_stride,
+                           b,
+                           32,
+                           0xffff,
+                           c + n,
+                           ldc,
+                           scale,
+                           bias,
+                           relu_type,
+                           relu_alpha);
+    b += 32 * pack_k;
+  }
+  const int tails[] = {24, 16, 8, 4, 2, 1};
+  for (int width : tails) {
+    if (n + width > N) {
+      continue;
+    }
+    if (width > 16) {
+      gemm_tile<R, 2, kVnni>(k_loop,
+                             a,
+                             a_step,
+                             pair_stride,
+                             b,
+                             width,
+                             (1 << (width - 16)) - 1,
+                             c + n,
+                             ldc,
+                             scale,
+                             bias,
+                             relu_type,
+                             relu_alpha);
+    } else {
+      gemm_tile<R, 1, kVnni>(k_loop,
+                             a,
+                             a_step,
+                             pair_stride,
+                             b,
+                             width,
+                             static_cast<__mmask16>((1 << width) - 1),
+                             c + n,
+                             ldc,
+                             scale,
+                             bias,
+                             relu_type,
+                             relu_alpha);
+    }
+    b += width * pack_k;
+    n += width;
+  }
+}
+
+// Up to 8 rows at a time: 16 accumulators, 2 panels of B and A in 19 zmm.
+template <bool kVnni, typename TYPE_C>
+static void gemm_loop(int M,
+                      int N,
+                      int K,
+                      const int8_t* A,
+                      const uint8_t* B,
+                      TYPE_C* C,
+                      int ldc,
+                      const float* scale,
+                      const float* bias,
+                      int relu_type,
+                      float relu_alpha) {
+  const int k_loop = (K + 3) >> 2;
+  const int pack_k = k_loop << 2;
+  const int pair_stride = 2 * pack_k;
+  int m = 0;
+  for (; m + 8 <= M; m += 8) {
+    gemm_rows<8, kVnni>(N,
+                        k_loop,
+                        A + m * pack_k,
+                        8,
+                        pair_stride,
+                        B,
+                        C + m * ldc,
+                        ldc,
+                        scale + m,
+                        bias + m,
+                        relu_type,
+                        relu_alpha);
+  }
+  const int pairs = (M - m) / 2;
+  const int8_t* a = A + m * pack_k;
+  TYPE_C* c = C + m * ldc;
+#define GEMM_ROWS(R)                \
+  gemm_rows<R, kVnni>(N,            \
+                      k_loop,       \
+                      a,            \
+                      8,            \
+                      pair_stride,  \
+                      B,            \
+                      c,            \
+                      ldc,          \
+                      scale + m,    \
+                      bias + m,     \
+                      relu_type,    \
+                      relu_alpha);
+  if (pairs == 3) {
+    GEMM_ROWS(6)
+  } else if (pairs == 2) {
+    GEMM_ROWS(4)
+  } else if (pairs == 1) {
+    GEMM_ROWS(2)
+  }
+#undef GEMM_ROWS
+  m += pairs * 2;
+  if (m < M) {
+    // the last odd row is packed alone
+    gemm_rows<1, kVnni>(N,
+                        k_loop,
+                        A + m * pack_k,
+                        4,
+                        pair_stride,
+                        B,
+                        C + m * ldc,
+                        ldc,
+                        scale + m,
+                        bias + m,
+                        relu_type,
+                        relu_alpha);
+  }
+}
+
+template <typename TYPE_C>
+static void gemm_loop_dispatch(int M,
+                               int N,
+                               int K,
+                               const int8_t* A,
+                               const uint8_t* B,
+                               TYPE_C* C,
+                               int ldc,
+                               const float* scale,
+                               const float* bias,
+                               int relu_type,
+                               float relu_alpha,
+                               bool vnni) {
+  if (vnni) {
+    gemm_loop<true>(
+        M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+  } else {
+    gemm_loop<false>(
+        M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+  }
+}
+
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  int8_t* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni) {
+  gemm_loop_dispatch(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha, vnni);
+}
+
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  float* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni) {
+  gemm_loop_dispatch(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha, vnni);
+}
+
+#else  // LITE_GEMM_S8U8_AVX512
+
+// The compiler has no AVX-512, gemm_s8u8_best_isa never picks these.
+bool gemm_s8u8_avx512_built(bool vnni) { return false; }
+
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  int8_t* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni) {}
+
+void gemm_kernel_loop_int8_avx512(int M,
+                                  int N,
+                                  int K,
+                                  int8_t* A,
+                                  uint8_t* B,
+                                  float* C,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha,
+                                  bool vnni) {}
+
+#endif  // LITE_GEMM_S8U8_AVX512
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -16,6 +16,7 @@ limitations under the License. */
 #include <string>
 #include <vector>
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -107,10 +108,7 @@ void bilinear_interp(const float* input_data,
   int out_stride = h_out * w_out;
   int total = n * c;
 
-#ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
-#endif
-  for (int nc = 0; nc < total; ++nc) {
+  LITE_PARALLEL_BEGIN(nc, tid, total) {
     const float* src = input_data + nc * in_stride;
     float* dst = output_data + nc * out_stride;
     const float* betap = beta;
@@ -465,6 +463,7 @@ void bilinear_interp(const float* input_data,
     lite::host::free(rowsbuf0);
     lite::host::free(rowsbuf1);
   }
+  LITE_PARALLEL_END();
   lite::host::free(buf);
 }
 
@@ -0,0 +1,563 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/packed_sgemm.h"
+#include <string.h>
+#include <algorithm>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/memory.h"
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+#if defined(__AVX__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// The AVX-512 micro kernel is compiled with a function level target when the
+// translation unit itself only targets AVX2, and picked at runtime.
+#if defined(__AVX512F__)
+#define LITE_SGEMM_WITH_AVX512
+#define LITE_SGEMM_AVX512_TARGET
+#elif defined(__AVX2__) && defined(__GNUC__) && !defined(_WIN32)
+#define LITE_SGEMM_WITH_AVX512
+#define LITE_SGEMM_AVX512_TARGET __attribute__((target("avx512f")))
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// K is split in blocks of KBLOCK so that one B micro panel (KBLOCK x NR)
+// stays in L1 while the A panels of a task stream from L2.
+constexpr int KBLOCK = 256;
+// Rows of C computed by one task, a multiple of every MR below.
+constexpr int MBLOCK = 96;
+// Upper bound of the columns of C computed by one task.
+constexpr int NBLOCK = 1024;
+constexpr int kMaxMR = 12;
+constexpr int kMaxNR = 32;
+
+typedef void (*sgemm_micro_kernel)(int kc,
+                                   const float* a,
+                                   const float* b,
+                                   float* c,
+                                   int ldc,
+                                   float alpha,
+                                   float beta);
+
+struct SgemmKernel {
+  int mr;
+  int nr;
+  // kernels[i] computes a (i + 1) x nr tile of C
+  sgemm_micro_kernel kernels[kMaxMR];
+};
+
+static inline int round_up(int x, int align) {
+  return (x + align - 1) / align * align;
+}
+
+template <int ROWS, int NR>
+inline void sgemm_store_ref(const float (&acc)[ROWS][NR],
+                            float* c,
+                            int ldc,
+                            float alpha,
+                            float beta) {
+  for (int i = 0; i < ROWS; ++i) {
+    float* c_row = c + i * ldc;
+    if (beta == 0.f) {
+      for (int j = 0; j < NR; ++j) c_row[j] = alpha * acc[i][j];
+    } else {
+      for (int j = 0; j < NR; ++j) {
+        c_row[j] = alpha * acc[i][j] + beta * c_row[j];
+      }
+    }
+  }
+}
+
+// Portable kernel, used when the library is built without AVX.
+template <int ROWS>
+void sgemm_kernel_ref(int kc,
+                      const float* a,
+                      const float* b,
+                      float* c,
+                      int ldc,
+                      float alpha,
+                      float beta) {
+  constexpr int MR = 4;
+  constexpr int NR = 8;
+  float acc[ROWS][NR];
+  for (int i = 0; i < ROWS; ++i) {
+    for (int j = 0; j < NR; ++j) acc[i][j] = 0.f;
+  }
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < ROWS; ++i) {
+      float ai = a[i];
+      for (int j = 0; j < NR; ++j) acc[i][j] += ai * b[j];
+    }
+    a += MR;
+    b += NR;
+  }
+  sgemm_store_ref<ROWS, NR>(acc, c, ldc, alpha, beta);
+}
+
+static const SgemmKernel kSgemmKernelRef = {4,
+                                            8,
+                                            {sgemm_kernel_ref<1>,
+                                             sgemm_kernel_ref<2>,
+                                             sgemm_kernel_ref<3>,
+                                             sgemm_kernel_ref<4>}};
+
+#ifdef __AVX2__
+// 6x16 tile: 12 accumulators + 2 B vectors + 1 broadcast of 16 ymm.
+template <int ROWS>
+void sgemm_kernel_avx2(int kc,
+                       const float* a,
+                       const float* b,
+                       float* c,
+                       int ldc,
+                       float alpha,
+                       float beta) {
+  constexpr int MR = 6;
+  __m256 acc0[ROWS];
+  __m256 acc1[ROWS];
+  for (int i = 0; i < ROWS; ++i) {
+    acc0[i] = _mm256_setzero_ps();
+    acc1[i] = _mm256_setzero_ps();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    for (int i = 0; i < ROWS; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc0[i] = _mm256_fmadd_ps(ai, b0, acc0[i]);
+      acc1[i] = _mm256_fmadd_ps(ai, b1, acc1[i]);
+    }
+    a += MR;
+    b += 16;
+  }
+  __m256 valpha = _mm256_set1_ps(alpha);
+  __m256 vbeta = _mm256_set1_ps(beta);
+  for (int i = 0; i < ROWS; ++i) {
+    float* c_row = c + i * ldc;
+    __m256 r0 = _mm256_mul_ps(acc0[i], valpha);
+    __m256 r1 = _mm256_mul_ps(acc1[i], valpha);
+    if (beta != 0.f) {
+      r0 = _mm256_fmadd_ps(_mm256_loadu_ps(c_row), vbeta, r0);
+      r1 = _mm256_fmadd_ps(_mm256_loadu_ps(c_row + 8), vbeta, r1);
+    }
+    _mm256_storeu_ps(c_row, r0);
+    _mm256_storeu_ps(c_row + 8, r1);
+  }
+}
+
+static const SgemmKernel kSgemmKernelAvx2 = {6,
+                                             16,
+                                             {sgemm_kernel_avx2<1>,
+                                              sgemm_kernel_avx2<2>,
+                                              sgemm_kernel_avx2<3>,
+                                              sgemm_kernel_avx2<4>,
+                                              sgemm_kernel_avx2<5>,
+                                              sgemm_kernel_avx2<6>}};
+#endif  // __AVX2__
+
+#ifdef LITE_SGEMM_WITH_AVX512
+// 12x32 tile: 24 accumulators + 2 B vectors + 1 broadcast of 32 zmm.
+template <int ROWS>
+LITE_SGEMM_AVX512_TARGET void sgemm_kernel_avx512(int kc,
+                                                  const float* a,
+                                                  const float* b,
+                                                  float* c,
+                                                  int ldc,
+                                                  float alpha,
+                                                  float beta) {
+  constexpr int MR = 12;
+  __m512 acc0[ROWS];
+  __m512 acc1[ROWS];
+  for (int i = 0; i < ROWS; ++i) {
+    acc0[i] = _mm512_setzero_ps();
+    acc1[i] = _mm512_setzero_ps();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + 16);
+    for (int i = 0; i < ROWS; ++i) {
+      __m512 ai = _mm512_set1_ps(a[i]);
+      acc0[i] = _mm512_fmadd_ps(ai, b0, acc0[i]);
+      acc1[i] = _mm512_fmadd_ps(ai, b1, acc1[i]);
+    }
+    a += MR;
+    b += 32;
+  }
+  __m512 valpha = _mm512_set1_ps(alpha);
+  __m512 vbeta = _mm512_set1_ps(beta);
+  for (int i = 0; i < ROWS; ++i) {
+    float* c_row = c + i * ldc;
+    __m512 r0 = _mm512_mul_ps(acc0[i], valpha);
+    __m512 r1 = _mm512_mul_ps(acc1[i], valpha);
+    if (beta != 0.f) {
+      r0 = _mm512_fmadd_ps(_mm512_loadu_ps(c_row), vbeta, r0);
+      r1 = _mm512_fmadd_ps(_mm512_loadu_ps(c_row + 16), vbeta, r1);
+    }
+    _mm512_storeu_ps(c_row, r0);
+    _mm512_storeu_ps(c_row + 16, r1);
+  }
+}
+
+static const SgemmKernel kSgemmKernelAvx512 = {12,
+                                               32,
+                                               {sgemm_kernel_avx512<1>,
+                                                sgemm_kernel_avx512<2>,
+                                                sgemm_kernel_avx512<3>,
+                                                sgemm_kernel_avx512<4>,
+                                                sgemm_kernel_avx512<5>,
+                                                sgemm_kernel_avx512<6>,
+                                                sgemm_kernel_avx512<7>,
+                                                sgemm_kernel_avx512<8>,
+                                                sgemm_kernel_avx512<9>,
+                                                sgemm_kernel_avx512<10>,
+                                                sgemm_kernel_avx512<11>,
+                                                sgemm_kernel_avx512<12>}};
+
+static bool sgemm_has_avx512() {
+#if defined(__GNUC__) && !defined(_WIN32)
+  return MayIUse(avx512f) || __builtin_cpu_supports("avx512f");
+#else
+  return MayIUse(avx512f);
+#endif
+}
+#endif  // LITE_SGEMM_WITH_AVX512
+
+static const SgemmKernel& sgemm_kernel() {
+  static const SgemmKernel* kernel = []() {
+#ifdef LITE_SGEMM_WITH_AVX512
+    if (sgemm_has_avx512()) {
+      return &kSgemmKernelAvx512;
+    }
+#endif
+#ifdef __AVX2__
+    return &kSgemmKernelAvx2;
+#else
+    return &kSgemmKernelRef;
+#endif
+  }();
+  return *kernel;
+}
+
+int sgemm_block_m() { return sgemm_kernel().mr; }
+
+int sgemm_block_n() { return sgemm_kernel().nr; }
+
+int sgemm_block_k() { return KBLOCK; }
+
+int64_t sgemm_packed_a_size(int M, int K) {
+  return static_cast<int64_t>(round_up(M, sgemm_block_m())) * K;
+}
+
+int64_t sgemm_packed_b_size(int N, int K) {
+  return static_cast<int64_t>(round_up(N, sgemm_block_n())) * K;
+}
+
+// Packed layout of A (M x K), for every K block [k0, k0 + kc):
+//   panels of MR rows, each panel stored as kc columns of MR values,
+// so the panel holding rows [i0, i0 + MR) starts at k0 * Mpad + i0 * kc.
+// B is stored the same way with NR columns per panel.
+void sgemm_prepack_a(
+    bool is_trans, int M, int K, const float* A, int lda, float* A_packed) {
+  const int mr = sgemm_block_m();
+  const int m_pad = round_up(M, mr);
+  const int panels = m_pad / mr;
+  const int k_blocks = (K + KBLOCK - 1) / KBLOCK;
+  LITE_PARALLEL_BEGIN(task, tid, k_blocks * panels) {
+    const int k0 = (task / panels) * KBLOCK;
+    const int i0 = (task % panels) * mr;
+    const int kc = std::min(KBLOCK, K - k0);
+    const int rows = std::min(mr, M - i0);
+    float* out = A_packed + static_cast<int64_t>(k0) * m_pad + i0 * kc;
+    for (int p = 0; p < kc; ++p) {
+      const int k = k0 + p;
+      for (int r = 0; r < rows; ++r) {
+        out[r] = is_trans ? A[static_cast<int64_t>(k) * lda + i0 + r]
+                          : A[static_cast<int64_t>(i0 + r) * lda + k];
+      }
+      for (int r = rows; r < mr; ++r) out[r] = 0.f;
+      out += mr;
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void sgemm_prepack_b(
+    bool is_trans, int N, int K, const float* B, int ldb, float* B_packed) {
+  const int nr = sgemm_block_n();
+  const int n_pad = round_up(N, nr);
+  const int panels = n_pad / nr;
+  const int k_blocks = (K + KBLOCK - 1) / KBLOCK;
+  LITE_PARALLEL_BEGIN(task, tid, k_blocks * panels) {
+    const int k0 = (task / panels) * KBLOCK;
+    const int j0 = (task % panels) * nr;
+    const int kc = std::min(KBLOCK, K - k0);
+    const int cols = std::min(nr, N - j0);
+    float* out = B_packed + static_cast<int64_t>(k0) * n_pad + j0 * kc;
+    for (int p = 0; p < kc; ++p) {
+      const int k = k0 + p;
+      if (is_trans) {
+        for (int c = 0; c < cols; ++c) {
+          out[c] = B[static_cast<int64_t>(j0 + c) * ldb + k];
+        }
+      } else {
+        memcpy(out,
+               B + static_cast<int64_t>(k) * ldb + j0,
+               cols * sizeof(float));
+      }
+      for (int c = cols; c < nr; ++c) out[c] = 0.f;
+      out += nr;
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+static void sgemm_scale_c(int M, int N, float beta, float* C, int ldc) {
+  for (int i = 0; i < M; ++i) {
+    float* c_row = C + static_cast<int64_t>(i) * ldc;
+    for (int j = 0; j < N; ++j) {
+      c_row[j] = beta == 0.f ? 0.f : beta * c_row[j];
+    }
+  }
+}
+
+void sgemm_packed(int M,
+                  int N,
+                  int K,
+                  float alpha,
+                  const float* A_packed,
+                  const float* B_packed,
+                  float beta,
+                  float* C,
+                  int ldc) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  if (K <= 0) {
+    sgemm_scale_c(M, N, beta, C, ldc);
+    return;
+  }
+  const SgemmKernel& kernel = sgemm_kernel();
+  const int mr = kernel.mr;
+  const int nr = kernel.nr;
+  const int m_pad = round_up(M, mr);
+  const int n_pad = round_up(N, nr);
+
+  // Split C into tiles of mblock x nblock, narrowing the columns when there
+  // are too few row tiles to keep every thread busy (e.g. fc with batch 1).
+  const int mblock = std::min(MBLOCK, m_pad);
+  const int m_tiles = (M + mblock - 1) / mblock;
+  const int threads = static_cast<int>(lite::x86::GetMaxThreads());
+  int nblock = std::min(NBLOCK, n_pad);
+  if (m_tiles < threads) {
+    int n_tiles_wanted = (threads + m_tiles - 1) / m_tiles;
+    nblock = std::min(
+        nblock, round_up((N + n_tiles_wanted - 1) / n_tiles_wanted, nr));
+  }
+  const int n_tiles = (N + nblock - 1) / nblock;
+
+  LITE_PARALLEL_BEGIN(task, tid, m_tiles * n_tiles) {
+    const int i0 = (task % m_tiles) * mblock;
+    const int j0 = (task / m_tiles) * nblock;
+    const int rows = std::min(mblock, M - i0);
+    const int cols = std::min(nblock, N - j0);
+    alignas(64) float tile[kMaxMR * kMaxNR];
+    for (int k0 = 0; k0 < K; k0 += KBLOCK) {
+      const int kc = std::min(KBLOCK, K - k0);
+      const float cur_beta = k0 == 0 ? beta : 1.f;
+      const float* a_block =
+          A_packed + static_cast<int64_t>(k0) * m_pad + i0 * kc;
+      const float* b_block =
+          B_packed + static_cast<int64_t>(k0) * n_pad + j0 * kc;
+      for (int jr = 0; jr < cols; jr += nr) {
+        const int n = std::min(nr, cols - jr);
+        const float* b_panel = b_block + jr * kc;
+        for (int ir = 0; ir < rows; ir += mr) {
+          const int m = std::min(mr, rows - ir);
+          const float* a_panel = a_block + ir * kc;
+          float* c_tile = C + static_cast<int64_t>(i0 + ir) * ldc + j0 + jr;
+          if (n == nr) {
+            kernel.kernels[m - 1](
+                kc, a_panel, b_panel, c_tile, ldc, alpha, cur_beta);
+            continue;
+          }
+          // right edge: run the full width kernel on a local tile
+          memset(tile, 0, sizeof(tile));
+          if (cur_beta != 0.f) {
+            for (int i = 0; i < m; ++i) {
+              memcpy(tile + i * nr, c_tile + i * ldc, n * sizeof(float));
+            }
+          }
+          kernel.kernels[m - 1](
+              kc, a_panel, b_panel, tile, nr, alpha, cur_beta);
+          for (int i = 0; i < m; ++i) {
+            memcpy(c_tile + i * ldc, tile + i * nr, n * sizeof(float));
+          }
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void sgemm_prepacked_a(bool is_trans_b,
+                       int M,
+                       int N,
+                       int K,
+                       float alpha,
+                       const float* A_packed,
+                       const float* B,
+                       int ldb,
+                       float beta,
+                       float* C,
+                       int ldc) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  float* B_packed = static_cast<float*>(
+      TargetMalloc(TARGET(kX86), sgemm_packed_b_size(N, K) * sizeof(float)));
+  sgemm_prepack_b(is_trans_b, N, K, B, ldb, B_packed);
+  sgemm_packed(M, N, K, alpha, A_packed, B_packed, beta, C, ldc);
+  TargetFree(TARGET(kX86), B_packed);
+}
+
+void sgemm_prepacked_b(bool is_trans_a,
+                       int M,
+                       int N,
+                       int K,
+                       float alpha,
+                       const float* A,
+                       int lda,
+                       const float* B_packed,
+                       float beta,
+                       float* C,
+                       int ldc) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  float* A_packed = static_cast<float*>(
+      TargetMalloc(TARGET(kX86), sgemm_packed_a_size(M, K) * sizeof(float)));
+  sgemm_prepack_a(is_trans_a, M, K, A, lda, A_packed);
+  sgemm_packed(M, N, K, alpha, A_packed, B_packed, beta, C, ldc);
+  TargetFree(TARGET(kX86), A_packed);
+}
+
+void sgemm(bool is_trans_a,
+           bool is_trans_b,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  if (M == 1 && !is_trans_b) {
+    // a row vector times a matrix is a transposed gemv, no packing needed
+    sgemv(true, K, N, alpha, B, ldb, A, is_trans_a ? lda : 1, beta, C, 1);
+    return;
+  }
+  if (N == 1 && !is_trans_a) {
+    sgemv(false, M, K, alpha, A, lda, B, is_trans_b ? 1 : ldb, beta, C, ldc);
+    return;
+  }
+  float* B_packed = static_cast<float*>(
+      TargetMalloc(TARGET(kX86), sgemm_packed_b_size(N, K) * sizeof(float)));
+  sgemm_prepack_b(is_trans_b, N, K, B, ldb, B_packed);
+  sgemm_prepacked_b(
+      is_trans_a, M, N, K, alpha, A, lda, B_packed, beta, C, ldc);
+  TargetFree(TARGET(kX86), B_packed);
+}
+
+static float sdot(int n, const float* x, const float* y, int incy) {
+  float sum = 0.f;
+  int i = 0;
+#ifdef __AVX__
+  if (incy == 1) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+      acc0 = _mm256_add_ps(
+          acc0, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+      acc1 = _mm256_add_ps(acc1,
+                           _mm256_mul_ps(_mm256_loadu_ps(x + i + 8),
+                                         _mm256_loadu_ps(y + i + 8)));
+    }
+    alignas(32) float buf[8];
+    _mm256_store_ps(buf, _mm256_add_ps(acc0, acc1));
+    for (int j = 0; j < 8; ++j) sum += buf[j];
+  }
+#endif
+  for (; i < n; ++i) sum += x[i] * y[static_cast<int64_t>(i) * incy];
+  return sum;
+}
+
+void sgemv(bool is_trans,
+           int M,
+           int N,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* x,
+           int incx,
+           float beta,
+           float* y,
+           int incy) {
+  if (!is_trans) {
+    // y[i] = alpha * dot(A[i, :], x) + beta * y[i]
+    LITE_PARALLEL_BEGIN(i, tid, M) {
+      float sum = sdot(N, A + static_cast<int64_t>(i) * lda, x, incx);
+      float* yi = y + static_cast<int64_t>(i) * incy;
+      *yi = beta == 0.f ? alpha * sum : alpha * sum + beta * *yi;
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
+  // y[j] = alpha * sum_i(A[i, j] * x[i]) + beta * y[j], split over columns
+  constexpr int kColBlock = 256;
+  const int col_blocks = (N + kColBlock - 1) / kColBlock;
+  LITE_PARALLEL_BEGIN(cb, tid, col_blocks) {
+    const int j0 = cb * kColBlock;
+    const int cols = std::min(kColBlock, N - j0);
+    float acc[kColBlock];
+    for (int j = 0; j < cols; ++j) acc[j] = 0.f;
+    for (int i = 0; i < M; ++i) {
+      const float xi = x[static_cast<int64_t>(i) * incx];
+      const float* a_row = A + static_cast<int64_t>(i) * lda + j0;
+      for (int j = 0; j < cols; ++j) acc[j] += xi * a_row[j];
+    }
+    for (int j = 0; j < cols; ++j) {
+      float* yj = y + static_cast<int64_t>(j0 + j) * incy;
+      *yj = beta == 0.f ? alpha * acc[j] : alpha * acc[j] + beta * *yj;
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Built-in cache-blocked sgemm for x86, used as the float Blas backend when
+// the library is built with LITE_WITH_X86_SGEMM (no MKL/cblas).
+//
+// Both operands are repacked into micro-kernel panels before the multiply:
+// A into row panels of sgemm_block_m() rows, B into column panels of
+// sgemm_block_n() columns, both split along K into blocks of
+// sgemm_block_k(). The panel sizes depend on the instruction set picked at
+// runtime (AVX-512, AVX2 or plain C++), so a packed buffer is only valid in
+// the process that produced it.
+//
+// Weights that do not change between runs can be packed once with
+// sgemm_prepack_a/sgemm_prepack_b and fed to sgemm_prepacked_a/_b, which
+// only pack the other operand per call.
+
+int sgemm_block_m();
+int sgemm_block_n();
+int sgemm_block_k();
+
+//! number of floats needed to store the packed A(M x K) / B(K x N)
+int64_t sgemm_packed_a_size(int M, int K);
+int64_t sgemm_packed_b_size(int N, int K);
+
+void sgemm_prepack_a(
+    bool is_trans, int M, int K, const float* A, int lda, float* A_packed);
+
+void sgemm_prepack_b(
+    bool is_trans, int N, int K, const float* B, int ldb, float* B_packed);
+
+//! C = alpha * A_packed * B_packed + beta * C
+void sgemm_packed(int M,
+                  int N,
+                  int K,
+                  float alpha,
+                  const float* A_packed,
+                  const float* B_packed,
+                  float beta,
+                  float* C,
+                  int ldc);
+
+//! C = alpha * A_packed * op(B) + beta * C, used by conv with packed weights
+void sgemm_prepacked_a(bool is_trans_b,
+                       int M,
+                       int N,
+                       int K,
+                       float alpha,
+                       const float* A_packed,
+                       const float* B,
+                       int ldb,
+                       float beta,
+                       float* C,
+                       int ldc);
+
+//! C = alpha * op(A) * B_packed + beta * C, used by fc with packed weights
+void sgemm_prepacked_b(bool is_trans_a,
+                       int M,
+                       int N,
+                       int K,
+                       float alpha,
+                       const float* A,
+                       int lda,
+                       const float* B_packed,
+                       float beta,
+                       float* C,
+                       int ldc);
+
+//! C = alpha * op(A) * op(B) + beta * C, row major
+void sgemm(bool is_trans_a,
+           bool is_trans_b,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc);
+
+//! y = alpha * op(A) * x + beta * y, A is M x N row major
+void sgemv(bool is_trans,
+           int M,
+           int N,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* x,
+           int incx,
+           float beta,
+           float* y,
+           int incy);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
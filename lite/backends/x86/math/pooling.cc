@@ -13,8 +13,14 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/pooling.h"
+#include <float.h>
 #include <algorithm>
 #include <vector>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include "lite/backends/x86/math/saturate.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -54,57 +60,54 @@ class Pool2dFunctor<lite::TargetType::kX86, PoolProcess, T> {
     const int input_stride = input_height * input_width;
     const int output_stride = output_height * output_width;
 
-    const T* input_data = input->template data<T>();
-    T* output_data = output->template mutable_data<T>(lite::TargetType::kX86);
-
-    int hstart, hend;
-    int wstart, wend;
+    const T* input_ptr = input->template data<T>();
+    T* output_ptr = output->template mutable_data<T>(lite::TargetType::kX86);
 
-    for (int i = 0; i < batch_size; i++) {
-      for (int c = 0; c < output_channels; ++c) {
-        for (int ph = 0; ph < output_height; ++ph) {
+    LITE_PARALLEL_BEGIN(nc, tid, batch_size * output_channels) {
+      const T* input_data = input_ptr + nc * input_stride;
+      T* output_data = output_ptr + nc * output_stride;
+      int hstart = 0, hend = 0;
+      int wstart = 0, wend = 0;
+      for (int ph = 0; ph < output_height; ++ph) {
+        if (adaptive) {
+          hstart = AdaptStartIndex(ph, input_height, output_height);
+          hend = AdaptEndIndex(ph, input_height, output_height);
+        }
+        for (int pw = 0; pw < output_width; ++pw) {
+          int pool_size = 1;
           if (adaptive) {
-            hstart = AdaptStartIndex(ph, input_height, output_height);
-            hend = AdaptEndIndex(ph, input_height, output_height);
+            wstart = AdaptStartIndex(pw, input_width, output_width);
+            wend = AdaptEndIndex(pw, input_width, output_width);
+          } else {
+            hstart = ph * stride_height - padding_height;
+            wstart = pw * stride_width - padding_width;
+            hend =
+                std::min(hstart + ksize_height, input_height + padding_height);
+            wend = std::min(wstart + ksize_width, input_width + padding_width);
+            pool_size = (hend - hstart) * (wend - wstart);
+
+            wstart = std::max(wstart, 0);
+            hstart = std::max(hstart, 0);
+            hend = std::min(hend, input_height);
+            wend = std::min(wend, input_width);
           }
-          for (int pw = 0; pw < output_width; ++pw) {
-            int pool_size = 1;
-            if (adaptive) {
-              wstart = AdaptStartIndex(pw, input_width, output_width);
-              wend = AdaptEndIndex(pw, input_width, output_width);
-            } else {
-              hstart = ph * stride_height - padding_height;
-              wstart = pw * stride_width - padding_width;
-              hend = std::min(hstart + ksize_height,
-                              input_height + padding_height);
-              wend =
-                  std::min(wstart + ksize_width, input_width + padding_width);
-              pool_size = (hend - hstart) * (wend - wstart);
-
-              wstart = std::max(wstart, 0);
-              hstart = std::max(hstart, 0);
-              hend = std::min(hend, input_height);
-              wend = std::min(wend, input_width);
-            }
 
-            T ele = pool_process.initial();
-            for (int h = hstart; h < hend; ++h) {
-              for (int w = wstart; w < wend; ++w) {
-                pool_process.compute(input_data[h * input_width + w], &ele);
-              }
+          T ele = pool_process.initial();
+          for (int h = hstart; h < hend; ++h) {
+            for (int w = wstart; w < wend; ++w) {
+              pool_process.compute(input_data[h * input_width + w], &ele);
             }
-            if (exclusive || adaptive) {
-              pool_size = (hend - hstart) * (wend - wstart);
-            }
-
-            pool_process.finalize(static_cast<T>(pool_size), &ele);
-            output_data[ph * output_width + pw] = ele;
           }
+          if (exclusive || adaptive) {
+            pool_size = (hend - hstart) * (wend - wstart);
+          }
+
+          pool_process.finalize(static_cast<T>(pool_size), &ele);
+          output_data[ph * output_width + pw] = ele;
         }
-        input_data += input_stride;
-        output_data += output_stride;
       }
     }
+    LITE_PARALLEL_END();
   }
 };
 
@@ -912,6 +915,630 @@ template class MaxPool3dWithIndexFunctor<lite::TargetType::kX86, double, int>;
 template class MaxPool3dWithIndexGradFunctor<lite::TargetType::kX86,
                                              double,
                                              int>;
+
+/*
+ * The vectorized fp32 pooling below keeps the window rules of
+ * Pool2dFunctor: the outputs whose window is inside the input run the SIMD
+ * loop, the border ones go through pool_window.
+ */
+// Clips the window of the output (ph, pw) to the input, returns the avg
+// divisor.
+static inline int clip_window(int ph,
+                              int pw,
+                              int hin,
+                              int win,
+                              int kernel_h,
+                              int kernel_w,
+                              int stride_h,
+                              int stride_w,
+                              int pad_top,
+                              int pad_left,
+                              bool exclusive,
+                              int* hstart,
+                              int* hend,
+                              int* wstart,
+                              int* wend) {
+  int hs = ph * stride_h - pad_top;
+  int ws = pw * stride_w - pad_left;
+  int he = (std::min)(hs + kernel_h, hin + pad_top);
+  int we = (std::min)(ws + kernel_w, win + pad_left);
+  int pool_size = (he - hs) * (we - ws);
+  *hstart = (std::max)(hs, 0);
+  *wstart = (std::max)(ws, 0);
+  *hend = (std::min)(he, hin);
+  *wend = (std::min)(we, win);
+  if (exclusive) {
+    pool_size = (*hend - *hstart) * (*wend - *wstart);
+  }
+  return pool_size;
+}
+
+template <bool kMax>
+static inline float pool_window(const float* din,
+                                int win,
+                                int hstart,
+                                int hend,
+                                int wstart,
+                                int wend,
+                                int pool_size) {
+  float res = kMax ? -FLT_MAX : 0.f;
+  for (int h = hstart; h < hend; ++h) {
+    for (int w = wstart; w < wend; ++w) {
+      float x = din[h * win + w];
+      res = kMax ? (res > x ? res : x) : res + x;
+    }
+  }
+  return kMax ? res : res / pool_size;
+}
+
+#ifdef __AVX__
+template <bool kMax>
+static inline __m256 pool_reduce(__m256 a, __m256 b);
+
+template <>
+inline __m256 pool_reduce<true>(__m256 a, __m256 b) {
+  return _mm256_max_ps(a, b);
+}
+
+template <>
+inline __m256 pool_reduce<false>(__m256 a, __m256 b) {
+  return _mm256_add_ps(a, b);
+}
+
+// the even and the odd elements of x[0:16]
+static inline void load_deinterleave(const float* x,
+                                     __m256* even,
+                                     __m256* odd) {
+  __m256 a = _mm256_loadu_ps(x);
+  __m256 b = _mm256_loadu_ps(x + 8);
+  __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+  __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+  *even = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+  *odd = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+#endif
+
+template <bool kMax>
+static void pooling_global(
+    const float* din, float* dout, int num, int chin, int size) {
+  LITE_PARALLEL_BEGIN(nc, tid, num * chin) {
+    const float* x = din + nc * size;
+    float res = kMax ? -FLT_MAX : 0.f;
+    int i = 0;
+#ifdef __AVX__
+    if (size >= 8) {
+      __m256 acc0 = _mm256_set1_ps(res);
+      __m256 acc1 = acc0;
+      for (; i + 16 <= size; i += 16) {
+        acc0 = pool_reduce<kMax>(acc0, _mm256_loadu_ps(x + i));
+        acc1 = pool_reduce<kMax>(acc1, _mm256_loadu_ps(x + i + 8));
+      }
+      for (; i + 8 <= size; i += 8) {
+        acc0 = pool_reduce<kMax>(acc0, _mm256_loadu_ps(x + i));
+      }
+      float buf[8];
+      _mm256_storeu_ps(buf, pool_reduce<kMax>(acc0, acc1));
+      for (int k = 0; k < 8; k++) {
+        res = kMax ? (res > buf[k] ? res : buf[k]) : res + buf[k];
+      }
+    }
+#endif
+    for (; i < size; i++) {
+      res = kMax ? (res > x[i] ? res : x[i]) : res + x[i];
+    }
+    dout[nc] = kMax ? res : res / size;
+  }
+  LITE_PARALLEL_END();
+}
+
+void pooling_global_max(
+    const float* din, float* dout, int num, int chin, int hin, int win) {
+  pooling_global<true>(din, dout, num, chin, hin * win);
+}
+
+void pooling_global_avg(
+    const float* din, float* dout, int num, int chin, int hin, int win) {
+  pooling_global<false>(din, dout, num, chin, hin * win);
+}
+
+// K x K windows with a stride of 2, 8 outputs of a row take two
+// deinterleaved loads per window row.
+template <int K, bool kMax>
+static void pooling_kxks2(const float* din,
+                          float* dout,
+                          int num,
+                          int chin,
+                          int hin,
+                          int win,
+                          int hout,
+                          int wout,
+                          int pad_top,
+                          int pad_left,
+                          bool exclusive) {
+  const int size_in = hin * win;
+  const int size_out = hout * wout;
+  // from pw_begin on the windows don't cross the left border
+  const int pw_begin = (std::min)((pad_left + 1) / 2, wout);
+  LITE_PARALLEL_BEGIN(nc, tid, num * chin) {
+    const float* in = din + nc * size_in;
+    float* out = dout + nc * size_out;
+    int hs, he, ws, we;
+    for (int ph = 0; ph < hout; ++ph) {
+      float* o = out + ph * wout;
+      int hstart = ph * 2 - pad_top;
+      int pw = 0;
+      if (hstart >= 0 && hstart + K <= hin) {
+        for (; pw < pw_begin; ++pw) {
+          int pool_size = clip_window(ph,
+                                      pw,
+                                      hin,
+                                      win,
+                                      K,
+                                      K,
+                                      2,
+                                      2,
+                                      pad_top,
+                                      pad_left,
+                                      exclusive,
+                                      &hs,
+                                      &he,
+                                      &ws,
+                                      &we);
+          o[pw] = pool_window<kMax>(in, win, hs, he, ws, we, pool_size);
+        }
+#ifdef __AVX__
+        const float* row = in + hstart * win;
+        const __m256 vscale = _mm256_set1_ps(1.f / (K * K));
+        // K == 3 also reads x[16:18] past the even/odd pairs
+        const int load = K == 3 ? 18 : 16;
+        for (; pw + 8 <= wout && pw * 2 - pad_left + load <= win; pw += 8) {
+          const float* x = row + pw * 2 - pad_left;
+          __m256 acc = _mm256_set1_ps(kMax ? -FLT_MAX : 0.f);
+          __m256 even, odd;
+          for (int kh = 0; kh < K; ++kh) {
+            load_deinterleave(x, &even, &odd);
+            acc = pool_reduce<kMax>(acc, pool_reduce<kMax>(even, odd));
+            if (K == 3) {
+              load_deinterleave(x + 2, &even, &odd);
+              acc = pool_reduce<kMax>(acc, even);
+            }
+            x += win;
+          }
+          if (!kMax) {
+            acc = _mm256_mul_ps(acc, vscale);
+          }
+          _mm256_storeu_ps(o + pw, acc);
+        }
+#endif
+      }
+      for (; pw < wout; ++pw) {
+        int pool_size = clip_window(ph,
+                                    pw,
+                                    hin,
+                                    win,
+                                    K,
+                                    K,
+                                    2,
+                                    2,
+                                    pad_top,
+                                    pad_left,
+                                    exclusive,
+                                    &hs,
+                                    &he,
+                                    &ws,
+                                    &we);
+        o[pw] = pool_window<kMax>(in, win, hs, he, ws, we, pool_size);
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void pooling2x2s2_max(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left) {
+  pooling_kxks2<2, true>(
+      din, dout, num, chin, hin, win, hout, wout, pad_top, pad_left, false);
+}
+
+void pooling2x2s2_avg(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left,
+                      bool exclusive) {
+  pooling_kxks2<2, false>(din,
+                          dout,
+                          num,
+                          chin,
+                          hin,
+                          win,
+                          hout,
+                          wout,
+                          pad_top,
+                          pad_left,
+                          exclusive);
+}
+
+void pooling3x3s2_max(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left) {
+  pooling_kxks2<3, true>(
+      din, dout, num, chin, hin, win, hout, wout, pad_top, pad_left, false);
+}
+
+void pooling3x3s2_avg(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left,
+                      bool exclusive) {
+  pooling_kxks2<3, false>(din,
+                          dout,
+                          num,
+                          chin,
+                          hin,
+                          win,
+                          hout,
+                          wout,
+                          pad_top,
+                          pad_left,
+                          exclusive);
+}
+
+template <bool kMax>
+static void pooling_nchwc(const float* din,
+                          float* dout,
+                          int num,
+                          int cblocks,
+                          int block,
+                          int hin,
+                          int win,
+                          int hout,
+                          int wout,
+                          const std::vector<int>& ksize,
+                          const std::vector<int>& strides,
+                          const std::vector<int>& paddings,
+                          bool exclusive) {
+  const int size_in = hin * win * block;
+  const int size_out = hout * wout * block;
+  LITE_PARALLEL_BEGIN(nc, tid, num * cblocks) {
+    const float* in = din + nc * size_in;
+    float* out = dout + nc * size_out;
+    int hs, he, ws, we;
+    for (int ph = 0; ph < hout; ++ph) {
+      for (int pw = 0; pw < wout; ++pw) {
+        int pool_size = clip_window(ph,
+                                    pw,
+                                    hin,
+                                    win,
+                                    ksize[0],
+                                    ksize[1],
+                                    strides[0],
+                                    strides[1],
+                                    paddings[0],
+                                    paddings[2],
+                                    exclusive,
+                                    &hs,
+                                    &he,
+                                    &ws,
+                                    &we);
+        float* o = out + (ph * wout + pw) * block;
+#ifdef __AVX__
+        if (block == 8) {
+          __m256 acc = _mm256_set1_ps(kMax ? -FLT_MAX : 0.f);
+          for (int h = hs; h < he; ++h) {
+            const float* x = in + (h * win + ws) * 8;
+            for (int w = ws; w < we; ++w, x += 8) {
+              acc = pool_reduce<kMax>(acc, _mm256_loadu_ps(x));
+            }
+          }
+          if (!kMax) {
+            acc = _mm256_div_ps(acc, _mm256_set1_ps(pool_size));
+          }
+          _mm256_storeu_ps(o, acc);
+          continue;
+        }
+#endif
+#ifdef __AVX512F__
+        if (block == 16) {
+          __m512 acc = _mm512_set1_ps(kMax ? -FLT_MAX : 0.f);
+          for (int h = hs; h < he; ++h) {
+            const float* x = in + (h * win + ws) * 16;
+            for (int w = ws; w < we; ++w, x += 16) {
+              acc = kMax ? _mm512_max_ps(acc, _mm512_loadu_ps(x))
+                         : _mm512_add_ps(acc, _mm512_loadu_ps(x));
+            }
+          }
+          if (!kMax) {
+            acc = _mm512_div_ps(acc, _mm512_set1_ps(pool_size));
+          }
+          _mm512_storeu_ps(o, acc);
+          continue;
+        }
+#endif
+        for (int c = 0; c < block; ++c) {
+          float res = kMax ? -FLT_MAX : 0.f;
+          for (int h = hs; h < he; ++h) {
+            for (int w = ws; w < we; ++w) {
+              float x = in[(h * win + w) * block + c];
+              res = kMax ? (res > x ? res : x) : res + x;
+            }
+          }
+          o[c] = kMax ? res : res / pool_size;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void pooling_nchwc_max(const float* din,
+                       float* dout,
+                       int num,
+                       int cblocks,
+                       int block,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       const std::vector<int>& ksize,
+                       const std::vector<int>& strides,
+                       const std::vector<int>& paddings) {
+  pooling_nchwc<true>(din,
+                      dout,
+                      num,
+                      cblocks,
+                      block,
+                      hin,
+                      win,
+                      hout,
+                      wout,
+                      ksize,
+                      strides,
+                      paddings,
+                      false);
+}
+
+void pooling_nchwc_avg(const float* din,
+                       float* dout,
+                       int num,
+                       int cblocks,
+                       int block,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       const std::vector<int>& ksize,
+                       const std::vector<int>& strides,
+                       const std::vector<int>& paddings,
+                       bool exclusive) {
+  pooling_nchwc<false>(din,
+                       dout,
+                       num,
+                       cblocks,
+                       block,
+                       hin,
+                       win,
+                       hout,
+                       wout,
+                       ksize,
+                       strides,
+                       paddings,
+                       exclusive);
+}
+
+static inline void store_pool_int8(float v, int8_t* out) {
+  int8_t res = saturate_cast<int8_t>(roundf(v));
+  *out = res < -127 ? -127 : res;
+}
+
+static inline void store_pool_int8(float v, float* out) { *out = v; }
+
+/*
+ * Every output row first reduces the rows of its window into an int32 row
+ * (vectorized across w), then slides the window along that row. Avg sums
+ * in int32, so the division happens once with the scale.
+ */
+template <bool kMax, typename T>
+static void pooling_int8_impl(const int8_t* din,
+                              T* dout,
+                              int num,
+                              int chin,
+                              int hin,
+                              int win,
+                              int hout,
+                              int wout,
+                              const std::vector<int>& ksize,
+                              const std::vector<int>& strides,
+                              const std::vector<int>& paddings,
+                              bool exclusive,
+                              float scale) {
+  const int size_in = hin * win;
+  const int size_out = hout * wout;
+  LITE_PARALLEL_BEGIN(nc, tid, num * chin) {
+    const int8_t* in = din + nc * size_in;
+    T* out = dout + nc * size_out;
+    std::vector<int32_t> row(win);
+    int hs, he, ws, we;
+    for (int ph = 0; ph < hout; ++ph) {
+      clip_window(ph,
+                  0,
+                  hin,
+                  win,
+                  ksize[0],
+                  ksize[1],
+                  strides[0],
+                  strides[1],
+                  paddings[0],
+                  paddings[2],
+                  exclusive,
+                  &hs,
+                  &he,
+                  &ws,
+                  &we);
+      int32_t* r = row.data();
+      for (int w = 0; w < win; ++w) {
+        r[w] = kMax ? -128 : 0;
+      }
+      for (int h = hs; h < he; ++h) {
+        const int8_t* x = in + h * win;
+        int w = 0;
+#ifdef __AVX2__
+        for (; w + 8 <= win; w += 8) {
+          __m256i vx = _mm256_cvtepi8_epi32(
+              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + w)));
+          __m256i vr = _mm256_loadu_si256(reinterpret_cast<__m256i*>(r + w));
+          vr = kMax ? _mm256_max_epi32(vr, vx) : _mm256_add_epi32(vr, vx);
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + w), vr);
+        }
+#endif
+        for (; w < win; ++w) {
+          r[w] = kMax ? (r[w] > x[w] ? r[w] : x[w]) : r[w] + x[w];
+        }
+      }
+      for (int pw = 0; pw < wout; ++pw) {
+        int pool_size = clip_window(ph,
+                                    pw,
+                                    hin,
+                                    win,
+                                    ksize[0],
+                                    ksize[1],
+                                    strides[0],
+                                    strides[1],
+                                    paddings[0],
+                                    paddings[2],
+                                    exclusive,
+                                    &hs,
+                                    &he,
+                                    &ws,
+                                    &we);
+        int32_t res = kMax ? -128 : 0;
+        for (int w = ws; w < we; ++w) {
+          res = kMax ? (res > r[w] ? res : r[w]) : res + r[w];
+        }
+        float v = kMax ? res * scale : res * (scale / pool_size);
+        store_pool_int8(v, out + ph * wout + pw);
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void pooling_int8(const int8_t* din,
+                  int8_t* dout,
+                  int num,
+                  int chin,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  float scale) {
+  if (is_max) {
+    pooling_int8_impl<true>(din,
+                            dout,
+                            num,
+                            chin,
+                            hin,
+                            win,
+                            hout,
+                            wout,
+                            ksize,
+                            strides,
+                            paddings,
+                            true,
+                            scale);
+  } else {
+    pooling_int8_impl<false>(din,
+                             dout,
+                             num,
+                             chin,
+                             hin,
+                             win,
+                             hout,
+                             wout,
+                             ksize,
+                             strides,
+                             paddings,
+                             exclusive,
+                             scale);
+  }
+}
+
+void pooling_int8(const int8_t* din,
+                  float* dout,
+                  int num,
+                  int chin,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  float scale) {
+  if (is_max) {
+    pooling_int8_impl<true>(din,
+                            dout,
+                            num,
+                            chin,
+                            hin,
+                            win,
+                            hout,
+                            wout,
+                            ksize,
+                            strides,
+                            paddings,
+                            true,
+                            scale);
+  } else {
+    pooling_int8_impl<false>(din,
+                             dout,
+                             num,
+                             chin,
+                             hin,
+                             win,
+                             hout,
+                             wout,
+                             ksize,
+                             strides,
+                             paddings,
+                             exclusive,
+                             scale);
+  }
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
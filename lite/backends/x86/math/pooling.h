@@ -240,6 +240,134 @@ class MaxPool3dWithIndexGradFunctor {
                   lite::Tensor* input_grad);
 };
 
+/*
+ * Vectorized fp32 pooling, din is [num, chin, hin, win] and dout is
+ * [num, chin, hout, wout]. The windows follow Pool2dFunctor: they start at
+ * pad_top / pad_left before the input, and unless exclusive the avg divisor
+ * of a border window counts the padding.
+ */
+void pooling_global_max(
+    const float* din, float* dout, int num, int chin, int hin, int win);
+
+void pooling_global_avg(
+    const float* din, float* dout, int num, int chin, int hin, int win);
+
+void pooling2x2s2_max(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left);
+
+void pooling2x2s2_avg(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left,
+                      bool exclusive);
+
+void pooling3x3s2_max(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left);
+
+void pooling3x3s2_avg(const float* din,
+                      float* dout,
+                      int num,
+                      int chin,
+                      int hin,
+                      int win,
+                      int hout,
+                      int wout,
+                      int pad_top,
+                      int pad_left,
+                      bool exclusive);
+
+/*
+ * Pooling of channel blocked data, din is [num, cblocks, hin, win, block] and
+ * dout is [num, cblocks, hout, wout, block], so every window step is a whole
+ * vector. block is 8 (AVX) or 16 (AVX-512), other sizes run the scalar loop.
+ * paddings is {top, bottom, left, right} and the windows follow
+ * Pool2dFunctor.
+ */
+void pooling_nchwc_max(const float* din,
+                       float* dout,
+                       int num,
+                       int cblocks,
+                       int block,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       const std::vector<int>& ksize,
+                       const std::vector<int>& strides,
+                       const std::vector<int>& paddings);
+
+void pooling_nchwc_avg(const float* din,
+                       float* dout,
+                       int num,
+                       int cblocks,
+                       int block,
+                       int hin,
+                       int win,
+                       int hout,
+                       int wout,
+                       const std::vector<int>& ksize,
+                       const std::vector<int>& strides,
+                       const std::vector<int>& paddings,
+                       bool exclusive);
+
+/*
+ * Int8 pooling of NCHW data, din is [num, chin, hin, win] and dout is
+ * [num, chin, hout, wout], the windows follow pooling_nchwc. The pooled
+ * value v of the int8 input is stored as v * scale, so scale is
+ * in_scale / out_scale for an int8 dout and in_scale for a float one.
+ */
+void pooling_int8(const int8_t* din,
+                  int8_t* dout,
+                  int num,
+                  int chin,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  float scale);
+
+void pooling_int8(const int8_t* din,
+                  float* dout,
+                  int num,
+                  int chin,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  float scale);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -20,6 +20,7 @@ limitations under the License. */
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/cpu_vec.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -108,9 +109,11 @@ class SoftmaxFunctor<Target, T, is_test, enable_if_CPU<Target>> {
     const int num_remain = num_classes / axis_dim;
 
     if (num_remain == 1 && lite::x86::MayIUse(lite::x86::avx)) {
-      const T* in_data = X->template data<T>();
-      auto* out_data = Y->template mutable_data<T>();
-      for (int bs = 0; bs < batch_size; ++bs) {
+      const T* in_ptr = X->template data<T>();
+      auto* out_ptr = Y->template mutable_data<T>();
+      LITE_PARALLEL_BEGIN(bs, tid, batch_size) {
+        const T* in_data = in_ptr + bs * num_classes;
+        T* out_data = out_ptr + bs * num_classes;
         T max_val = *std::max_element(in_data, in_data + num_classes);
         max_val *= static_cast<T>(-1);
         vec_add_bias<T, lite::x86::avx>(
@@ -123,10 +126,8 @@ class SoftmaxFunctor<Target, T, is_test, enable_if_CPU<Target>> {
         vec_sum<T, lite::x86::avx>(num_classes, out_data, &sum);
         sum = static_cast<T>(1) / sum;
         vec_scal<T, lite::x86::avx>(num_classes, sum, out_data, out_data);
-
-        in_data += num_classes;
-        out_data += num_classes;
       }
+      LITE_PARALLEL_END();
     } else {
       SoftmaxEigen<Target, T, is_test>(context, axis_dim, X, Y);
     }
@@ -160,7 +161,11 @@ class SoftmaxFunctor<Target, float, true, enable_if_CPU<Target>> {
     const int batch_size = in_dims[kBatchDim];
     const int length = in_dims[kClassDim];
     const int stride = in_dims[kClassDim] / axis_dim;
-    for (int bs = 0; bs < batch_size; ++bs) {
+    const float* in_ptr = in_data;
+    float* out_ptr = out_data;
+    LITE_PARALLEL_BEGIN(bs, tid, batch_size) {
+      const float* in_data = in_ptr + bs * length;
+      float* out_data = out_ptr + bs * length;
       // get max value of input data
       float in_max = -FLT_MAX;
       for (int i = 0; i < length; ++i) {
@@ -180,9 +185,8 @@ class SoftmaxFunctor<Target, float, true, enable_if_CPU<Target>> {
           out_data[i + j * stride] /= sum;
         }
       }
-      in_data += length;
-      out_data += length;
     }
+    LITE_PARALLEL_END();
 #endif
   }
 };
@@ -15,9 +15,12 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #ifdef PADDLE_WITH_MKLML
 #include <omp.h>
 #include "lite/backends/x86/mklml.h"
+#elif defined(LITE_USE_THREAD_POOL)
+#include "lite/core/parallel_defines.h"
 #endif
 
 namespace paddle {
@@ -41,6 +44,10 @@ static inline int64_t GetMaxThreads() {
 #ifdef PADDLE_WITH_MKLML
   // Do not support nested omp parallem.
   num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#elif defined(LITE_USE_THREAD_POOL)
+  // Without MKLML the loops run on the pool of the calling predictor.
+  ThreadPool* pool = ThreadPool::Current();
+  num_threads = pool ? pool->thread_num() : 1;
 #endif
   return (std::max<int>)(num_threads, 1L);
 }
@@ -67,6 +74,19 @@ static inline void RunParallelFor(const int64_t begin,
     }
     return;
   }
+#elif defined(LITE_USE_THREAD_POOL)
+  int64_t num_threads = (std::min)(GetMaxThreads(), end - begin);
+  if (num_threads > 1) {
+    int64_t chunk_size = (end - begin + num_threads - 1) / num_threads;
+    LITE_PARALLEL_BEGIN(i, tid, num_threads) {
+      int64_t begin_i = begin + i * chunk_size;
+      if (begin_i < end) {
+        f(begin_i, (std::min)(end, chunk_size + begin_i));
+      }
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
 #endif
 
   f(begin, end);
@@ -16,5 +16,11 @@
 #include "lite/utils/macros.h"
 
 namespace paddle {
-namespace lite {}  // namespace lite
+namespace lite {
+
+#ifdef LITE_WITH_X86
+LITE_THREAD_LOCAL TensorLite Context<TargetType::kX86>::workspace_;
+#endif
+
+}  // namespace lite
 }  // namespace paddle
@@ -42,6 +42,7 @@
 #include "lite/core/scope.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
 #include "lite/utils/all.h"
 #include "lite/utils/env.h"
 #include "lite/utils/macros.h"
@@ -354,7 +355,25 @@ class Context<TargetType::kX86> {
   AVXType avx_level() { return device_avx_level(); }
   FMAType fma_level() { return device_fma_level(); }
 
+  // The scratch memory shared by the x86 kernels running on the same thread.
+  // It only grows, so a kernel should reserve its peak size in PrepareForRun
+  // with ExtendWorkspace, and the following runs allocate nothing.
+  template <typename T>
+  T* workspace_data() {
+    return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
+  }
+
+  bool ExtendWorkspace(size_t size) {
+    if (size > workspace_.memory_size()) {
+      workspace_.Resize({static_cast<int64_t>(size)});
+    }
+    return workspace_.mutable_data<int8_t>() != nullptr;
+  }
+
+  size_t workspace_size() const { return workspace_.memory_size(); }
+
  private:
+  static LITE_THREAD_LOCAL TensorLite workspace_;
   // overall information
   //
   // kernel information
@@ -432,6 +451,10 @@ class KernelContext {
     return *ctx_.get_mutable<ContextT>();
   }
 
+  // The pool the `LITE_PARALLEL_*` loops of the running kernel dispatch to,
+  // i.e. the one of the predictor calling `Run`.
+  ThreadPool* thread_pool() const { return ThreadPool::Current(); }
+
  private:
   Any ctx_;
 };
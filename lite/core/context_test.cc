@@ -47,5 +47,28 @@ namespace lite {
 // }
 // #endif
 
+#ifdef LITE_WITH_X86
+TEST(X86Context, workspace) {
+  auto ctx1_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+  auto ctx2_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+  auto& ctx1 = ctx1_p->As<X86Context>();
+  auto& ctx2 = ctx2_p->As<X86Context>();
+
+  ASSERT_TRUE(ctx1.ExtendWorkspace(1024));
+  auto* data = ctx1.workspace_data<float>();
+  ASSERT_TRUE(data != nullptr);
+  ASSERT_GE(ctx1.workspace_size(), 1024u);
+
+  // The workspace is shared by the contexts of one thread and never shrinks.
+  ASSERT_TRUE(ctx2.ExtendWorkspace(256));
+  ASSERT_EQ(ctx2.workspace_data<float>(), data);
+  ASSERT_GE(ctx2.workspace_size(), 1024u);
+
+  ASSERT_TRUE(ctx2.ExtendWorkspace(1 << 20));
+  ASSERT_GE(ctx1.workspace_size(), static_cast<size_t>(1 << 20));
+  ASSERT_EQ(ctx1.workspace_data<float>(), ctx2.workspace_data<float>());
+}
+#endif
+
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,144 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/dag_executor.h"
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <queue>
+#include <set>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+#ifdef LITE_WITH_ARM
+#include "lite/core/device_info.h"
+#endif
+
+namespace paddle {
+namespace lite {
+
+void DagExecutor::Build(const std::vector<std::vector<int>>& reads,
+                        const std::vector<std::vector<int>>& writes) {
+  CHECK_EQ(reads.size(), writes.size());
+  size_t num = reads.size();
+  std::vector<std::set<int>> deps(num);
+  std::map<int, int> last_writer;
+  std::map<int, std::vector<int>> readers;
+  for (size_t i = 0; i < num; i++) {
+    int node = static_cast<int>(i);
+    for (int res : reads[i]) {
+      auto it = last_writer.find(res);
+      if (it != last_writer.end()) deps[i].insert(it->second);
+      readers[res].push_back(node);
+    }
+    for (int res : writes[i]) {
+      auto it = last_writer.find(res);
+      if (it != last_writer.end()) deps[i].insert(it->second);
+      auto& res_readers = readers[res];
+      deps[i].insert(res_readers.begin(), res_readers.end());
+      res_readers.clear();
+      last_writer[res] = node;
+    }
+    deps[i].erase(node);
+  }
+
+  successors_.assign(num, std::vector<int>());
+  num_deps_.assign(num, 0);
+  std::vector<int> levels(num, 0);
+  std::vector<int> level_sizes;
+  for (size_t i = 0; i < num; i++) {
+    for (int dep : deps[i]) {
+      successors_[dep].push_back(static_cast<int>(i));
+      levels[i] = (std::max)(levels[i], levels[dep] + 1);
+    }
+    num_deps_[i] = static_cast<int>(deps[i].size());
+    if (levels[i] >= static_cast<int>(level_sizes.size())) {
+      level_sizes.resize(levels[i] + 1, 0);
+    }
+    level_sizes[levels[i]]++;
+  }
+  width_ = level_sizes.empty()
+               ? 0
+               : *std::max_element(level_sizes.begin(), level_sizes.end());
+}
+
+void DagExecutor::Clear() {
+  successors_.clear();
+  num_deps_.clear();
+  width_ = 0;
+}
+
+void DagExecutor::Run(int lanes,
+                      int intra_threads,
+                      const std::function<void(int)>& run_node) {
+  lanes = (std::max)(lanes, 1);
+  intra_threads = (std::max)(intra_threads, 1);
+#ifdef LITE_USE_THREAD_POOL
+  if (static_cast<int>(lane_pools_.size()) != lanes ||
+      intra_threads_ != intra_threads) {
+    lane_pools_.clear();
+    for (int i = 0; i < lanes; i++) {
+      lane_pools_.push_back(ThreadPool::Create(intra_threads));
+    }
+    intra_threads_ = intra_threads;
+  }
+#endif
+#ifdef LITE_WITH_ARM
+  auto mode = DeviceInfo::Global().mode();
+  int threads = DeviceInfo::Global().threads();
+#endif
+
+  std::vector<int> pending(num_deps_);
+  // The smallest index first, close to the program order.
+  std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+  for (size_t i = 0; i < pending.size(); i++) {
+    if (pending[i] == 0) ready.push(static_cast<int>(i));
+  }
+  size_t remaining = pending.size();
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  LITE_PARALLEL_BEGIN(lane, tid, lanes) {
+    ThreadPoolGuard guard(lane < static_cast<int>(lane_pools_.size())
+                              ? lane_pools_[lane].get()
+                              : nullptr);
+#ifdef LITE_WITH_ARM
+    DeviceInfo::Global().SetRunMode(mode, intra_threads);
+#endif
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&] { return remaining == 0 || !ready.empty(); });
+      if (remaining == 0) break;
+      int node = ready.top();
+      ready.pop();
+      lock.unlock();
+      run_node(node);
+      lock.lock();
+      remaining--;
+      for (int next : successors_[node]) {
+        if (--pending[next] == 0) ready.push(next);
+      }
+      cv.notify_all();
+    }
+  }
+  LITE_PARALLEL_END();
+
+#ifdef LITE_WITH_ARM
+  DeviceInfo::Global().SetRunMode(mode, threads);
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,70 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "lite/core/thread_pool.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Runs the nodes of a dependency graph, e.g. the instructions of a program,
+ * on several threads at once.
+ *
+ * The graph is built from the resources each node reads and writes, taken
+ * in the program order: a node depends on the last writer of everything it
+ * reads, and a writer also waits for the readers since the previous write.
+ * So any two nodes touching the same resource, unless both only read it,
+ * keep their program order, and the others may run concurrently.
+ *
+ * Run() dispatches `lanes` loops onto the thread pool of the calling thread.
+ * Each lane takes the ready node with the smallest index, runs it and
+ * releases its successors. A lane binds a pool of `intra_threads` of its own,
+ * so that the threads are split between the inter-op and the intra-op
+ * parallelism.
+ */
+class DagExecutor {
+ public:
+  // `reads[i]` and `writes[i]` are the resources of the i-th node.
+  void Build(const std::vector<std::vector<int>>& reads,
+             const std::vector<std::vector<int>>& writes);
+  void Clear();
+
+  size_t num_nodes() const { return num_deps_.size(); }
+  const std::vector<int>& successors(int node) const {
+    return successors_[node];
+  }
+  // The most nodes that may run at the same time, by the levels of the
+  // graph.
+  int width() const { return width_; }
+
+  // Runs `run_node(node)` for all the nodes and returns after the last one.
+  void Run(int lanes,
+           int intra_threads,
+           const std::function<void(int)>& run_node);
+
+ private:
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> num_deps_;
+  int width_{0};
+  int intra_threads_{0};
+  std::vector<std::shared_ptr<ThreadPool>> lane_pools_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,93 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/dag_executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(dag_executor, build) {
+  // 0: a = f(x)
+  // 1: b = g(x)
+  // 2: c = h(a, b)
+  // 3: x = k(c), reuses x after 0 and 1 read it
+  // 4: d = m(a)
+  DagExecutor dag;
+  const int x = 0, a = 1, b = 2, c = 3, d = 4;
+  dag.Build({{x}, {x}, {a, b}, {c}, {a}}, {{a}, {b}, {c}, {x}, {d}});
+  ASSERT_EQ(dag.num_nodes(), 5u);
+  EXPECT_EQ(dag.successors(0), std::vector<int>({2, 3, 4}));
+  EXPECT_EQ(dag.successors(1), std::vector<int>({2, 3}));
+  EXPECT_EQ(dag.successors(2), std::vector<int>({3}));
+  EXPECT_TRUE(dag.successors(3).empty());
+  // 0 and 1, then 2 and 4.
+  EXPECT_EQ(dag.width(), 2);
+}
+
+TEST(dag_executor, run) {
+  // Two chains of 8 nodes each writing its own resource, joined by the last
+  // node.
+  const int len = 8;
+  std::vector<std::vector<int>> reads, writes;
+  for (int chain = 0; chain < 2; chain++) {
+    for (int i = 0; i < len; i++) {
+      int res = chain * len + i;
+      reads.push_back(i ? std::vector<int>({res - 1}) : std::vector<int>());
+      writes.push_back({res});
+    }
+  }
+  reads.push_back({len - 1, 2 * len - 1});
+  writes.push_back({2 * len});
+  DagExecutor dag;
+  dag.Build(reads, writes);
+  EXPECT_EQ(dag.width(), 2);
+
+  auto pool = ThreadPool::Create(4);
+  ThreadPoolGuard guard(pool.get());
+  for (int lanes : {1, 2, 4}) {
+    std::vector<std::atomic<int>> done(reads.size());
+    for (auto& x : done) x = 0;
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    dag.Run(lanes, 2, [&](int node) {
+      for (int res : reads[node]) {
+        // The writer of every resource read is done.
+        EXPECT_EQ(done[res].load(), 1);
+      }
+      int now = ++running;
+      int prev = max_running.load();
+      while (now > prev && !max_running.compare_exchange_weak(prev, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      // The intra-op loops still run.
+      std::atomic<int> sum{0};
+      LITE_PARALLEL_BEGIN(i, tid, 16) { sum += i; }
+      LITE_PARALLEL_END();
+      EXPECT_EQ(sum.load(), 120);
+      running--;
+      done[node] = 1;
+    });
+    for (auto& x : done) EXPECT_EQ(x.load(), 1);
+    EXPECT_LE(max_running.load(), lanes);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
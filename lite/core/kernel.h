@@ -81,7 +81,9 @@ class KernelBase {
   }
 #endif
 
-  void Launch() {
+  // `shapes_unchanged` tells that the shapes of the inputs and the outputs are
+  // the same as the last launch, so that there is nothing to re-init.
+  void Launch(bool shapes_unchanged = false) {
     /// First run, init kernel, do weights transform once
     if (is_first_epoch_) {
       PrepareForRun();
@@ -89,7 +91,9 @@ class KernelBase {
     }
     /// re-init the kernel if needed (input shape should be checked in conv
     /// kernel)
-    ReInitWhenNeeded();
+    if (!shapes_unchanged) {
+      ReInitWhenNeeded();
+    }
 
     // Reset the workspace to make every kernel in the same thread to share the
     // temporary memory.
@@ -0,0 +1,172 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/timer.h"
+
+namespace paddle {
+namespace lite {
+
+// Every candidate runs once to warm up, then the best of a few runs counts.
+static const int kTuneRepeats = 3;
+
+KernelTuner& KernelTuner::Global() {
+  static KernelTuner* x = new KernelTuner;
+  return *x;
+}
+
+std::string KernelTuner::CpuModel() {
+  std::string model = "unknown";
+#if defined(__linux__)
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.find("model name") == 0 || line.find("Hardware") == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 2 <= line.size()) {
+        model = line.substr(pos + 2);
+      }
+      break;
+    }
+  }
+#endif
+  // The key is tab separated.
+  std::replace(model.begin(), model.end(), '\t', ' ');
+  return model;
+}
+
+void KernelTuner::Enable(bool enable, const std::string& file) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = enable;
+  if (!enable) return;
+  if (cpu_model_.empty()) cpu_model_ = CpuModel();
+  if (file != file_) {
+    file_ = file;
+    winners_.clear();
+    Load();
+  }
+}
+
+bool KernelTuner::enabled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return enabled_;
+}
+
+size_t KernelTuner::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return winners_.size();
+}
+
+std::string KernelTuner::Key(const std::string& signature) const {
+  return cpu_model_ + "\t" + std::to_string(ParallelThreadNum()) + "\t" +
+         signature;
+}
+
+std::string KernelTuner::Tune(const std::string& signature,
+                              const std::vector<std::string>& candidates,
+                              const std::function<void(int)>& run) {
+  CHECK(!candidates.empty()) << "No candidates to tune " << signature;
+  std::string key;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_ || candidates.size() == 1) return candidates.front();
+    key = Key(signature);
+    auto it = winners_.find(key);
+    if (it != winners_.end() &&
+        std::find(candidates.begin(), candidates.end(), it->second) !=
+            candidates.end()) {
+      VLOG(4) << "Tuned " << signature << ": " << it->second;
+      return it->second;
+    }
+  }
+
+  // Time the candidates without holding the lock, other kernels may be
+  // tuned by other predictors at the same time.
+  Timer timer;
+  int best = 0;
+  float best_ms = (std::numeric_limits<float>::max)();
+  for (size_t i = 0; i < candidates.size(); i++) {
+    run(static_cast<int>(i));
+    float ms = (std::numeric_limits<float>::max)();
+    for (int r = 0; r < kTuneRepeats; r++) {
+      timer.Start();
+      run(static_cast<int>(i));
+      ms = (std::min)(ms, timer.Stop());
+    }
+    VLOG(4) << "Tuning " << signature << ": " << candidates[i] << " takes "
+            << ms << " ms";
+    if (ms < best_ms) {
+      best_ms = ms;
+      best = static_cast<int>(i);
+    }
+  }
+  VLOG(3) << "Tuned " << signature << ": " << candidates[best];
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  winners_[key] = candidates[best];
+  Save();
+  return candidates[best];
+}
+
+// One winner per line: the cpu model, the number of threads, the op
+// signature and the winner, separated by tabs.
+void KernelTuner::Load() {
+  if (file_.empty()) return;
+  std::ifstream in(file_);
+  if (!in.is_open()) {
+    LOG(INFO) << "Not found the cpu tuning file: " << file_;
+    return;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    auto pos = line.rfind('\t');
+    if (line.empty() || pos == std::string::npos) continue;
+    winners_[line.substr(0, pos)] = line.substr(pos + 1);
+  }
+  LOG(INFO) << "Loaded " << winners_.size()
+            << " tuned kernels from the cpu tuning file: " << file_;
+}
+
+void KernelTuner::Save() {
+  if (file_.empty()) return;
+  // Write aside and rename, so that a reader never sees half of the file.
+  std::string tmp = file_ + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    if (!out.is_open()) {
+      LOG(WARNING) << "Failed to write the cpu tuning file: " << tmp;
+      return;
+    }
+    for (auto& it : winners_) {
+      out << it.first << "\t" << it.second << "\n";
+    }
+  }
+#ifdef _WIN32
+  // rename doesn't replace an existing file on windows.
+  std::remove(file_.c_str());
+#endif
+  if (std::rename(tmp.c_str(), file_.c_str()) != 0) {
+    LOG(WARNING) << "Failed to save the cpu tuning file: " << file_;
+    std::remove(tmp.c_str());
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,72 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Picks the algorithm of a CPU kernel by timing the candidates, the CPU
+ * counterpart of the OpenCL local work size tuning.
+ *
+ * A kernel with several algorithms for the same op, e.g. direct, depthwise
+ * and im2col+gemm convolutions, asks the tuner in PrepareForRun, where the
+ * real input shapes are known. The tuner runs every candidate on them and
+ * keeps the fastest. The winners are keyed by the CPU model, the number of
+ * threads and the op signature, and saved to the tuning file so that later
+ * loads on the same machine reuse them without timing anything.
+ */
+class KernelTuner {
+ public:
+  static KernelTuner& Global();
+
+  // Turns tuning on or off. The winners saved in `file` are loaded, and the
+  // new ones are added to it. An empty `file` keeps them in memory only.
+  void Enable(bool enable, const std::string& file = "");
+  bool enabled();
+
+  // Returns the fastest of `candidates` for the op of `signature`, running
+  // `run(i)` to time the i-th candidate if the op has not been tuned yet.
+  // The first candidate is returned if tuning is off.
+  std::string Tune(const std::string& signature,
+                   const std::vector<std::string>& candidates,
+                   const std::function<void(int)>& run);
+
+  // The number of tuned ops.
+  size_t size();
+
+  // The name of the CPU, part of the key of the winners.
+  static std::string CpuModel();
+
+ private:
+  std::string Key(const std::string& signature) const;
+  void Load();
+  void Save();
+
+  std::mutex mutex_;
+  bool enabled_{false};
+  std::string file_;
+  std::string cpu_model_;
+  std::map<std::string, std::string> winners_;
+};
+
+}  // namespace lite
+}  // namespace paddle
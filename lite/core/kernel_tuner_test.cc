@@ -0,0 +1,79 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <gtest/gtest.h>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <thread>  // NOLINT
+
+namespace paddle {
+namespace lite {
+
+static std::function<void(int)> Sleep(const std::vector<int>& us,
+                                      std::vector<int>* calls) {
+  calls->assign(us.size(), 0);
+  return [us, calls](int i) {
+    (*calls)[i]++;
+    std::this_thread::sleep_for(std::chrono::microseconds(us[i]));
+  };
+}
+
+TEST(kernel_tuner, tune) {
+  auto& tuner = KernelTuner::Global();
+  std::vector<int> calls;
+  // Off, the first candidate is the default.
+  tuner.Enable(false);
+  EXPECT_EQ(tuner.Tune("op0", {"a", "b"}, Sleep({5000, 100}, &calls)), "a");
+  EXPECT_EQ(calls[0] + calls[1], 0);
+
+  tuner.Enable(true);
+  std::vector<std::string> candidates{"a", "b", "c"};
+  EXPECT_EQ(tuner.Tune("op0", candidates, Sleep({5000, 100, 3000}, &calls)),
+            "b");
+  EXPECT_GT(calls[2], 0);
+  // Tuned once per op.
+  EXPECT_EQ(tuner.Tune("op0", candidates, Sleep({5000, 100, 3000}, &calls)),
+            "b");
+  EXPECT_EQ(calls[0] + calls[1] + calls[2], 0);
+  // A winner that is no longer a candidate is tuned again.
+  EXPECT_EQ(tuner.Tune("op0", {"a", "c"}, Sleep({5000, 100}, &calls)), "c");
+  EXPECT_GT(calls[0], 0);
+  tuner.Enable(false);
+}
+
+TEST(kernel_tuner, file) {
+  std::string file = "kernel_tuner_test.txt";
+  std::remove(file.c_str());
+  auto& tuner = KernelTuner::Global();
+  std::vector<int> calls;
+  tuner.Enable(true, file);
+  EXPECT_EQ(tuner.size(), 0u);
+  EXPECT_EQ(tuner.Tune("op1", {"a", "b"}, Sleep({3000, 100}, &calls)), "b");
+  EXPECT_EQ(tuner.Tune("op2", {"a", "b"}, Sleep({100, 3000}, &calls)), "a");
+
+  // Reloading the file, the winners are not timed again.
+  tuner.Enable(true, "");
+  EXPECT_EQ(tuner.size(), 0u);
+  tuner.Enable(true, file);
+  EXPECT_EQ(tuner.size(), 2u);
+  EXPECT_EQ(tuner.Tune("op1", {"a", "b"}, Sleep({100, 3000}, &calls)), "b");
+  EXPECT_EQ(tuner.Tune("op2", {"a", "b"}, Sleep({3000, 100}, &calls)), "a");
+  EXPECT_EQ(calls[0] + calls[1], 0);
+  tuner.Enable(false);
+  std::remove(file.c_str());
+}
+
+}  // namespace lite
+}  // namespace paddle
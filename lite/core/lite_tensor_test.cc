@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <cstring>
 #include "lite/core/tensor.h"
+#include "lite/utils/hash.h"
 
 namespace paddle {
 namespace lite {
@@ -53,5 +54,32 @@ TEST(tensor, shared_memory) {
   test_shared_memory_tensor<int8_t, TargetType::kHost>();
 }
 
+TEST(tensor, hash_shape) {
+  auto hash = [](const TensorLite& x) {
+    uint64_t res = kHashBytesSeed;
+    HashShape(x, &res);
+    return res;
+  };
+  TensorLite x, y;
+  x.Resize({2, 3});
+  y.Resize({2, 3});
+  EXPECT_EQ(hash(x), hash(y));
+  y.Resize({3, 2});
+  EXPECT_NE(hash(x), hash(y));
+  y.Resize({2, 3, 1});
+  EXPECT_NE(hash(x), hash(y));
+  y.Resize({2, 3});
+  y.set_lod({{0, 2}});
+  EXPECT_NE(hash(x), hash(y));
+  x.set_lod({{0, 1, 2}});
+  EXPECT_NE(hash(x), hash(y));
+  x.set_lod({{0, 2}});
+  EXPECT_EQ(hash(x), hash(y));
+  // The data doesn't matter.
+  x.mutable_data<float>()[0] = 1.f;
+  y.mutable_data<float>()[0] = 2.f;
+  EXPECT_EQ(hash(x), hash(y));
+}
+
 }  // namespace lite
 }  // namespace paddle
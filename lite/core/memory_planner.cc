@@ -0,0 +1,179 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <algorithm>
+#include <limits>
+
+namespace paddle {
+namespace lite {
+
+int MemoryPlanner::AddBlock(size_t size, int begin, int end) {
+  CHECK_LE(begin, end) << "Invalid lifetime [" << begin << ", " << end << "]";
+  size_t aligned = (size + alignment_ - 1) / alignment_ * alignment_;
+  blocks_.push_back({aligned, begin, end, 0});
+  return static_cast<int>(blocks_.size()) - 1;
+}
+
+size_t MemoryPlanner::Plan() {
+  std::vector<int> order(blocks_.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = static_cast<int>(i);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return blocks_[a].size > blocks_[b].size;
+  });
+
+  arena_size_ = 0;
+  naive_size_ = 0;
+  std::vector<int> placed;
+  std::vector<int> alive;
+  for (auto id : order) {
+    auto& block = blocks_[id];
+    naive_size_ += block.size;
+    // The placed blocks that are alive at the same time, by offset.
+    alive.clear();
+    for (auto other : placed) {
+      if (blocks_[other].begin <= block.end &&
+          block.begin <= blocks_[other].end) {
+        alive.push_back(other);
+      }
+    }
+    std::sort(alive.begin(), alive.end(), [&](int a, int b) {
+      return blocks_[a].offset < blocks_[b].offset;
+    });
+    // Pick the smallest gap that fits, or the end of the alive blocks.
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t prev_end = 0;
+    for (auto other : alive) {
+      auto& o = blocks_[other];
+      if (o.offset > prev_end) {
+        size_t gap = o.offset - prev_end;
+        if (gap >= block.size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = prev_end;
+        }
+      }
+      prev_end = (std::max)(prev_end, o.offset + o.size);
+    }
+    block.offset = best_gap == std::numeric_limits<size_t>::max()
+                       ? prev_end
+                       : best_offset;
+    arena_size_ = (std::max)(arena_size_, block.offset + block.size);
+    placed.push_back(id);
+  }
+  return arena_size_;
+}
+
+void MemoryPlanner::Clear() {
+  blocks_.clear();
+  arena_size_ = 0;
+  naive_size_ = 0;
+}
+
+size_t MemoryPlanner::offset(int id) const {
+  CHECK_LT(static_cast<size_t>(id), blocks_.size());
+  return blocks_[id].offset;
+}
+
+size_t MemoryPlanner::size(int id) const {
+  CHECK_LT(static_cast<size_t>(id), blocks_.size());
+  return blocks_[id].size;
+}
+
+struct ArenaStorage {
+  explicit ArenaStorage(size_t size)
+      : data(TargetMalloc(TARGET(kHost), size)) {}
+  ~ArenaStorage() { TargetFree(TARGET(kHost), data); }
+
+  void* data{nullptr};
+  bool expired{false};
+};
+
+namespace {
+
+// A non-owning view of one slot of the arena.
+class ArenaBuffer : public Buffer {
+ public:
+  ArenaBuffer(const std::shared_ptr<ArenaStorage>& storage,
+              size_t offset,
+              TargetType target,
+              size_t size)
+      : Buffer(static_cast<char*>(storage->data) + offset, target, size),
+        storage_(storage) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (storage_ && (target != target_ || space_ < size)) {
+      // Leave the arena and fall back to a buffer of its own.
+      storage_->expired = true;
+      storage_.reset();
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+    }
+    Buffer::ResetLazy(target, size);
+  }
+
+  void Free() override {
+    Buffer::Free();
+    if (storage_) {
+      storage_->expired = true;
+      storage_.reset();
+      own_data_ = true;
+    }
+  }
+
+ private:
+  std::shared_ptr<ArenaStorage> storage_;
+};
+
+}  // namespace
+
+void ActivationArena::Bind(const std::vector<Tensor*>& tensors,
+                           const std::vector<size_t>& sizes,
+                           const std::vector<std::pair<int, int>>& lifetimes) {
+  CHECK_EQ(tensors.size(), sizes.size());
+  CHECK_EQ(tensors.size(), lifetimes.size());
+  Release();
+  if (tensors.empty()) return;
+
+  MemoryPlanner planner;
+  for (size_t i = 0; i < tensors.size(); i++) {
+    planner.AddBlock(sizes[i], lifetimes[i].first, lifetimes[i].second);
+  }
+  arena_size_ = planner.Plan();
+  naive_size_ = planner.naive_size();
+  storage_ = std::make_shared<ArenaStorage>(arena_size_);
+  for (size_t i = 0; i < tensors.size(); i++) {
+    auto* tensor = tensors[i];
+    int id = static_cast<int>(i);
+    std::shared_ptr<Buffer> slot = std::make_shared<ArenaBuffer>(
+        storage_, planner.offset(id), tensor->target(), planner.size(id));
+    tensor->ResetBuffer(slot, tensor->memory_size());
+  }
+}
+
+void ActivationArena::Release() {
+  storage_.reset();
+  arena_size_ = 0;
+  naive_size_ = 0;
+}
+
+bool ActivationArena::expired() const {
+  return storage_ != nullptr && storage_->expired;
+}
+
+}  // namespace lite
+}  // namespace paddle
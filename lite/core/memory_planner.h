@@ -0,0 +1,97 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/memory.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * An offset planner for the activations of a program.
+ *
+ * Each block is described by its size in bytes and its lifetime [begin, end]
+ * over the instruction list. Two blocks whose lifetimes overlap must not
+ * overlap in memory. The blocks are placed from the largest to the smallest,
+ * each one into the tightest gap left between the already placed blocks that
+ * are alive at the same time (greedy by size with best fit), so that all of
+ * them fit into a single arena of arena_size() bytes.
+ */
+class MemoryPlanner {
+ public:
+  explicit MemoryPlanner(size_t alignment = host::MALLOC_ALIGN)
+      : alignment_(alignment) {}
+
+  // Add a block and return its id.
+  int AddBlock(size_t size, int begin, int end);
+  // Compute the offsets of all blocks and return the size of the arena.
+  size_t Plan();
+  void Clear();
+
+  size_t num_blocks() const { return blocks_.size(); }
+  size_t offset(int id) const;
+  size_t size(int id) const;
+  size_t arena_size() const { return arena_size_; }
+  // The bytes needed if every block owned its own allocation.
+  size_t naive_size() const { return naive_size_; }
+
+ private:
+  struct Block {
+    size_t size;
+    int begin;
+    int end;
+    size_t offset;
+  };
+
+  size_t alignment_;
+  std::vector<Block> blocks_;
+  size_t arena_size_{0};
+  size_t naive_size_{0};
+};
+
+struct ArenaStorage;
+
+/*
+ * Binds a set of host tensors to the slots of one arena planned by
+ * MemoryPlanner. The tensors keep working as usual: a tensor that needs more
+ * memory than its slot (e.g. the input shape grows) silently moves to its own
+ * allocation and marks the arena as expired, so that the caller can plan it
+ * again with the new sizes.
+ */
+class ActivationArena {
+ public:
+  void Bind(const std::vector<Tensor*>& tensors,
+            const std::vector<size_t>& sizes,
+            const std::vector<std::pair<int, int>>& lifetimes);
+  // Drop the arena, it is freed once the bound tensors are cleared or rebound.
+  void Release();
+
+  bool empty() const { return storage_ == nullptr; }
+  bool expired() const;
+  size_t arena_size() const { return arena_size_; }
+  size_t naive_size() const { return naive_size_; }
+
+ private:
+  std::shared_ptr<ArenaStorage> storage_;
+  size_t arena_size_{0};
+  size_t naive_size_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
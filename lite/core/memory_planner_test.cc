@@ -0,0 +1,124 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace paddle {
+namespace lite {
+
+static void CheckNoConflict(const MemoryPlanner& planner,
+                            const std::vector<std::pair<int, int>>& lifetimes) {
+  for (size_t i = 0; i < planner.num_blocks(); i++) {
+    EXPECT_LE(planner.offset(i) + planner.size(i), planner.arena_size());
+    for (size_t j = i + 1; j < planner.num_blocks(); j++) {
+      bool alive = lifetimes[i].first <= lifetimes[j].second &&
+                   lifetimes[j].first <= lifetimes[i].second;
+      bool overlap = planner.offset(i) < planner.offset(j) + planner.size(j) &&
+                     planner.offset(j) < planner.offset(i) + planner.size(i);
+      EXPECT_FALSE(alive && overlap) << "block " << i << " vs " << j;
+    }
+  }
+}
+
+TEST(memory_planner, chain) {
+  // A chain of ops where each output only lives until the next op.
+  MemoryPlanner planner(64);
+  std::vector<std::pair<int, int>> lifetimes;
+  std::vector<size_t> sizes = {4096, 1024, 8192, 512, 2048};
+  for (size_t i = 0; i < sizes.size(); i++) {
+    lifetimes.emplace_back(i, i + 1);
+    planner.AddBlock(sizes[i], i, i + 1);
+  }
+  planner.Plan();
+  CheckNoConflict(planner, lifetimes);
+  EXPECT_EQ(planner.naive_size(), 15872u);
+  // The peak is the largest pair of neighbouring tensors.
+  EXPECT_EQ(planner.arena_size(), 8192u + 1024u);
+}
+
+TEST(memory_planner, alignment) {
+  MemoryPlanner planner(64);
+  planner.AddBlock(1, 0, 0);
+  planner.AddBlock(65, 0, 0);
+  planner.Plan();
+  EXPECT_EQ(planner.size(0), 64u);
+  EXPECT_EQ(planner.size(1), 128u);
+  EXPECT_EQ(planner.offset(0) % 64, 0u);
+  EXPECT_EQ(planner.offset(1) % 64, 0u);
+  EXPECT_EQ(planner.arena_size(), 192u);
+}
+
+TEST(memory_planner, random) {
+  std::mt19937 rng(7);
+  for (int round = 0; round < 20; round++) {
+    MemoryPlanner planner;
+    std::vector<std::pair<int, int>> lifetimes;
+    for (int i = 0; i < 200; i++) {
+      int begin = rng() % 100;
+      int end = begin + rng() % 10;
+      lifetimes.emplace_back(begin, end);
+      planner.AddBlock(1 + rng() % 100000, begin, end);
+    }
+    planner.Plan();
+    CheckNoConflict(planner, lifetimes);
+    EXPECT_LE(planner.arena_size(), planner.naive_size());
+  }
+}
+
+TEST(activation_arena, bind) {
+  Tensor a, b, c;
+  a.Resize({1024});
+  b.Resize({256});
+  c.Resize({1024});
+  a.mutable_data<float>(TARGET(kHost));
+  b.mutable_data<float>(TARGET(kHost));
+  c.mutable_data<float>(TARGET(kHost));
+
+  // a and c are never alive at the same time, so they share one slot.
+  ActivationArena arena;
+  arena.Bind({&a, &b, &c},
+             {a.memory_size(), b.memory_size(), c.memory_size()},
+             {{0, 1}, {1, 2}, {2, 3}});
+  EXPECT_EQ(arena.naive_size(), 9216u);
+  EXPECT_EQ(arena.arena_size(), 5120u);
+  EXPECT_EQ(a.data<float>(), c.data<float>());
+  EXPECT_NE(a.data<float>(), b.data<float>());
+  EXPECT_EQ(a.target(), TARGET(kHost));
+  EXPECT_FALSE(arena.expired());
+
+  // Shrinking stays in the slot, growing leaves the arena.
+  auto* data = a.mutable_data<float>();
+  a.Resize({512});
+  EXPECT_EQ(a.mutable_data<float>(), data);
+  EXPECT_FALSE(arena.expired());
+  b.Resize({2048});
+  b.mutable_data<float>();
+  EXPECT_TRUE(arena.expired());
+  for (int i = 0; i < 2048; i++) {
+    b.mutable_data<float>()[i] = i;
+  }
+  EXPECT_EQ(b.data<float>()[2047], 2047.f);
+
+  // Clearing a tensor gives its slot back as well.
+  arena.Bind({&a, &c}, {a.memory_size(), c.memory_size()}, {{0, 1}, {2, 3}});
+  EXPECT_FALSE(arena.expired());
+  c.clear();
+  EXPECT_TRUE(arena.expired());
+  EXPECT_NE(c.mutable_data<float>(), nullptr);
+}
+
+}  // namespace lite
+}  // namespace paddle
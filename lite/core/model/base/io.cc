@@ -13,6 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/model/base/io.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -41,7 +47,8 @@ std::string ByteReader::ReadToString(size_t size) const {
   return tmp;
 }
 
-BinaryFileReader::BinaryFileReader(const std::string& path, size_t offset) {
+BinaryFileReader::BinaryFileReader(const std::string& path, size_t offset)
+    : offset_(offset) {
   file_ = fopen(path.c_str(), "rb");
   CHECK(file_) << "Unable to open file: " << path;
   fseek(file_, 0L, SEEK_END);
@@ -56,6 +63,90 @@ void BinaryFileReader::Read(void* dst, size_t size) const {
   cur_ += size;
 }
 
+void BinaryFileReader::ReadAt(void* dst, size_t size, size_t pos) const {
+  CHECK(dst);
+  CHECK_LE(pos + size, length_) << "Failed to read " << size << " bytes.";
+#if !defined(_WIN32)
+  int fd = fileno(file_);
+  char* out = static_cast<char*>(dst);
+  while (size > 0) {
+    ssize_t n = pread(fd, out, size, offset_ + pos);
+    CHECK_GT(n, 0) << "Failed to read " << size << " bytes.";
+    out += n;
+    pos += n;
+    size -= n;
+  }
+#else
+  std::lock_guard<std::mutex> lock(mutex_);
+  fseek(file_, offset_ + pos, SEEK_SET);
+  CHECK_EQ(fread(dst, 1, size, file_), size) << "Failed to read " << size
+                                             << " bytes.";
+  fseek(file_, offset_ + cur_, SEEK_SET);
+#endif
+}
+
+MappedFile::MappedFile(const std::string& path) {
+#if !defined(_WIN32)
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Unable to open file: " << path;
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file: " << path;
+  length_ = static_cast<size_t>(st.st_size);
+  if (length_ > 0) {
+    void* addr = mmap(
+        nullptr, length_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    CHECK(addr != MAP_FAILED) << "Unable to map file: " << path;
+    data_ = static_cast<char*>(addr);
+    mapped_ = true;
+  }
+  close(fd);
+#else
+  BinaryFileReader reader(path);
+  length_ = reader.length();
+  data_ = static_cast<char*>(TargetMalloc(TARGET(kHost), length_ + 1));
+  reader.Read(data_, length_);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+  if (mapped_) {
+    munmap(data_, length_);
+  }
+#else
+  TargetFree(TARGET(kHost), data_);
+#endif
+}
+
+MmapFileReader::MmapFileReader(const std::string& path, size_t offset)
+    : file_(std::make_shared<MappedFile>(path)) {
+  CHECK_LE(offset, file_->length());
+  buf_ = file_->data() + offset;
+  length_ = file_->length() - offset;
+}
+
+void MmapFileReader::Read(void* dst, size_t size) const {
+  CHECK(dst);
+  lite::TargetCopy(TargetType::kHost, dst, ReadView(size), size);
+}
+
+void MmapFileReader::ReadAt(void* dst, size_t size, size_t pos) const {
+  CHECK(dst);
+  lite::TargetCopy(TargetType::kHost, dst, ViewAt(pos, size), size);
+}
+
+const void* MmapFileReader::ViewAt(size_t pos, size_t size) const {
+  CHECK_LE(pos + size, length_) << "Failed to read " << size << " bytes.";
+  return buf_ + pos;
+}
+
+const void* MmapFileReader::ReadView(size_t size) const {
+  CHECK_LE(cur_ + size, length_) << "Failed to read " << size << " bytes.";
+  const char* view = buf_ + cur_;
+  cur_ += size;
+  return view;
+}
+
 void BinaryFileWriter::Write(const void* src, size_t size) const {
   CHECK(src);
   CHECK_EQ(fwrite(src, 1, size, file_), size) << "Failed to read " << size
@@ -69,12 +160,24 @@ void StringBufferReader::Read(void* dst, size_t size) const {
   cur_ += size;
 }
 
+void StringBufferReader::ReadAt(void* dst, size_t size, size_t pos) const {
+  CHECK(dst);
+  CHECK_LE(pos + size, length_) << "Failed to read " << size << " bytes.";
+  lite::TargetCopy(TargetType::kHost, dst, buf_ + pos, size);
+}
+
 void CharBufferReader::Read(void* dst, size_t size) const {
   CHECK(dst);
   lite::TargetCopy(TargetType::kHost, dst, buf_ + cur_, size);
   cur_ += size;
 }
 
+void CharBufferReader::ReadAt(void* dst, size_t size, size_t pos) const {
+  CHECK(dst);
+  CHECK_LE(pos + size, length_) << "Failed to read " << size << " bytes.";
+  lite::TargetCopy(TargetType::kHost, dst, buf_ + pos, size);
+}
+
 }  // namespace model_parser
 }  // namespace lite
 }  // namespace paddle
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
 #include "lite/core/memory.h"
@@ -90,6 +91,20 @@ class ByteReader {
   virtual size_t current() const = 0;
   virtual bool ReachEnd() const = 0;
 
+  // Readers backed by memory that outlives them, such as a mapped file,
+  // return the address of the next `size` bytes and skip them. The others
+  // return nullptr and the data has to be copied out with Read().
+  virtual const void* ReadView(size_t size) const { return nullptr; }
+  // The owner of the memory returned by ReadView, keep it to use the memory
+  // after the reader is destroyed.
+  virtual std::shared_ptr<void> view_holder() const { return nullptr; }
+  // Like ReadView, but for the `size` bytes at position `pos` and without
+  // moving the cursor.
+  virtual const void* ViewAt(size_t pos, size_t size) const { return nullptr; }
+  // Copy the `size` bytes at position `pos` without moving the cursor. It may
+  // be called from several threads at the same time.
+  virtual void ReadAt(void* dst, size_t size, size_t pos) const = 0;
+
   template <
       typename T,
       typename = typename std::enable_if<LITE_IS_TRIVIALLY_COPYABLE(T)>::type>
@@ -124,6 +139,8 @@ class ByteWriter {
   }
 
   virtual size_t Align(size_t bytes_size) const = 0;
+  // The number of bytes written so far.
+  virtual size_t current() const = 0;
 
   virtual ~ByteWriter() = default;
 
@@ -141,12 +158,59 @@ class BinaryFileReader : public ByteReader {
     }
   }
   void Read(void* dst, size_t size) const override;
+  void ReadAt(void* dst, size_t size, size_t pos) const override;
   bool ReachEnd() const override { return cur_ >= length_; }
   size_t length() const override { return length_; }
   size_t current() const override { return cur_; }
 
  private:
   FILE* file_{};
+  size_t offset_{0};
+  size_t length_{0};
+  mutable size_t cur_{0};
+#if defined(_WIN32)
+  // ReadAt has to move the shared file position.
+  mutable std::mutex mutex_;
+#endif
+};
+
+// A read-only view of a whole file. It is mapped into memory where mmap is
+// available: the pages are mapped private, so that the processes loading the
+// same model share one page-cached copy of it, and the few pages written by a
+// process are copied on write instead of changing the file. Elsewhere the file
+// is read into memory.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  char* data() const { return data_; }
+  size_t length() const { return length_; }
+
+ private:
+  char* data_{nullptr};
+  size_t length_{0};
+  bool mapped_{false};
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+class MmapFileReader : public ByteReader {
+ public:
+  explicit MmapFileReader(const std::string& path, size_t offset = 0);
+  void Read(void* dst, size_t size) const override;
+  void ReadAt(void* dst, size_t size, size_t pos) const override;
+  const void* ReadView(size_t size) const override;
+  const void* ViewAt(size_t pos, size_t size) const override;
+  std::shared_ptr<void> view_holder() const override { return file_; }
+  bool ReachEnd() const override { return cur_ >= length_; }
+  size_t length() const override { return length_; }
+  size_t current() const override { return cur_; }
+
+ private:
+  std::shared_ptr<MappedFile> file_;
+  const char* buf_{nullptr};
   size_t length_{0};
   mutable size_t cur_{0};
 };
@@ -174,6 +238,8 @@ class BinaryFileWriter : public ByteWriter {
     return padding_bytes;
   }
 
+  size_t current() const override { return cur_; }
+
  private:
   FILE* file_{};
   mutable size_t cur_{0};
@@ -193,6 +259,7 @@ class StringBufferReader : public ByteReader {
   }
   ~StringBufferReader() = default;
   void Read(void* dst, size_t size) const override;
+  void ReadAt(void* dst, size_t size, size_t pos) const override;
   bool ReachEnd() const override { return cur_ >= length_; }
   size_t length() const override { return length_; }
   size_t current() const override { return cur_; }
@@ -212,6 +279,7 @@ class CharBufferReader : public ByteReader {
   }
   ~CharBufferReader() = default;
   void Read(void* dst, size_t size) const override;
+  void ReadAt(void* dst, size_t size, size_t pos) const override;
   bool ReachEnd() const override { return cur_ >= length_; }
   size_t length() const override { return length_; }
   size_t current() const override { return cur_; }
@@ -18,48 +18,40 @@
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/utils/hash.h"
 #include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
 
+uint64_t OpLite::InputShapeHash() const {
+  uint64_t hash = kHashBytesSeed;
+  for (auto *tensor : input_tensor_ptrs_cache_) {
+    HashShape(*tensor, &hash);
+  }
+  return hash;
+}
+
 bool OpLite::InferShape() {
-  auto UseCache = [&, this]() -> bool {
-    if (last_input_shapes_.empty()) {
-      return false;
-    }
-    if (last_input_shapes_.size() == input_tensor_ptrs_cache_.size()) {
-      for (size_t i = 0; i < input_tensor_ptrs_cache_.size(); i++) {
-        if (last_input_shapes_[i] != input_tensor_ptrs_cache_[i]->dims() ||
-            last_input_lods_[i] != input_tensor_ptrs_cache_[i]->lod()) {
-          return false;
-        }
-      }
-      return true;
-    }
-    return false;
-  };
-  if (InferShapeWithCache() && UseCache()) {
+  if (!InferShapeWithCache()) {
+    return this->InferShapeImpl();
+  }
+  uint64_t input_hash = InputShapeHash();
+  if (has_last_input_hash_ && input_hash == last_input_hash_) {
     for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
       output_tensor_ptrs_cache_[i]->Resize(last_output_shapes_[i]);
       output_tensor_ptrs_cache_[i]->set_lod(last_output_lods_[i]);
     }
   } else {
     this->InferShapeImpl();
-    if (InferShapeWithCache()) {
-      last_output_shapes_.clear();
-      last_output_lods_.clear();
-      for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
-        last_output_shapes_.push_back(output_tensor_ptrs_cache_[i]->dims());
-        last_output_lods_.push_back(output_tensor_ptrs_cache_[i]->lod());
-      }
-      last_input_shapes_.clear();
-      last_input_lods_.clear();
-      for (size_t i = 0; i < input_tensor_ptrs_cache_.size(); i++) {
-        last_input_shapes_.push_back(input_tensor_ptrs_cache_[i]->dims());
-        last_input_lods_.push_back(input_tensor_ptrs_cache_[i]->lod());
-      }
+    last_output_shapes_.clear();
+    last_output_lods_.clear();
+    for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
+      last_output_shapes_.push_back(output_tensor_ptrs_cache_[i]->dims());
+      last_output_lods_.push_back(output_tensor_ptrs_cache_[i]->lod());
     }
+    has_last_input_hash_ = true;
+    last_input_hash_ = input_hash;
   }
   return true;
 }
@@ -23,6 +23,7 @@
 #include <vector>
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
+#include "lite/core/profile/profiler.h"
 #include "lite/core/scope.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/op_params.h"
@@ -80,9 +81,8 @@ class OpLite : public Registry {
   // Indicate whether the Op runs only once or not
   virtual bool run_once() const { return false; }
   std::string Type() const { return op_type_; }
-#ifdef LITE_WITH_PROFILE
+  // Describe the last run, e.g. the shapes and the FLOPs, for the profilers.
   virtual void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {}
-#endif
 
   // Link the external execution environ to internal context.
   bool Attach(const cpp::OpDesc &opdesc, lite::Scope *scope);
@@ -194,11 +194,10 @@ class OpLite : public Registry {
   std::vector<Tensor *> output_tensor_ptrs_cache_{};
 
  private:
-  // todo: it's prefered to combine last_input_shapes and
-  // last_input_lods into a single hash value to decrease
-  // memory usage.
-  std::vector<DDimLite> last_input_shapes_{};
-  std::vector<LoD> last_input_lods_{};
+  // The hash of the dims and LoDs of all the inputs in the last inference.
+  uint64_t InputShapeHash() const;
+  bool has_last_input_hash_{false};
+  uint64_t last_input_hash_{0};
   std::vector<DDimLite> last_output_shapes_{};
   std::vector<LoD> last_output_lods_{};
 };
@@ -26,11 +26,20 @@ namespace mir {
 void TransformerAttentionFusePass::Apply(
     const std::unique_ptr<SSAGraph>& graph) {
   bool has_int8 = false;
+  bool has_arm = false;
+  bool has_x86 = false;
   for (auto& place : graph->valid_places()) {
     if (place.precision == PRECISION(kInt8)) {
       has_int8 = true;
     }
+    if (place.target == TARGET(kARM)) {
+      has_arm = true;
+    } else if (place.target == TARGET(kX86)) {
+      has_x86 = true;
+    }
   }
+  // arm has the int8 kernel and x86 the fp32 one
+  bool enable = has_int8 ? has_arm : has_x86;
   std::vector<bool> reshape_has_xshapes = {false, true};
   std::vector<bool> transpose_has_xshapes = {false, true};
   std::vector<bool> dropout_masks = {false, true};
@@ -41,7 +50,7 @@ void TransformerAttentionFusePass::Apply(
         for (auto mul_type : mul_types) {
           fusion::TransformerAttentionFuser fuser(
               reshape_has_xshape, transpose_has_xshape, dropout_mask, mul_type);
-          if ((has_int8)) {
+          if (enable) {
             fuser(graph.get());
           }
         }
@@ -56,7 +65,7 @@ void TransformerAttentionFusePass::Apply(
 
 REGISTER_MIR_PASS(transformer_attention_fuse_pass,
                   paddle::lite::mir::TransformerAttentionFusePass)
-    .BindTargets({TARGET(kARM)})
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
     .ExcludeTargets(
         {TARGET(kXPU), TARGET(kOpenCL), TARGET(kMetal), TARGET(kNNAdapter)})
     .BindKernel("fused_attention");
@@ -468,6 +468,26 @@ void TransformerAttentionFuser::InsertNewNode(SSAGraph* graph,
                             weight0_dims[1]);
     ComputeNewBias(&bias_tensor, bias0_t, bias1_t, bias2_t, bias0_dims[0]);
     op_desc.SetAttr<float>("scale", scale0_scale);
+    // dropout scales its output by 1 - dropout_prob in inference unless it
+    // is upscale_in_train, so v = fc2 is scaled instead
+    auto dropout_op_desc = matched.at("dropout")->stmt()->op_info();
+    if (!dropout_op_desc->HasAttr("dropout_implementation") ||
+        dropout_op_desc->GetAttr<std::string>("dropout_implementation") !=
+            "upscale_in_train") {
+      float dropout_scale =
+          1.f - dropout_op_desc->GetAttr<float>("dropout_prob");
+      int iw = weight0_dims[1];
+      float* fuse_weights = weight_tensor.mutable_data<float>();
+      for (int h = 0; h < weight0_dims[0]; h++) {
+        for (int w = 2 * iw; w < 3 * iw; w++) {
+          fuse_weights[h * 3 * iw + w] *= dropout_scale;
+        }
+      }
+      float* fuse_bias = bias_tensor.mutable_data<float>();
+      for (int w = 2 * iw; w < 3 * iw; w++) {
+        fuse_bias[w] *= dropout_scale;
+      }
+    }
   }
   // update weight bias
   weight0_t->Resize({weight0_dims[0], weight0_dims[1] * 3});
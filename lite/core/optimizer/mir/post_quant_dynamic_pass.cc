@@ -163,9 +163,32 @@ void PostQuantDynamicPerChannel(OpInfo* op_info,
   op_info->SetAttr(weight_name + "_quant_scale", scales);
 }
 
+// The fc ops the x86 kernel can run with int8 weights, see FcCompute.
+static bool IsX86DynamicQuantFc(mir::Node* node) {
+  auto& stmt = node->AsStmt();
+  if (stmt.op_type() != "fc") {
+    return false;
+  }
+  const auto& kernel = stmt.picked_kernel();
+  if (kernel.target() != TARGET(kX86) ||
+      kernel.precision() != PRECISION(kFloat)) {
+    return false;
+  }
+  const auto* op_info = stmt.op_info();
+  if (op_info->HasAttr("padding_weights") &&
+      op_info->GetAttr<bool>("padding_weights")) {
+    return false;
+  }
+  std::string act_type = op_info->HasAttr("activation_type")
+                             ? op_info->GetAttr<std::string>("activation_type")
+                             : "";
+  return act_type.empty() || act_type == "relu";
+}
+
 void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   int quant_bits = 16;
-  if (quant_type_ == lite_api::QuantType::QUANT_INT8) {
+  bool dynamic = quant_type_ == lite_api::QuantType::QUANT_INT8_DYNAMIC;
+  if (quant_type_ == lite_api::QuantType::QUANT_INT8 || dynamic) {
     quant_bits = 8;
   } else if (quant_type_ == lite_api::QuantType::QUANT_INT16) {
     quant_bits = 16;
@@ -188,6 +211,24 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     const std::string op_type = node->stmt()->op_type();
     OpInfo* op_info = node->stmt()->mutable_op_info();
     auto* scope = node->stmt()->op()->scope();
+    if (dynamic && IsX86DynamicQuantFc(node)) {
+      // only W is quantized, the bias is added to the fp32 output
+      std::string weight_name = op_info->Input("W").front();
+      Tensor* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+      if (weight->precision() != PrecisionType::kFloat) {
+        LOG(INFO) << "The dtype of weight is not fp32, "
+                  << "so skip quantizing the weight of " << weight_name;
+        continue;
+      }
+      PostQuantDynamicPerChannel(op_info, weight, weight_name, 1, 8);
+      op_info->SetAttr<std::string>("quantization_type",
+                                    "post_dynamic_channel_wise_abs_max");
+      // the op and the kernel are attached already, refresh their params
+      auto op_desc = *op_info;
+      node->stmt()->op()->Attach(op_desc, scope);
+      node->stmt()->op()->AttachKernel(&(node->stmt()->picked_kernel()));
+      continue;
+    }
     for (auto* in_node : node->inlinks) {
       CHECK(in_node->IsArg()) << "The input node should be variable.";
       if (in_node->arg()->is_weight) {
@@ -30,6 +30,10 @@ namespace mir {
  * weights to int8/16. So the size of the quantized weights is reduced 4x/2x.
  * In inference stage, the quantized weights are dequantized to fp32 and run
  * all ops to get output.
+ * With QUANT_INT8_DYNAMIC, the weights of the fc ops picked for x86 stay int8
+ * at inference: they are marked with quantization_type
+ * "post_dynamic_channel_wise_abs_max", and the kernel quantizes its input per
+ * row at runtime and runs an int8 gemm. The other ops fall back to QUANT_INT8.
  */
 class PostQuantDynamicPass : public ProgramPass {
  public:
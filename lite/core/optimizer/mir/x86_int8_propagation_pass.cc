@@ -0,0 +1,139 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/x86_int8_propagation_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static bool IsInt8(Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  return op_info->HasAttr("enable_int8") &&
+         op_info->GetAttr<bool>("enable_int8");
+}
+
+bool X86Int8PropagationPass::IsCandidate(Node* node) const {
+  // the activation inputs of each op which has an x86 int8 kernel
+  static const std::map<std::string, std::vector<std::string>> kInt8Inputs{
+      {"pool2d", {"X"}},
+      {"elementwise_add", {"X", "Y"}},
+      {"elementwise_mul", {"X", "Y"}},
+      {"concat", {"X"}},
+      {"matmul", {"X", "Y"}},
+      {"matmul_v2", {"X", "Y"}}};
+  auto* op_info = node->stmt()->op_info();
+  auto iter = kInt8Inputs.find(op_info->Type());
+  if (iter == kInt8Inputs.end() || op_info->HasAttr("enable_int8")) {
+    return false;
+  }
+  const std::string& op_type = op_info->Type();
+  if (op_type == "pool2d") {
+    auto pooling_type = op_info->GetAttr<std::string>("pooling_type");
+    if (pooling_type != "max" && pooling_type != "avg") return false;
+    if (op_info->GetAttr<std::vector<int>>("ksize").size() != 2) return false;
+    if (op_info->HasAttr("adaptive") && op_info->GetAttr<bool>("adaptive")) {
+      return false;
+    }
+    if (op_info->HasAttr("data_format") &&
+        op_info->GetAttr<std::string>("data_format") == "NHWC") {
+      return false;
+    }
+  }
+  if (op_type.find("elementwise") == 0 && op_info->HasAttr("fuse_scale") &&
+      op_info->GetAttr<bool>("fuse_scale")) {
+    return false;
+  }
+  // e.g. the AxisTensor of concat
+  for (auto& arg_name : op_info->InputArgumentNames()) {
+    if (std::find(iter->second.begin(), iter->second.end(), arg_name) ==
+            iter->second.end() &&
+        !op_info->Input(arg_name).empty()) {
+      return false;
+    }
+  }
+  for (auto* in : node->inlinks) {
+    if (!in->IsArg()) continue;
+    if (in->arg()->is_weight || in->arg()->is_persist) return false;
+    if (!op_info->HasInputScale(in->arg()->name)) return false;
+  }
+  return true;
+}
+
+bool X86Int8PropagationPass::HasInt8Neighbor(Node* node) const {
+  for (auto* in : node->inlinks) {
+    for (auto* producer : in->inlinks) {
+      if (producer->IsStmt() && IsInt8(producer)) return true;
+    }
+  }
+  for (auto* out : node->outlinks) {
+    for (auto* consumer : out->outlinks) {
+      if (consumer->IsStmt() && IsInt8(consumer)) return true;
+    }
+  }
+  return false;
+}
+
+void X86Int8PropagationPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  const auto& valid_places = graph->valid_places();
+  if (std::none_of(
+          valid_places.begin(), valid_places.end(), [](const Place& place) {
+            return place.target == TARGET(kX86) &&
+                   place.precision == PRECISION(kInt8);
+          })) {
+    return;
+  }
+
+  std::vector<Node*> candidates;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (node->IsStmt() && IsCandidate(node)) {
+      candidates.push_back(node);
+    }
+  }
+
+  // marking an op can give an int8 neighbour to one seen before it
+  std::set<Node*> marked;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto* node : candidates) {
+      if (marked.count(node) || !HasInt8Neighbor(node)) continue;
+      node->stmt()->mutable_op_info()->SetAttr("enable_int8", true);
+      marked.insert(node);
+      changed = true;
+    }
+  }
+
+  // the ops read enable_int8 and the scales when they are attached
+  for (auto* node : marked) {
+    VLOG(4) << "run " << node->stmt()->op_type() << " in int8";
+    auto op_info = *node->stmt()->op_info();
+    node->stmt()->ResetOp(op_info, valid_places);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(x86_int8_propagation_pass,
+                  paddle::lite::mir::X86Int8PropagationPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,49 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * The quantization fusers only set enable_int8 on the ops with weights
+ * (conv, fc, mul, matmul), so a pool2d, elementwise_add/mul or concat between
+ * two of them still runs in fp32 and type_precision_cast_pass puts a calib op
+ * on each side. When (kX86, kInt8) is a valid place, this pass sets
+ * enable_int8 on those ops if all their inputs carry a scale and a producer
+ * of an input or a consumer of the output is already int8, repeated until
+ * nothing changes. static_kernel_pick_pass then picks their int8 kernels and
+ * the calib ops only stay at the borders of the int8 region.
+ */
+class X86Int8PropagationPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // The op has an x86 int8 kernel for its attributes and all its inputs are
+  // quantized activations.
+  bool IsCandidate(Node* node) const;
+
+  bool HasInt8Neighbor(Node* node) const;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
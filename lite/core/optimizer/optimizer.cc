@@ -237,6 +237,8 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "__xpu__matmul_scale_softmax_v1_fuse_pass",
        "__xpu__up_decoder_fuse_pass",
        "__xpu__multi_up_decoder_fuse_pass",
+       // run pool2d, elementwise, concat and matmul between int8 ops in int8
+       "x86_int8_propagation_pass",
        // pick original kernel from graph (exclude xpu)
        "static_kernel_pick_pass",
        // xpu pick original kernel from graph
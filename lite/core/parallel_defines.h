@@ -49,7 +49,9 @@
   paddle::lite::ThreadPool::Enqueue(std::move(task)); \
   }
 
-#elif defined(ARM_WITH_OMP)
+#elif defined(ARM_WITH_OMP) || \
+    (defined(PADDLE_WITH_MKLML) && !defined(_WIN32) && !defined(__APPLE__))
+// x86 builds with MKLML are compiled with -fopenmp (see configure.cmake)
 #include <omp.h>
 
 #define LITE_PARALLEL_BEGIN(index, tid, work_size)                     \
@@ -71,3 +73,22 @@
   for (int index = (start); index < (end); index += (step)) {
 #define LITE_PARALLEL_COMMON_END() }
 #endif
+
+namespace paddle {
+namespace lite {
+
+// The number of threads the LITE_PARALLEL loops of the calling thread run on.
+inline int ParallelThreadNum() {
+#ifdef LITE_USE_THREAD_POOL
+  auto* pool = ThreadPool::Current();
+  return pool ? pool->thread_num() : 1;
+#elif defined(ARM_WITH_OMP) || \
+    (defined(PADDLE_WITH_MKLML) && !defined(_WIN32) && !defined(__APPLE__))
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,144 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/perf_counters.h"
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+#if defined(__linux__)
+static int OpenCounter(uint64_t config, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // The calling thread on any cpu.
+  return static_cast<int>(
+      syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+bool PerfCounters::Open() {
+  if (is_open()) return true;
+#if defined(__linux__)
+  group_fd_ = OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (group_fd_ < 0) {
+    LOG(WARNING) << "Failed to open the hardware counters: "
+                 << strerror(errno)
+                 << ", check /proc/sys/kernel/perf_event_paranoid";
+    return false;
+  }
+  const uint64_t configs[3] = {PERF_COUNT_HW_INSTRUCTIONS,
+                               PERF_COUNT_HW_CACHE_MISSES,
+                               PERF_COUNT_HW_BRANCH_MISSES};
+  for (int i = 0; i < 3; i++) {
+    fds_[i] = OpenCounter(configs[i], group_fd_);
+    if (fds_[i] < 0) {
+      LOG(WARNING) << "Failed to open the hardware counters: "
+                   << strerror(errno);
+      Close();
+      return false;
+    }
+  }
+  return true;
+#else
+  LOG(WARNING) << "The hardware counters are only supported on Linux";
+  return false;
+#endif
+}
+
+void PerfCounters::Close() {
+#if defined(__linux__)
+  for (auto& fd : fds_) {
+    if (fd >= 0) close(fd);
+    fd = -1;
+  }
+  if (group_fd_ >= 0) close(group_fd_);
+#endif
+  group_fd_ = -1;
+}
+
+void PerfCounters::Enable() {
+#if defined(__linux__)
+  if (!is_open()) return;
+  ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void PerfCounters::Disable() {
+#if defined(__linux__)
+  if (!is_open()) return;
+  ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+bool PerfCounters::Read(PerfCounterValues* values) const {
+#if defined(__linux__)
+  if (!is_open()) return false;
+  // nr, time_enabled, time_running and the values in the order opened.
+  uint64_t data[3 + 4];
+  if (read(group_fd_, data, sizeof(data)) !=
+          static_cast<ssize_t>(sizeof(data)) ||
+      data[0] != 4) {
+    return false;
+  }
+  double scale = 1.;
+  if (data[2] > 0 && data[2] < data[1]) {
+    scale = static_cast<double>(data[1]) / data[2];
+  }
+  values->cycles = static_cast<uint64_t>(data[3] * scale);
+  values->instructions = static_cast<uint64_t>(data[4] * scale);
+  values->cache_misses = static_cast<uint64_t>(data[5] * scale);
+  values->branch_misses = static_cast<uint64_t>(data[6] * scale);
+  return true;
+#else
+  return false;
+#endif
+}
+
+int PerfCounters::PeakFlopsPerCycle() {
+#if defined(__aarch64__)
+  // Two 128-bit FMA pipes.
+  return 16;
+#elif defined(__arm__)
+  return 8;
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  // Two FMA ports of the widest vectors.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return 64;
+  if (__builtin_cpu_supports("fma")) return 32;
+  if (__builtin_cpu_supports("avx")) return 16;
+  return 8;
+#else
+  return 8;
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
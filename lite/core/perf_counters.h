@@ -0,0 +1,80 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+
+struct PerfCounterValues {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t cache_misses{0};
+  uint64_t branch_misses{0};
+
+  PerfCounterValues& operator+=(const PerfCounterValues& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+  }
+  PerfCounterValues operator-(const PerfCounterValues& other) const {
+    PerfCounterValues res;
+    res.cycles = cycles - other.cycles;
+    res.instructions = instructions - other.instructions;
+    res.cache_misses = cache_misses - other.cache_misses;
+    res.branch_misses = branch_misses - other.branch_misses;
+    return res;
+  }
+};
+
+/*
+ * The hardware counters of the calling thread, read by perf_event_open on
+ * Linux and unsupported elsewhere. The work done by the other threads, e.g.
+ * the workers of the thread pool, is not counted.
+ */
+class PerfCounters {
+ public:
+  PerfCounters() = default;
+  ~PerfCounters() { Close(); }
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Opens the counters for the calling thread. Returns false if the kernel
+  // or the hardware doesn't support them, or perf_event_paranoid forbids.
+  bool Open();
+  void Close();
+  bool is_open() const { return group_fd_ >= 0; }
+
+  // The counters only count between Enable() and Disable().
+  void Enable();
+  void Disable();
+  // Reads the values counted so far, scaled if the counters were
+  // multiplexed with others.
+  bool Read(PerfCounterValues* values) const;
+
+  // The peak single precision FLOPs per cycle of a core, by the widest SIMD
+  // FMA the CPU supports.
+  static int PeakFlopsPerCycle();
+
+ private:
+  int group_fd_{-1};
+  int fds_[3]{-1, -1, -1};
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/prepared_weights.h"
+#include <utility>
+
+namespace paddle {
+namespace lite {
+
+PreparedWeights& PreparedWeights::Global() {
+  static PreparedWeights* x = new PreparedWeights;
+  return *x;
+}
+
+std::shared_ptr<const Tensor> PreparedWeights::Get(const Tensor& weight,
+                                                   const std::string& tag,
+                                                   const Prepare& prepare) {
+  Key key(&weight, weight.raw_data(), tag);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      auto prepared = it->second.lock();
+      if (prepared) return prepared;
+    }
+  }
+
+  // Prepare without holding the lock, the kernels of unrelated weights don't
+  // wait on each other. Two clones racing on the same weight both prepare it
+  // and the first one wins.
+  std::shared_ptr<Tensor> prepared = std::make_shared<Tensor>();
+  prepare(prepared.get());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = cache_[key];
+  auto existing = entry.lock();
+  if (existing) return existing;
+  entry = prepared;
+  // Drop the entries of the weights no kernel uses anymore.
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (it->second.expired()) {
+      it = cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return prepared;
+}
+
+size_t PreparedWeights::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (auto& it : cache_) {
+    if (!it.second.expired()) count++;
+  }
+  return count;
+}
+
+}  // namespace lite
+}  // namespace paddle
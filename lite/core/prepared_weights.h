@@ -0,0 +1,65 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <tuple>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * A process-wide cache of the weights that kernels transform in
+ * PrepareForRun, e.g. packed for a gemm or into the winograd domain.
+ *
+ * The predictors cloned from one another share their persistable tensors, so
+ * the kernels of every clone would transform the same weights in the same
+ * way. With the cache, the first kernel does the work and the others share
+ * its result. The cache only keeps weak references: a prepared tensor is
+ * freed together with the last kernel using it.
+ */
+class PreparedWeights {
+ public:
+  typedef std::function<void(Tensor*)> Prepare;
+
+  static PreparedWeights& Global();
+
+  // Returns the result of `prepare` for `weight`, running it only if no live
+  // kernel has prepared it yet. `tag` names the kernel and the layout of the
+  // result, it must tell apart every way `weight` may be transformed.
+  // The returned tensor is shared and must not be modified.
+  std::shared_ptr<const Tensor> Get(const Tensor& weight,
+                                    const std::string& tag,
+                                    const Prepare& prepare);
+
+  // The number of prepared tensors still in use.
+  size_t size();
+
+ private:
+  // The weight tensor, its data and the tag. The data is part of the key, so
+  // that weights reloaded into the same tensor are prepared again.
+  typedef std::tuple<const Tensor*, const void*, std::string> Key;
+
+  std::mutex mutex_;
+  std::map<Key, std::weak_ptr<const Tensor>> cache_;
+};
+
+}  // namespace lite
+}  // namespace paddle
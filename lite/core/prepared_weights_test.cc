@@ -0,0 +1,101 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/prepared_weights.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+static PreparedWeights::Prepare Double(const Tensor& weight,
+                                       std::atomic<int>* calls) {
+  return [&weight, calls](Tensor* out) {
+    (*calls)++;
+    out->Resize(weight.dims());
+    auto* dst = out->mutable_data<float>();
+    for (int i = 0; i < weight.numel(); i++) {
+      dst[i] = weight.data<float>()[i] * 2.f;
+    }
+  };
+}
+
+TEST(prepared_weights, share) {
+  auto& cache = PreparedWeights::Global();
+  Tensor weight;
+  weight.Resize({16});
+  auto* data = weight.mutable_data<float>();
+  for (int i = 0; i < 16; i++) data[i] = i;
+
+  std::atomic<int> calls{0};
+  auto a = cache.Get(weight, "test/double", Double(weight, &calls));
+  auto b = cache.Get(weight, "test/double", Double(weight, &calls));
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ(a->data<float>()[3], 6.f);
+  EXPECT_EQ(cache.size(), 1u);
+
+  // Another layout of the same weight is prepared on its own.
+  auto c = cache.Get(weight, "test/double/v2", Double(weight, &calls));
+  EXPECT_EQ(calls, 2);
+  EXPECT_NE(a.get(), c.get());
+
+  // The entry dies with its last user.
+  a.reset();
+  b.reset();
+  c.reset();
+  EXPECT_EQ(cache.size(), 0u);
+  auto d = cache.Get(weight, "test/double", Double(weight, &calls));
+  EXPECT_EQ(calls, 3);
+
+  // Weights reloaded into the same tensor are prepared again.
+  Tensor reloaded;
+  reloaded.Resize({16});
+  reloaded.mutable_data<float>();
+  weight.ShareDataWith(reloaded);
+  auto e = cache.Get(weight, "test/double", Double(weight, &calls));
+  EXPECT_EQ(calls, 4);
+  EXPECT_NE(d.get(), e.get());
+}
+
+TEST(prepared_weights, threads) {
+  auto& cache = PreparedWeights::Global();
+  Tensor weight;
+  weight.Resize({1024});
+  auto* data = weight.mutable_data<float>();
+  for (int i = 0; i < 1024; i++) data[i] = i;
+
+  std::atomic<int> calls{0};
+  std::vector<std::shared_ptr<const Tensor>> results(8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&, t]() {
+      results[t] = cache.Get(weight, "test/threads", Double(weight, &calls));
+    });
+  }
+  for (auto& t : threads) t.join();
+  // Racing threads may prepare twice, but all of them end up sharing one.
+  EXPECT_GE(calls, 1);
+  for (int t = 0; t < 8; t++) {
+    EXPECT_EQ(results[t].get(), results[0].get());
+  }
+  EXPECT_EQ(results[0]->data<float>()[1023], 2046.f);
+  auto last = cache.Get(weight, "test/threads", Double(weight, &calls));
+  EXPECT_EQ(last.get(), results[7].get());
+}
+
+}  // namespace lite
+}  // namespace paddle
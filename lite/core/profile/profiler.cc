@@ -146,7 +146,8 @@ std::string Profiler::Summary(Type type, bool concise, size_t w) {
   ss << " " << setw(7) << left << "Per(%)"
      << " " << setw(10) << left << "MFLOPs";
   if (!concise) {
-    ss << " " << setw(7) << left << "GOPS";
+    ss << " " << setw(7) << left << "GOPS"
+       << " " << setw(13) << left << "WorkSpace(KB)";
   }
   if (concise) {
     ss << " " << setw(11) << left << "CalledTimes";
@@ -290,7 +291,9 @@ std::string Profiler::Summary(Type type, bool concise, size_t w) {
          << " " << setw(10) << left << fixed << setprecision(3)
                 << 1e-6f * unit.Character().macs
          << " " << setw(7) << left << fixed << setprecision(2)
-                << 1e-6f * unit.Character().macs / times.Avg(w);
+                << 1e-6f * unit.Character().macs / times.Avg(w)
+         << " " << setw(13) << left << fixed << setprecision(1)
+                << unit.Character().workspace_size / 1024.f;
 // clang-format on
 #ifdef LITE_WITH_OPENCL
       ss << " " << setw(9) << left << fixed << setprecision(3)
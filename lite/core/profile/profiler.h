@@ -71,6 +71,8 @@ struct OpCharacter {
   float arith_intense{0.f};
 
   float io_duration{0.f};
+  // scratch memory reserved by the kernel in its context workspace
+  size_t workspace_size{0};
 
 #ifdef LITE_WITH_OPENCL
   cl::Event cl_event{};
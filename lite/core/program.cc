@@ -15,16 +15,20 @@
 #include "lite/core/program.h"
 
 #include <algorithm>
+#include <cctype>
+#include <functional>
 #include <map>
 #include <set>
 
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#include "lite/core/parallel_defines.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
 #include "lite/operators/while_op.h"
+#include "lite/utils/hash.h"
 #ifdef LITE_WITH_PRECISION_PROFILE
 #include "lite/core/profile/precision_profiler.h"
 #endif
@@ -599,26 +603,52 @@ void RuntimeProgram::Run() {
 #endif
 
   int idx = -1;
+  bool profiling = runtime_profiler_.BeginRun();
+  bool cached_shapes = cache_shapes_ && SelectShapePlan();
+  // The instruction graph is built from the buffers of a run with the same
+  // feed shapes, and is only used by the runs that are not profiled.
+  int lanes = (std::min)(inter_op_threads_, ParallelThreadNum());
+  uint64_t feed_hash = lanes > 1 ? FeedShapeHash() : 0;
+  bool graph_valid = lanes > 1 && instruction_graph_supported_ &&
+                     instruction_graph_.num_nodes() > 0 &&
+                     instruction_graph_feed_hash_ == feed_hash;
+  bool concurrent = graph_valid && !profiling;
+  ran_instruction_graph_ = concurrent;
 
   auto& insts = instructions_[kRootBlockIdx];
-  for (auto& inst : insts) {
-    ++idx;
+  if (concurrent) {
+    RunInstructionGraph(lanes, cached_shapes);
+  } else {
+    for (auto& inst : insts) {
+      ++idx;
 #if !defined(LITE_WITH_METAL)
-    if (inst.is_feed_fetch_op()) continue;
+      if (inst.is_feed_fetch_op()) continue;
 #endif
 
 #ifdef LITE_WITH_OPENCL
-    // delegate flush judgement to specify target , it is too heavy for Inst
-    inst.Flush(idx);
+      // delegate flush judgement to specify target , it is too heavy for Inst
+      inst.Flush(idx);
 #endif
 
-    inst.Run();
+      if (profiling) runtime_profiler_.StartInstruction();
+      if (cached_shapes) {
+        cached_shapes = inst.RunWithCachedShapes();
+      } else {
+        inst.Run();
+      }
+      if (profiling) {
+        runtime_profiler_.StopInstruction();
+        profile::OpCharacter ch;
+        inst.GetRuntimeInfo(&ch);
+        runtime_profiler_.Record(idx, ch);
+      }
 #ifdef LITE_WITH_PRECISION_PROFILE
-    if (inst.op()->Type() != "while") {
-      precision_profiler_summary +=
-          inst_precision_profiler.GetInstPrecision(&inst);
-    }
+      if (inst.op()->Type() != "while") {
+        precision_profiler_summary +=
+            inst_precision_profiler.GetInstPrecision(&inst);
+      }
 #endif  // LITE_WITH_PRECISION_PROFILE
+    }
   }
 
 #ifdef LITE_WITH_METAL
@@ -628,6 +658,26 @@ void RuntimeProgram::Run() {
   }
 #endif
 
+  if (profiling) runtime_profiler_.EndRun();
+
+  bool arena_planned = false;
+  if (use_memory_arena_ &&
+      (!memory_arena_planned_ || memory_arena_.expired())) {
+    PlanMemoryArena();
+    arena_planned = true;
+  }
+  if (lanes > 1 && instruction_graph_supported_ &&
+      (!graph_valid || arena_planned)) {
+    // Not rebuilt while the feed shapes keep changing, those runs go on in
+    // order. A graph of the buffers of the old arena is dropped.
+    if (feed_hash == last_feed_hash_ || instruction_graph_.num_nodes() == 0) {
+      BuildInstructionGraph();
+    } else if (arena_planned) {
+      instruction_graph_.Clear();
+    }
+  }
+  last_feed_hash_ = feed_hash;
+
 #ifdef LITE_WITH_PRECISION_PROFILE
   LOG(INFO) << "\n"
             << precision_profiler_summary
@@ -635,6 +685,336 @@ void RuntimeProgram::Run() {
 #endif
 }
 
+namespace {
+
+// Whether all the instructions run on the host and only touch the variables
+// of their ops, unlike the ops running sub-blocks or picking the branches.
+bool IsPlainHostProgram(const std::vector<Instruction>& insts) {
+  const std::set<std::string> control_flow_ops = {"while",
+                                                  "conditional_block",
+                                                  "conditional_block_infer",
+                                                  "select_input",
+                                                  "split_lod_tensor",
+                                                  "merge_lod_tensor",
+                                                  "merge_lod_tensor_infer"};
+  auto is_host = [](TargetType x) -> bool {
+    return x == TARGET(kHost) || x == TARGET(kX86) || x == TARGET(kARM);
+  };
+  for (auto& inst : insts) {
+    if (control_flow_ops.count(inst.op()->Type()) ||
+        !is_host(inst.kernel()->target())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+uint64_t RuntimeProgram::FeedShapeHash() {
+  if (!feed_tensors_collected_) {
+    feed_tensors_collected_ = true;
+    for (auto& inst : instructions_[kRootBlockIdx]) {
+      if (inst.op()->Type() != "feed") continue;
+      auto* scope = const_cast<OpLite*>(inst.op())->scope();
+      for (auto& name : inst.op()->op_info()->output_names()) {
+        auto* var = scope ? scope->FindVar(name) : nullptr;
+        if (var && var->IsType<Tensor>()) {
+          feed_tensors_.push_back(&var->Get<Tensor>());
+        }
+      }
+    }
+  }
+  uint64_t hash = kHashBytesSeed;
+  for (auto* tensor : feed_tensors_) {
+    HashShape(*tensor, &hash);
+  }
+  return hash;
+}
+
+void RuntimeProgram::set_shape_plan_capacity(int n) {
+  CHECK_GE(n, 1) << "The shape plan capacity should be at least 1";
+  shape_plan_capacity_ = n;
+  // The instructions are set up again in the next run.
+  shape_cache_inited_ = false;
+  feed_hashes_.clear();
+}
+
+bool RuntimeProgram::SelectShapePlan() {
+  if (!shape_cache_inited_) InitShapeCache();
+  if (!shape_cache_supported_) return false;
+  uint64_t hash = FeedShapeHash();
+  auto it = std::find_if(
+      feed_hashes_.begin(),
+      feed_hashes_.end(),
+      [&](const std::pair<uint64_t, int>& x) { return x.first == hash; });
+  bool hit = it != feed_hashes_.end();
+  int plan = 0;
+  if (hit) {
+    plan = it->second;
+    feed_hashes_.erase(it);
+    shape_cache_hits_++;
+  } else {
+    // Take a free plan or evict the least recently used one.
+    plan = static_cast<int>(feed_hashes_.size());
+    if (plan >= shape_plan_capacity_) {
+      plan = feed_hashes_.back().second;
+      feed_hashes_.pop_back();
+    }
+    shape_cache_misses_++;
+  }
+  feed_hashes_.emplace_front(hash, plan);
+  if (plan != shape_plan_) {
+    shape_plan_ = plan;
+    for (auto& inst : instructions_[kRootBlockIdx]) {
+      if (!inst.is_feed_fetch_op()) inst.SwitchShapePlan(plan);
+    }
+  }
+  return hit;
+}
+
+void RuntimeProgram::InitShapeCache() {
+  shape_cache_inited_ = true;
+#if defined(LITE_WITH_METAL) || defined(LITE_WITH_PROFILE) || \
+    defined(LITE_WITH_PRECISION_PROFILE)
+  return;
+#endif
+  // The shapes of the ops running sub-blocks or picking the branches are not
+  // decided by the feeds.
+  auto& insts = instructions_[kRootBlockIdx];
+  shape_plan_ = 0;
+  if (!IsPlainHostProgram(insts)) return;
+  for (auto& inst : insts) {
+    if (!inst.is_feed_fetch_op() &&
+        !inst.EnableShapeCache(shape_plan_capacity_)) {
+      return;
+    }
+  }
+  shape_cache_supported_ = true;
+}
+
+void RuntimeProgram::set_inter_op_threads(int n) {
+  CHECK_GE(n, 1) << "The inter-op threads should be at least 1";
+  inter_op_threads_ = n;
+}
+
+void RuntimeProgram::BuildInstructionGraph() {
+  instruction_graph_.Clear();
+  auto& insts = instructions_[kRootBlockIdx];
+#if defined(LITE_WITH_METAL) || defined(LITE_WITH_PROFILE) || \
+    defined(LITE_WITH_PRECISION_PROFILE)
+  instruction_graph_supported_ = false;
+#endif
+  if (!exec_scope_ || !IsPlainHostProgram(insts)) {
+    instruction_graph_supported_ = false;
+  }
+  if (!instruction_graph_supported_) return;
+
+  // Step1. Collect the variables read and written by each instruction.
+  std::map<std::string, int> var_ids;
+  std::vector<std::string> var_names;
+  auto var_id = [&](const std::string& name) {
+    auto it = var_ids.find(name);
+    if (it != var_ids.end()) return it->second;
+    var_names.push_back(name);
+    return var_ids[name] = static_cast<int>(var_names.size()) - 1;
+  };
+  std::vector<std::vector<int>> reads(insts.size());
+  std::vector<std::vector<int>> writes(insts.size());
+  for (size_t i = 0; i < insts.size(); i++) {
+    if (insts[i].is_feed_fetch_op()) continue;
+    const auto* op_info = insts[i].op()->op_info();
+    for (auto& name : op_info->input_names()) {
+      reads[i].push_back(var_id(name));
+    }
+    for (auto& name : op_info->output_names()) {
+      writes[i].push_back(var_id(name));
+    }
+  }
+
+  // Step2. The variables sharing their buffers, i.e. the slots of the memory
+  // arena, the outputs reusing the buffers of the inputs and the views of
+  // other tensors, are one resource, so that their users keep the program
+  // order. The variables sharing the names by MemoryOptimizePass are
+  // already one.
+  std::vector<int> parents(var_names.size());
+  for (size_t i = 0; i < parents.size(); i++) {
+    parents[i] = static_cast<int>(i);
+  }
+  std::function<int(int)> find = [&](int x) {
+    return parents[x] == x ? x : parents[x] = find(parents[x]);
+  };
+  struct MemoryRange {
+    const char* begin;
+    const char* end;
+    int id;
+  };
+  std::vector<MemoryRange> ranges;
+  for (size_t i = 0; i < var_names.size(); i++) {
+    auto* var = exec_scope_->FindVar(var_names[i]);
+    if (!var || !var->IsType<lite::Tensor>()) continue;
+    const auto& tensor = var->Get<lite::Tensor>();
+    if (!tensor.IsInitialized() || tensor.memory_size() == 0) continue;
+    const char* begin = static_cast<const char*>(tensor.raw_data());
+    ranges.push_back(
+        {begin, begin + tensor.memory_size(), static_cast<int>(i)});
+  }
+  std::sort(ranges.begin(),
+            ranges.end(),
+            [](const MemoryRange& a, const MemoryRange& b) {
+              return a.begin < b.begin;
+            });
+  for (size_t i = 1, last = 0; i < ranges.size(); i++) {
+    if (ranges[i].begin < ranges[last].end) {
+      parents[find(ranges[i].id)] = find(ranges[last].id);
+    }
+    if (ranges[i].end > ranges[last].end) last = i;
+  }
+  for (size_t i = 0; i < insts.size(); i++) {
+    for (auto& id : reads[i]) id = find(id);
+    for (auto& id : writes[i]) id = find(id);
+  }
+
+  // Step3. Order the instructions touching the same resources.
+  instruction_graph_.Build(reads, writes);
+  instruction_graph_feed_hash_ = FeedShapeHash();
+  VLOG(4) << "Instruction graph: " << insts.size() << " instructions, at most "
+          << instruction_graph_.width() << " in parallel";
+}
+
+void RuntimeProgram::RunInstructionGraph(int lanes, bool cached_shapes) {
+  auto& insts = instructions_[kRootBlockIdx];
+  int intra_threads = (std::max)(ParallelThreadNum() / lanes, 1);
+  std::atomic<bool> shapes_valid{cached_shapes};
+  instruction_graph_.Run(lanes, intra_threads, [&](int idx) {
+    auto& inst = insts[idx];
+    if (inst.is_feed_fetch_op()) return;
+    // An instruction whose shapes changed runs before all its successors,
+    // which then infer their shapes.
+    if (shapes_valid.load()) {
+      if (!inst.RunWithCachedShapes()) shapes_valid.store(false);
+    } else {
+      inst.Run();
+    }
+  });
+}
+
+void RuntimeProgram::PlanMemoryArena() {
+  memory_arena_planned_ = true;
+  if (!exec_scope_) return;
+  // The variables of these ops are accessed out of the instruction list or
+  // share the buffers with other variables, see MemoryOptimizePass.
+  const std::set<std::string> invalid_op_types = {"while",
+                                                  "conditional_block",
+                                                  "conditional_block_infer",
+                                                  "merge_lod_tensor_infer",
+                                                  "merge_lod_tensor",
+                                                  "lod_reset",
+                                                  "subgraph",
+                                                  "feed",
+                                                  "fetch",
+                                                  "share_data"};
+  auto is_host = [](TargetType x) -> bool {
+    return x == TARGET(kHost) || x == TARGET(kX86) || x == TARGET(kARM);
+  };
+
+  // Step1. Collect the lifetimes of the variables in the instruction order.
+  auto& insts = instructions_[kRootBlockIdx];
+  std::map<std::string, std::pair<int, int>> lifetimes;
+  std::set<std::string> used_vars;
+  std::set<std::string> invalid_vars;
+  for (size_t i = 0; i < insts.size(); i++) {
+    int idx = static_cast<int>(i);
+    const auto* op_info = insts[i].op()->op_info();
+    auto in_names = op_info->input_names();
+    auto out_names = op_info->output_names();
+    used_vars.insert(in_names.begin(), in_names.end());
+    used_vars.insert(out_names.begin(), out_names.end());
+    if (insts[i].is_feed_fetch_op() ||
+        invalid_op_types.count(op_info->Type())) {
+      invalid_vars.insert(in_names.begin(), in_names.end());
+      invalid_vars.insert(out_names.begin(), out_names.end());
+      continue;
+    }
+    for (auto& name : in_names) {
+      // Read before written, its data must survive between the runs.
+      if (!lifetimes.count(name)) {
+        invalid_vars.insert(name);
+        continue;
+      }
+      lifetimes[name].second = idx;
+    }
+    for (auto& name : out_names) {
+      if (!lifetimes.count(name)) {
+        lifetimes[name] = std::make_pair(idx, idx);
+      } else {
+        lifetimes[name].second = idx;
+      }
+    }
+  }
+
+  // Step2. The variables that alias the memory of others, e.g. the inplace
+  // outputs of reshape or the slices of a tensor, are left out.
+  struct MemoryRange {
+    const char* begin;
+    const char* end;
+    std::string name;
+  };
+  std::vector<MemoryRange> ranges;
+  for (auto& name : used_vars) {
+    auto* var = exec_scope_->FindVar(name);
+    if (!var || !var->IsType<lite::Tensor>()) {
+      invalid_vars.insert(name);
+      continue;
+    }
+    const auto& tensor = var->Get<lite::Tensor>();
+    if (!tensor.IsInitialized() || tensor.memory_size() == 0) continue;
+    const char* begin = static_cast<const char*>(tensor.raw_data());
+    ranges.push_back({begin, begin + tensor.memory_size(), name});
+  }
+  std::sort(ranges.begin(),
+            ranges.end(),
+            [](const MemoryRange& a, const MemoryRange& b) {
+              return a.begin < b.begin;
+            });
+  for (size_t i = 1, last = 0; i < ranges.size(); i++) {
+    if (ranges[i].begin < ranges[last].end) {
+      invalid_vars.insert(ranges[i].name);
+      invalid_vars.insert(ranges[last].name);
+    }
+    if (ranges[i].end > ranges[last].end) last = i;
+  }
+
+  // Step3. Plan the arena for the remaining host activations.
+  std::vector<Tensor*> tensors;
+  std::vector<size_t> sizes;
+  std::vector<std::pair<int, int>> arena_lifetimes;
+  for (auto& item : lifetimes) {
+    const auto& name = item.first;
+    if (invalid_vars.count(name)) continue;
+    auto* tensor = exec_scope_->FindMutableTensor(name);
+    if (!tensor || tensor->persistable() || !is_host(tensor->target()) ||
+        tensor->offset() != 0 || !tensor->IsInitialized() ||
+        tensor->memory_size() == 0) {
+      continue;
+    }
+    auto& peak_size = memory_arena_peak_sizes_[name];
+    peak_size = (std::max)(peak_size, tensor->memory_size());
+    tensors.push_back(tensor);
+    sizes.push_back(peak_size);
+    arena_lifetimes.push_back(item.second);
+  }
+  memory_arena_.Bind(tensors, sizes, arena_lifetimes);
+  VLOG(4) << "Memory arena: " << tensors.size() << " tensors, "
+          << memory_arena_.arena_size() << " bytes in the arena vs "
+          << memory_arena_.naive_size() << " bytes allocated separately";
+}
+
+void RuntimeProgram::ReleaseMemoryArena() {
+  memory_arena_.Release();
+  memory_arena_planned_ = false;
+}
+
 void Program::Build(const std::shared_ptr<cpp::ProgramDesc>& program_desc) {
   CHECK(ops_.empty()) << "Executor duplicate Build found";
 
@@ -813,8 +1193,17 @@ void Instruction::Run() {
   }
 
   op_->InferShape();
+  if (cache_shapes_) {
+    SaveOutputShapes();
+  }
   kernel_->Launch();
   has_run_ = true;
+  plan_switched_ = false;
+  // The kernel resized the outputs, the inferred shapes can't be trusted.
+  if (cache_shapes_ && !OutputShapesMatch()) {
+    shapes_from_data_ = true;
+    SaveOutputShapes();
+  }
 #ifdef LITE_WITH_XPU
 #ifdef LITE_WITH_PRECISION_PROFILE
   if (lite::TargetWrapperXPU::xpu_runtime_ptr->need_dump_xpu_info) {
@@ -828,6 +1217,185 @@ void Instruction::Run() {
 #endif
 }
 
+bool Instruction::RunWithCachedShapes() {
+  if (op_->run_once() && has_run_) {
+    return true;
+  }
+  bool unchanged = true;
+  // The plans share the params of the op, which some ops set for the input
+  // shapes in InferShape, e.g. the paddings of the SAME convs and pools.
+  if (shapes_from_values_ || shapes_from_data_ || plan_switched_) {
+    op_->InferShape();
+    // The shapes set by the kernel are only known after the launch.
+    if (!shapes_from_data_) unchanged = OutputShapesMatch();
+  } else {
+    auto& plan = shape_plans_[shape_plan_];
+    for (size_t i = 0; i < outputs_.size(); i++) {
+      outputs_[i]->Resize(plan.dims[i]);
+      outputs_[i]->set_lod(plan.lods[i]);
+    }
+  }
+  kernel_->Launch(unchanged);
+  has_run_ = true;
+  plan_switched_ = false;
+  if (shapes_from_data_) unchanged = OutputShapesMatch();
+  if (!unchanged) SaveOutputShapes();
+  return unchanged;
+}
+
+void Instruction::SwitchShapePlan(int idx) {
+  if (!cache_shapes_ || idx == shape_plan_) return;
+  CHECK_LT(idx, static_cast<int>(shape_plans_.size()));
+  auto& kernel = shape_plans_[idx].kernel;
+  if (!kernel) {
+    // A new kernel of the same type, which has yet to run.
+    auto kernels = op_->CreateKernels({}, kernel_->SerializedKernelType());
+    for (auto& k : kernels) {
+      if (k->alias() == kernel_->alias()) {
+        kernel = std::move(k);
+        break;
+      }
+    }
+    CHECK(kernel) << "Failed to create the kernel "
+                  << kernel_->SerializedKernelType();
+    kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  }
+  shape_plans_[shape_plan_].kernel = std::move(kernel_);
+  kernel_ = std::move(kernel);
+  shape_plan_ = idx;
+  plan_switched_ = true;
+}
+
+bool Instruction::EnableShapeCache(int num_plans) {
+  // The inputs whose values rather than shapes decide the output shapes.
+  static const std::set<std::string> value_args = {"OutSize",
+                                                   "Shape",
+                                                   "Scale",
+                                                   "K",
+                                                   "Paddings",
+                                                   "Offsets",
+                                                   "RepeatTimes",
+                                                   "ExpandTimes",
+                                                   "Start",
+                                                   "End",
+                                                   "Step",
+                                                   "Stop",
+                                                   "Num",
+                                                   "Length",
+                                                   "depth_tensor",
+                                                   "SequenceLength",
+                                                   "RoisNum",
+                                                   "MultiLevelRoIsNum",
+                                                   "RoisLod",
+                                                   "OutputShape",
+                                                   "Axis"};
+  // The ops whose kernels resize the outputs by the data of the inputs.
+  static const std::set<std::string> data_ops = {"where_index",
+                                                 "unique",
+                                                 "unique_with_counts",
+                                                 "multiclass_nms",
+                                                 "multiclass_nms2",
+                                                 "multiclass_nms3",
+                                                 "matrix_nms",
+                                                 "generate_proposals",
+                                                 "generate_proposals_v2",
+                                                 "distribute_fpn_proposals",
+                                                 "collect_fpn_proposals",
+                                                 "retinanet_detection_output"};
+  auto* scope = op_->scope();
+  if (!scope) return false;
+  // Back to the original kernel, the other plans are dropped.
+  SwitchShapePlan(0);
+  cache_shapes_ = false;
+  shape_plans_.clear();
+  shape_plans_.resize(num_plans);
+  const auto* op_info = op_->op_info();
+  outputs_.clear();
+  for (auto& name : op_info->output_names()) {
+    auto* var = scope->FindVar(name);
+    if (!var || !var->IsType<Tensor>()) return false;
+    outputs_.push_back(var->GetMutable<Tensor>());
+  }
+  // The value inputs are named like `ShapeTensor`, `SizeTensorList` or
+  // `repeat_times_tensor`, so the suffix is matched in lower case.
+  auto is_tensor_arg = [](std::string arg) {
+    std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+    for (std::string suffix : {"tensor", "tensorlist", "tensor_list"}) {
+      if (arg.size() >= suffix.size() &&
+          arg.compare(arg.size() - suffix.size(), suffix.size(), suffix) ==
+              0) {
+        return true;
+      }
+    }
+    return false;
+  };
+  shapes_from_values_ = op_info->Type() == "lod_reset";
+  for (auto& arg : op_info->input_argnames()) {
+    bool is_value_arg = value_args.count(arg) || is_tensor_arg(arg);
+    if (!is_value_arg) continue;
+    for (auto& name : op_info->Input(arg)) {
+      auto* var = scope->FindVar(name);
+      if (var && var->IsType<Tensor>() && var->Get<Tensor>().persistable()) {
+        continue;
+      }
+      shapes_from_values_ = true;
+    }
+  }
+  shapes_from_data_ = data_ops.count(op_info->Type()) > 0;
+  cache_shapes_ = true;
+  SaveOutputShapes();
+  return true;
+}
+
+void Instruction::SaveOutputShapes() {
+  auto& plan = shape_plans_[shape_plan_];
+  plan.dims.resize(outputs_.size());
+  plan.lods.resize(outputs_.size());
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    plan.dims[i] = outputs_[i]->dims();
+    plan.lods[i] = outputs_[i]->lod();
+  }
+}
+
+bool Instruction::OutputShapesMatch() const {
+  auto& plan = shape_plans_[shape_plan_];
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    if (outputs_[i]->dims() != plan.dims[i] ||
+        outputs_[i]->lod() != plan.lods[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Instruction::GetRuntimeInfo(profile::OpCharacter* ch) const {
+  ch->target = kernel_->target();
+  ch->op_type = op_->Type();
+  ch->kernel_name = kernel_->name();
+  op_->GetOpRuntimeInfo(ch);
+  // Fall back to the shapes of all the tensors for the ops which don't
+  // describe themselves. The bytes of all the tensors are the memory access.
+  size_t bytes = 0;
+  auto shapes = [&](const std::vector<std::string>& names) {
+    std::string res;
+    for (auto& name : names) {
+      auto* var = op_->scope() ? op_->scope()->FindVar(name) : nullptr;
+      if (!var || !var->IsType<Tensor>()) continue;
+      auto& tensor = var->Get<Tensor>();
+      bytes += tensor.memory_size();
+      if (!res.empty()) res += ",";
+      res += ch->DimToStr(tensor.dims());
+    }
+    return res.empty() ? std::string("N/A") : res;
+  };
+  auto input_shape = shapes(op_->op_info()->input_names());
+  auto output_shape = shapes(op_->op_info()->output_names());
+  if (ch->input_shape == "N/A") ch->input_shape = input_shape;
+  if (ch->output_shape == "N/A") ch->output_shape = output_shape;
+  ch->macs_ = bytes * 1e-6f;
+  if (ch->macs_ > 0.f) ch->arith_intense = ch->macs * 1e-6f / ch->macs_;
+}
+
 STL::ostream& operator<<(STL::ostream& os, const Instruction& other) {
   os << other.kernel_->summary() << "\t(" << other.kernel_->doc() << ")";
   return os;
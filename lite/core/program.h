@@ -13,15 +13,20 @@
 // limitations under the License.
 
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/core/dag_executor.h"
 #include "lite/core/kernel.h"
+#include "lite/core/memory_planner.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/runtime_profiler.h"
 #include "lite/model_parser/cpp_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -121,6 +126,21 @@ struct Instruction {
 
   // Run the instruction.
   void Run();
+  // Run the instruction with the output shapes of the last run instead of
+  // inferring them, when the shapes of the inputs are known to be the same.
+  // Returns false if the output shapes turn out to be different, e.g. they
+  // depend on the data of the inputs, then the rest of the program should
+  // infer the shapes again.
+  bool RunWithCachedShapes();
+  // Record the output shapes in Run() for RunWithCachedShapes(), in
+  // `num_plans` shape plans. Returns false if the outputs are not all
+  // Tensors.
+  bool EnableShapeCache(int num_plans = 1);
+  // Use the output shapes and the kernel of the `idx`-th shape plan. Every
+  // plan has a kernel of its own, so that the states the kernels re-init
+  // for new shapes, e.g. the packed inputs and the selected algorithms, are
+  // kept for each plan.
+  void SwitchShapePlan(int idx);
 #ifdef LITE_WITH_METAL
   void SaveOutput();
 #endif
@@ -133,6 +153,9 @@ struct Instruction {
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  // Describe the last run of the instruction for the RuntimeProfiler.
+  void GetRuntimeInfo(profile::OpCharacter* ch) const;
+
 #ifdef LITE_WITH_OPENCL
   void Flush(const int inst_idx) const {
     if (TargetType::kOpenCL == kernel_->target()) {
@@ -177,6 +200,26 @@ struct Instruction {
   bool first_epoch_{true};
   bool has_run_{false};
 
+  void SaveOutputShapes();
+  bool OutputShapesMatch() const;
+  bool cache_shapes_{false};
+  struct ShapePlan {
+    std::vector<DDim> dims;
+    std::vector<LoD> lods;
+    // The kernel of the plan while another plan is in use.
+    std::unique_ptr<KernelBase> kernel;
+  };
+  // The output tensors, and their shapes after the last run of each plan.
+  std::vector<Tensor*> outputs_;
+  std::vector<ShapePlan> shape_plans_;
+  int shape_plan_{0};
+  // Another plan is taken since the last run, the shapes are inferred again.
+  bool plan_switched_{false};
+  // The output shapes depend on the values of some non-persistable inputs.
+  bool shapes_from_values_{false};
+  // The output shapes are set by the kernel from the data of the inputs.
+  bool shapes_from_data_{false};
+
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
   int profile_id_{-1};
@@ -305,6 +348,41 @@ class LITE_API RuntimeProgram {
 
   void set_version(const int64_t version) { version_ = version; }
 
+  // Pack the host activations into one arena planned from the tensor sizes
+  // and lifetimes recorded by the previous Run().
+  void set_use_memory_arena(bool x) { use_memory_arena_ = x; }
+  bool use_memory_arena() const { return use_memory_arena_; }
+  // Drop the arena, it is planned again after the next Run().
+  void ReleaseMemoryArena();
+
+  // Skip the shape inference of the runs whose feed shapes and LoDs are the
+  // same as a recent run, on by default.
+  void set_cache_shapes(bool x) {
+    cache_shapes_ = x;
+    feed_hashes_.clear();
+  }
+  bool cache_shapes() const { return cache_shapes_; }
+  // Keep the output shapes and the kernel states of the `n` latest feed
+  // shapes, so that alternating between them neither infers the shapes nor
+  // re-inits the kernels. Every plan beyond the first clones the kernels.
+  void set_shape_plan_capacity(int n);
+  int shape_plan_capacity() const { return shape_plan_capacity_; }
+  // The runs which found their feed shapes in the plans, and the others.
+  int64_t shape_cache_hits() const { return shape_cache_hits_.load(); }
+  int64_t shape_cache_misses() const { return shape_cache_misses_.load(); }
+
+  // Run the independent instructions concurrently on `n` threads of the
+  // thread pool, each of them running the kernels on its share of the pool
+  // threads. 1 runs the instructions in order, the default.
+  void set_inter_op_threads(int n);
+  int inter_op_threads() const { return inter_op_threads_; }
+  const DagExecutor& instruction_graph() const { return instruction_graph_; }
+  // Whether the last Run() ran the instructions concurrently.
+  bool ran_instruction_graph() const { return ran_instruction_graph_; }
+
+  // Times the instructions of the sampled runs, off by default.
+  RuntimeProfiler* mutable_runtime_profiler() { return &runtime_profiler_; }
+
   const int64_t get_version() const { return version_; }
 
 #ifndef LITE_ON_TINY_PUBLISH
@@ -328,6 +406,52 @@ class LITE_API RuntimeProgram {
   Scope* exec_scope_{};
   int64_t version_{0};
 
+  void PlanMemoryArena();
+  bool use_memory_arena_{false};
+  bool memory_arena_planned_{false};
+  ActivationArena memory_arena_;
+  // The largest size of each arena tensor seen so far, so that the arena only
+  // grows when the input shapes change.
+  std::map<std::string, size_t> memory_arena_peak_sizes_;
+
+  RuntimeProfiler runtime_profiler_;
+
+  // Switches the instructions to the shape plan of the feed shapes, returns
+  // whether the plan has run with them.
+  bool SelectShapePlan();
+  void InitShapeCache();
+  bool cache_shapes_{true};
+  bool shape_cache_inited_{false};
+  // False if the program has control flow or the ops of other devices.
+  bool shape_cache_supported_{false};
+  int shape_plan_capacity_{1};
+  int shape_plan_{0};
+  // The hashes of the recent feed shapes and their plans, the most recently
+  // used first.
+  std::list<std::pair<uint64_t, int>> feed_hashes_;
+  std::atomic<int64_t> shape_cache_hits_{0};
+  std::atomic<int64_t> shape_cache_misses_{0};
+
+  // The hash of the shapes and LoDs of all the feeds.
+  uint64_t FeedShapeHash();
+  bool feed_tensors_collected_{false};
+  std::vector<const Tensor*> feed_tensors_;
+
+  // Builds the dependencies of the instructions from the variables they
+  // touch and the buffers of the last run.
+  void BuildInstructionGraph();
+  void RunInstructionGraph(int lanes, bool cached_shapes);
+  int inter_op_threads_{1};
+  // False if the program has control flow or the ops of other devices.
+  bool instruction_graph_supported_{true};
+  DagExecutor instruction_graph_;
+  // The feed shapes of the run the graph is built from.
+  uint64_t instruction_graph_feed_hash_{0};
+  // The feed shapes of the last run, the graph is only rebuilt once they
+  // repeat.
+  uint64_t last_feed_hash_{0};
+  bool ran_instruction_graph_{false};
+
 #ifdef LITE_WITH_OPENCL
   bool opencl_valid_{false};
   bool has_opencl_kernel_{false};
@@ -0,0 +1,422 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
+#include "lite/core/thread_pool.h"
+
+namespace paddle {
+namespace lite {
+
+// Builds a RuntimeProgram of one block, the feeds are set on their output
+// tensors directly as the feed instructions are skipped by Run().
+class TestProgram {
+ public:
+  TestProgram() : desc_(std::make_shared<cpp::ProgramDesc>()) {
+    block_ = desc_->AddBlock<cpp::BlockDesc>();
+    scope_.Var("feed")->GetMutable<std::vector<Tensor>>();
+  }
+
+  void AddFeed(const std::string& name, int col) {
+    auto* op = AddOp("feed",
+                     {{"X", {"feed"}}},
+                     {{"Out", {name}}},
+                     "def",
+                     Place{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)});
+    op->SetAttr<int>("col", col);
+  }
+
+  // Adds an op running the kernel `alias` on `place`.
+  cpp::OpDesc* AddOp(
+      const std::string& type,
+      const std::map<std::string, std::vector<std::string>>& inputs,
+      const std::map<std::string, std::vector<std::string>>& outputs,
+      const std::string& alias,
+      const Place& place) {
+    auto* op = block_->AddOp<cpp::OpDesc>();
+    op->SetType(type);
+    for (auto& arg : inputs) {
+      op->SetInput(arg.first, arg.second);
+      for (auto& name : arg.second) {
+        if (name != "feed") tensor(name);
+      }
+    }
+    for (auto& arg : outputs) {
+      op->SetOutput(arg.first, arg.second);
+      for (auto& name : arg.second) tensor(name);
+    }
+    op->SetAttr<std::string>(
+        kKernelTypeAttr, KernelBase::SerializeKernelType(type, alias, place));
+    return op;
+  }
+
+  // y = scale * x + bias
+  void AddScale(const std::string& x,
+                const std::string& y,
+                float scale,
+                float bias) {
+    auto* op = AddOp("scale",
+                     {{"X", {x}}},
+                     {{"Out", {y}}},
+                     "def",
+                     Place{TARGET(kX86), PRECISION(kFloat)});
+    op->SetAttr<float>("scale", scale);
+    op->SetAttr<float>("bias", bias);
+    op->SetAttr<bool>("bias_after_scale", true);
+  }
+
+  RuntimeProgram* Build() {
+    program_.reset(new RuntimeProgram(desc_, &scope_));
+    return program_.get();
+  }
+
+  Tensor* tensor(const std::string& name) {
+    return scope_.Var(name)->GetMutable<Tensor>();
+  }
+
+  void SetFloat(const std::string& name,
+                const std::vector<int64_t>& dims,
+                const std::vector<float>& values) {
+    auto* x = tensor(name);
+    x->Resize(dims);
+    CHECK_EQ(static_cast<size_t>(x->numel()), values.size());
+    std::copy(values.begin(), values.end(), x->mutable_data<float>());
+  }
+
+  void SetInt(const std::string& name, int value) {
+    auto* x = tensor(name);
+    x->Resize({1});
+    x->mutable_data<int>()[0] = value;
+  }
+
+ private:
+  Scope scope_;
+  std::shared_ptr<cpp::ProgramDesc> desc_;
+  cpp::BlockDesc* block_{nullptr};
+  std::unique_ptr<RuntimeProgram> program_;
+};
+
+// feed x -> expand_v2(x, [n, -1]) -> e -> scale -> s
+//        -> where_index(x) -> idx
+// The shape of `e` depends on the value of `n`, the one of `idx` on the data
+// of `x`, neither of them is a feed.
+class ShapeCacheProgram : public TestProgram {
+ public:
+  ShapeCacheProgram() {
+    AddFeed("x", 0);
+    auto* expand =
+        AddOp("expand_v2",
+              {{"X", {"x"}}, {"expand_shapes_tensor", {"n", "m"}}},
+              {{"Out", {"e"}}},
+              "def",
+              Place{TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kAny)});
+    expand->SetAttr<std::vector<int>>("shape", {});
+    AddScale("e", "s", 2.f, 1.f);
+    AddOp("where_index",
+          {{"Condition", {"x"}}},
+          {{"Out", {"idx"}}},
+          "def",
+          Place{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)});
+    SetInt("m", -1);
+  }
+
+  // Runs with `x` of shape [1, values.size()] and checks all the outputs.
+  void Run(const std::vector<float>& values, int64_t n) {
+    int64_t w = static_cast<int64_t>(values.size());
+    SetFloat("x", {1, w}, values);
+    SetInt("n", static_cast<int>(n));
+    program()->Run();
+
+    ASSERT_EQ(tensor("e")->dims(), DDim({n, w}));
+    ASSERT_EQ(tensor("s")->dims(), DDim({n, w}));
+    const float* s = tensor("s")->data<float>();
+    for (int64_t i = 0; i < n * w; i++) {
+      EXPECT_EQ(s[i], values[i % w] * 2.f + 1.f);
+    }
+    std::vector<int64_t> nonzero;
+    for (int64_t i = 0; i < w; i++) {
+      if (values[i] != 0.f) nonzero.push_back(i);
+    }
+    int64_t count = static_cast<int64_t>(nonzero.size());
+    ASSERT_EQ(tensor("idx")->dims(), DDim({count, 2}));
+    const int64_t* idx = tensor("idx")->data<int64_t>();
+    for (int64_t i = 0; i < count; i++) {
+      EXPECT_EQ(idx[i * 2], 0);
+      EXPECT_EQ(idx[i * 2 + 1], nonzero[i]);
+    }
+  }
+
+  RuntimeProgram* program() {
+    if (!program_) program_ = Build();
+    return program_;
+  }
+
+ private:
+  RuntimeProgram* program_{nullptr};
+};
+
+TEST(RuntimeProgram, shape_cache) {
+  ShapeCacheProgram p;
+  ASSERT_TRUE(p.program()->cache_shapes());
+  p.Run({1.f, 0.f, 2.f}, 2);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 0);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 1);
+  // unchanged
+  p.Run({1.f, 0.f, 2.f}, 2);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 1);
+  // the same feed shapes, a new value of `n` and new nonzeros in `x`, the
+  // shapes of the ops after them are inferred again
+  p.Run({1.f, 0.f, 2.f}, 3);
+  p.Run({0.f, 0.f, 5.f}, 3);
+  p.Run({3.f, 4.f, 5.f}, 1);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 4);
+  // changed feed shapes
+  p.Run({1.f, 0.f, 2.f, 0.f}, 1);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 2);
+  p.Run({1.f, 0.f, 2.f, 3.f}, 2);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 5);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 2);
+}
+
+TEST(RuntimeProgram, shape_plans) {
+  ShapeCacheProgram p;
+  p.program()->set_shape_plan_capacity(2);
+  // The kernel of scale, every plan has one of its own.
+  auto kernel = [&]() { return p.program()->instructions()[2].kernel(); };
+  std::vector<float> a = {1.f, 0.f};
+  std::vector<float> b = {1.f, 0.f, 2.f};
+  std::vector<float> c = {1.f, 0.f, 2.f, 3.f};
+  p.Run(a, 2);
+  auto* kernel0 = kernel();
+  p.Run(b, 2);
+  auto* kernel1 = kernel();
+  EXPECT_NE(kernel0, kernel1);
+  p.Run(a, 2);
+  EXPECT_EQ(kernel(), kernel0);
+  p.Run(b, 3);
+  EXPECT_EQ(kernel(), kernel1);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 2);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 2);
+  // `a` is the least recently used, its plan goes to `c`
+  p.Run(c, 2);
+  EXPECT_EQ(kernel(), kernel0);
+  p.Run(b, 2);
+  EXPECT_EQ(kernel(), kernel1);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 3);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 3);
+  // then `c`, and `b`
+  p.Run(a, 1);
+  EXPECT_EQ(kernel(), kernel0);
+  p.Run(c, 1);
+  EXPECT_EQ(kernel(), kernel1);
+  p.Run(a, 2);
+  EXPECT_EQ(kernel(), kernel0);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 4);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 5);
+}
+
+TEST(RuntimeProgram, shape_cache_off) {
+  ShapeCacheProgram p;
+  p.program()->set_cache_shapes(false);
+  p.Run({1.f, 0.f, 2.f}, 2);
+  p.Run({1.f, 0.f, 2.f}, 3);
+  p.Run({0.f, 1.f}, 1);
+  EXPECT_EQ(p.program()->shape_cache_hits(), 0);
+  EXPECT_EQ(p.program()->shape_cache_misses(), 0);
+}
+
+// feed x -> conv2d(3x3, stride 2, SAME) -> y
+// The paddings of the conv are set by InferShape for the input shape, (0, 1)
+// for a width of 8 and (1, 1) for 9.
+class SameConvProgram : public TestProgram {
+ public:
+  SameConvProgram() {
+    AddFeed("x", 0);
+    auto* conv = AddOp("conv2d",
+                       {{"Input", {"x"}}, {"Filter", {"w"}}},
+                       {{"Output", {"y"}}},
+                       "def",
+                       Place{TARGET(kX86), PRECISION(kFloat)});
+    conv->SetAttr<std::vector<int>>("strides", {2, 2});
+    conv->SetAttr<std::vector<int>>("paddings", {0, 0});
+    conv->SetAttr<std::vector<int>>("dilations", {1, 1});
+    conv->SetAttr<int>("groups", 1);
+    conv->SetAttr<std::string>("padding_algorithm", "SAME");
+    std::vector<float> w(9);
+    for (int i = 0; i < 9; i++) w[i] = static_cast<float>(i + 1);
+    SetFloat("w", {1, 1, 3, 3}, w);
+    tensor("w")->set_persistable(true);
+    program_ = Build();
+  }
+
+  // Runs with `x` of shape [1, 1, w, w] and returns `y`.
+  std::vector<float> Run(int64_t w) {
+    std::vector<float> values(w * w);
+    for (int64_t i = 0; i < w * w; i++) {
+      values[i] = static_cast<float>(i % 7) - 3.f;
+    }
+    SetFloat("x", {1, 1, w, w}, values);
+    program_->Run();
+    const auto* y = tensor("y");
+    return std::vector<float>(y->data<float>(),
+                              y->data<float>() + y->numel());
+  }
+
+  RuntimeProgram* program() { return program_; }
+
+ private:
+  RuntimeProgram* program_{nullptr};
+};
+
+TEST(RuntimeProgram, shape_plans_infer_params) {
+  SameConvProgram cached;
+  cached.program()->set_shape_plan_capacity(2);
+  SameConvProgram uncached;
+  uncached.program()->set_cache_shapes(false);
+  for (int64_t w : {8, 9, 8, 9, 8}) {
+    auto y = cached.Run(w);
+    auto expected = uncached.Run(w);
+    ASSERT_EQ(y.size(), expected.size());
+    for (size_t i = 0; i < y.size(); i++) {
+      EXPECT_NEAR(y[i], expected[i], 1e-5f) << "width " << w;
+    }
+  }
+  EXPECT_EQ(cached.program()->shape_cache_hits(), 3);
+}
+
+// feed x -> scale -> a -> scale -> b
+//        -> scale -> c -> scale -> d
+// The two branches are independent but for the memory arena, where `c` takes
+// the slot of `a` or `b` after their last use.
+class BranchProgram : public TestProgram {
+ public:
+  BranchProgram() {
+    AddFeed("x", 0);
+    AddScale("x", "a", 2.f, 1.f);
+    AddScale("a", "b", 3.f, 0.f);
+    AddScale("x", "c", 0.5f, 1.f);
+    AddScale("c", "d", 2.f, 0.f);
+    program_ = Build();
+    program_->set_use_memory_arena(true);
+    program_->set_inter_op_threads(2);
+  }
+
+  // Runs with `x` of shape [1, w] and checks `d`, the only output left
+  // intact by the arena. The arena is planned after the first run and drops
+  // its outputs, which the fetch ops would have copied.
+  void Run(int64_t w) {
+    std::vector<float> values(w);
+    for (int64_t i = 0; i < w; i++) values[i] = static_cast<float>(i);
+    SetFloat("x", {1, w}, values);
+    program_->Run();
+    if (runs_++ == 0) return;
+    ASSERT_EQ(tensor("d")->dims(), DDim({1, w}));
+    const float* d = tensor("d")->data<float>();
+    for (int64_t i = 0; i < w; i++) {
+      EXPECT_EQ(d[i], values[i] + 2.f);
+    }
+  }
+
+  bool Overlap(const std::string& x, const std::string& y) {
+    const char* x_begin = static_cast<const char*>(tensor(x)->raw_data());
+    const char* y_begin = static_cast<const char*>(tensor(y)->raw_data());
+    return x_begin < y_begin + tensor(y)->memory_size() &&
+           y_begin < x_begin + tensor(x)->memory_size();
+  }
+
+  // Whether the instruction `to` waits for the instruction `from`.
+  bool Reaches(int from, int to) {
+    const auto& graph = program_->instruction_graph();
+    std::vector<bool> visited(graph.num_nodes(), false);
+    std::vector<int> stack = {from};
+    while (!stack.empty()) {
+      int node = stack.back();
+      stack.pop_back();
+      if (node == to) return true;
+      for (int next : graph.successors(node)) {
+        if (!visited[next]) {
+          visited[next] = true;
+          stack.push_back(next);
+        }
+      }
+    }
+    return false;
+  }
+
+  RuntimeProgram* program() { return program_; }
+
+ private:
+  RuntimeProgram* program_{nullptr};
+  int runs_{0};
+};
+
+TEST(RuntimeProgram, instruction_graph) {
+  auto pool = ThreadPool::Create(4);
+  ThreadPoolGuard guard(pool.get());
+  // The graph needs a thread pool of the kernels to run on.
+  if (ParallelThreadNum() < 2) return;
+  BranchProgram p;
+  p.Run(64);
+  EXPECT_FALSE(p.program()->ran_instruction_graph());
+  ASSERT_EQ(p.program()->instruction_graph().num_nodes(), 5u);
+  // `c` reuses the buffer of `a` or `b`, so it is written after `b`
+  ASSERT_TRUE(p.Overlap("c", "a") || p.Overlap("c", "b"));
+  EXPECT_TRUE(p.Reaches(2, 3));
+  EXPECT_FALSE(p.Reaches(3, 2));
+  p.Run(64);
+  EXPECT_TRUE(p.program()->ran_instruction_graph());
+
+  // The profiled runs go on in order.
+  p.program()->mutable_runtime_profiler()->set_sample_every(1);
+  p.Run(64);
+  EXPECT_FALSE(p.program()->ran_instruction_graph());
+  p.program()->mutable_runtime_profiler()->set_sample_every(0);
+  p.Run(64);
+  EXPECT_TRUE(p.program()->ran_instruction_graph());
+
+  // So do the runs with new feed shapes, the graph is kept while the shapes
+  // keep changing
+  p.Run(32);
+  EXPECT_FALSE(p.program()->ran_instruction_graph());
+  p.Run(16);
+  EXPECT_FALSE(p.program()->ran_instruction_graph());
+  p.Run(64);
+  EXPECT_TRUE(p.program()->ran_instruction_graph());
+  // and rebuilt once they repeat.
+  p.Run(16);
+  p.Run(16);
+  EXPECT_FALSE(p.program()->ran_instruction_graph());
+  p.Run(16);
+  EXPECT_TRUE(p.program()->ran_instruction_graph());
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed);
+USE_LITE_OP(conv2d);
+USE_LITE_OP(expand_v2);
+USE_LITE_OP(scale);
+USE_LITE_OP(where_index);
+USE_LITE_KERNEL(feed, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(expand_v2, kHost, kFloat, kAny, def);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(where_index, kHost, kAny, kAny, def);
@@ -0,0 +1,262 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/runtime_profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+std::string Quote(const std::string& s) {
+  std::string res = "\"";
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        res += "\\\"";
+        break;
+      case '\\':
+        res += "\\\\";
+        break;
+      case '\n':
+        res += "\\n";
+        break;
+      case '\t':
+        res += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", c);
+          res += buf;
+        } else {
+          res += c;
+        }
+    }
+  }
+  return res + "\"";
+}
+
+std::string Number(double x) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.3f", x);
+  return buf;
+}
+
+std::string Ratio(double x, double y) { return Number(y > 0. ? x / y : 0.); }
+
+std::string CounterArgs(const PerfCounterValues& counters, double count) {
+  return ",\"cycles\":" + Number(counters.cycles / count) +
+         ",\"instructions\":" + Number(counters.instructions / count) +
+         ",\"cache_misses\":" + Number(counters.cache_misses / count) +
+         ",\"branch_misses\":" + Number(counters.branch_misses / count) +
+         ",\"ipc\":" + Ratio(counters.instructions, counters.cycles);
+}
+
+}  // namespace
+
+const size_t RuntimeProfiler::kMaxTraceEvents;
+
+void RuntimeProfiler::set_sample_every(int n) {
+  CHECK_GE(n, 0) << "sample_every should be non-negative";
+  sample_every_.store(n);
+}
+
+void RuntimeProfiler::StartCounters() {
+  if (!use_perf_counters_.load(std::memory_order_relaxed)) {
+    if (counters_.is_open()) counters_.Close();
+    return;
+  }
+  // Counters only count the thread they are opened for.
+  auto thread = std::this_thread::get_id();
+  if (counters_.is_open() && counters_thread_ != thread) counters_.Close();
+  if (!counters_.is_open() && !counters_failed_) {
+    counters_failed_ = !counters_.Open();
+    counters_thread_ = thread;
+    counters_.Enable();
+  }
+  static const int peak = PerfCounters::PeakFlopsPerCycle();
+  peak_flops_per_cycle_ = static_cast<double>(peak) * ParallelThreadNum();
+}
+
+void RuntimeProfiler::Record(int idx,
+                             const profile::OpCharacter& ch,
+                             Clock::time_point start,
+                             Clock::time_point end,
+                             const PerfCounterValues* counters) {
+  double ts_us = Micros(start);
+  double dur_us = Micros(end) - ts_us;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (insts_.size() <= static_cast<size_t>(idx)) insts_.resize(idx + 1);
+  auto& stat = insts_[idx];
+  // Keep the description of the latest run, the shapes may change.
+  stat.op_type = ch.op_type;
+  stat.kernel_name = ch.kernel_name;
+  stat.input_shape = ch.input_shape;
+  stat.output_shape = ch.output_shape;
+  stat.filter_shape = ch.filter_shape;
+  stat.remark = ch.remark;
+  stat.flops = ch.macs;
+  // OpCharacter::macs_ is the memory access in MB.
+  stat.bytes = ch.macs_ * 1e6;
+  stat.min_us = stat.count ? (std::min)(stat.min_us, dur_us) : dur_us;
+  stat.max_us = (std::max)(stat.max_us, dur_us);
+  stat.total_us += dur_us;
+  stat.count++;
+  if (counters) {
+    stat.counted++;
+    stat.counters += *counters;
+    stat.counted_flops += ch.macs;
+    stat.peak_flops += counters->cycles * peak_flops_per_cycle_;
+  }
+
+  events_.push_back({idx,
+                     profiled_runs_,
+                     ts_us,
+                     dur_us,
+                     counters != nullptr,
+                     counters ? *counters : PerfCounterValues()});
+  if (events_.size() > kMaxTraceEvents) events_.pop_front();
+}
+
+void RuntimeProfiler::EndRun() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profiled_runs_++;
+}
+
+void RuntimeProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  profiled_runs_ = 0;
+  events_.clear();
+  insts_.clear();
+}
+
+std::string RuntimeProfiler::ChromeTrace() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string res = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (auto& event : events_) {
+    auto& stat = insts_[event.idx];
+    if (!first) res += ",";
+    first = false;
+    res += "\n{\"name\":" + Quote(stat.op_type) +
+           ",\"cat\":\"op\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" +
+           Number(event.ts_us) + ",\"dur\":" + Number(event.dur_us) +
+           ",\"args\":{\"index\":" + std::to_string(event.idx) +
+           ",\"run\":" + std::to_string(event.run) +
+           ",\"kernel\":" + Quote(stat.kernel_name) +
+           ",\"input_shape\":" + Quote(stat.input_shape) +
+           ",\"output_shape\":" + Quote(stat.output_shape) +
+           ",\"filter_shape\":" + Quote(stat.filter_shape) +
+           ",\"remark\":" + Quote(stat.remark) +
+           ",\"flops\":" + Number(stat.flops) +
+           (event.has_counters ? CounterArgs(event.counters, 1.) : "") + "}}";
+  }
+  res += "\n]}\n";
+  return res;
+}
+
+std::string RuntimeProfiler::Summary() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  double total_us = 0.;
+  for (auto& stat : insts_) {
+    total_us += stat.total_us;
+  }
+  auto percent = [&](double us) {
+    return Number(total_us > 0. ? us * 100. / total_us : 0.);
+  };
+  auto per_run_ms = [&](double us) {
+    return Number(profiled_runs_ ? us * 1e-3 / profiled_runs_ : 0.);
+  };
+
+  std::string res = "{\"sample_every\":" + std::to_string(sample_every()) +
+                    ",\"perf_counters\":" +
+                    (use_perf_counters() ? "true" : "false") +
+                    ",\"profiled_runs\":" + std::to_string(profiled_runs_) +
+                    ",\"avg_run_ms\":" + per_run_ms(total_us) +
+                    ",\n\"instructions\":[";
+  // The op types in the order they first appear.
+  std::vector<std::string> op_types;
+  std::map<std::string, InstStat> by_type;
+  bool first = true;
+  for (size_t i = 0; i < insts_.size(); i++) {
+    auto& stat = insts_[i];
+    if (!stat.count) continue;
+    double avg_us = stat.total_us / stat.count;
+    if (!first) res += ",";
+    first = false;
+    res += "\n{\"index\":" + std::to_string(i) +
+           ",\"op_type\":" + Quote(stat.op_type) +
+           ",\"kernel\":" + Quote(stat.kernel_name) +
+           ",\"input_shape\":" + Quote(stat.input_shape) +
+           ",\"output_shape\":" + Quote(stat.output_shape) +
+           ",\"filter_shape\":" + Quote(stat.filter_shape) +
+           ",\"remark\":" + Quote(stat.remark) +
+           ",\"flops\":" + Number(stat.flops) +
+           ",\"bytes\":" + Number(stat.bytes) +
+           ",\"bytes_per_flop\":" + Ratio(stat.bytes, stat.flops) +
+           ",\"count\":" + std::to_string(stat.count) +
+           ",\"avg_ms\":" + Number(avg_us * 1e-3) +
+           ",\"min_ms\":" + Number(stat.min_us * 1e-3) +
+           ",\"max_ms\":" + Number(stat.max_us * 1e-3) +
+           ",\"percent\":" + percent(stat.total_us) +
+           ",\"gflops\":" + Ratio(stat.flops * 1e-3, avg_us);
+    if (stat.counted) {
+      res += CounterArgs(stat.counters, stat.counted) + ",\"peak_percent\":" +
+             Ratio(stat.counted_flops * 100., stat.peak_flops);
+    }
+    res += "}";
+    auto it = by_type.find(stat.op_type);
+    if (it == by_type.end()) {
+      op_types.push_back(stat.op_type);
+      it = by_type.emplace(stat.op_type, InstStat()).first;
+    }
+    it->second.count += stat.count;
+    it->second.total_us += stat.total_us;
+    it->second.flops += stat.flops * stat.count;
+    it->second.counted += stat.counted;
+    it->second.counters += stat.counters;
+    it->second.counted_flops += stat.counted_flops;
+    it->second.peak_flops += stat.peak_flops;
+  }
+  res += "\n],\n\"op_types\":[";
+  first = true;
+  for (auto& op_type : op_types) {
+    auto& stat = by_type[op_type];
+    if (!first) res += ",";
+    first = false;
+    res += "\n{\"op_type\":" + Quote(op_type) +
+           ",\"count\":" + std::to_string(stat.count) +
+           ",\"ms_per_run\":" + per_run_ms(stat.total_us) +
+           ",\"percent\":" + percent(stat.total_us) +
+           ",\"gflops\":" + Ratio(stat.flops * 1e-3, stat.total_us);
+    if (stat.counted) {
+      res += ",\"ipc\":" +
+             Ratio(stat.counters.instructions, stat.counters.cycles) +
+             ",\"peak_percent\":" +
+             Ratio(stat.counted_flops * 100., stat.peak_flops);
+    }
+    res += "}";
+  }
+  res += "\n]}\n";
+  return res;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,171 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/perf_counters.h"
+#include "lite/core/profile/profiler.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Times the instructions of a RuntimeProgram in any build, unlike the
+ * profile::Profiler which needs LITE_WITH_PROFILE.
+ *
+ * It is off by default and costs one branch per run. Once turned on, one run
+ * in every `sample_every` is profiled: each instruction is timed from its
+ * InferShape to the end of its kernel, and described by the op, the kernel,
+ * the shapes and the FLOPs reported by OpLite::GetOpRuntimeInfo. The timings
+ * are exported as a Chrome trace, see chrome://tracing or ui.perfetto.dev,
+ * and as per-instruction aggregates in JSON, so that two runs can be diffed.
+ *
+ * With the hardware counters on, the cycles, instructions, cache misses and
+ * branch misses of each instruction are recorded too, giving the IPC and the
+ * achieved FLOPs as a percentage of the peak. Together with the bytes per
+ * FLOP, they tell the memory bound ops from the compute bound ones.
+ *
+ * The program runs on one thread, the exports may come from any other.
+ */
+class RuntimeProfiler {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  RuntimeProfiler() : epoch_(Clock::now()) {}
+
+  // Profiles one run in every `n`, 0 turns the profiler off. The records are
+  // kept until Reset().
+  void set_sample_every(int n);
+  int sample_every() const { return sample_every_.load(); }
+  // Reads the hardware counters of the running thread in the profiled runs,
+  // see PerfCounters.
+  void set_use_perf_counters(bool x) { use_perf_counters_.store(x); }
+  bool use_perf_counters() const { return use_perf_counters_.load(); }
+
+  // Called at the beginning of every run, returns whether to profile it.
+  bool BeginRun() {
+    int n = sample_every_.load(std::memory_order_relaxed);
+    if (n <= 0 || runs_++ % n != 0) return false;
+    StartCounters();
+    return true;
+  }
+  // Brackets an instruction of the profiled run, which is then described
+  // by Record().
+  void StartInstruction() {
+    inst_start_ = Clock::now();
+    counters_valid_ = counters_.Read(&inst_counters_);
+  }
+  void StopInstruction() {
+    PerfCounterValues end;
+    counters_valid_ = counters_valid_ && counters_.Read(&end);
+    inst_end_ = Clock::now();
+    if (counters_valid_) inst_counters_ = end - inst_counters_;
+  }
+  // Records the `idx`-th instruction described by `ch`.
+  void Record(int idx, const profile::OpCharacter& ch) {
+    Record(idx,
+           ch,
+           inst_start_,
+           inst_end_,
+           counters_valid_ ? &inst_counters_ : nullptr);
+  }
+  // Records that the `idx`-th instruction ran from `start` to `end`, with
+  // the hardware counters if not null.
+  void Record(int idx,
+              const profile::OpCharacter& ch,
+              Clock::time_point start,
+              Clock::time_point end,
+              const PerfCounterValues* counters = nullptr);
+  // Called at the end of a profiled run.
+  void EndRun();
+
+  // Chrome trace events of the latest profiled runs.
+  std::string ChromeTrace() const;
+  // Per-instruction and per-op-type aggregates of all the profiled runs.
+  std::string Summary() const;
+  void Reset();
+
+  // The most trace events kept, the oldest are dropped beyond it. The
+  // aggregates cover all the runs.
+  static const size_t kMaxTraceEvents = 1 << 18;
+
+ private:
+  struct Event {
+    int idx;
+    int64_t run;
+    double ts_us;
+    double dur_us;
+    bool has_counters;
+    PerfCounterValues counters;
+  };
+
+  struct InstStat {
+    std::string op_type;
+    std::string kernel_name;
+    std::string input_shape;
+    std::string output_shape;
+    std::string filter_shape;
+    std::string remark;
+    float flops{0.f};
+    // The bytes of the inputs and outputs.
+    double bytes{0.};
+    int64_t count{0};
+    double total_us{0.};
+    double min_us{0.};
+    double max_us{0.};
+    // Summed over the runs with counters.
+    int64_t counted{0};
+    PerfCounterValues counters;
+    double counted_flops{0.};
+    double peak_flops{0.};
+  };
+
+  void StartCounters();
+
+  double Micros(Clock::time_point t) const {
+    return std::chrono::duration<double, std::micro>(t - epoch_).count();
+  }
+
+  std::atomic<int> sample_every_{0};
+  std::atomic<bool> use_perf_counters_{false};
+  // Only touched by the running thread.
+  uint64_t runs_{0};
+  PerfCounters counters_;
+  // The thread the counters are opened for.
+  std::thread::id counters_thread_;
+  bool counters_failed_{false};
+  // The peak FLOPs of the cores running the profiled run per cycle.
+  double peak_flops_per_cycle_{0.};
+  Clock::time_point inst_start_;
+  Clock::time_point inst_end_;
+  bool counters_valid_{false};
+  PerfCounterValues inst_counters_;
+
+  mutable std::mutex mutex_;
+  Clock::time_point epoch_;
+  int64_t profiled_runs_{0};
+  std::deque<Event> events_;
+  std::vector<InstStat> insts_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,129 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/runtime_profiler.h"
+#include <gtest/gtest.h>
+#include <string>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+static size_t Count(const std::string& s, const std::string& sub) {
+  size_t n = 0;
+  for (auto pos = s.find(sub); pos != std::string::npos;
+       pos = s.find(sub, pos + 1)) {
+    n++;
+  }
+  return n;
+}
+
+// Runs two fake instructions, the second one twice as long as the first.
+static void FakeRun(RuntimeProfiler* profiler) {
+  if (!profiler->BeginRun()) return;
+  auto t = RuntimeProfiler::Clock::now();
+  profile::OpCharacter conv;
+  conv.op_type = "conv2d";
+  conv.kernel_name = "conv2d:x86/float/NCHW";
+  conv.input_shape = "1x3x8x8";
+  conv.macs = 2000.f;
+  profiler->Record(0, conv, t, t + std::chrono::microseconds(100));
+  profile::OpCharacter relu;
+  relu.op_type = "relu";
+  relu.remark = "\"quoted\"";
+  t += std::chrono::microseconds(100);
+  profiler->Record(1, relu, t, t + std::chrono::microseconds(200));
+  profiler->EndRun();
+}
+
+TEST(runtime_profiler, off) {
+  RuntimeProfiler profiler;
+  for (int i = 0; i < 4; i++) FakeRun(&profiler);
+  EXPECT_EQ(Count(profiler.ChromeTrace(), "\"ph\":\"X\""), 0u);
+  EXPECT_NE(profiler.Summary().find("\"profiled_runs\":0"), std::string::npos);
+}
+
+TEST(runtime_profiler, sample) {
+  RuntimeProfiler profiler;
+  profiler.set_sample_every(3);
+  for (int i = 0; i < 7; i++) FakeRun(&profiler);
+  // The 1st, 4th and 7th runs.
+  auto trace = profiler.ChromeTrace();
+  EXPECT_EQ(Count(trace, "\"ph\":\"X\""), 6u);
+  EXPECT_EQ(Count(trace, "\"name\":\"conv2d\""), 3u);
+  EXPECT_NE(trace.find("\"dur\":200.000"), std::string::npos);
+  EXPECT_NE(trace.find("\\\"quoted\\\""), std::string::npos);
+
+  auto summary = profiler.Summary();
+  EXPECT_NE(summary.find("\"profiled_runs\":3"), std::string::npos);
+  EXPECT_NE(summary.find("\"avg_run_ms\":0.300"), std::string::npos);
+  EXPECT_NE(summary.find("\"input_shape\":\"1x3x8x8\""), std::string::npos);
+  // 2000 FLOPs in 100 us.
+  EXPECT_NE(summary.find("\"gflops\":0.020"), std::string::npos);
+  EXPECT_EQ(Count(summary, "\"percent\":66.667"), 2u);
+  EXPECT_EQ(Count(summary, "\"op_type\":\"relu\""), 2u);
+
+  profiler.Reset();
+  EXPECT_EQ(Count(profiler.ChromeTrace(), "\"ph\":\"X\""), 0u);
+  profiler.set_sample_every(0);
+  FakeRun(&profiler);
+  EXPECT_NE(profiler.Summary().find("\"profiled_runs\":0"), std::string::npos);
+}
+
+TEST(runtime_profiler, counters) {
+  RuntimeProfiler profiler;
+  profiler.set_sample_every(1);
+  ASSERT_TRUE(profiler.BeginRun());
+  auto t = RuntimeProfiler::Clock::now();
+  profile::OpCharacter ch;
+  ch.op_type = "fc";
+  ch.macs = 4000.f;
+  // 8000 bytes.
+  ch.macs_ = 0.008f;
+  PerfCounterValues counters;
+  counters.cycles = 1000;
+  counters.instructions = 2500;
+  counters.cache_misses = 3;
+  counters.branch_misses = 1;
+  profiler.Record(0, ch, t, t + std::chrono::microseconds(10), &counters);
+  profiler.EndRun();
+
+  auto summary = profiler.Summary();
+  EXPECT_NE(summary.find("\"bytes_per_flop\":2.000"), std::string::npos);
+  EXPECT_NE(summary.find("\"ipc\":2.500"), std::string::npos);
+  EXPECT_NE(summary.find("\"cache_misses\":3.000"), std::string::npos);
+  EXPECT_NE(profiler.ChromeTrace().find("\"cycles\":1000.000"),
+            std::string::npos);
+}
+
+TEST(perf_counters, read) {
+  PerfCounters counters;
+  if (!counters.Open()) {
+    LOG(INFO) << "The hardware counters are not available, skipped";
+    return;
+  }
+  counters.Enable();
+  PerfCounterValues start, end;
+  ASSERT_TRUE(counters.Read(&start));
+  volatile float sum = 0.f;
+  for (int i = 0; i < 1000000; i++) sum += i * 0.5f;
+  ASSERT_TRUE(counters.Read(&end));
+  auto delta = end - start;
+  EXPECT_GT(delta.cycles, 0u);
+  EXPECT_GT(delta.instructions, 1000000u);
+  EXPECT_GT(PerfCounters::PeakFlopsPerCycle(), 0);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -14,6 +14,7 @@
 
 #include "lite/core/tensor.h"
 #include <string>
+#include "lite/utils/hash.h"
 #include "lite/utils/string.h"
 
 namespace paddle {
@@ -84,5 +85,19 @@ const cl::Image2D *TensorLite::data<uint16_t, cl::Image2D>() const {
 }
 #endif
 
+void HashShape(const TensorLite &x, uint64_t *hash) {
+  auto &dims = x.dims().data();
+  uint64_t size = dims.size();
+  HashBytes(&size, sizeof(size), hash);
+  HashBytes(dims.data(), dims.size() * sizeof(dims[0]), hash);
+  size = x.lod().size();
+  HashBytes(&size, sizeof(size), hash);
+  for (auto &level : x.lod()) {
+    size = level.size();
+    HashBytes(&size, sizeof(size), hash);
+    HashBytes(level.data(), level.size() * sizeof(level[0]), hash);
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -289,6 +289,11 @@ bool TensorCompareWith(const TensorT &a, const TensorT &b) {
   return true;
 }
 
+// Mixes the dims and the LoD of `x` into `hash`, which starts with
+// kHashBytesSeed. Shapes are compared by their hashes where comparing them
+// one by one costs too much.
+void HashShape(const TensorLite &x, uint64_t *hash);
+
 #ifdef LITE_WITH_OPENCL
 template <>
 const cl::Image2D *TensorLite::data<float, cl::Image2D>() const;
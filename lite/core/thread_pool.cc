@@ -14,11 +14,88 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include <algorithm>
+#include <new>
+#include "lite/core/target_wrapper.h"
 #include "lite/utils/log/logging.h"
+#include "lite/utils/macros.h"
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 namespace paddle {
 namespace lite {
 
+namespace {
+// Number of polling iterations before an idle thread parks. With a pause
+// instruction per iteration this is in the order of 100us, which covers the
+// gap between two consecutive parallel loops of one inference.
+constexpr int kSpinCount = 1 << 14;
+// Every range is split into this many chunks, the remaining chunks of a slow
+// thread are left for the others to steal.
+constexpr int kChunksPerThread = 4;
+
+// Give the core away every few polls, so spinning threads do not starve the
+// ones doing real work when the pool is larger than the available cores.
+constexpr int kYieldInterval = 64;
+
+inline void CpuRelax(int iteration) {
+  if ((iteration + 1) % kYieldInterval == 0) {
+    std::this_thread::yield();
+    return;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// The pool bound to this thread by ThreadPoolGuard.
+LITE_THREAD_LOCAL ThreadPool* tls_pool = nullptr;
+LITE_THREAD_LOCAL bool tls_pool_bound = false;
+
+// Returns false if any of `cpu_ids` can not be bound to: out of the range of
+// cpu_set_t, offline, or outside the cpus the process may run on.
+bool CheckCpuIds(const std::vector<int>& cpu_ids) {
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  bool has_allowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  for (auto id : cpu_ids) {
+    if (id < 0 || id >= CPU_SETSIZE) {
+      LOG(WARNING) << "Invalid cpu id " << id
+                   << ", the thread pool is not bound to cpus.";
+      return false;
+    }
+    if (has_allowed && !CPU_ISSET(id, &allowed)) {
+      LOG(WARNING) << "Cpu " << id << " is offline or not available to the "
+                   << "process, the thread pool is not bound to cpus.";
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+void BindToCpus(const std::vector<int>& cpu_ids) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto id : cpu_ids) {
+    CPU_SET(id, &mask);
+  }
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    LOG(WARNING) << "Failed to bind the thread pool worker to the given cpus.";
+  }
+#else
+  LOG(WARNING) << "Binding the thread pool to cpus is not supported.";
+#endif
+}
+}  // namespace
+
 ThreadPool* ThreadPool::gInstance = nullptr;
 static std::mutex gInitMutex;  // confirm thread-safe when use singleton mode
 int ThreadPool::Init(int number) {
@@ -40,92 +117,173 @@ void ThreadPool::Destroy() {
   }
 }
 
-ThreadPool::ThreadPool(int number) {
+std::shared_ptr<ThreadPool> ThreadPool::Create(
+    int number, const std::vector<int>& cpu_ids) {
+  if (number <= 1) {
+    return nullptr;
+  }
+  return std::make_shared<ThreadPool>(number, cpu_ids);
+}
+
+ThreadPool* ThreadPool::Current() {
+  return tls_pool_bound ? tls_pool : gInstance;
+}
+
+ThreadPool::ThreadPool(int number, const std::vector<int>& cpu_ids) {
   thread_num_ = number;
+  static_assert(alignof(WorkRange) <= host::MALLOC_ALIGN,
+                "host::malloc does not align the work ranges");
+  ranges_ = static_cast<WorkRange*>(
+      host::malloc(sizeof(WorkRange) * static_cast<size_t>(thread_num_)));
   for (int i = 0; i < thread_num_; ++i) {
-    tasks_.second.emplace_back(new std::atomic<bool>{false});
+    new (&ranges_[i]) WorkRange();
+  }
+  std::vector<int> bind_ids;
+  if (!cpu_ids.empty() && CheckCpuIds(cpu_ids)) {
+    bind_ids = cpu_ids;
   }
   for (int thread_index = 1; thread_index < thread_num_; ++thread_index) {
-    workers_.emplace_back([this, thread_index]() {
-      while (!stop_) {
-        // if (*tasks_.second[thread_index]) {
-        while (!(*tasks_.second[thread_index])) {
-          std::this_thread::yield();
-        }
-        tasks_.first(thread_index, thread_index);
-        *tasks_.second[thread_index] = false;
+    workers_.emplace_back([this, thread_index, bind_ids]() {
+      if (!bind_ids.empty()) {
+        BindToCpus(bind_ids);
       }
+      WorkerLoop(thread_index);
     });
   }
 }
 
 ThreadPool::~ThreadPool() {
   stop_ = true;
+  {
+    std::lock_guard<std::mutex> _l(park_mutex_);
+    park_cv_.notify_all();
+  }
   for (auto& worker : workers_) {
     worker.join();
   }
-  for (auto c : tasks_.second) {
-    delete c;
+  for (int i = 0; i < thread_num_; ++i) {
+    ranges_[i].~WorkRange();
   }
+  host::free(ranges_);
 }
 
-void ThreadPool::AcquireThreadPool() {
-  if (nullptr == gInstance) {
-    return;
+void ThreadPool::WorkerLoop(int tid) {
+  // Workers are started before the first loop is dispatched, a late starter
+  // must not mistake the epoch of that loop for its starting point.
+  uint32_t epoch = 0;
+  while (WaitForTask(&epoch)) {
+    RunChunks(tid);
+    if (active_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> _l(done_mutex_);
+      done_cv_.notify_one();
+    }
   }
-  LOG(INFO) << "ThreadPool::AcquireThreadPool()\n";
-  std::unique_lock<std::mutex> _l(gInstance->mutex_);
-  while (!gInstance->ready_) gInstance->cv_.wait(_l);
-  gInstance->ready_ = false;
-  return;
 }
 
-void ThreadPool::ReleaseThreadPool() {
-  if (nullptr == gInstance) {
-    return;
+bool ThreadPool::WaitForTask(uint32_t* epoch) {
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (stop_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    uint32_t current = epoch_.load(std::memory_order_acquire);
+    if (current != *epoch) {
+      *epoch = current;
+      return true;
+    }
+    CpuRelax(i);
+  }
+  // Park until the next loop is dispatched. `parked_workers_` is raised before
+  // the predicate is checked, so the dispatcher either sees it and notifies,
+  // or this thread sees the new epoch.
+  std::unique_lock<std::mutex> _l(park_mutex_);
+  parked_workers_.fetch_add(1);
+  park_cv_.wait(_l, [this, epoch]() {
+    return stop_.load() || epoch_.load() != *epoch;
+  });
+  parked_workers_.fetch_sub(1);
+  if (stop_) {
+    return false;
   }
-  LOG(INFO) << "ThreadPool::ReleaseThreadPool()\n";
-  std::unique_lock<std::mutex> _l(gInstance->mutex_);
-  gInstance->ready_ = true;
-  gInstance->cv_.notify_all();
+  *epoch = epoch_.load(std::memory_order_acquire);
+  return true;
 }
 
-void ThreadPool::Enqueue(TASK_BASIC&& task) {
-  if (task.second <= 1 || (nullptr == gInstance)) {
-    for (int i = 0; i < task.second; ++i) {
-      task.first(i, 0);
+void ThreadPool::WaitForWorkers() {
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (active_workers_.load(std::memory_order_acquire) == 0) {
+      return;
     }
-    return;
+    CpuRelax(i);
+  }
+  std::unique_lock<std::mutex> _l(done_mutex_);
+  done_cv_.wait(_l, [this]() {
+    return active_workers_.load(std::memory_order_acquire) == 0;
+  });
+}
+
+bool ThreadPool::ClaimChunk(int owner, int* begin, int* end) {
+  auto& range = ranges_[owner];
+  int start = range.next.fetch_add(chunk_size_, std::memory_order_relaxed);
+  if (start >= range.end) {
+    return false;
   }
-  int work_size = task.second;
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = [work_size, &task](int index, int tId) {
-      for (int v = tId; v < work_size; v += gInstance->thread_num_) {
-        task.first(v, tId);  // nested lambda func
+  *begin = start;
+  *end = std::min(start + chunk_size_, range.end);
+  return true;
+}
+
+void ThreadPool::RunChunks(int tid) {
+  int begin = 0;
+  int end = 0;
+  // drain the own range first, then steal from the others
+  for (int i = 0; i < thread_num_; ++i) {
+    int owner = (tid + i) % thread_num_;
+    while (ClaimChunk(owner, &begin, &end)) {
+      for (int v = begin; v < end; ++v) {
+        (*task_)(v, tid);
       }
-    };
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = std::move(task.first);
+    }
   }
-  for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
+}
+
+void ThreadPool::ParallelFor(const TASK& task, int work_size) {
+  int active = std::min(thread_num_, work_size);
+  int base = work_size / active;
+  int remain = work_size % active;
+  int begin = 0;
+  for (int i = 0; i < thread_num_; ++i) {
+    int len = i < active ? base + (i < remain ? 1 : 0) : 0;
+    ranges_[i].next.store(begin, std::memory_order_relaxed);
+    ranges_[i].end = begin + len;
+    begin += len;
+  }
+  chunk_size_ = std::max(1, work_size / (active * kChunksPerThread));
+  task_ = &task;
+  active_workers_.store(thread_num_ - 1, std::memory_order_relaxed);
+  epoch_.fetch_add(1);
+  if (parked_workers_.load() > 0) {
+    std::lock_guard<std::mutex> _l(park_mutex_);
+    park_cv_.notify_all();
   }
   // invoke tid 0 callback in main thread
   // other tid task is invoked in child thread
-  gInstance->tasks_.first(0, 0);
-  bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in child thread
-  do {
-    std::this_thread::yield();
-    complete = true;
-    for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
-        complete = false;
-        break;
-      }
+  RunChunks(0);
+  WaitForWorkers();
+  task_ = nullptr;
+}
+
+void ThreadPool::Enqueue(TASK_BASIC&& task) {
+  ThreadPool* pool = Current();
+  bool expected = false;
+  if (task.second <= 1 || (nullptr == pool) ||
+      !pool->busy_.compare_exchange_strong(expected, true)) {
+    for (int i = 0; i < task.second; ++i) {
+      task.first(i, 0);
     }
-  } while (!complete);
+    return;
+  }
+  pool->ParallelFor(task.first, task.second);
+  pool->busy_.store(false);
 }
 
 void ThreadPool::Enqueue(TASK_COMMON&& task) {
@@ -133,45 +291,34 @@ void ThreadPool::Enqueue(TASK_COMMON&& task) {
   int start = std::get<2>(task);
   int step = std::get<3>(task);
   int work_size = (end - start + step - 1) / step;
-  if (work_size <= 1 || (nullptr == gInstance)) {
+  ThreadPool* pool = Current();
+  bool expected = false;
+  if (work_size <= 1 || (nullptr == pool) ||
+      !pool->busy_.compare_exchange_strong(expected, true)) {
     for (int v = start; v < end; v += step) {
       std::get<0>(task)(v, 0);
     }
     return;
   }
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto start_index = start + tId * step;
-      auto stride = gInstance->thread_num_ * step;
-      for (int v = start_index; v < end; v += stride) {
-        std::get<0>(task)(v, tId);  // nested lambda func
-      }
-    });
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto v = start + tId * step;
-      std::get<0>(task)(v, tId);  // nested lambda func
-    });
-  }
-  for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
-  }
-  // invoke tid 0 callback in main thread
-  // other tid task is invoked in new thread
-  gInstance->tasks_.first(0, 0);
-  bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in new thread
-  do {
-    std::this_thread::yield();
-    complete = true;
-    for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
-        complete = false;
-        break;
-      }
-    }
-  } while (!complete);
+  auto& func = std::get<0>(task);
+  pool->ParallelFor(
+      [&func, start, step](int index, int tid) {
+        func(start + index * step, tid);  // nested lambda func
+      },
+      work_size);
+  pool->busy_.store(false);
+}
+
+ThreadPoolGuard::ThreadPoolGuard(ThreadPool* pool) {
+  prev_pool_ = tls_pool;
+  prev_bound_ = tls_pool_bound;
+  tls_pool = pool;
+  tls_pool_bound = true;
+}
+
+ThreadPoolGuard::~ThreadPoolGuard() {
+  tls_pool = prev_pool_;
+  tls_pool_bound = prev_bound_;
 }
 
 }  // namespace lite
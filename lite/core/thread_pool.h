@@ -16,6 +16,7 @@
 #include <atomic>
 #include <condition_variable>  //NOLINT
 #include <functional>
+#include <memory>
 #include <mutex>   //NOLINT
 #include <thread>  //NOLINT
 #include <tuple>
@@ -25,6 +26,23 @@
 namespace paddle {
 namespace lite {
 
+/*
+ * ThreadPool runs the body of a `LITE_PARALLEL_*` loop on a fixed set of
+ * worker threads, the calling thread takes part as tid 0.
+ *
+ * The iteration space is split into one contiguous range per thread, and
+ * every thread consumes its own range in chunks. A thread that runs out of
+ * work steals chunks from the ranges of the other threads, so an unbalanced
+ * loop does not wait on its slowest thread.
+ *
+ * Idle workers spin for a bounded number of iterations waiting for the next
+ * task and then park on a condition variable, so an idle pool does not
+ * occupy any core.
+ *
+ * Several pools may live in one process, e.g. one per predictor. `Enqueue`
+ * dispatches to the pool bound to the calling thread by `ThreadPoolGuard`,
+ * and falls back to the process-wide pool created by `Init` otherwise.
+ */
 class ThreadPool {
  public:
   typedef std::function<void(int, int)> TASK;
@@ -33,24 +51,79 @@ class ThreadPool {
 
   static void Enqueue(TASK_BASIC&& task);
   static void Enqueue(TASK_COMMON&& task);
-  static void AcquireThreadPool();
-  static void ReleaseThreadPool();
+  // Create the process-wide pool used by threads without a bound pool.
   static int Init(int number);
   static void Destroy();
 
+  // Create an independent pool, returns nullptr if `number` <= 1. The worker
+  // threads are pinned to `cpu_ids` if it is not empty (Linux only), the
+  // calling thread which runs tid 0 is left untouched.
+  static std::shared_ptr<ThreadPool> Create(
+      int number, const std::vector<int>& cpu_ids = std::vector<int>());
+  // The pool `Enqueue` dispatches to on the calling thread, nullptr means the
+  // loops run serially.
+  static ThreadPool* Current();
+
+  explicit ThreadPool(int number = 0,
+                      const std::vector<int>& cpu_ids = std::vector<int>());
+  ~ThreadPool();
+
+  int thread_num() const { return thread_num_; }
+
  private:
+  // The range of loop indices owned by one thread, aligned to a cache line to
+  // avoid false sharing between the cursors of neighbouring threads. The
+  // array is allocated with `host::malloc`, as `new[]` does not honour the
+  // alignment before C++17.
+  struct alignas(64) WorkRange {
+    std::atomic<int> next{0};
+    int end{0};
+  };
+
   static ThreadPool* gInstance;
-  explicit ThreadPool(int number = 0);
-  ~ThreadPool();
+
+  // Run `task(index, tid)` for every index in [0, work_size).
+  void ParallelFor(const TASK& task, int work_size);
+  void WorkerLoop(int tid);
+  // Returns false if the pool is being destroyed.
+  bool WaitForTask(uint32_t* epoch);
+  void WaitForWorkers();
+  void RunChunks(int tid);
+  bool ClaimChunk(int owner, int* begin, int* end);
 
   std::vector<std::thread> workers_;
   std::atomic<bool> stop_{false};
-  bool ready_{true};
-  std::pair<TASK, std::vector<std::atomic<bool>*>> tasks_;
-  std::condition_variable cv_;
-  std::mutex mutex_;
+
+  // Only one loop can be dispatched to the pool at a time, a nested or a
+  // concurrent caller falls back to a serial loop.
+  std::atomic<bool> busy_{false};
+  const TASK* task_{nullptr};
+  int chunk_size_{1};
+  WorkRange* ranges_{nullptr};
+  // Bumped once per dispatched loop, workers wait for it to change.
+  std::atomic<uint32_t> epoch_{0};
+  // Number of workers which have not finished the current loop yet.
+  std::atomic<int> active_workers_{0};
+  std::atomic<int> parked_workers_{0};
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+  std::mutex done_mutex_;
+  std::condition_variable done_cv_;
 
   int thread_num_ = 0;
 };
+
+// Binds a pool to the current thread for the lifetime of the guard, so that
+// the `LITE_PARALLEL_*` loops of the kernels run on it. A nullptr pool makes
+// the loops run serially even if the process-wide pool exists.
+class ThreadPoolGuard {
+ public:
+  explicit ThreadPoolGuard(ThreadPool* pool);
+  ~ThreadPoolGuard();
+
+ private:
+  ThreadPool* prev_pool_{nullptr};
+  bool prev_bound_{false};
+};
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,133 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/thread_pool.h"
+#include <gtest/gtest.h>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(ThreadPool, basic_loop) {
+  const int thread_num = 4;
+  ThreadPool::Init(thread_num);
+  for (int work_size = 1; work_size < 300; work_size += 7) {
+    std::vector<int> hits(work_size, 0);
+    std::vector<int> tids(work_size, -1);
+    LITE_PARALLEL_BEGIN(i, tid, work_size) {
+      hits[i]++;
+      tids[i] = tid;
+    }
+    LITE_PARALLEL_END();
+    for (int i = 0; i < work_size; ++i) {
+      ASSERT_EQ(hits[i], 1);
+      ASSERT_GE(tids[i], 0);
+      ASSERT_LT(tids[i], thread_num);
+    }
+  }
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, common_loop) {
+  ThreadPool::Init(4);
+  const int start = 3;
+  const int step = 5;
+  for (int end = 4; end < 500; end += 13) {
+    std::vector<int> hits(end, 0);
+    LITE_PARALLEL_COMMON_BEGIN(c, tid, end, start, step) { hits[c]++; }
+    LITE_PARALLEL_COMMON_END();
+    for (int i = 0; i < end; ++i) {
+      int expect = (i >= start && (i - start) % step == 0) ? 1 : 0;
+      ASSERT_EQ(hits[i], expect);
+    }
+  }
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, unbalanced_and_nested_loop) {
+  ThreadPool::Init(4);
+  const int outer = 16;
+  const int inner = 8;
+  std::vector<int> hits(outer * inner, 0);
+  LITE_PARALLEL_BEGIN(i, tid, outer) {
+    // the first iterations are much heavier than the rest
+    if (i < 2) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // a nested loop falls back to the calling thread
+    LITE_PARALLEL_BEGIN(j, tid_inner, inner) { hits[i * inner + j]++; }
+    LITE_PARALLEL_END();
+  }
+  LITE_PARALLEL_END();
+  for (auto v : hits) {
+    ASSERT_EQ(v, 1);
+  }
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, independent_pools) {
+  auto pool2 = ThreadPool::Create(2);
+  auto pool3 = ThreadPool::Create(3);
+  ASSERT_FALSE(ThreadPool::Create(1));
+  ASSERT_EQ(pool2->thread_num(), 2);
+  ASSERT_EQ(pool3->thread_num(), 3);
+
+  auto run_on = [](ThreadPool* pool, int thread_num) {
+    ThreadPoolGuard guard(pool);
+    ASSERT_EQ(ThreadPool::Current(), pool);
+    const int work_size = 64;
+    std::vector<int> hits(work_size, 0);
+    std::vector<int> tids(work_size, -1);
+    for (int iter = 0; iter < 100; ++iter) {
+      LITE_PARALLEL_BEGIN(i, tid, work_size) {
+        hits[i]++;
+        tids[i] = tid;
+      }
+      LITE_PARALLEL_END();
+    }
+    for (int i = 0; i < work_size; ++i) {
+      ASSERT_EQ(hits[i], 100);
+      ASSERT_LT(tids[i], thread_num);
+    }
+  };
+  // two predictors running concurrently on their own pools
+  std::thread t2(run_on, pool2.get(), 2);
+  std::thread t3(run_on, pool3.get(), 3);
+  t2.join();
+  t3.join();
+  // a null pool runs the loops serially
+  run_on(nullptr, 1);
+  ASSERT_EQ(ThreadPool::Current(), nullptr);
+}
+
+TEST(ThreadPool, invalid_cpu_ids) {
+  // pools given cpu ids they can not bind to still run unbound
+  for (auto& cpu_ids : std::vector<std::vector<int>>{{-1}, {0, 1 << 20}}) {
+    auto pool = ThreadPool::Create(2, cpu_ids);
+    ThreadPoolGuard guard(pool.get());
+    const int work_size = 32;
+    std::vector<int> hits(work_size, 0);
+    LITE_PARALLEL_BEGIN(i, tid, work_size) { hits[i]++; }
+    LITE_PARALLEL_END();
+    for (int i = 0; i < work_size; ++i) {
+      ASSERT_EQ(hits[i], 1);
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -104,7 +104,7 @@ void GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   ctx.ExtendWorkspace(workspace_size_);
   auto weights = param.filter->data<float>();
   if (flag_trans_weights_) {
-    weights = weights_.data<float>();
+    weights = weights_->data<float>();
   }
   const float* bias = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
@@ -144,7 +144,7 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   ctx.ExtendWorkspace(workspace_size_);
   auto weights = param.filter->data<int8_t>();
   if (flag_trans_weights_) {
-    weights = weights_.data<int8_t>();
+    weights = weights_->data<int8_t>();
   }
   auto bias = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
@@ -208,7 +208,7 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   ctx.ExtendWorkspace(workspace_size_);
   auto weights = param.filter->data<int8_t>();
   if (flag_trans_weights_) {
-    weights = weights_.data<int8_t>();
+    weights = weights_->data<int8_t>();
   }
   auto bias = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
@@ -276,7 +276,7 @@ void GemmLikeConv<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
   ctx.ExtendWorkspace(workspace_size_);
   auto weights = param.filter->data<float16_t>();
   if (flag_trans_weights_) {
-    weights = weights_.data<float16_t>();
+    weights = weights_->data<float16_t>();
   }
   const float16_t* bias = param.bias ? param.bias->data<float16_t>() : nullptr;
   if (flag_trans_bias_) {
@@ -15,12 +15,14 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
+#include "lite/core/prepared_weights.h"
 #include "lite/core/target_wrapper.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
@@ -86,17 +88,25 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
       workspace_size_ = k * n * sizeof(float);
     }
     if (!flag_trans_weights_ && n > 1 && m > 1) {
-      if (param.filter->precision() == PrecisionType::kFP16) {
+      // The packed layout depends on the cpu arch, the clones running on
+      // the same arch share it.
+      std::string tag = "arm/conv2d_gemmlike/" + PrecisionToStr(Ptype) +
+                        "/groups=" + std::to_string(param.groups) +
+                        "/arch=" + std::to_string(static_cast<int>(ctx.arch()));
+      weights_ = PreparedWeights::Global().Get(
+          *param.filter, tag, [&](Tensor* weights) {
+            if (param.filter->precision() == PrecisionType::kFP16) {
 #ifdef ENABLE_ARM_FP16
-        lite::arm::math::fp16::trans_gemm_weights_fp16(
-            *(param.filter), weights_, param.groups, &ctx);
+              lite::arm::math::fp16::trans_gemm_weights_fp16(
+                  *(param.filter), *weights, param.groups, &ctx);
 #else
-        LOG(FATAL) << "FP16 conv must open ENABLE_ARM_FP16";
+              LOG(FATAL) << "FP16 conv must open ENABLE_ARM_FP16";
 #endif
-      } else {
-        lite::arm::math::trans_gemm_weights<Ptype>(
-            *(param.filter), weights_, param.groups, &ctx);
-      }
+            } else {
+              lite::arm::math::trans_gemm_weights<Ptype>(
+                  *(param.filter), *weights, param.groups, &ctx);
+            }
+          });
       flag_trans_weights_ = true;
     } else if (n == 1 || m == 1) {
       flag_trans_weights_ = false;
@@ -134,7 +144,8 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
   bool flag_1x1gemm_{true};
   bool flag_trans_weights_{false};
   bool flag_trans_bias_{false};
-  Tensor weights_;
+  // the packed weights, shared by the clones
+  std::shared_ptr<const Tensor> weights_;
   Tensor bias_;
   int workspace_size_{0};
 };
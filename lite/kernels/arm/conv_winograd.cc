@@ -85,31 +85,36 @@ void WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>::ReInitWhenNeeded() {
   workspace_size_ = (temp_size + new_input_size) * sizeof(float);
 
   //! update trans weights impl
-  weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
-  void* trans_tmp_ptr = malloc(sizeof(float) * wino_iw * wino_iw * oc * ic);
-  auto weights_data_ = weights_.mutable_data<float>();
-  memset(reinterpret_cast<char*>(weights_data_),
-         0,
-         weights_.numel() * sizeof(float));
-  switch (wino_iw) {
-    case 8:
-      lite::arm::math::weight_trans_c4_8x8(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    case 6:
-      lite::arm::math::weight_trans_c4_6x6(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    case 4:
-      lite::arm::math::weight_trans_c4_4x4(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    default:
-      lite::arm::math::weight_trans_c4_8x8(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-  }
-
-  free(trans_tmp_ptr);
+  auto trans_weights = [&](Tensor* weights) {
+    weights->Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
+    void* trans_tmp_ptr = malloc(sizeof(float) * wino_iw * wino_iw * oc * ic);
+    auto weights_data_ = weights->mutable_data<float>();
+    memset(reinterpret_cast<char*>(weights_data_),
+           0,
+           weights->numel() * sizeof(float));
+    switch (wino_iw) {
+      case 8:
+        lite::arm::math::weight_trans_c4_8x8(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      case 6:
+        lite::arm::math::weight_trans_c4_6x6(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      case 4:
+        lite::arm::math::weight_trans_c4_4x4(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      default:
+        lite::arm::math::weight_trans_c4_8x8(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+    }
+    free(trans_tmp_ptr);
+  };
+  weights_ = PreparedWeights::Global().Get(
+      *param.filter,
+      "arm/conv2d_winograd/fp32/c4_" + std::to_string(wino_iw),
+      trans_weights);
 }
 
 template <>
@@ -125,7 +130,7 @@ void WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& ctx = this->ctx_->template As<ARMContext>();
   ctx.ExtendWorkspace(workspace_size_);
   const auto* i_data = param.x->data<float>();
-  const auto* w_data = weights_.data<float>();
+  const auto* w_data = weights_->data<float>();
   const auto* b_data = param.bias ? param.bias->data<float>() : nullptr;
   auto* o_data = param.output->mutable_data<float>();
 
@@ -379,38 +384,45 @@ void WinogradConv<PRECISION(kFP16), PRECISION(kFP16)>::ReInitWhenNeeded() {
                         threads;
   workspace_size_ = (temp_size + new_input_size) * sizeof(float16_t);
 
-  weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
-  void* trans_tmp_ptr = malloc(sizeof(float16_t) * wino_iw * wino_iw * oc * ic);
-  auto weights_data_ = weights_.mutable_data<float16_t>();
-  memset(reinterpret_cast<char*>(weights_data_),
-         0,
-         weights_.numel() * sizeof(int16_t));
-  switch (wino_iw) {
-    case 4:
-      lite::arm::math::fp16::weight_trans_c8_4x4_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    case 6:
-      lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    default:
-      lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-  }
-  free(trans_tmp_ptr);
+  auto trans_weights = [&](Tensor* weights) {
+    weights->Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
+    void* trans_tmp_ptr =
+        malloc(sizeof(float16_t) * wino_iw * wino_iw * oc * ic);
+    auto weights_data_ = weights->mutable_data<float16_t>();
+    memset(reinterpret_cast<char*>(weights_data_),
+           0,
+           weights->numel() * sizeof(int16_t));
+    switch (wino_iw) {
+      case 4:
+        lite::arm::math::fp16::weight_trans_c8_4x4_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      case 6:
+        lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      default:
+        lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+    }
+    free(trans_tmp_ptr);
+  };
+  weights_ = PreparedWeights::Global().Get(
+      *param.filter,
+      "arm/conv2d_winograd/fp16/c8_" + std::to_string(wino_iw),
+      trans_weights);
 }
 
 template <>
@@ -424,7 +436,7 @@ void WinogradConv<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
   auto& ctx = this->ctx_->template As<ARMContext>();
   ctx.ExtendWorkspace(workspace_size_);
   const auto* i_data = param.x->template data<float16_t>();
-  const auto* w_data = weights_.data<float16_t>();
+  const auto* w_data = weights_->data<float16_t>();
   const auto* b_data =
       param.bias ? param.bias->template data<float16_t>() : nullptr;
   auto* o_data = param.output->template mutable_data<float16_t>();
@@ -15,11 +15,13 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
+#include "lite/core/prepared_weights.h"
 #include "lite/core/target_wrapper.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/conv_impl_fp16.h"
@@ -61,7 +63,8 @@ class WinogradConv : public KernelLite<TARGET(kARM), Ptype> {
 
  protected:
   using param_t = operators::ConvParam;
-  Tensor weights_;
+  // the weights in the winograd domain, shared by the clones
+  std::shared_ptr<const Tensor> weights_;
   DDim last_shape_;
   int workspace_size_{0};
   int last_function_{-1};
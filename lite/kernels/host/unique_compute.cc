@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/transpose.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -126,42 +127,6 @@ void UniqueFlattendTensorFunc(const lite::Tensor& in,
   }
 }
 
-template <typename T>
-void UniqueTransCompute(const Tensor& input,
-                        Tensor* output,
-                        const std::vector<int>& orders) {
-  auto in_dims = input.dims();
-  auto out_dims = output->dims();
-  int num_axes = in_dims.size();
-  int count = in_dims.production();
-  const T* din = input.data<T>();
-  T* dout = output->mutable_data<T>();
-  std::vector<int> old_steps;
-  int temp = 1;
-  for (int i = 0; i < num_axes; ++i) {
-    old_steps.push_back(temp);
-    temp *= in_dims[num_axes - 1 - i];
-  }
-  std::reverse(old_steps.begin(), old_steps.end());
-  std::vector<int> new_steps;
-  temp = 1;
-  for (int i = 0; i < num_axes; ++i) {
-    new_steps.push_back(temp);
-    temp *= out_dims[num_axes - 1 - i];
-  }
-  std::reverse(new_steps.begin(), new_steps.end());
-  for (int i = 0; i < count; ++i) {
-    int old_idx = 0;
-    int idx = i;
-    for (int j = 0; j < num_axes; ++j) {
-      int order = orders[j];
-      old_idx += (idx / new_steps[j]) * old_steps[order];
-      idx %= new_steps[j];
-    }
-    dout[i] = din[old_idx];
-  }
-}
-
 lite::DDim UniqueFlattenTo2d(const lite::DDim& src, int num_col_dims) {
   return DDim(std::vector<DDim::value_type>{
       src.Slice(0, num_col_dims).production(),
@@ -287,7 +252,7 @@ void UniqueDimFunc(const lite::Tensor& in,
   lite::DDim in_trans_dims = DDim(in_trans_dims_vec);
   in_trans.Resize(in_trans_dims);
   in_trans.mutable_data<InT>();
-  UniqueTransCompute<InT>(in, &in_trans, permute);
+  lite::host::math::Transpose<InT>(in, &in_trans, permute);
   // reshape tensor: eg. [dim1, dim0, dim2] -> [dim1, dim0*dim2]
   lite::DDim in_trans_flat_dims = UniqueFlattenTo2d(in_trans_dims, 1);
   in_trans.Resize(in_trans_flat_dims);
@@ -344,7 +309,7 @@ void UniqueDimFunc(const lite::Tensor& in,
   out->Resize(out_trans_dims_vec);
   out->mutable_data<InT>();
   UniqueConcatFunc<InT>(input_unbind, 0, &out_trans);
-  UniqueTransCompute<InT>(out_trans, out, permute);
+  lite::host::math::Transpose<InT>(out_trans, out, permute);
   if (return_inverse) {
     UniqueTensorFromVector(inverse_vec, index);
   }
@@ -14,6 +14,11 @@
 
 #include "lite/kernels/x86/concat_compute.h"
 
+typedef paddle::lite::kernels::x86::ConcatInt8Compute<PRECISION(kInt8)>
+    ConcatInt8_Int8;
+typedef paddle::lite::kernels::x86::ConcatInt8Compute<PRECISION(kFloat)>
+    ConcatInt8_Fp32;
+
 REGISTER_LITE_KERNEL(concat,
                      kX86,
                      kFloat,
@@ -49,3 +54,17 @@ REGISTER_LITE_KERNEL(concat,
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kInt8, kNCHW, ConcatInt8_Int8, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kInt8, kNCHW, ConcatInt8_Fp32, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -15,6 +15,7 @@
 
 #include <Eigen/Core>
 #include <vector>
+#include "lite/backends/x86/math/calib.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -78,6 +79,65 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~ConcatCompute() = default;
 };
 
+// Int8 concat, each input is requantized from its own scale to the output
+// one, or copied when they are equal. OutType is the precision of the
+// output, int8 or float.
+template <PrecisionType OutType>
+class ConcatInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ConcatParam;
+
+  void Run() override {
+    auto& param = *param_.get_mutable<param_t>();
+    CHECK_EQ(param.input_scales.size(), param.x.size());
+    int axis = param.axis;
+    if (param.axis_tensor != nullptr) {
+      axis = param.axis_tensor->template data<int>()[0];
+    }
+    const auto& x_dims = param.x[0]->dims();
+    if (axis < 0) {
+      axis += static_cast<int>(x_dims.size());
+    }
+
+    auto* out = param.output;
+    int offset_concat_axis = 0;
+    int num_concat = count(0, axis, x_dims);
+    int concat_input_size = count(axis + 1, x_dims.size(), x_dims);
+    const int top_concat_axis = out->dims()[axis];
+    for (size_t i = 0; i < param.x.size(); ++i) {
+      const int8_t* bottom_data = param.x[i]->template data<int8_t>();
+      const int bottom_concat_axis = param.x[i]->dims()[axis];
+      const int size = bottom_concat_axis * concat_input_size;
+      for (int n = 0; n < num_concat; ++n) {
+        const int8_t* src = bottom_data + n * size;
+        int offset =
+            (n * top_concat_axis + offset_concat_axis) * concat_input_size;
+        if (OutType == PRECISION(kInt8)) {
+          int8_t* dst = out->template mutable_data<int8_t>() + offset;
+          float scale = param.input_scales[i] / param.output_scale;
+          if (scale == 1.f) {
+            std::memcpy(dst, src, size);
+          } else {
+            lite::x86::math::int8_to_int8(
+                src, dst, &scale, 1, bottom_concat_axis, concat_input_size);
+          }
+        } else {
+          float* dst = out->template mutable_data<float>() + offset;
+          lite::x86::math::int8_to_fp32(src,
+                                        dst,
+                                        &param.input_scales[i],
+                                        1,
+                                        bottom_concat_axis,
+                                        concat_input_size);
+        }
+      }
+      offset_concat_axis += bottom_concat_axis;
+    }
+  }
+
+  virtual ~ConcatInt8Compute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
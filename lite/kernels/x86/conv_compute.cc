@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/conv_compute.h"
+#include <algorithm>
 #include <utility>
 #include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/kernels/x86/conv_depthwise.h"
 #include "lite/kernels/x86/conv_direct.h"
 
@@ -63,6 +65,16 @@ namespace x86 {
   bool flag_dw_5x5 =                                                          \
       (kernel_h == 5) && (kernel_w == 5) && (stride_h == 1 || stride_h == 2);
 
+// The im2col buffer of one image, which holds the columns of all groups.
+template <typename T>
+static size_t ConvColDataSize(const operators::ConvParam& param) {
+  auto w_dims = param.filter->dims();
+  auto o_dims = param.output->dims();
+  return static_cast<size_t>(param.x->dims()[1] * w_dims[2] * w_dims[3] *
+                             o_dims[2] * o_dims[3]) *
+         sizeof(T);
+}
+
 #define PREPARE_PARAM_INT8                                          \
   auto& param = this->Param<param_t>();                             \
   const int input_channel = param.x->dims()[1];                     \
@@ -79,6 +91,70 @@ namespace x86 {
   bool pads_equal =                                                 \
       ((paddings[0] == paddings[1]) && (paddings[2] == paddings[3]));
 
+// The shapes and attributes the speed of a conv algorithm depends on.
+static std::string ConvSignature(const operators::ConvParam& param) {
+  return "conv2d/fp32/x=" + Join(param.x->dims().Vectorize(), ",") + "/w=" +
+         Join(param.filter->dims().Vectorize(), ",") + "/s=" +
+         Join(param.strides, ",") + "/p=" + Join(*param.paddings, ",") +
+         "/d=" + Join(*param.dilations, ",") + "/g=" +
+         std::to_string(param.groups) + "/act=" +
+         std::to_string(static_cast<int>(param.activation_param.active_type));
+}
+
+static KernelLite<TARGET(kX86), PRECISION(kFloat)>* NewConvImpl(
+    const std::string& algo) {
+  if (algo == "depthwise") {
+    return new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
+  }
+#if defined(_WIN64) || defined(__MINGW64__) || \
+    (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__)
+  if (algo == "direct") {
+    return new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
+  }
+#endif
+  LOG(FATAL) << "Unknown conv2d algorithm: " << algo;
+  return nullptr;
+}
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareGemm() {
+  auto& param = this->Param<param_t>();
+  workspace_size_ = flag_1x1gemm_ ? 0 : ConvColDataSize<float>(param);
+  ctx_->As<X86Context>().ExtendWorkspace(workspace_size_);
+
+#ifdef LITE_WITH_X86_SGEMM
+  //! pack the weights of every group once for the built-in sgemm
+  const int input_channel = param.x->dims()[1];
+  const int output_channel = param.filter->dims()[0];
+  const int groups = param.groups;
+  const int kernel_h = param.filter->dims()[2];
+  const int kernel_w = param.filter->dims()[3];
+  const int m = output_channel / groups;
+  const int k = input_channel * kernel_h * kernel_w / groups;
+  const int64_t group_size_packed = lite::x86::math::sgemm_packed_a_size(m, k);
+  weights_ = PreparedWeights::Global().Get(
+      *param.filter,
+      "x86/conv2d/sgemm_packed_a/groups=" + std::to_string(groups),
+      [&](Tensor* packed) {
+        packed->Resize({groups * group_size_packed});
+        auto weights = param.filter->data<float>();
+        auto weights_packed = packed->mutable_data<float>();
+        for (int g = 0; g < groups; g++) {
+          lite::x86::math::sgemm_prepack_a(
+              false,
+              m,
+              k,
+              weights + g * m * k,
+              k,
+              weights_packed + g * group_size_packed);
+        }
+      });
+#endif
+}
+
+template <>
+void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run();
+
 template <>
 void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   PREPARE_PARAM
@@ -100,13 +176,8 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
                        (paddings[2] == paddings[3]);
   bool flag_p = paddings[0] <= stride_h;
 
-  //! select conv impl
-  if (dw_kernel && kps_equal && flag_dw && pads_equal &&
-      ((flag_dw_5x5 && no_dilation) || (flag_dw_3x3 && (groups & 3) == 0))) {
-    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    VLOG(3) << "invoking conv_depthwise_3x3p0p1 or conv_depthwise_5x5";
-  }
-
+  //! the candidate algorithms, the one picked by the rules above first
+  std::vector<std::string> algos;
   // support 3x3s1p01,5x5s1p01,7x7s1p01
   //  3x3s2p012,5x5s1p012,7x7s1p012
   if (output_channel % 8 == 0 && groups == 1 &&
@@ -115,17 +186,60 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
       pad_all_equal && flag_p) {
 #if defined(_WIN64) || defined(__MINGW64__) || \
     (defined(__CYGWIN__) && defined(__x86_64__)) || defined(__x86_64__)
-    impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
-    VLOG(3) << "invoking directConv";
+    algos.push_back("direct");
 #endif
   }
-
-  if (impl_) {
+  if (dw_kernel && kps_equal && flag_dw && pads_equal &&
+      ((flag_dw_5x5 && no_dilation) || (flag_dw_3x3 && (groups & 3) == 0))) {
+    algos.push_back("depthwise");
+  }
+  algos.push_back("gemm");
+
+  std::string algo = algos.front();
+  if (algos.size() > 1 && KernelTuner::Global().enabled()) {
+    // Time the candidates on the real input. The output they write is
+    // overwritten by the run that follows. A candidate is only prepared when
+    // it's timed, a tuned op prepares nothing but its winner.
+    std::vector<std::unique_ptr<KernelLite<TARGET(kX86), PRECISION(kFloat)>>>
+        impls(algos.size());
+    std::vector<bool> prepared(algos.size(), false);
+    auto prepare = [&](int i) {
+      if (prepared[i]) return;
+      prepared[i] = true;
+      if (algos[i] == "gemm") {
+        PrepareGemm();
+        return;
+      }
+      impls[i].reset(NewConvImpl(algos[i]));
+      impls[i]->SetContext(
+          ContextScheduler::Global().NewContext(TARGET(kX86)));
+      impls[i]->SetParam(param);
+      impls[i]->PrepareForRun();
+      impls[i]->ReInitWhenNeeded();
+    };
+    algo = KernelTuner::Global().Tune(ConvSignature(param), algos, [&](int i) {
+      prepare(i);
+      if (impls[i]) {
+        impls[i]->Run();
+      } else {
+        Run();
+      }
+    });
+    int winner = std::find(algos.begin(), algos.end(), algo) - algos.begin();
+    prepare(winner);
+    impl_ = impls[winner].release();
+    // The packed weights of the gemm are only kept if it wins.
+    if (impl_) weights_.reset();
+  } else if (algo != "gemm") {
+    impl_ = NewConvImpl(algo);
     impl_->SetContext(std::move(this->ctx_));
     impl_->SetParam(param);
     impl_->PrepareForRun();
-    is_first_epoch_ = false;
+  } else {
+    PrepareGemm();
   }
+  VLOG(3) << "invoking conv2d " << algo;
+  is_first_epoch_ = false;
 }
 
 template <>
@@ -153,9 +267,10 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   float* col_data = nullptr;
 
   if (!flag_1x1gemm_) {
-    size_t col_size = group_size_coldata * group;
-    size_t col_data_size = static_cast<size_t>(col_size * sizeof(float));
-    col_data = static_cast<float*>(TargetMalloc(TARGET(kX86), col_data_size));
+    workspace_size_ =
+        static_cast<size_t>(group_size_coldata) * group * sizeof(float);
+    ctx.ExtendWorkspace(workspace_size_);
+    col_data = ctx.workspace_data<float>();
   }
   auto act_param = param.activation_param;
   paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(ctx);
@@ -190,6 +305,21 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
         matmul.GEMV<float>(
             false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
       } else {
+#ifdef LITE_WITH_X86_SGEMM
+        lite::x86::math::sgemm_prepacked_a(
+            false,
+            m,
+            n,
+            k,
+            1.f,
+            weights_->data<float>() +
+                g * lite::x86::math::sgemm_packed_a_size(m, k),
+            col_data_group,
+            n,
+            0.f,
+            dout_group,
+            n);
+#else
         matmul.GEMM<float>(false,
                            false,
                            m,
@@ -203,13 +333,13 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                            0.f,
                            dout_group,
                            n);
+#endif
       }
     }
     //! bias and activate
     lite::x86::math::fill_bias_act(
         dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
 }
 
 template <>
@@ -221,6 +351,8 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
   } else {
     flag_1x1gemm_ = false;
   }
+  workspace_size_ = flag_1x1gemm_ ? 0 : ConvColDataSize<int8_t>(param);
+  ctx_->As<X86Context>().ExtendWorkspace(workspace_size_);
 
   auto o_dims = param.output->dims();
   int m = output_channel / groups;
@@ -304,9 +436,10 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   auto dilations = *param.dilations;
 
   if (!flag_1x1gemm_) {
-    int col_size = group * group_size_coldata;
-    col_data = static_cast<int8_t*>(
-        TargetMalloc(TARGET(kX86), col_size * sizeof(int8_t)));
+    auto& ctx = ctx_->As<X86Context>();
+    workspace_size_ = static_cast<size_t>(group) * group_size_coldata;
+    ctx.ExtendWorkspace(workspace_size_);
+    col_data = ctx.workspace_data<int8_t>();
   }
   for (int b = 0; b < num; ++b) {
     for (int g = 0; g < group; ++g) {
@@ -337,7 +470,6 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
       }
     }
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
 }
 
 template <>
@@ -349,6 +481,8 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
   } else {
     flag_1x1gemm_ = false;
   }
+  workspace_size_ = flag_1x1gemm_ ? 0 : ConvColDataSize<int8_t>(param);
+  ctx_->As<X86Context>().ExtendWorkspace(workspace_size_);
 
   auto o_dims = param.output->dims();
   int m = output_channel / groups;
@@ -435,9 +569,10 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   auto dilations = *param.dilations;
 
   if (!flag_1x1gemm_) {
-    int col_size = group * group_size_coldata;
-    col_data = static_cast<int8_t*>(
-        TargetMalloc(TARGET(kX86), col_size * sizeof(int8_t)));
+    auto& ctx = ctx_->As<X86Context>();
+    workspace_size_ = static_cast<size_t>(group) * group_size_coldata;
+    ctx.ExtendWorkspace(workspace_size_);
+    col_data = ctx.workspace_data<int8_t>();
   }
   for (int b = 0; b < num; ++b) {
     for (int g = 0; g < group; ++g) {
@@ -468,7 +603,6 @@ void Conv2dCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
       }
     }
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
 }
 
 #undef PREPARE_PARAM
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <memory>
 #include <string>
 #include <vector>
 #include "lite/backends/x86/math/avx/conv_utils.h"
@@ -21,9 +22,11 @@
 #include "lite/backends/x86/math/conv_bias.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/backends/x86/math/im2col.h"
+#include "lite/backends/x86/math/packed_sgemm.h"
 #include "lite/backends/x86/math/vol2col.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/prepared_weights.h"
 #include "lite/core/types.h"
 #include "lite/operators/conv_op.h"
 
@@ -64,6 +67,7 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
   virtual void SetProfileRuntimeKernelInfo(
       paddle::lite::profile::OpCharacter* ch) {
     ch->kernel_func_name = "NotImplForConv";
+    ch->workspace_size = workspace_size_;
   }
 #endif
 
@@ -79,12 +83,18 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
+  // Reserves the im2col buffer and packs the weights for the gemm.
+  void PrepareGemm();
+
   KernelLite<TARGET(kX86), Ptype>* impl_{nullptr};
   Context<TargetType::kX86>* device_ctx;
   bool flag_1x1gemm_{false};
   bool flag_trans_bias_{true};
+  // bytes of the im2col buffer taken from the context workspace
+  size_t workspace_size_{0};
   std::vector<float> w_scale_;
-  Tensor weights_;
+  // the packed weights of the fp32 gemm, shared by the clones
+  std::shared_ptr<const Tensor> weights_;
   Tensor bias_;
   std::vector<lite::x86::math::generate_gemm_s8u8_x86_kern<float>*>
       gemm_s8_ptr_float_{};
@@ -47,13 +47,15 @@ void DirectConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int oh = o_dims[2];
   int ow = o_dims[3];
 
-  float* trans_out = static_cast<float*>(
-      TargetMalloc(TARGET(kX86), sizeof(float) * bs * oc_expand_ * oh * ow));
+  auto& ctx = this->ctx_->template As<X86Context>();
+  workspace_size_ = sizeof(float) * bs * oc_expand_ * oh * ow;
+  ctx.ExtendWorkspace(workspace_size_);
+  float* trans_out = ctx.workspace_data<float>();
   memset(trans_out, 0, sizeof(float) * oc * oh * ow * bs);
 
   auto act_param = param.activation_param;
   code_->run(i_data,
-             weights_.data<float>(),
+             weights_->data<float>(),
              trans_out,
              bs,
              ic,
@@ -78,7 +80,6 @@ void DirectConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                                              b_data,
                                              act_param.active_type,
                                              act_param);
-  TargetFree(TARGET(kX86), trans_out);
 }
 }  // namespace x86
 }  // namespace kernels
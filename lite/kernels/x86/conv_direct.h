@@ -15,12 +15,14 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 #include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/backends/x86/math/conv_direct_fp32.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
+#include "lite/core/prepared_weights.h"
 #include "lite/core/target_wrapper.h"
 
 namespace paddle {
@@ -54,11 +56,20 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
     int cround = ROUNDUP(oc, block);
     oc_expand_ = cround;
     // [chout, chin, wh, ww] -> [chout / block, chin, wh, ww, block]
-    weights_.Resize({cround / block, ic, wh, ww, block});
-    auto filter_data = param.filter->template data<float>();
-    auto weights_w_data = weights_.mutable_data<float>();
-    lite::x86::math::conv_trans_weights_numc(
-        filter_data, weights_w_data, oc, ic, wh, ww, block);
+    weights_ = PreparedWeights::Global().Get(
+        *param.filter,
+        "x86/conv2d_direct/numc/block=" + std::to_string(block),
+        [&](Tensor* weights) {
+          weights->Resize({cround / block, ic, wh, ww, block});
+          lite::x86::math::conv_trans_weights_numc(
+              param.filter->template data<float>(),
+              weights->mutable_data<float>(),
+              oc,
+              ic,
+              wh,
+              ww,
+              block);
+        });
 
     auto x_dims = param.x->dims();
     auto w_dims = param.filter->dims();
@@ -75,12 +86,17 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
     code_->generate_code(
         ic, ih, iw, oc, oc_expand_, oh, ow, ph, pw, wh, ww, param.strides[1]);
     code_->ready();
+
+    // the blocked output is written to the context workspace first
+    workspace_size_ = sizeof(float) * x_dims[0] * oc_expand_ * oh * ow;
+    this->ctx_->template As<X86Context>().ExtendWorkspace(workspace_size_);
   }
 
 #ifdef LITE_WITH_PROFILE
   virtual void SetProfileRuntimeKernelInfo(
       paddle::lite::profile::OpCharacter* ch) {
     ch->kernel_func_name = kernel_func_name_;
+    ch->workspace_size = workspace_size_;
   }
 
   std::string kernel_func_name_{"NotImplForConvDirect"};
@@ -88,13 +104,14 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
-  Tensor weights_;
+  std::shared_ptr<const Tensor> weights_;
   Tensor bias_;
   Tensor trans_in_;
   bool flag_trans_weights_{false};
   bool flag_trans_bias_{false};
   std::vector<float> w_scale_;
   int oc_expand_;
+  size_t workspace_size_{0};
   lite::x86::math::conv_direct* code_;
 };
 
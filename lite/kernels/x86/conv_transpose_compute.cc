@@ -74,12 +74,25 @@ void Conv2DTransposeCompute<PRECISION(kFloat),
   int m = chout * kw * kh / param.groups;
   int n = hin * win;
 
-  workspace_size_ = param.groups * m * n * sizeof(float);
+  auto paddings = *param.paddings;
   auto dilations = *param.dilations;
   bool ks_equal = (param.strides[0] == param.strides[1]) && (kw == kh);
   bool no_dilation = (dilations[0] == 1) && (dilations[1] == 1);
+  bool stride_1 = param.strides[0] == 1 && param.strides[1] == 1;
+  bool stride_2 = param.strides[0] == 2 && param.strides[1] == 2;
   depthwise_ =
       (param.groups == chin && chin == chout && ks_equal && no_dilation);
+  bool pads_zero = paddings[0] == 0 && paddings[1] == 0 && paddings[2] == 0 &&
+                   paddings[3] == 0;
+  bool flag_1x1s1p1 =
+      kw == 1 && kh == 1 && stride_1 && pads_zero && no_dilation;
+  // Only the gemm + col2im path needs the column buffer.
+  if (flag_1x1s1p1 || (depthwise_ && (stride_1 || stride_2))) {
+    workspace_size_ = 0;
+  } else {
+    workspace_size_ = static_cast<size_t>(param.groups) * m * n * sizeof(float);
+  }
+  ctx_->As<X86Context>().ExtendWorkspace(workspace_size_);
   is_first_epoch_ = false;
 }
 
@@ -115,10 +128,11 @@ void Conv2DTransposeCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                 : nullptr;
   float* col_data = nullptr;
 
-  if (!flag_1x1s1p1) {
-    int col_size = param.groups * group_size_coldata;
-    col_data = static_cast<float*>(
-        TargetMalloc(TARGET(kX86), col_size * sizeof(float)));
+  if (!flag_1x1s1p1 && !depthwise_s1 && !depthwise_s2) {
+    workspace_size_ =
+        static_cast<size_t>(param.groups) * group_size_coldata * sizeof(float);
+    ctx.ExtendWorkspace(workspace_size_);
+    col_data = ctx.workspace_data<float>();
   }
 
   for (int i = 0; i < num; i++) {
@@ -174,7 +188,6 @@ void Conv2DTransposeCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     lite::x86::math::fill_bias_act(
         dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
   }
-  if (!flag_1x1s1p1) TargetFree(TARGET(kX86), col_data);
 }
 
 }  // namespace x86
@@ -38,6 +38,7 @@ class Conv2DTransposeCompute : public KernelLite<TARGET(kX86), Ptype> {
   virtual void SetProfileRuntimeKernelInfo(
       paddle::lite::profile::OpCharacter* ch) {
     ch->kernel_func_name = kernel_func_name_;
+    ch->workspace_size = workspace_size_;
   }
 
 #define PROFILE_INFO(dtype1, dtype2)                                        \
@@ -45,6 +46,7 @@ class Conv2DTransposeCompute : public KernelLite<TARGET(kX86), Ptype> {
   void Conv2DTransposeCompute<PRECISION(dtype1), PRECISION(dtype2)>::       \
       SetProfileRuntimeKernelInfo(paddle::lite::profile::OpCharacter* ch) { \
     ch->kernel_func_name = kernel_func_name_;                               \
+    ch->workspace_size = workspace_size_;                                   \
   }
 
 #define KERNEL_FUNC_NAME(kernel_func_name) kernel_func_name_ = kernel_func_name;
@@ -55,7 +57,7 @@ class Conv2DTransposeCompute : public KernelLite<TARGET(kX86), Ptype> {
 #endif
 
  protected:
-  int workspace_size_{0};
+  size_t workspace_size_{0};
   bool depthwise_{false};
   bool flag_trans_bias_{false};
   std::vector<float> w_scale_;
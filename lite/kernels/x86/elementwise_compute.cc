@@ -17,9 +17,11 @@
 
 #include "lite/kernels/x86/elementwise_compute.h"
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "lite/backends/x86/math/elementwise.h"
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
+#include "lite/backends/x86/math/elementwise_int8.h"
 #include "lite/kernels/host/elementwise_op_func.h"
 
 namespace paddle {
@@ -350,6 +352,56 @@ void elementwise_compute_template(paddle::lite::KernelBase* kernel,
     }                                                                         \
   }
 
+template <bool kMul, PrecisionType OutType>
+void elementwise_int8_compute(paddle::lite::KernelBase* kernel) {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  auto& param = kernel->template Param<operators::ElementwiseParam>();
+  std::vector<int64_t> x_dims;
+  std::vector<int64_t> y_dims;
+  lite::kernels::host::fix_x_y_dims<int64_t>(
+      param.X, param.Y, param.Out, param.axis, &x_dims, &y_dims);
+  auto out_dims = param.Out->dims().Vectorize();
+  float out_scale = OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+  auto* out_data = param.Out->template mutable_data<OutT>();
+  if (kMul) {
+    lite::x86::math::elementwise_mul_int8(param.X->template data<int8_t>(),
+                                          param.Y->template data<int8_t>(),
+                                          out_data,
+                                          x_dims,
+                                          y_dims,
+                                          out_dims,
+                                          param.x_input_scale,
+                                          param.y_input_scale,
+                                          out_scale);
+  } else {
+    lite::x86::math::elementwise_add_int8(param.X->template data<int8_t>(),
+                                          param.Y->template data<int8_t>(),
+                                          out_data,
+                                          x_dims,
+                                          y_dims,
+                                          out_dims,
+                                          param.x_input_scale,
+                                          param.y_input_scale,
+                                          out_scale);
+  }
+}
+
+template <PrecisionType OutType>
+void ElementwiseAddInt8Compute<OutType>::Run() {
+  elementwise_int8_compute<false, OutType>(this);
+}
+
+template <PrecisionType OutType>
+void ElementwiseMulInt8Compute<OutType>::Run() {
+  elementwise_int8_compute<true, OutType>(this);
+}
+
+template class ElementwiseAddInt8Compute<PRECISION(kInt8)>;
+template class ElementwiseAddInt8Compute<PRECISION(kFloat)>;
+template class ElementwiseMulInt8Compute<PRECISION(kInt8)>;
+template class ElementwiseMulInt8Compute<PRECISION(kFloat)>;
+
 // clang-format off
 ElementwiseOpCompute(Add)
 ElementwiseOpActivationCompute(Add)
@@ -736,3 +788,56 @@ REGISTER_LITE_KERNEL(elementwise_min,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .Finalize();
+
+typedef paddle::lite::kernels::x86::ElementwiseAddInt8Compute<PRECISION(kInt8)>
+    ElementwiseAddInt8_Int8;
+typedef paddle::lite::kernels::x86::ElementwiseAddInt8Compute<PRECISION(kFloat)>
+    ElementwiseAddInt8_Fp32;
+typedef paddle::lite::kernels::x86::ElementwiseMulInt8Compute<PRECISION(kInt8)>
+    ElementwiseMulInt8_Int8;
+typedef paddle::lite::kernels::x86::ElementwiseMulInt8Compute<PRECISION(kFloat)>
+    ElementwiseMulInt8_Fp32;
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kX86,
+                     kInt8,
+                     kNCHW,
+                     ElementwiseAddInt8_Int8,
+                     int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kX86,
+                     kInt8,
+                     kNCHW,
+                     ElementwiseAddInt8_Fp32,
+                     fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul,
+                     kX86,
+                     kInt8,
+                     kNCHW,
+                     ElementwiseMulInt8_Int8,
+                     int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul,
+                     kX86,
+                     kInt8,
+                     kNCHW,
+                     ElementwiseMulInt8_Fp32,
+                     fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
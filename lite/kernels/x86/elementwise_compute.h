@@ -184,6 +184,26 @@ class ElementwisePowActivationCompute
   virtual ~ElementwisePowActivationCompute() = default;
 };
 
+// Int8 elementwise add and mul, the inputs are requantized with their own
+// scales. OutType is the precision of the output, int8 or float.
+template <PrecisionType OutType>
+class ElementwiseAddInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseAddInt8Compute() = default;
+};
+
+template <PrecisionType OutType>
+class ElementwiseMulInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseMulInt8Compute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -63,7 +63,8 @@ class FCFunctor {
                   T* Y,
                   const T* B = nullptr,
                   bool relu = false,
-                  bool padding_weights = false) {
+                  bool padding_weights = false,
+                  const T* packed_w = nullptr) {
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
     T* Y1_data = nullptr;
 
@@ -82,8 +83,9 @@ class FCFunctor {
     };
 
     // Because of the overhead of memcpy, we only do padding for GEMM
-    //  when weights is already padded in fc_fuse_pass.
-    if (padding_weights) {
+    //  when weights is already padded in fc_fuse_pass. Packed weights
+    //  already carry their own layout.
+    if (padding_weights && !packed_w) {
       const int NN = N + 4;
       const int KK = K + 4;
 
@@ -130,7 +132,16 @@ class FCFunctor {
       }
       parallel_compute(0, M);
     } else {
+#ifdef LITE_WITH_X86_SGEMM
+      if (packed_w) {
+        lite::x86::math::sgemm_prepacked_b(
+            false, M, N, K, 1.f, X, K, packed_w, 0.f, Y, N);
+      } else {
+        blas.MatMul(M, N, K, X, W, Y);
+      }
+#else
       blas.MatMul(M, N, K, X, W, Y);
+#endif
       if (!B) {
         return;
       }
@@ -139,6 +150,48 @@ class FCFunctor {
   }
 };
 
+template <PrecisionType PType, PrecisionType OutType>
+void FcCompute<PType, OutType>::PrepareForRun() {}
+
+template <>
+void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = *param_.get_mutable<param_t>();
+  const auto& w_dims = param.w->dims();
+  if (param.dynamic_quant) {
+    int K = w_dims[0];
+    int N = w_dims[1];
+    CHECK(param.w->precision() == PRECISION(kInt8))
+        << "the weights of a dynamic quant fc must be int8";
+    CHECK(!param.padding_weights);
+    CHECK_EQ(param.weight_scale.size(), static_cast<size_t>(N));
+    packed_w_int8_ = PreparedWeights::Global().Get(
+        *param.w, "x86/fc/s8u8_packed_b", [&](Tensor* packed_w) {
+          packed_w->Resize({lite::x86::math::gemm_s8u8_packed_b_size(N, K)});
+          lite::x86::math::gemm_s8u8_prepack_b(
+              false,
+              N,
+              K,
+              param.w->template data<int8_t>(),
+              packed_w->mutable_data<uint8_t>());
+        });
+    return;
+  }
+#ifdef LITE_WITH_X86_SGEMM
+  int K = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+  int N = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+  packed_w_ = PreparedWeights::Global().Get(
+      *param.w, "x86/fc/sgemm_packed_b", [&](Tensor* packed_w) {
+        packed_w->Resize({lite::x86::math::sgemm_packed_b_size(N, K)});
+        lite::x86::math::sgemm_prepack_b(false,
+                                         N,
+                                         K,
+                                         param.w->template data<float>(),
+                                         w_dims[1],
+                                         packed_w->mutable_data<float>());
+      });
+#endif
+}
+
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = *param_.get_mutable<param_t>();
@@ -156,8 +209,21 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int M = output->dims().production() / w_dims1;
 
   const float* input_data = input->template data<float>();
-  const float* w_data = w->template data<float>();
   float* output_data = output->template mutable_data<float>();
+  if (param.dynamic_quant) {
+    lite::x86::math::gemm_s8u8_dynamic(
+        M,
+        w_dims1,
+        w_dims0,
+        input_data,
+        packed_w_int8_->data<uint8_t>(),
+        param.weight_scale.data(),
+        bias ? bias->template data<float>() : nullptr,
+        output_data,
+        with_relu);
+    return;
+  }
+  const float* w_data = w->template data<float>();
 
   auto& context = ctx_->As<X86Context>();
   FCFunctor<lite::TargetType::kX86, float> fc;
@@ -170,7 +236,12 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
      output_data,
      bias ? bias->template data<float>() : NULL,
      with_relu,
+#ifdef LITE_WITH_X86_SGEMM
+     padding_weights,
+     packed_w_->data<float>());
+#else
      padding_weights);
+#endif
 }
 
 template <>
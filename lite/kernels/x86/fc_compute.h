@@ -14,14 +14,17 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/packed_sgemm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/prepared_weights.h"
 #include "lite/core/type_system.h"
 #include "lite/operators/fc_op.h"
 
@@ -35,9 +38,19 @@ class FcCompute : public KernelLite<TARGET(kX86), PType> {
  public:
   using param_t = operators::FcParam;
 
+  virtual void PrepareForRun();
+
   virtual void Run();
 
   virtual ~FcCompute() = default;
+
+ private:
+#ifdef LITE_WITH_X86_SGEMM
+  // weights packed once for the built-in sgemm, shared by the clones
+  std::shared_ptr<const Tensor> packed_w_;
+#endif
+  // int8 weights of post_quant_dynamic packed once for the s8u8 gemm
+  std::shared_ptr<const Tensor> packed_w_int8_;
 };
 
 }  // namespace x86
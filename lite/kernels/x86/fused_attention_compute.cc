@@ -0,0 +1,159 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fused_attention_compute.h"
+#include <string>
+#include <vector>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fused_attention.h"
+#include "lite/backends/x86/math/packed_sgemm.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/prepared_weights.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void FusedAttentionCompute::PrepareForRun() {
+#ifdef LITE_WITH_X86_SGEMM
+  auto& param = this->Param<param_t>();
+  const auto& w_dims = param.fc_w->dims();
+  int K = w_dims[0];
+  int N = w_dims[1];
+  packed_w_ = PreparedWeights::Global().Get(
+      *param.fc_w, "x86/fused_attention/sgemm_packed_b", [&](Tensor* packed_w) {
+        packed_w->Resize({lite::x86::math::sgemm_packed_b_size(N, K)});
+        lite::x86::math::sgemm_prepack_b(false,
+                                         N,
+                                         K,
+                                         param.fc_w->data<float>(),
+                                         N,
+                                         packed_w->mutable_data<float>());
+      });
+#endif
+}
+
+void FusedAttentionCompute::Run() {
+  auto& param = this->Param<param_t>();
+  CHECK(param.activation_type.empty())
+      << "fused_attention on x86 does not support the fc activation "
+      << param.activation_type;
+  auto input_dims = param.input->dims();
+  auto w_dims = param.fc_w->dims();
+  auto out_dims = param.output->dims();
+  int in_num_col_dims = param.in_num_col_dims;
+  if (param.op_type == "matmul" || param.op_type == "matmul_v2") {
+    in_num_col_dims = input_dims.size() - 1;
+  }
+  int M = input_dims.Slice(0, in_num_col_dims).production();
+  int K = input_dims.Slice(in_num_col_dims, input_dims.size()).production();
+  int N = w_dims[1];
+  CHECK_EQ(K, w_dims[0]);
+
+  // the output is [batch, head_num, seq_len, head_dim]
+  CHECK_EQ(out_dims.size(), 4UL);
+  int batch = out_dims[0];
+  int head_num = out_dims[1];
+  int seq_len = out_dims[2];
+  int head_dim = out_dims[3];
+  CHECK_EQ(M, batch * seq_len);
+  CHECK_EQ(N, 3 * head_num * head_dim);
+  int axis = param.softmax_axis;
+  CHECK(axis == -1 || axis == 3) << "softmax must be on the last axis, but "
+                                 << "the axis is " << axis;
+
+  // q/k/v fc, [batch, seq_len, 3, head_num, head_dim]
+  Tensor qkv;
+  qkv.Resize({M, N});
+  float* qkv_data = qkv.mutable_data<float>();
+  const float* input_data = param.input->data<float>();
+#ifdef LITE_WITH_X86_SGEMM
+  lite::x86::math::sgemm_prepacked_b(false,
+                                     M,
+                                     N,
+                                     K,
+                                     1.f,
+                                     input_data,
+                                     K,
+                                     packed_w_->data<float>(),
+                                     0.f,
+                                     qkv_data,
+                                     N);
+#else
+  auto& context = ctx_->As<X86Context>();
+  auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, float>(context);
+  blas.MatMul(M, N, K, input_data, param.fc_w->data<float>(), qkv_data);
+#endif
+  if (param.fc_bias) {
+    const float* bias = param.fc_bias->data<float>();
+    for (int i = 0; i < M; i++) {
+      float* row = qkv_data + i * N;
+      for (int j = 0; j < N; j++) {
+        row[j] += bias[j];
+      }
+    }
+  }
+
+  // the mask broadcasts to [batch, head_num, seq_len, seq_len] from the right
+  const float* mask = nullptr;
+  int64_t mask_strides[3] = {0, 0, 0};
+  if (param.residual) {
+    auto mask_dims = param.residual->dims();
+    int rank = mask_dims.size();
+    CHECK_LE(rank, 4);
+    CHECK_EQ(mask_dims[rank - 1], seq_len);
+    const int64_t full_dims[4] = {batch, head_num, seq_len, seq_len};
+    int64_t stride = 1;
+    for (int i = 3; i >= 0; i--) {
+      int64_t dim = i >= 4 - rank ? mask_dims[i - 4 + rank] : 1;
+      CHECK(dim == 1 || dim == full_dims[i])
+          << "the mask of dims " << mask_dims
+          << " can not broadcast to the scores";
+      if (i < 3) {
+        mask_strides[i] = dim == 1 ? 0 : stride;
+      }
+      stride *= dim;
+    }
+    mask = param.residual->data<float>();
+  }
+
+  lite::x86::math::fused_attention(qkv_data,
+                                   mask,
+                                   mask_strides,
+                                   param.output->mutable_data<float>(),
+                                   batch,
+                                   seq_len,
+                                   head_num,
+                                   head_dim,
+                                   param.scale);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fused_attention,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusedAttentionCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Residual", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
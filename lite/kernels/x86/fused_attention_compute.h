@@ -0,0 +1,52 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+/*
+ * fp32 fused_attention: one gemm for the concatenated q/k/v fc, then the
+ * attention of every head in tiles with an online softmax, so the
+ * seq_len x seq_len scores are never written to memory.
+ */
+class FusedAttentionCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusedAttentionParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~FusedAttentionCompute() = default;
+
+#ifdef LITE_WITH_X86_SGEMM
+ private:
+  // weights packed once for the built-in sgemm, shared by the clones
+  std::shared_ptr<const Tensor> packed_w_;
+#endif
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
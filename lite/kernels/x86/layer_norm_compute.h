@@ -17,6 +17,7 @@
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -71,15 +72,25 @@ class LayerNormCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto ker = paddle::lite::jit::KernelFuncs<jit::LayerNormTuple<T>,
                                               lite::fluid::CPUPlace>::Cache()
                    .At(right);
-    ker(in.mutable_data<T>(),
-        out.mutable_data<T>(),
-        Mean->template mutable_data<T>(),
-        Var->template mutable_data<T>(),
-        Scale->template data<T>(),
-        Bias->template data<T>(),
-        static_cast<int>(left),
-        epsilon,
-        right);
+    T* in_data = in.mutable_data<T>();
+    T* out_data = out.mutable_data<T>();
+    T* mean_data = Mean->template mutable_data<T>();
+    T* var_data = Var->template mutable_data<T>();
+    const T* scale_data = Scale->template data<T>();
+    const T* bias_data = Bias->template data<T>();
+    // rows are normalized independently, split them across threads
+    lite::x86::RunParallelFor(
+        0, left, [&](const int64_t begin, const int64_t end) {
+          ker(in_data + begin * right,
+              out_data + begin * right,
+              mean_data + begin,
+              var_data + begin,
+              scale_data,
+              bias_data,
+              static_cast<int>(end - begin),
+              epsilon,
+              right);
+        });
   }
 
   virtual ~LayerNormCompute() = default;
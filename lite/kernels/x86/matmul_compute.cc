@@ -14,6 +14,11 @@
 
 #include "lite/kernels/x86/matmul_compute.h"
 
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<PRECISION(kInt8)>
+    MatMulInt8_Int8;
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<PRECISION(kFloat)>
+    MatMulInt8_Fp32;
+
 REGISTER_LITE_KERNEL(matmul,
                      kX86,
                      kFloat,
@@ -24,3 +29,15 @@ REGISTER_LITE_KERNEL(matmul,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(matmul, kX86, kInt8, kNCHW, MatMulInt8_Int8, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(matmul, kX86, kInt8, kNCHW, MatMulInt8_Fp32, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
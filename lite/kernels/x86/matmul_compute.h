@@ -13,7 +13,12 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_s8u8_compute.h"
+#include "lite/backends/x86/math/saturate.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -70,6 +75,135 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~MatMulCompute() = default;
 };
 
+/**
+ * Int8 matmul of two quantized activations, or of an activation and an int8
+ * weight whose scale is per tensor or per column. X rides in the place of
+ * the fc input: the rows of a batch of X are the packed A of the s8u8 gemm,
+ * Y is B. OutType is the precision of the output, int8 or float.
+ */
+template <PrecisionType OutType>
+class MatMulInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::MatMulParam;
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+
+  void Run() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
+        RowMatrixFromVector(param.X->dims()), 0, param.transpose_X);
+    auto mat_dim_b = lite::x86::math::CreateMatrixDescriptor(
+        ColumnMatrixFromVector(param.Y->dims()), 0, param.transpose_Y);
+    CHECK_EQ(mat_dim_a.width_, mat_dim_b.height_);
+    CHECK(mat_dim_a.batch_size_ == mat_dim_b.batch_size_ ||
+          mat_dim_a.batch_size_ == 0 || mat_dim_b.batch_size_ == 0)
+        << "int8 matmul only broadcasts a batch of one";
+    const int m = mat_dim_a.height_;
+    const int n = mat_dim_b.width_;
+    const int k = mat_dim_a.width_;
+    const int batch = (std::max)(
+        (std::max)(mat_dim_a.batch_size_, mat_dim_b.batch_size_),
+        static_cast<int64_t>(1));
+    const bool per_column = param.weight_scale.size() > 1;
+    CHECK(!param.weight_scale.empty()) << "the scale of Y is not set";
+    if (per_column) {
+      CHECK_EQ(param.weight_scale.size(), static_cast<size_t>(n))
+          << "the scale of Y must be per tensor or per column";
+    }
+    // A per column scale is applied after the gemm, which then computes
+    // float of the unscaled Y.
+    std::vector<float> row_scale(
+        m, per_column ? param.alpha : param.weight_scale[0] * param.alpha);
+    const float output_scale =
+        OutType == PRECISION(kInt8) ? param.output_scale : 1.f;
+
+    const int8_t *x_data = param.X->template data<int8_t>();
+    const int8_t *y_data = param.Y->template data<int8_t>();
+    OutT *out_data = param.Out->template mutable_data<OutT>();
+    if (per_column && OutType == PRECISION(kInt8)) {
+      tmp_out_.Resize({m, n});
+    }
+    for (int b = 0; b < batch; ++b) {
+      const int8_t *a = x_data + (mat_dim_a.batch_size_ ? b : 0) *
+                                     mat_dim_a.stride_;
+      const int8_t *w = y_data + (mat_dim_b.batch_size_ ? b : 0) *
+                                     mat_dim_b.stride_;
+      OutT *c = out_data + static_cast<int64_t>(b) * m * n;
+      if (!per_column) {
+        lite::x86::math::generate_gemm_s8u8_x86_kern<OutT> gemm(
+            mat_dim_a.trans_,
+            mat_dim_b.trans_,
+            m,
+            n,
+            k,
+            a,
+            n,
+            row_scale.data(),
+            param.input_scale,
+            output_scale,
+            nullptr,
+            0,
+            1.f);
+        gemm.compute(a, w, c);
+        continue;
+      }
+      float *c_fp32 = OutType == PRECISION(kInt8)
+                          ? tmp_out_.mutable_data<float>()
+                          : reinterpret_cast<float *>(c);
+      lite::x86::math::generate_gemm_s8u8_x86_kern<float> gemm(
+          mat_dim_a.trans_,
+          mat_dim_b.trans_,
+          m,
+          n,
+          k,
+          a,
+          n,
+          row_scale.data(),
+          param.input_scale,
+          1.f,
+          nullptr,
+          0,
+          1.f);
+      gemm.compute(a, w, c_fp32);
+      ScaleColumns(c_fp32, m, n, param.weight_scale, output_scale, c);
+    }
+  }
+
+  virtual ~MatMulInt8Compute() = default;
+
+ private:
+  // out = in * scale[column], requantized for an int8 out
+  static void ScaleColumns(const float *in,
+                           int m,
+                           int n,
+                           const std::vector<float> &scale,
+                           float output_scale,
+                           float *out) {
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        out[i * n + j] = in[i * n + j] * scale[j];
+      }
+    }
+  }
+
+  static void ScaleColumns(const float *in,
+                           int m,
+                           int n,
+                           const std::vector<float> &scale,
+                           float output_scale,
+                           int8_t *out) {
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        int8_t v = lite::x86::math::saturate_cast<int8_t>(
+            roundf(in[i * n + j] * scale[j] / output_scale));
+        out[i * n + j] = v < -127 ? -127 : v;
+      }
+    }
+  }
+
+  lite::Tensor tmp_out_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,6 +14,60 @@
 
 #include "lite/kernels/x86/pool_compute.h"
 
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+template <PrecisionType OutType>
+void PoolInt8Compute<OutType>::Run() {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  auto& param = this->template Param<param_t>();
+  auto& in_dims = param.x->dims();
+  auto& out_dims = param.output->dims();
+  CHECK_EQ(in_dims.size(), 4u) << "int8 pool2d only supports NCHW input";
+  CHECK(!param.adaptive) << "int8 pool2d does not support adaptive pooling";
+  bool is_max = param.pooling_type == "max";
+  CHECK(is_max || param.pooling_type == "avg")
+      << "unsupported pooling type: " << param.pooling_type;
+  std::vector<int> ksize = param.ksize;
+  if (param.global_pooling) {
+    ksize = {static_cast<int>(in_dims[2]), static_cast<int>(in_dims[3])};
+  }
+  float scale = param.input_scale;
+  if (OutType == PRECISION(kInt8)) {
+    scale /= param.output_scale;
+  }
+  lite::x86::math::pooling_int8(param.x->template data<int8_t>(),
+                                param.output->template mutable_data<OutT>(),
+                                in_dims[0],
+                                in_dims[1],
+                                in_dims[2],
+                                in_dims[3],
+                                out_dims[2],
+                                out_dims[3],
+                                ksize,
+                                param.strides,
+                                *param.paddings,
+                                is_max,
+                                param.exclusive,
+                                scale);
+}
+
+template class PoolInt8Compute<PRECISION(kInt8)>;
+template class PoolInt8Compute<PRECISION(kFloat)>;
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+typedef paddle::lite::kernels::x86::PoolInt8Compute<PRECISION(kInt8)>
+    PoolInt8_Int8;
+typedef paddle::lite::kernels::x86::PoolInt8Compute<PRECISION(kFloat)>
+    PoolInt8_Fp32;
+
 REGISTER_LITE_KERNEL(pool2d,
                      kX86,
                      kFloat,
@@ -23,3 +77,13 @@ REGISTER_LITE_KERNEL(pool2d,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kInt8, kNCHW, PoolInt8_Int8, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kInt8, kNCHW, PoolInt8_Fp32, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -14,7 +14,13 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/fluid/eigen.h"
+#ifdef __AVX__
+#include "lite/backends/x86/math/avx/conv_utils.h"
+#endif
 #include "lite/backends/x86/math/math_function.h"
 #include "lite/backends/x86/math/pooling.h"
 #include "lite/core/kernel.h"
@@ -40,6 +46,9 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
     switch (param.ksize.size()) {
       case 2: {
+        if (std::is_same<T, float>::value && RunFloat(param)) {
+          break;
+        }
         if (param.pooling_type == "max") {
           paddle::lite::x86::math::Pool2dFunctor<
               lite::TargetType::kX86,
@@ -54,7 +63,7 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
                          *param.paddings,
                          pool_process,
                          true,
-                         false,
+                         param.adaptive,
                          param.output);
         } else if (param.pooling_type == "avg") {
           paddle::lite::x86::math::Pool2dFunctor<
@@ -79,6 +88,154 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
   }
   virtual ~PoolCompute() = default;
+
+ private:
+  // The vectorized fp32 paths: global, 2x2s2 and 3x3s2 in NCHW, the other
+  // non adaptive windows on NCHW8c when the channels allow. Returns false
+  // when none of them applies.
+  bool RunFloat(const param_t& param) {
+    namespace math = paddle::lite::x86::math;
+    auto& in_dims = param.x->dims();
+    auto& out_dims = param.output->dims();
+    if (in_dims.size() != 4 || out_dims.size() != 4) return false;
+    bool is_max = param.pooling_type == "max";
+    if (!is_max && param.pooling_type != "avg") return false;
+    const int num = in_dims[0];
+    const int chin = in_dims[1];
+    const int hin = in_dims[2];
+    const int win = in_dims[3];
+    const int hout = out_dims[2];
+    const int wout = out_dims[3];
+    const std::vector<int>& ksize = param.ksize;
+    const std::vector<int>& strides = param.strides;
+    const std::vector<int>& paddings = *param.paddings;
+    const float* din = param.x->template data<float>();
+    float* dout = param.output->template mutable_data<float>();
+
+    bool no_pad = paddings[0] == 0 && paddings[2] == 0;
+    bool whole_window =
+        param.global_pooling || param.adaptive ||
+        (ksize[0] == hin && ksize[1] == win && no_pad);
+    if (hout == 1 && wout == 1 && whole_window) {
+      if (is_max) {
+        math::pooling_global_max(din, dout, num, chin, hin, win);
+      } else {
+        math::pooling_global_avg(din, dout, num, chin, hin, win);
+      }
+      return true;
+    }
+    if (param.adaptive) return false;
+    bool s2 = strides[0] == 2 && strides[1] == 2 && ksize[0] == ksize[1];
+    if (s2 && ksize[0] == 2) {
+      if (is_max) {
+        math::pooling2x2s2_max(din,
+                               dout,
+                               num,
+                               chin,
+                               hin,
+                               win,
+                               hout,
+                               wout,
+                               paddings[0],
+                               paddings[2]);
+      } else {
+        math::pooling2x2s2_avg(din,
+                               dout,
+                               num,
+                               chin,
+                               hin,
+                               win,
+                               hout,
+                               wout,
+                               paddings[0],
+                               paddings[2],
+                               param.exclusive);
+      }
+      return true;
+    }
+    if (s2 && ksize[0] == 3) {
+      if (is_max) {
+        math::pooling3x3s2_max(din,
+                               dout,
+                               num,
+                               chin,
+                               hin,
+                               win,
+                               hout,
+                               wout,
+                               paddings[0],
+                               paddings[2]);
+      } else {
+        math::pooling3x3s2_avg(din,
+                               dout,
+                               num,
+                               chin,
+                               hin,
+                               win,
+                               hout,
+                               wout,
+                               paddings[0],
+                               paddings[2],
+                               param.exclusive);
+      }
+      return true;
+    }
+#ifdef __AVX__
+    if (chin % 8 == 0) {
+      const int cblocks = chin / 8;
+      math::pack8_m256(param.x, &packed_x_, cblocks, false);
+      packed_out_.Resize({num, cblocks, hout, wout, 8});
+      if (is_max) {
+        math::pooling_nchwc_max(packed_x_.data<float>(),
+                                packed_out_.mutable_data<float>(),
+                                num,
+                                cblocks,
+                                8,
+                                hin,
+                                win,
+                                hout,
+                                wout,
+                                ksize,
+                                strides,
+                                paddings);
+      } else {
+        math::pooling_nchwc_avg(packed_x_.data<float>(),
+                                packed_out_.mutable_data<float>(),
+                                num,
+                                cblocks,
+                                8,
+                                hin,
+                                win,
+                                hout,
+                                wout,
+                                ksize,
+                                strides,
+                                paddings,
+                                param.exclusive);
+      }
+      math::unpack8_m256(&packed_out_, param.output);
+      return true;
+    }
+#endif
+    return false;
+  }
+
+#ifdef __AVX__
+  lite::Tensor packed_x_;
+  lite::Tensor packed_out_;
+#endif
+};
+
+// Int8 pool2d on NCHW, max or avg with 2-D windows. OutType is the
+// precision of the output, int8 or float.
+template <PrecisionType OutType>
+class PoolInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::PoolParam;
+
+  void Run() override;
+
+  virtual ~PoolInt8Compute() = default;
 };
 
 }  // namespace x86
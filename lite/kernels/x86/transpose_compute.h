@@ -14,9 +14,8 @@
 
 #pragma once
 
-#include <Eigen/Core>
 #include <vector>
-#include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/host/math/transpose.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -28,42 +27,6 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
-template <lite::TargetType Target, typename T>
-inline void TransCompute(const int dim,
-                         const lite::Context<Target>& context,
-                         const lite::Tensor& in,
-                         lite::Tensor* out,
-                         const std::vector<int>& axis) {
-  switch (dim) {
-    case 1:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 1> trans1;
-      trans1(context, in, out, axis);
-      break;
-    case 2:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 2> trans2;
-      trans2(context, in, out, axis);
-      break;
-    case 3:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 3> trans3;
-      trans3(context, in, out, axis);
-      break;
-    case 4:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 4> trans4;
-      trans4(context, in, out, axis);
-      break;
-    case 5:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 5> trans5;
-      trans5(context, in, out, axis);
-      break;
-    case 6:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 6> trans6;
-      trans6(context, in, out, axis);
-      break;
-    default:
-      LOG(FATAL) << "Tensors with rank at most 6 are supported";
-  }
-}
-
 template <typename T>
 class TransposeCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -75,14 +38,11 @@ class TransposeCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto* out = param.output;
     auto* x_ptr = x->template data<T>();
     auto* out_ptr = out->template mutable_data<T>();
-    int ndims = param.axis.size();
-    auto& context = ctx_->As<X86Context>();
     if (!param.x->dims().size()) {
       out_ptr[0] = x_ptr[0];
       return;
     }
-    TransCompute<lite::TargetType::kX86, T>(
-        ndims, context, *x, out, param.axis);
+    lite::host::math::Transpose<T>(*x, out, param.axis);
   }
 
   virtual ~TransposeCompute() = default;
@@ -99,14 +59,11 @@ class Transpose2Compute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto* out = param.output;
     auto* x_ptr = x->template data<T>();
     auto* out_ptr = out->template mutable_data<T>();
-    int ndims = param.axis.size();
-    auto& context = ctx_->As<X86Context>();
     if (!param.x->dims().size()) {
       out_ptr[0] = x_ptr[0];
       return;
     }
-    TransCompute<lite::TargetType::kX86, T>(
-        ndims, context, *x, out, param.axis);
+    lite::host::math::Transpose<T>(*x, out, param.axis);
   }
 
   virtual ~Transpose2Compute() = default;
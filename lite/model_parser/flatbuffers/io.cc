@@ -13,17 +13,79 @@
 // limitations under the License.
 
 #include "lite/model_parser/flatbuffers/io.h"
+#include <cstdint>
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 #include "lite/core/model/base/io.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/model_parser/flatbuffers/traits.h"
 
 namespace paddle {
 namespace lite {
 namespace fbs {
+namespace {
+// A tensor buffer that points into the memory of a model reader. It moves to
+// an allocation of its own if the tensor needs more space.
+class ParamViewBuffer : public lite::Buffer {
+ public:
+  ParamViewBuffer(void* data, size_t size, const std::shared_ptr<void>& holder)
+      : lite::Buffer(data, TARGET(kHost), size), holder_(holder) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (holder_ && (target != target_ || space_ < size)) {
+      holder_.reset();
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+    }
+    lite::Buffer::ResetLazy(target, size);
+  }
+
+  void Free() override {
+    lite::Buffer::Free();
+    if (holder_) {
+      holder_.reset();
+      own_data_ = true;
+    }
+  }
+
+ private:
+  std::shared_ptr<void> holder_;
+};
+
+// The params are copied in chunks of this size, so that a few large params
+// are still spread over the threads.
+constexpr size_t kParamCopyChunk = 4 * 1024 * 1024;
+
+size_t AlignUp(size_t pos, size_t alignment) {
+  return (pos + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+uint32_t Crc32(const void* data, size_t size) {
+  static const std::vector<uint32_t> table = [] {
+    std::vector<uint32_t> t(256);
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  uint32_t crc = 0xFFFFFFFFU;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFU;
+}
+
 namespace deprecated {
 void SetCombinedParamsWithScope(const lite::Scope& scope,
                                 const std::set<std::string>& param_names,
@@ -68,6 +130,181 @@ void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param) {
   std::memcpy(dst, param.GetData(), param.byte_size());
   tensor->set_persistable(true);
 }
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<void>& holder) {
+  CHECK(tensor);
+  CHECK(param.GetData());
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  tensor->ResetBuffer(
+      std::make_shared<ParamViewBuffer>(
+          const_cast<void*>(param.GetData()), param.byte_size(), holder),
+      param.byte_size());
+  tensor->set_persistable(true);
+}
+
+void IndexedParamSerializer::ForwardWrite(
+    const lite::Scope& scope, const std::set<std::string>& param_names) {
+  constexpr size_t kEntryFixedBytes = 2 * sizeof(uint64_t) +
+                                      3 * sizeof(uint32_t) +
+                                      2 * sizeof(uint16_t);
+  std::vector<ParamIndexEntry> index;
+  std::vector<const lite::Tensor*> tensors;
+  uint64_t index_size = 0;
+  for (const auto& name : param_names) {
+    auto& tensor = scope.FindVar(name)->Get<lite::Tensor>();
+    ParamIndexEntry entry;
+    entry.name = name;
+    entry.dims = tensor.dims().Vectorize();
+    entry.data_type =
+        static_cast<int32_t>(lite::ConvertPrecisionType(tensor.precision()));
+    entry.length = tensor.memory_size();
+    entry.alignment = kParamDataAlignment;
+    entry.checksum =
+        entry.length ? Crc32(tensor.raw_data(), tensor.memory_size()) : 0;
+    CHECK_LT(entry.name.size(), (std::numeric_limits<uint16_t>::max)());
+    CHECK_LT(entry.dims.size(), (std::numeric_limits<uint16_t>::max)());
+    index_size += kEntryFixedBytes + sizeof(int64_t) * entry.dims.size() +
+                  entry.name.size();
+    index.push_back(std::move(entry));
+    tensors.push_back(&tensor);
+  }
+  CHECK_LT(index.size(), (std::numeric_limits<uint32_t>::max)());
+
+  // Lay out the data behind the index.
+  size_t pos = writer_->current() + sizeof(uint16_t) + sizeof(uint32_t) +
+               sizeof(uint64_t) + index_size;
+  for (auto& entry : index) {
+    pos = AlignUp(pos, entry.alignment);
+    entry.offset = pos;
+    pos += entry.length;
+  }
+
+  writer_->Write<uint16_t>(0U);
+  writer_->Write<uint32_t>(static_cast<uint32_t>(index.size()));
+  writer_->Write<uint64_t>(index_size);
+  for (const auto& entry : index) {
+    writer_->Write<uint64_t>(entry.offset);
+    writer_->Write<uint64_t>(entry.length);
+    writer_->Write<uint32_t>(entry.alignment);
+    writer_->Write<int32_t>(entry.data_type);
+    writer_->Write<uint32_t>(entry.checksum);
+    writer_->Write<uint16_t>(static_cast<uint16_t>(entry.dims.size()));
+    writer_->Write<uint16_t>(static_cast<uint16_t>(entry.name.size()));
+    if (!entry.dims.empty()) {
+      writer_->Write(entry.dims.data(), sizeof(int64_t) * entry.dims.size());
+    }
+    writer_->Write(entry.name.data(), entry.name.size());
+  }
+  for (size_t i = 0; i < index.size(); ++i) {
+    while (writer_->current() < index[i].offset) {
+      writer_->Write<uint8_t>(0U);
+    }
+    if (index[i].length) {
+      writer_->Write(tensors[i]->raw_data(), index[i].length);
+    }
+  }
+}
+
+void IndexedParamDeserializer::ReadIndex() {
+  uint16_t version = reader_->Read<uint16_t>();
+  CHECK_EQ(version, 0U)
+      << "File format error: The version of params must be zero.";
+  uint32_t params_size = reader_->Read<uint32_t>();
+  uint64_t index_size = reader_->Read<uint64_t>();
+  CHECK_LE(index_size, reader_->length() - reader_->current())
+      << "File format error: The index of params is truncated.";
+  model_parser::Buffer buf(index_size);
+  reader_->Read(buf.data(), index_size);
+
+  const char* cur = static_cast<const char*>(buf.data());
+  const char* end = cur + index_size;
+  auto read = [&](void* dst, size_t size) {
+    CHECK_LE(size, static_cast<size_t>(end - cur))
+        << "File format error: The index of params is truncated.";
+    std::memcpy(dst, cur, size);
+    cur += size;
+  };
+  index_.resize(params_size);
+  for (auto& entry : index_) {
+    uint16_t dims_size = 0;
+    uint16_t name_size = 0;
+    read(&entry.offset, sizeof(entry.offset));
+    read(&entry.length, sizeof(entry.length));
+    read(&entry.alignment, sizeof(entry.alignment));
+    read(&entry.data_type, sizeof(entry.data_type));
+    read(&entry.checksum, sizeof(entry.checksum));
+    read(&dims_size, sizeof(dims_size));
+    read(&name_size, sizeof(name_size));
+    entry.dims.resize(dims_size);
+    if (dims_size) {
+      read(entry.dims.data(), sizeof(int64_t) * dims_size);
+    }
+    entry.name.resize(name_size);
+    if (name_size) {
+      read(&entry.name[0], name_size);
+    }
+    CHECK_LE(entry.offset + entry.length, reader_->length())
+        << "File format error: The data of param " << entry.name
+        << " is out of range.";
+  }
+}
+
+void IndexedParamDeserializer::ForwardRead(lite::Scope* scope,
+                                           bool verify_checksum) {
+  CHECK(scope) << "The pointer of scope is nullptr";
+  struct Chunk {
+    char* dst;
+    size_t pos;
+    size_t size;
+  };
+  std::vector<Chunk> chunks;
+  std::vector<lite::Tensor*> tensors;
+  for (const auto& entry : index_) {
+    auto* tensor = scope->Var(entry.name)->GetMutable<lite::Tensor>();
+    tensor->Resize(entry.dims);
+    tensor->set_precision(lite::ConvertPrecisionType(
+        static_cast<lite::VarDataType>(entry.data_type)));
+    tensor->set_persistable(true);
+    tensors.push_back(tensor);
+    const void* view = reader_->ViewAt(entry.offset, entry.length);
+    if (view && entry.length &&
+        reinterpret_cast<uintptr_t>(view) % kParamDataAlignment == 0) {
+      tensor->ResetBuffer(std::make_shared<ParamViewBuffer>(
+                              const_cast<void*>(view),
+                              entry.length,
+                              reader_->view_holder()),
+                          entry.length);
+      continue;
+    }
+    // The tensors are allocated here and filled by the threads below.
+    char* dst = static_cast<char*>(tensor->mutable_data(entry.length));
+    for (size_t i = 0; i < entry.length; i += kParamCopyChunk) {
+      chunks.push_back({dst + i,
+                        static_cast<size_t>(entry.offset) + i,
+                        (std::min)(kParamCopyChunk,
+                                   static_cast<size_t>(entry.length) - i)});
+    }
+  }
+
+  LITE_PARALLEL_BEGIN(i, tid, static_cast<int>(chunks.size())) {
+    reader_->ReadAt(chunks[i].dst, chunks[i].size, chunks[i].pos);
+  }
+  LITE_PARALLEL_END();
+
+  if (verify_checksum) {
+    LITE_PARALLEL_BEGIN(i, tid, static_cast<int>(index_.size())) {
+      const auto& entry = index_[i];
+      if (entry.checksum) {
+        CHECK_EQ(Crc32(tensors[i]->raw_data(), entry.length), entry.checksum)
+            << "The data of param " << entry.name << " is corrupted.";
+      }
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 void ParamSerializer::ForwardWrite(const lite::Scope& scope,
                                    const std::set<std::string>& param_names) {
@@ -99,10 +336,23 @@ void ParamSerializer::ForwardWrite(const lite::Scope& scope,
 
     const size_t param_bytes = buf_->size();
     CHECK(param_bytes) << "The bytes size of param can not be zero";
-    constexpr uint32_t offset = sizeof(uint32_t);
+    // Pad in front of the param to put its tensor data at an aligned offset
+    // of the file. Readers skip the padding as part of `offset`.
+    const size_t data_offset =
+        static_cast<const char*>(ParamDescView(buf_.get()).GetData()) -
+        static_cast<const char*>(buf_->data());
+    const size_t data_pos =
+        writer_->current() + 2 * sizeof(uint32_t) + data_offset;
+    const uint32_t padding_bytes =
+        (kParamDataAlignment - data_pos % kParamDataAlignment) %
+        kParamDataAlignment;
+    const uint32_t offset = sizeof(uint32_t) + padding_bytes;
     const uint32_t total_size = param_bytes + offset;
     writer_->Write<uint32_t>(total_size);
     writer_->Write<uint32_t>(offset);
+    for (uint32_t j = 0; j < padding_bytes; ++j) {
+      writer_->Write<uint8_t>(0U);
+    }
     writer_->Write(buf_->data(), param_bytes);
   }
 }
@@ -130,6 +380,18 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
+    const void* view = reader_->ReadView(param_bytes);
+    if (view) {
+      fbs::ParamDescView param(view, param_bytes);
+      auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+      if (reinterpret_cast<uintptr_t>(param.GetData()) % kParamDataAlignment) {
+        // Written by an older opt without the alignment padding.
+        FillTensor(tensor, param);
+      } else {
+        ShareTensor(tensor, param, reader_->view_holder());
+      }
+      continue;
+    }
     ReadBytesToBuffer(param_bytes);
     fbs::ParamDescView param(buf_.get());
     FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
@@ -33,6 +33,16 @@ void FillParam(const std::string& name,
 
 void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param);
 
+// The params written by ParamSerializer keep their tensor data at offsets of
+// the file aligned to this, so that a mapped model can be used in place.
+constexpr size_t kParamDataAlignment = 64;
+
+// Let the tensor use the data of the param in place, `holder` keeps the
+// memory of the param alive.
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<void>& holder);
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 class ParamSerializer {
  public:
@@ -74,6 +84,78 @@ class ParamDeserializer {
   std::unique_ptr<model_parser::Buffer> buf_;
 };
 
+/*
+ * Params of the naive buffer model with meta_version=3. An index in front of
+ * the params lists where the data of every param is, so that the params can
+ * be filled in parallel, or used in place when the reader is mapped.
+ * ------------------------------------------------------------------
+ * |   PART         |   Precision     |   Length(byte)              |
+ * |   version      |   uint16_t      |   2                         |
+ * |   params_size  |   uint32_t      |   4                         |
+ * |   index_size   |   uint64_t      |   8                         |
+ * |   index        |   char[]        |   index_size                |
+ * |   data         |   char[]        |   the data of all params    |
+ * ------------------------------------------------------------------
+ * Each entry of the index:
+ * |   offset       |   uint64_t      |   position of the data      |
+ * |   length       |   uint64_t      |   bytes of the data         |
+ * |   alignment    |   uint32_t      |   alignment of `offset`     |
+ * |   data_type    |   int32_t       |   lite::VarDataType         |
+ * |   checksum     |   uint32_t      |   crc32 of the data, or 0   |
+ * |   dims_size    |   uint16_t      |                             |
+ * |   name_size    |   uint16_t      |                             |
+ * |   dims         |   int64_t[]     |   8 * dims_size             |
+ * |   name         |   char[]        |   name_size                 |
+ * ------------------------------------------------------------------
+ * The positions are counted from the beginning of the reader, which is the
+ * beginning of the model file.
+ */
+struct ParamIndexEntry {
+  std::string name;
+  std::vector<int64_t> dims;
+  int32_t data_type{0};
+  uint64_t offset{0};
+  uint64_t length{0};
+  uint32_t alignment{1};
+  uint32_t checksum{0};
+};
+
+uint32_t Crc32(const void* data, size_t size);
+
+class IndexedParamSerializer {
+ public:
+  explicit IndexedParamSerializer(model_parser::ByteWriter* writer)
+      : writer_(writer) {
+    CHECK(writer_)
+        << "A valid writer should be passed in the ctor of param serializer.";
+  }
+  void ForwardWrite(const lite::Scope& scope,
+                    const std::set<std::string>& param_names);
+
+ private:
+  model_parser::ByteWriter* writer_{nullptr};
+};
+
+class IndexedParamDeserializer {
+ public:
+  explicit IndexedParamDeserializer(model_parser::ByteReader* reader)
+      : reader_(reader) {
+    CHECK(reader_)
+        << "A valid reader should be passed in the ctor of param deserializer.";
+    ReadIndex();
+  }
+  // Aligned params of a mapped reader are used in place and only paged in
+  // when they are touched. The others are copied by the threads of the
+  // `LITE_PARALLEL_*` loops.
+  void ForwardRead(lite::Scope* scope, bool verify_checksum = false);
+  const std::vector<ParamIndexEntry>& index() const { return index_; }
+
+ private:
+  void ReadIndex();
+  model_parser::ByteReader* reader_{nullptr};
+  std::vector<ParamIndexEntry> index_;
+};
+
 namespace deprecated {
 void SetScopeWithCombinedParams(lite::Scope* scope,
                                 const CombinedParamsDescReadAPI& params);
@@ -15,6 +15,7 @@
 #include "lite/model_parser/flatbuffers/io.h"
 #include <gtest/gtest.h>
 #include <functional>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -128,9 +129,86 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+
+  {
+    Scope scope_4;
+    LOG(INFO) << "Load params from mapped file...";
+    model_parser::MmapFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_4);
+    check_params(scope_4);
+    // The params are used in place, so their data must stay aligned.
+    for (const auto& name : param_names) {
+      const auto& tensor = scope_4.FindVar(name)->Get<Tensor>();
+      CHECK_EQ(reinterpret_cast<uintptr_t>(tensor.raw_data()) %
+                   kParamDataAlignment,
+               0u);
+    }
+  }
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
+TEST(IndexedParams, Scope) {
+  const std::string path{"io_test.indexed_params"};
+  Scope scope;
+  std::vector<std::string> param_names({"var_0", "var_1", "var_2", "var_3"});
+  std::vector<Tensor*> tensors;
+  for (const auto& name : param_names) {
+    tensors.push_back(scope.Var(name)->GetMutable<Tensor>());
+  }
+  set_tensor<float>(tensors[0], std::vector<int64_t>({3, 2}));
+  set_tensor<int8_t>(tensors[1], std::vector<int64_t>({10, 1}));
+  set_tensor<int16_t>(tensors[2], std::vector<int64_t>({16, 1}));
+  // Large enough to be copied in several chunks.
+  set_tensor<float>(tensors[3], std::vector<int64_t>({1024, 1025, 2}));
+  std::set<std::string> params_set(param_names.begin(), param_names.end());
+
+  {
+    model_parser::BinaryFileWriter writer{path};
+    // Put the params at an unaligned position of the file.
+    const uint8_t padding = 0;
+    writer.Write(&padding, sizeof(padding));
+    fbs::IndexedParamSerializer serializer{&writer};
+    serializer.ForwardWrite(scope, params_set);
+  }
+
+  auto check_params = [&](const lite::Scope& loaded) {
+    for (size_t i = 0; i < param_names.size(); ++i) {
+      const auto& tensor = loaded.FindVar(param_names[i])->Get<Tensor>();
+      CHECK(TensorCompareWith(*tensors[i], tensor));
+    }
+  };
+
+  {
+    Scope scope_0;
+    model_parser::BinaryFileReader reader(path);
+    uint8_t padding;
+    reader.Read(&padding, sizeof(padding));
+    fbs::IndexedParamDeserializer deserializer(&reader);
+    ASSERT_EQ(deserializer.index().size(), param_names.size());
+    for (const auto& entry : deserializer.index()) {
+      EXPECT_EQ(entry.offset % kParamDataAlignment, 0u);
+    }
+    deserializer.ForwardRead(&scope_0, true);
+    check_params(scope_0);
+  }
+
+  {
+    Scope scope_1;
+    model_parser::MmapFileReader reader(path);
+    uint8_t padding;
+    reader.Read(&padding, sizeof(padding));
+    fbs::IndexedParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_1, true);
+    check_params(scope_1);
+    // The mapped params are used in place.
+    const auto& tensor = scope_1.FindVar(param_names[3])->Get<Tensor>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.raw_data()) %
+                  kParamDataAlignment,
+              0u);
+  }
+}
+
 }  // namespace fbs
 }  // namespace lite
 }  // namespace paddle
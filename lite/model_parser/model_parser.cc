@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <fstream>
 #include <limits>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -39,6 +40,7 @@
 #include "lite/model_parser/pb/var_desc.h"
 #include "lite/model_parser/ssa/program_desc.h"
 #endif
+#include "lite/utils/env.h"
 #include "lite/utils/io.h"
 namespace paddle {
 namespace lite {
@@ -468,14 +470,14 @@ void AppendToFile(const std::string &filename,
 /* ---------- Flatbuffers ---------- */
 void SaveModelNaive(const std::string &model_file,
                     const Scope &exec_scope,
-                    const cpp::ProgramDesc &cpp_prog) {
+                    const cpp::ProgramDesc &cpp_prog,
+                    uint16_t meta_version) {
   model_parser::Buffer buffer;
   /* 1. Save model to model.fbs */
   const std::string prog_path = model_file + ".nb";
   model_parser::BinaryFileWriter writer{prog_path};
 
   // Meta_version(uint16), default value is 2.
-  uint16_t meta_version = 2;
   // You can modify meta_version by register environment variable
   // 'PADDLE_LITE_MODEL_VERSION1'
   const char *PADDLE_LITE_EXPERIMENTAL_MODEL =
@@ -530,9 +532,15 @@ void SaveModelNaive(const std::string &model_file,
       serializer.ForwardWrite(exec_scope, unique_var_names);
       break;
     }
+    case 3: {
+      fbs::IndexedParamSerializer serializer{&writer};
+      // 3.3 Save the index of params and the aligned params into naive model
+      serializer.ForwardWrite(exec_scope, unique_var_names);
+      break;
+    }
     default: {
       LOG(FATAL) << "Error: Unsupported opt meta_version, "
-                    "meta_version should be set as 1 or 2.";
+                    "meta_version should be set as 1, 2 or 3.";
       break;
     }
   }
@@ -738,22 +746,30 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
  *      opt_version:  lite_version of opt tool that transformed this model.
  *      topo_size:    length of `topo_data`.
  *      topo_data:    contains model's topology data.
- *      param_data:   contains model's params data.
+ *      param_data:   contains model's params data, with meta_version=3 it
+ *                    starts with an index of the params, see
+ *                    fbs::IndexedParamSerializer.
  */
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            bool use_mmap) {
   CHECK(cpp_prog);
   CHECK(scope);
   // ModelFile
   const std::string prog_path = filename;
   // Offset
-  model_parser::BinaryFileReader reader(filename, 0);
+  std::unique_ptr<model_parser::ByteReader> reader;
+  if (use_mmap) {
+    reader.reset(new model_parser::MmapFileReader(filename, 0));
+  } else {
+    reader.reset(new model_parser::BinaryFileReader(filename, 0));
+  }
 
   // (1)get meta version
   uint16_t meta_version;
-  reader.Read(&meta_version, sizeof(uint16_t));
+  reader->Read(&meta_version, sizeof(uint16_t));
   VLOG(4) << "Meta_version:" << meta_version;
 
   switch (meta_version) {
@@ -767,10 +783,13 @@ void LoadModelNaiveFromFile(const std::string &filename,
 #endif
       break;
     case 1:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 1);
+      LoadModelFbsFromFile(reader.get(), scope, cpp_prog, 1);
       break;
     case 2:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromFile(reader.get(), scope, cpp_prog, 2);
+      break;
+    case 3:
+      LoadModelFbsFromFile(reader.get(), scope, cpp_prog, 3);
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -835,7 +854,7 @@ void LoadModelNaiveV0FromFile(const std::string &filename,
   VLOG(4) << "Load naive buffer model in '" << filename << "' successfully";
 }
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
+void LoadModelFbsFromFile(model_parser::ByteReader *reader,
                           Scope *scope,
                           cpp::ProgramDesc *cpp_prog,
                           uint16_t meta_version) {
@@ -894,6 +913,13 @@ void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
       deserializer.ForwardRead(scope);
       break;
     }
+    case 3: {
+      /* load scope from the indexed params with meta_version=3 */
+      fbs::IndexedParamDeserializer deserializer(reader);
+      deserializer.ForwardRead(
+          scope, GetBoolFromEnv("PADDLE_LITE_VERIFY_MODEL_CHECKSUM"));
+      break;
+    }
     default:
       LOG(FATAL) << "Unspported model meta_version " << meta_version;
       break;
@@ -930,6 +956,9 @@ void LoadModelNaiveFromMemory(const char *model_buffer,
     case 2:
       LoadModelFbsFromMemory(&reader, scope, cpp_prog, 2);
       break;
+    case 3:
+      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 3);
+      break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
                     "you use the correct interface and model file.";
@@ -975,7 +1004,7 @@ void LoadModelNaiveV0FromMemory(const std::string &model_buffer,
 }
 #endif
 ///////////////////////////////////////////////////////////////////
-// Meta_version=1,2
+// Meta_version=1,2,3
 ///////////////////////////////////////////////////////////////////
 void LoadModelFbsFromMemory(model_parser::CharBufferReader *reader,
                             Scope *scope,
@@ -1018,6 +1047,12 @@ void LoadModelFbsFromMemory(model_parser::CharBufferReader *reader,
       deserializer.ForwardRead(scope);
       break;
     }
+    case 3: {
+      fbs::IndexedParamDeserializer deserializer(reader);
+      deserializer.ForwardRead(
+          scope, GetBoolFromEnv("PADDLE_LITE_VERIFY_MODEL_CHECKSUM"));
+      break;
+    }
     default:
       LOG(FATAL) << "Unspported model meta_version " << meta_version;
       break;
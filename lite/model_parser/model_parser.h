@@ -98,9 +98,12 @@ void SaveCombinedParamsNaive(const std::string& path,
                              const lite::Scope& exec_scope,
                              const cpp::ProgramDesc& cpp_prog);
 
+// `meta_version` 2 writes the params one after another, 3 writes them behind
+// an index so that they can be loaded in parallel or in place.
 void SaveModelNaive(const std::string& model_dir,
                     const Scope& exec_scope,
-                    const cpp::ProgramDesc& cpp_prog);
+                    const cpp::ProgramDesc& cpp_prog,
+                    uint16_t meta_version = 2);
 
 void SaveModelFbs(const std::string& model_dir,
                   const Scope& exec_scope,
@@ -139,14 +142,17 @@ void LoadNonCombinedParamsPb(const std::string& model_dir,
                              const lite_api::CxxModelBuffer& model_buffer,
                              Scope* scope);
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader* reader,
+void LoadModelFbsFromFile(model_parser::ByteReader* reader,
                           Scope* scope,
                           cpp::ProgramDesc* cpp_prog,
                           uint16_t meta_version);
 
+// With `use_mmap`, the model file is mapped into memory and the params are
+// used in place instead of being copied into the scope.
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            bool use_mmap = false);
 
 void LoadModelNaiveFromMemory(const char* model_buffer,
                               size_t model_buffer_size,
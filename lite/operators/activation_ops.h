@@ -15,9 +15,7 @@
 #pragma once
 #include <string>
 #include "lite/core/op_lite.h"
-#ifdef LITE_WITH_PROFILE
 #include "lite/api/paddle_place.h"
-#endif
 
 namespace paddle {
 namespace lite {
@@ -39,7 +37,6 @@ class ActivationOp : public OpLite {
 
   std::string DebugString() const override { return "activation_op"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter* ch) {
     auto input_dims = param_.X->dims();
     auto output_dims = param_.Out->dims();
@@ -122,7 +119,6 @@ class ActivationOp : public OpLite {
                    << " doesn't support";
     }
   }
-#endif
 
  private:
   mutable operators::ActivationParam param_;
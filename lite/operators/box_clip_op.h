@@ -39,7 +39,6 @@ class BoxClipOpLite : public OpLite {
 
   std::string DebugString() const override { return "box clip"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.Input->dims();
     auto output_dims = param_.Output->dims();
@@ -48,7 +47,6 @@ class BoxClipOpLite : public OpLite {
     // ch->remark = "";
     ch->macs = param_.Output->numel() * 2.0;
   }
-#endif
 
  private:
   mutable BoxClipParam param_;
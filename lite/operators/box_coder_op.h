@@ -39,7 +39,6 @@ class BoxCoderOpLite : public OpLite {
 
   std::string DebugString() const override { return "box_coder"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     // auto input_dims = param_.Input->dims();
     // auto output_dims = param_.Output->dims();
@@ -52,7 +51,6 @@ class BoxCoderOpLite : public OpLite {
           param_.proposals->dims()[0] * param_.proposals->dims()[1] * 30.f;
     }
   }
-#endif
 
  private:
   mutable BoxCoderParam param_;
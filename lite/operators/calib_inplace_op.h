@@ -53,7 +53,6 @@ class CalibInplaceOpLite : public OpLite {
 
   std::string DebugString() const override { return "calibInplace"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.input->dims();
     auto output_dims = param_.output->dims();
@@ -62,7 +61,6 @@ class CalibInplaceOpLite : public OpLite {
     ch->remark = "scale" + std::to_string(param_.scale);
     ch->macs = param_.output->numel() * 1.0f;
   }
-#endif
 
  private:
   mutable CalibInplaceParam param_;
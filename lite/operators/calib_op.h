@@ -52,7 +52,6 @@ class CalibOpLite : public OpLite {
 
   std::string DebugString() const override { return "calib"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.input->dims();
     auto output_dims = param_.output->dims();
@@ -61,7 +60,6 @@ class CalibOpLite : public OpLite {
     ch->remark = "scale" + std::to_string(param_.scale);
     ch->macs = param_.output->numel() * 1.0f;
   }
-#endif
 
  private:
   mutable CalibParam param_;
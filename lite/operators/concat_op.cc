@@ -91,6 +91,21 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
       }
     }
   }
+
+  if (op_desc.HasAttr("enable_int8") && op_desc.GetAttr<bool>("enable_int8")) {
+    param_.enable_int8 = true;
+    param_.input_scales.clear();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      auto scale_name = "X" + std::to_string(i) + "_scale";
+      param_.input_scales.push_back(
+          op_desc.GetAttr<std::vector<float>>(scale_name)[0]);
+    }
+    // only set when the output is int8
+    if (op_desc.HasAttr("Out0_scale")) {
+      param_.output_scale =
+          op_desc.GetAttr<std::vector<float>>("Out0_scale")[0];
+    }
+  }
   return true;
 }
 
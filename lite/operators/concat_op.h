@@ -44,7 +44,6 @@ class ConcatOpLite : public OpLite {
     return true;
   }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto output_dims = param_.output->dims();
     std::string inputs_shape = "";
@@ -57,7 +56,6 @@ class ConcatOpLite : public OpLite {
     ch->remark = "axis" + std::to_string(param_.axis);
     ch->macs = 0.f;  // no calc. only io operation
   }
-#endif
 
  private:
   mutable ConcatParam param_;
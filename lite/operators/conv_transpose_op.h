@@ -21,9 +21,7 @@
 #include "lite/core/tensor.h"
 #include "lite/operators/op_params.h"
 #include "lite/utils/all.h"
-#ifdef LITE_WITH_PROFILE
 #include "lite/api/paddle_place.h"
-#endif
 
 namespace paddle {
 namespace lite {
@@ -45,7 +43,6 @@ class ConvTransposeOpLite : public OpLite {
 
   std::string DebugString() const override { return "conv_transpose"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto filter_dims = param_.filter->dims();
     auto input_dims = param_.x->dims();
@@ -66,7 +63,6 @@ class ConvTransposeOpLite : public OpLite {
     ch->macs = 2.f * filter_dims[2] * filter_dims[3] *
                output_dims.production() * input_dims[1] / param_.groups;
   }
-#endif
 
  private:
   mutable ConvParam param_;
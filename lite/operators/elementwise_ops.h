@@ -37,7 +37,6 @@ class ElementwiseOp : public OpLite {
 
   std::string DebugString() const override { return "elementwise_op"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter* ch) {
     auto output_dims = param_.Out->dims();
     ch->input_shape = "X" + ch->DimToStr(param_.X->dims()) + "Y" +
@@ -46,7 +45,6 @@ class ElementwiseOp : public OpLite {
     ch->remark = "axis" + std::to_string(param_.axis);
     ch->macs = 1.0f * param_.Out->numel();
   }
-#endif
 
  private:
   mutable operators::ElementwiseParam param_;
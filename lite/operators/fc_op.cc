@@ -147,6 +147,13 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   if (op_desc.HasAttr("op_type")) {
     param_.op_type = op_desc.GetAttr<std::string>("op_type");
   }
+  if (op_desc.HasAttr("quantization_type") &&
+      op_desc.GetAttr<std::string>("quantization_type") ==
+          "post_dynamic_channel_wise_abs_max") {
+    param_.dynamic_quant = true;
+    param_.weight_scale =
+        op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
+  }
 
   return true;
 }
@@ -45,7 +45,6 @@ class FcOpLite : public OpLite {
 
   std::string DebugString() const override { return "fc"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto m = param_.input->dims().count(0, param_.in_num_col_dims);
     ch->input_shape = ch->DimToStr(param_.input->dims());
@@ -54,7 +53,6 @@ class FcOpLite : public OpLite {
     ch->remark = (param_.bias ? "Bias" : "") + param_.activation_type;
     ch->macs = m * param_.w->dims()[0] * param_.w->dims()[1] * 3.0f;
   }
-#endif
 
  private:
   mutable FcParam param_;
@@ -39,14 +39,12 @@ class InterpolateOp : public OpLite {
 
   std::string DebugString() const override { return "interpolate"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->remark = param_.interp_method;
     ch->macs = param_.Out->numel() * 14.f;
   }
-#endif
 
  private:
   mutable InterpolateParam param_;
@@ -68,14 +66,12 @@ class LinearInterpolateOp : public OpLite {
 
   std::string DebugString() const override { return "interpolate"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->remark = param_.interp_method;
     ch->macs = param_.Out->numel() * 14.f;
   }
-#endif
 
  private:
   mutable InterpolateParam param_;
@@ -39,14 +39,12 @@ class InterpolateV2Op : public OpLite {
 
   std::string DebugString() const override { return "interpolate"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->remark = param_.interp_method;
     ch->macs = param_.Out->numel() * 14.f;
   }
-#endif
 
  private:
   mutable InterpolateParam param_;
@@ -69,14 +67,12 @@ class LinearInterpolateV2Op : public OpLite {
 
   std::string DebugString() const override { return "interpolate"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->remark = param_.interp_method;
     ch->macs = param_.Out->numel() * 14.f;
   }
-#endif
 
  private:
   mutable InterpolateParam param_;
@@ -38,7 +38,6 @@ class BinaryLogicalOp : public OpLite {
 
   std::string DebugString() const override { return "binary logical"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = "X" + ch->DimToStr(param_.X->dims()) + "Y" +
                       ch->DimToStr(param_.Y->dims());
@@ -46,7 +45,6 @@ class BinaryLogicalOp : public OpLite {
     // ch->remark = "";
     ch->macs = param_.Out->numel() * 3.f;
   }
-#endif
 
  private:
   mutable LogicalParam param_;
@@ -67,13 +65,11 @@ class UnaryLogicalOp : public OpLite {
 
   std::string DebugString() const override { return "binary logical"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = "X" + ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->macs = param_.Out->numel() * 3.f;
   }
-#endif
 
  private:
   mutable LogicalParam param_;
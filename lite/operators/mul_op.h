@@ -81,7 +81,6 @@ class MulOpLite : public OpLite {
 
   std::string DebugString() const override { return "mul"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.x->dims());
     ch->filter_shape = ch->DimToStr(param_.y->dims());
@@ -93,7 +92,6 @@ class MulOpLite : public OpLite {
     auto y_mat_dims = y_dims.Flatten2D(param_.y_num_col_dims);
     ch->macs = 1.f * x_mat_dims[0] * x_mat_dims[1] * y_mat_dims[1];
   }
-#endif
 
  private:
   mutable MulParam param_;
@@ -37,13 +37,11 @@ class OneHotV2Op : public OpLite {
 
   std::string DebugString() const override { return "one_hot_v2"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->output_shape = ch->DimToStr(param_.Out->dims());
     ch->macs = param_.X->numel() * 1.f;
   }
-#endif
 
  private:
   mutable OneHotParam param_;
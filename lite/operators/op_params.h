@@ -115,6 +115,9 @@ struct FcParam : ParamBase {
   float alpha{6.f};
   // for int8
   WITH_INT8_CONFIG
+  // int8 w with per-column weight_scale, the fp32 input is quantized per row
+  // at runtime (post_quant_dynamic with QUANT_INT8_DYNAMIC)
+  bool dynamic_quant{false};
 };
 
 struct FusedAttentionParam : ParamBase {
@@ -325,6 +328,9 @@ struct ConcatParam : ParamBase {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  // for int8
+  WITH_INT8_CONFIG
+  std::vector<float> input_scales{};
 };
 
 /// ----------------------- activation operators ----------------------
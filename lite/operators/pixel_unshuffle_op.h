@@ -36,7 +36,6 @@ class PixelUnShuffleOpLite : public OpLite {
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
   std::string DebugString() const override { return "pixel_unshuffle"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.x->dims();
     auto output_dims = param_.output->dims();
@@ -46,7 +45,6 @@ class PixelUnShuffleOpLite : public OpLite {
 
     ch->macs = 1;
   }
-#endif
 
  private:
   mutable PixelUnShuffleParam param_;
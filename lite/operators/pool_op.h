@@ -98,14 +98,17 @@ class PoolOpLite : public OpLite {
     if (op_desc.HasAttr("pad_zero")) {
       param_.pad_zero = op_desc.GetAttr<bool>("pad_zero");
     }
+#endif
     if (op_desc.HasAttr("enable_int8") &&
         op_desc.GetAttr<bool>("enable_int8")) {
       param_.enable_int8 = true;
-      param_.output_scale =
-          op_desc.GetAttr<std::vector<float>>("Out0_scale")[0];
       param_.input_scale = op_desc.GetAttr<std::vector<float>>("X0_scale")[0];
+      // only set when the output is int8
+      if (op_desc.HasAttr("Out0_scale")) {
+        param_.output_scale =
+            op_desc.GetAttr<std::vector<float>>("Out0_scale")[0];
+      }
     }
-#endif
     return true;
   }
 
@@ -113,7 +116,6 @@ class PoolOpLite : public OpLite {
 
   std::string DebugString() const override { return "pool"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.x->dims();
     auto output_dims = param_.output->dims();
@@ -130,7 +132,6 @@ class PoolOpLite : public OpLite {
     ch->remark += param_.padding_algorithm;
     ch->macs = output_dims.production() * param_.ksize[0] * param_.ksize[1];
   }
-#endif
 
  private:
   mutable PoolParam param_;
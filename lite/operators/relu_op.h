@@ -18,9 +18,7 @@
 #include "lite/core/op_lite.h"
 #include "lite/core/scope.h"
 #include "lite/utils/all.h"
-#ifdef LITE_WITH_PROFILE
 #include "lite/api/paddle_place.h"
-#endif
 
 namespace paddle {
 namespace lite {
@@ -41,7 +39,6 @@ class ReluOp : public OpLite {
 
   std::string DebugString() const override { return "relu"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.X->dims();
     auto output_dims = param_.Out->dims();
@@ -91,7 +88,6 @@ class ReluOp : public OpLite {
                    << " doesn't support";
     }
   }
-#endif
 
  private:
   mutable ActivationParam param_;
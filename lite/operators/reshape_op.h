@@ -46,14 +46,12 @@ class ReshapeOp : public OpLite {
   }
 
   bool InferShape() override;
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.x->dims();
     auto output_dims = param_.output->dims();
     ch->input_shape = ch->DimToStr(input_dims);
     ch->output_shape = ch->DimToStr(output_dims);
   }
-#endif
 
  protected:
   mutable ReshapeParam param_;
@@ -42,9 +42,7 @@ class RetinanetDetectionOutputOpLite : public OpLite {
     return "retinanet_detection_output";
   }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {}
-#endif
 
  private:
   mutable RetinanetDetectionOutputParam param_;
@@ -46,14 +46,12 @@ class ReverseOpLite : public OpLite {
     return true;
   }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.X->dims();
     auto output_dims = param_.Out->dims();
     ch->input_shape = ch->DimToStr(input_dims);
     ch->output_shape = ch->DimToStr(output_dims);
   }
-#endif
 
  private:
   mutable ReverseParam param_;
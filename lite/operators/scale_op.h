@@ -38,7 +38,6 @@ class ScaleOp : public OpLite {
 
   std::string DebugString() const override { return "scale"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.x->dims());
     ch->output_shape = ch->DimToStr(param_.output->dims());
@@ -47,7 +46,6 @@ class ScaleOp : public OpLite {
     ch->macs = param_.x->numel() * 1.f;
     if (param_.fuse_scaleact) ch->macs *= 2;
   }
-#endif
 
  private:
   mutable ScaleParam param_;
@@ -36,13 +36,11 @@ class ScatterNdAddOp : public OpLite {
 
   std::string DebugString() const override { return "scatter_nd_add"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.x->dims());
     ch->output_shape = ch->DimToStr(param_.output->dims());
     ch->macs = param_.x->numel() * 1.f;
   }
-#endif
 
  private:
   mutable ScatterNdAddParam param_;
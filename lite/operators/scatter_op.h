@@ -38,13 +38,11 @@ class ScatterOp : public OpLite {
 
   std::string DebugString() const override { return "Scatter"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.x->dims());
     ch->output_shape = ch->DimToStr(param_.output->dims());
     ch->macs = param_.x->numel() * 1.f;
   }
-#endif
 
  private:
   mutable ScatterParam param_;
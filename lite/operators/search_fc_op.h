@@ -38,7 +38,6 @@ class SearchFcOpLite : public OpLite {
 
   std::string DebugString() const override { return "search_fc"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.X->dims());
     ch->filter_shape = ch->DimToStr(param_.W->dims());
@@ -48,7 +47,6 @@ class SearchFcOpLite : public OpLite {
     auto w_dims = param_.W->dims();
     ch->macs = 2.f * x_dims[0] * x_dims[1] * w_dims[0];
   }
-#endif
 
  private:
   mutable SearchFcParam param_;
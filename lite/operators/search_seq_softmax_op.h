@@ -39,7 +39,6 @@ class SearchSeqSoftmaxOp : public OpLite {
 
   std::string DebugString() const override { return "search_seq_softmax_op"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.x->dims();
     auto output_dims = param_.output->dims();
@@ -48,7 +47,6 @@ class SearchSeqSoftmaxOp : public OpLite {
     ch->remark = "axis" + std::to_string(param_.axis);
     ch->macs = 4.f * param_.x->numel();
   }
-#endif
 
  private:
   mutable SoftmaxParam param_;
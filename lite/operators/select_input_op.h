@@ -42,7 +42,6 @@ class SelectInputOpLite : public OpLite {
     return true;
   }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto output_dims = param_.Out->dims();
     std::string inputs_shape = "";
@@ -55,7 +54,6 @@ class SelectInputOpLite : public OpLite {
     ch->remark = "Mask" + std::to_string(param_.Mask->data<int>()[0]);
     ch->macs = 0.f;  // no calc. only io operation
   }
-#endif
 
  private:
   mutable SelectInputParam param_;
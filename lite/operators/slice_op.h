@@ -40,7 +40,6 @@ class SliceOp : public OpLite {
 
   std::string DebugString() const override { return "slice"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.X->dims();
     auto output_dims = param_.Out->dims();
@@ -53,7 +52,6 @@ class SliceOp : public OpLite {
     }
     ch->remark = "axes" + axes;
   }
-#endif
 
  private:
   mutable SliceParam param_;
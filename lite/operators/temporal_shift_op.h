@@ -39,7 +39,6 @@ class TemporalShiftOpLite : public OpLite {
 
   std::string DebugString() const override { return "Temporal Shift Op"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     auto input_dims = param_.X->dims();
     auto output_dims = param_.Out->dims();
@@ -50,7 +49,6 @@ class TemporalShiftOpLite : public OpLite {
     float gops = 1.0f;
     ch->macs = gops * output_dims.production();
   }
-#endif
 
  private:
   mutable TemporalShiftParam param_;
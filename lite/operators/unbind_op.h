@@ -37,7 +37,6 @@ class UnbindOp : public OpLite {
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
   std::string DebugString() const override { return "unbind"; }
 
-#ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter *ch) {
     ch->input_shape = ch->DimToStr(param_.x->dims());
 
@@ -48,7 +47,6 @@ class UnbindOp : public OpLite {
     }
     ch->output_shape = outputs_shape;
   }
-#endif
 
  private:
   mutable UnbindParam param_;
@@ -0,0 +1,221 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <random>
+#include <vector>
+#include "lite/core/tensor.h"
+#include "lite/tests/cv/cv_basic.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+typedef paddle::lite::utils::cv::TransParam TransParam;
+typedef paddle::lite::utils::cv::ImagePreprocess ImagePreprocess;
+typedef paddle::lite_api::Tensor Tensor_api;
+
+static int ImageSize(ImageFormat format, int w, int h) {
+  switch (format) {
+    case ImageFormat::GRAY:
+      return w * h;
+    case ImageFormat::BGR:
+    case ImageFormat::RGB:
+      return w * h * 3;
+    case ImageFormat::NV12:
+    case ImageFormat::NV21:
+      return w * static_cast<int>(ceil(1.5 * h));
+    default:
+      return w * h * 4;
+  }
+}
+
+static std::vector<uint8_t> RandImage(int size) {
+  std::mt19937 gen(size);
+  std::uniform_int_distribution<int> dis(0, 255);
+  std::vector<uint8_t> img(size);
+  for (auto& x : img) x = dis(gen);
+  return img;
+}
+
+static TransParam Param(int iw, int ih, int ow, int oh) {
+  TransParam param;
+  param.iw = iw;
+  param.ih = ih;
+  param.ow = ow;
+  param.oh = oh;
+  param.flip_param = FlipParam::X;
+  param.rotate_param = 90;
+  return param;
+}
+
+TEST(image_preprocess_x86, convert) {
+  const ImageFormat formats[] = {ImageFormat::RGBA,
+                                 ImageFormat::BGRA,
+                                 ImageFormat::RGB,
+                                 ImageFormat::BGR,
+                                 ImageFormat::GRAY,
+                                 ImageFormat::NV21,
+                                 ImageFormat::NV12};
+  for (int w : {2, 6, 16, 38}) {
+    for (int h : {1, 4, 5}) {
+      for (auto src_format : formats) {
+        for (int dst = 0; dst < 5; dst++) {
+          auto dst_format = formats[dst];
+          bool nv = src_format == ImageFormat::NV12 ||
+                    src_format == ImageFormat::NV21;
+          if (nv && dst_format == ImageFormat::GRAY) continue;
+          auto src = RandImage(ImageSize(src_format, w, h));
+          int out_size = ImageSize(dst_format, w, h);
+          std::vector<uint8_t> out(out_size), ref(out_size);
+          ImagePreprocess process(src_format, dst_format, Param(w, h, w, h));
+          process.image_convert(src.data(), out.data());
+          image_convert_basic(src.data(),
+                              ref.data(),
+                              src_format,
+                              dst_format,
+                              w,
+                              h,
+                              out_size);
+          ASSERT_EQ(out, ref) << "w: " << w << ", h: " << h
+                              << ", src: " << src_format
+                              << ", dst: " << dst_format;
+        }
+      }
+    }
+  }
+}
+
+TEST(image_preprocess_x86, resize) {
+  for (auto format :
+       {ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::BGRA}) {
+    for (int w : {8, 37, 112}) {
+      for (int h : {4, 17}) {
+        for (int ow : {8, 33, 224}) {
+          for (int oh : {8, 61}) {
+            auto src = RandImage(ImageSize(format, w, h));
+            int out_size = ImageSize(format, ow, oh);
+            std::vector<uint8_t> out(out_size), ref(out_size);
+            ImagePreprocess process(format, format, Param(w, h, ow, oh));
+            process.image_resize(src.data(), out.data());
+            image_resize_basic(src.data(), ref.data(), format, w, h, ow, oh);
+            // the basic one is in float
+            for (int i = 0; i < out_size; i++) {
+              ASSERT_LE(abs(out[i] - ref[i]), 1) << "i: " << i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(image_preprocess_x86, flip_rotate) {
+  for (auto format :
+       {ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::BGRA}) {
+    for (int w : {1, 7, 40}) {
+      for (int h : {1, 9, 35}) {
+        auto src = RandImage(ImageSize(format, w, h));
+        int size = ImageSize(format, w, h);
+        std::vector<uint8_t> out(size), ref(size);
+        ImagePreprocess process(format, format, Param(w, h, w, h));
+        for (auto flip : {FlipParam::X, FlipParam::Y, FlipParam::XY}) {
+          process.image_flip(src.data(), out.data(), format, w, h, flip);
+          image_flip_basic(src.data(), ref.data(), format, w, h, flip);
+          ASSERT_EQ(out, ref) << "flip: " << flip;
+        }
+        for (float degree : {90.f, 180.f, 270.f}) {
+          process.image_rotate(src.data(), out.data(), format, w, h, degree);
+          image_rotate_basic(src.data(), ref.data(), format, w, h, degree);
+          ASSERT_EQ(out, ref) << "degree: " << degree;
+        }
+      }
+    }
+  }
+}
+
+TEST(image_preprocess_x86, to_tensor) {
+  float means[3] = {103.94f, 116.78f, 123.68f};
+  float scales[3] = {0.017f, 0.018f, 0.019f};
+  for (auto format :
+       {ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::BGRA}) {
+    int channels = format == ImageFormat::GRAY ? 1 : 3;
+    int num = ImageSize(format, 1, 1);
+    for (int w : {3, 16, 45}) {
+      int h = 5;
+      auto src = RandImage(ImageSize(format, w, h));
+      for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+        Tensor tensor;
+        Tensor_api dst(&tensor);
+        dst.Resize({1, channels, h, w});
+        ImagePreprocess process(format, format, Param(w, h, w, h));
+        process.image_to_tensor(src.data(), &dst, layout, means, scales);
+        const float* out = tensor.data<float>();
+        for (int i = 0; i < h * w; i++) {
+          for (int c = 0; c < channels; c++) {
+            float ref = (src[i * num + c] - means[c]) * scales[c];
+            float val = layout == LayoutType::kNCHW ? out[c * h * w + i]
+                                                    : out[i * channels + c];
+            ASSERT_EQ(val, ref) << "i: " << i << ", c: " << c;
+          }
+        }
+      }
+    }
+  }
+}
+
+// The fused call gives the same tensor as converting, resizing and
+// normalizing one by one.
+TEST(image_preprocess_x86, resize_to_tensor) {
+  float means[3] = {103.94f, 116.78f, 123.68f};
+  float scales[3] = {0.017f, 0.018f, 0.019f};
+  const std::vector<std::pair<ImageFormat, ImageFormat>> formats = {
+      {ImageFormat::BGR, ImageFormat::RGB},
+      {ImageFormat::BGR, ImageFormat::BGR},
+      {ImageFormat::BGRA, ImageFormat::RGB},
+      {ImageFormat::RGBA, ImageFormat::RGBA},
+      {ImageFormat::GRAY, ImageFormat::BGR},
+      {ImageFormat::GRAY, ImageFormat::GRAY},
+      {ImageFormat::BGR, ImageFormat::GRAY},
+      {ImageFormat::NV12, ImageFormat::RGB}};
+  for (auto& format : formats) {
+    int channels = format.second == ImageFormat::GRAY ? 1 : 3;
+    for (auto size : {std::vector<int>{64, 48, 64, 48},
+                      std::vector<int>{100, 60, 37, 29},
+                      std::vector<int>{30, 20, 224, 224}}) {
+      int w = size[0], h = size[1], ow = size[2], oh = size[3];
+      auto src = RandImage(ImageSize(format.first, w, h));
+      for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+        ImagePreprocess process(
+            format.first, format.second, Param(w, h, ow, oh));
+        Tensor tensor, tensor_ref;
+        Tensor_api dst(&tensor), dst_ref(&tensor_ref);
+        dst.Resize({1, channels, oh, ow});
+        dst_ref.Resize({1, channels, oh, ow});
+        process.image_resize_to_tensor(
+            src.data(), &dst, layout, means, scales);
+
+        std::vector<uint8_t> converted(w * h * 4), resized(ow * oh * 4);
+        process.image_convert(src.data(), converted.data());
+        process.image_resize(converted.data(), resized.data());
+        process.image_to_tensor(
+            resized.data(), &dst_ref, layout, means, scales);
+        const float* out = tensor.data<float>();
+        const float* ref = tensor_ref.data<float>();
+        for (int i = 0; i < channels * oh * ow; i++) {
+          ASSERT_EQ(out[i], ref[i]) << "i: " << i << ", src: " << format.first
+                                    << ", dst: " << format.second;
+        }
+      }
+    }
+  }
+}
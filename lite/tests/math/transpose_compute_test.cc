@@ -0,0 +1,162 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/backends/host/math/transpose.h"
+#include "lite/core/profile/timer.h"
+#include "lite/tests/utils/fill_data.h"
+
+using paddle::lite::profile::Timer;
+namespace math = paddle::lite::host::math;
+
+DEFINE_int32(warmup, 1, "warmup times");
+DEFINE_int32(repeats, 10, "repeats times");
+DEFINE_bool(run_benchmark, false, "time transpose against the naive one");
+
+// One div/mod per axis and element, the old host implementation.
+template <typename T>
+static void transpose_basic(const T* din,
+                            T* dout,
+                            const std::vector<int64_t>& dims,
+                            const std::vector<int>& axis) {
+  int rank = dims.size();
+  std::vector<int64_t> old_steps(rank, 1);
+  std::vector<int64_t> new_steps(rank, 1);
+  for (int i = rank - 2; i >= 0; i--) {
+    old_steps[i] = old_steps[i + 1] * dims[i + 1];
+    new_steps[i] = new_steps[i + 1] * dims[axis[i + 1]];
+  }
+  int64_t count = old_steps[0] * dims[0];
+  for (int64_t i = 0; i < count; i++) {
+    int64_t old_idx = 0;
+    int64_t idx = i;
+    for (int j = 0; j < rank; j++) {
+      old_idx += idx / new_steps[j] * old_steps[axis[j]];
+      idx %= new_steps[j];
+    }
+    dout[i] = din[old_idx];
+  }
+}
+
+static std::string shape_str(const std::vector<int64_t>& dims,
+                             const std::vector<int>& axis) {
+  std::string str = "[";
+  for (size_t i = 0; i < dims.size(); i++) {
+    str += (i ? "," : "") + std::to_string(dims[i]);
+  }
+  str += "] axis [";
+  for (size_t i = 0; i < axis.size(); i++) {
+    str += (i ? "," : "") + std::to_string(axis[i]);
+  }
+  return str + "]";
+}
+
+template <typename T>
+bool test_transpose(const std::vector<int64_t>& dims,
+                    const std::vector<int>& axis) {
+  int64_t count = 1;
+  for (auto d : dims) {
+    count *= d;
+  }
+  std::vector<T> din(count);
+  std::vector<T> dout(count);
+  std::vector<T> dref(count);
+  fill_data_rand<T>(din.data(), -100, 100, count);
+  math::transpose<T>(din.data(), dout.data(), dims, axis);
+  transpose_basic<T>(din.data(), dref.data(), dims, axis);
+  for (int64_t i = 0; i < count; i++) {
+    if (dout[i] != dref[i]) {
+      LOG(INFO) << "transpose " << shape_str(dims, axis)
+                << " mismatch at: " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+struct TransposeCase {
+  std::vector<int64_t> dims;
+  std::vector<int> axis;
+};
+
+static const std::vector<TransposeCase> transpose_cases = {
+    {{1}, {0}},
+    {{7, 9}, {1, 0}},
+    {{64, 48}, {1, 0}},
+    {{3, 17, 33}, {0, 2, 1}},
+    {{3, 17, 33}, {2, 0, 1}},
+    {{5, 1, 7}, {1, 2, 0}},
+    // NCHW <-> NHWC
+    {{2, 3, 13, 15}, {0, 2, 3, 1}},
+    {{2, 13, 15, 3}, {0, 3, 1, 2}},
+    // attention heads, [B, S, H, D] <-> [B, H, S, D]
+    {{2, 20, 4, 16}, {0, 2, 1, 3}},
+    {{2, 20, 4, 16}, {0, 2, 3, 1}},
+    {{2, 3, 4, 5}, {3, 2, 1, 0}},
+    {{2, 1, 9, 1, 10}, {4, 2, 0, 3, 1}},
+    {{2, 3, 4, 5, 6}, {0, 1, 4, 2, 3}},
+    {{2, 3, 2, 4, 3, 5}, {5, 1, 3, 0, 2, 4}},
+};
+
+TEST(TestHostTranspose, transpose_compute) {
+  for (auto& c : transpose_cases) {
+    EXPECT_TRUE(test_transpose<float>(c.dims, c.axis));
+    EXPECT_TRUE(test_transpose<int8_t>(c.dims, c.axis));
+    EXPECT_TRUE(test_transpose<int16_t>(c.dims, c.axis));
+    EXPECT_TRUE(test_transpose<int64_t>(c.dims, c.axis));
+  }
+}
+
+TEST(TestHostTranspose, transpose_benchmark) {
+  if (!FLAGS_run_benchmark) return;
+  const std::vector<TransposeCase> cases = {
+      {{1024, 1024}, {1, 0}},
+      {{1, 3, 224, 224}, {0, 2, 3, 1}},
+      {{1, 224, 224, 3}, {0, 3, 1, 2}},
+      {{1, 64, 56, 56}, {0, 2, 3, 1}},
+      {{8, 128, 12, 64}, {0, 2, 1, 3}},
+      {{8, 128, 12, 64}, {0, 2, 3, 1}},
+      {{8, 12, 128, 64}, {0, 1, 3, 2}},
+      {{16, 32, 8, 8, 8}, {0, 4, 2, 3, 1}},
+  };
+  for (auto& c : cases) {
+    int64_t count = 1;
+    for (auto d : c.dims) {
+      count *= d;
+    }
+    std::vector<float> din(count);
+    std::vector<float> dout(count);
+    fill_data_rand<float>(din.data(), -1.f, 1.f, count);
+    Timer t_new, t_basic;
+    for (int i = 0; i < FLAGS_warmup + FLAGS_repeats; i++) {
+      if (i >= FLAGS_warmup) t_new.Start();
+      math::transpose<float>(din.data(), dout.data(), c.dims, c.axis);
+      if (i >= FLAGS_warmup) t_new.Stop();
+    }
+    for (int i = 0; i < FLAGS_warmup + FLAGS_repeats; i++) {
+      if (i >= FLAGS_warmup) t_basic.Start();
+      transpose_basic<float>(din.data(), dout.data(), c.dims, c.axis);
+      if (i >= FLAGS_warmup) t_basic.Stop();
+    }
+    double bytes = 2.0 * count * sizeof(float);
+    LOG(INFO) << "transpose " << shape_str(c.dims, c.axis)
+              << ", avg time: " << t_new.LapTimes().Avg() << " ms, "
+              << bytes * 1e-6 / t_new.LapTimes().Avg()
+              << " GB/s, basic avg time: " << t_basic.LapTimes().Avg()
+              << " ms";
+  }
+}
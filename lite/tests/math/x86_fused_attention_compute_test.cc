@@ -0,0 +1,237 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/math/fused_attention.h"
+#include "lite/backends/x86/math/packed_sgemm.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+namespace math = paddle::lite::x86::math;
+
+DEFINE_int32(warmup, 1, "warmup times");
+DEFINE_int32(repeats, 5, "repeats times");
+DEFINE_bool(run_benchmark, false, "time fused attention against unfused");
+
+// Unfused attention: scores = q * k^T by sgemm, softmax, then scores * v,
+// with the seq_len x seq_len scores of a head in memory.
+static void unfused_attention(const float* qkv,
+                              const float* mask,
+                              const int64_t* mask_strides,
+                              float* out,
+                              float* scores,
+                              int batch,
+                              int seq_len,
+                              int head_num,
+                              int head_dim,
+                              float scale) {
+  int hidden = head_num * head_dim;
+  int ld = 3 * hidden;
+  for (int b = 0; b < batch; b++) {
+    for (int h = 0; h < head_num; h++) {
+      const float* q = qkv + b * seq_len * ld + h * head_dim;
+      const float* m = mask ? mask + b * mask_strides[0] + h * mask_strides[1]
+                            : nullptr;
+      for (int i = 0; i < seq_len; i++) {
+        for (int j = 0; j < seq_len; j++) {
+          scores[i * seq_len + j] = m ? m[i * mask_strides[2] + j] : 0.f;
+        }
+      }
+      math::sgemm(false,
+                  true,
+                  seq_len,
+                  seq_len,
+                  head_dim,
+                  scale,
+                  q,
+                  ld,
+                  q + hidden,
+                  ld,
+                  1.f,
+                  scores,
+                  seq_len);
+      for (int i = 0; i < seq_len; i++) {
+        float* s = scores + i * seq_len;
+        float max = *std::max_element(s, s + seq_len);
+        float sum = 0.f;
+        for (int j = 0; j < seq_len; j++) {
+          s[j] = expf(s[j] - max);
+          sum += s[j];
+        }
+        for (int j = 0; j < seq_len; j++) {
+          s[j] /= sum;
+        }
+      }
+      math::sgemm(false,
+                  false,
+                  seq_len,
+                  head_dim,
+                  seq_len,
+                  1.f,
+                  scores,
+                  seq_len,
+                  q + 2 * hidden,
+                  ld,
+                  0.f,
+                  out + (b * head_num + h) * seq_len * head_dim,
+                  head_dim);
+    }
+  }
+}
+
+// The mask is [batch, 1, 1, seq_len], the last quarter of the keys of the
+// second batch is padding.
+static void fill_mask(Tensor* mask, int batch, int seq_len) {
+  mask->Resize({batch, 1, 1, seq_len});
+  float* data = mask->mutable_data<float>();
+  for (int b = 0; b < batch; b++) {
+    for (int j = 0; j < seq_len; j++) {
+      bool padding = b == 1 && j >= seq_len - seq_len / 4;
+      data[b * seq_len + j] = padding ? -10000.f : 0.f;
+    }
+  }
+}
+
+bool test_fused_attention(
+    int batch, int seq_len, int head_num, int head_dim, bool with_mask) {
+  float scale = 1.f / sqrtf(head_dim);
+  Tensor qkv, mask, out, out_ref, scores;
+  qkv.Resize({batch, seq_len, 3, head_num, head_dim});
+  out.Resize({batch, head_num, seq_len, head_dim});
+  out_ref.Resize({batch, head_num, seq_len, head_dim});
+  scores.Resize({seq_len, seq_len});
+  qkv.mutable_data<float>();
+  fill_tensor_rand(qkv, -2.f, 2.f);
+  fill_mask(&mask, batch, seq_len);
+  const int64_t mask_strides[3] = {seq_len, 0, 0};
+  const float* mask_data = with_mask ? mask.data<float>() : nullptr;
+
+  math::fused_attention(qkv.data<float>(),
+                        mask_data,
+                        mask_strides,
+                        out.mutable_data<float>(),
+                        batch,
+                        seq_len,
+                        head_num,
+                        head_dim,
+                        scale);
+  unfused_attention(qkv.data<float>(),
+                    mask_data,
+                    mask_strides,
+                    out_ref.mutable_data<float>(),
+                    scores.mutable_data<float>(),
+                    batch,
+                    seq_len,
+                    head_num,
+                    head_dim,
+                    scale);
+
+  const float* dout = out.data<float>();
+  const float* dref = out_ref.data<float>();
+  float max_err = 0.f;
+  for (int i = 0; i < out.numel(); i++) {
+    max_err = std::max(max_err, fabsf(dout[i] - dref[i]));
+  }
+  if (max_err > 1e-4f) {
+    LOG(INFO) << "fused attention batch: " << batch << ", seq_len: " << seq_len
+              << ", head_num: " << head_num << ", head_dim: " << head_dim
+              << ", mask: " << with_mask << ", max diff: " << max_err;
+    return false;
+  }
+  return true;
+}
+
+TEST(TestX86FusedAttention, fused_attention_compute) {
+  for (auto& seq_len : {1, 7, 32, 64, 100, 129}) {
+    for (auto& head_dim : {16, 40, 64}) {
+      for (auto& with_mask : {false, true}) {
+        if (!test_fused_attention(2, seq_len, 3, head_dim, with_mask)) {
+          LOG(FATAL) << "fused attention precision check failed!";
+        }
+      }
+    }
+  }
+}
+
+// BERT-base attention, 12 heads of 64, over the sequence lengths.
+TEST(TestX86FusedAttention, fused_attention_benchmark) {
+  if (!FLAGS_run_benchmark) return;
+  const int batch = 1;
+  const int head_num = 12;
+  const int head_dim = 64;
+  for (auto& seq_len : {128, 256, 512, 1024, 2048}) {
+    float scale = 1.f / sqrtf(head_dim);
+    Tensor qkv, mask, out, scores;
+    qkv.Resize({batch, seq_len, 3, head_num, head_dim});
+    out.Resize({batch, head_num, seq_len, head_dim});
+    scores.Resize({seq_len, seq_len});
+    qkv.mutable_data<float>();
+    fill_tensor_rand(qkv, -2.f, 2.f);
+    fill_mask(&mask, batch, seq_len);
+    const int64_t mask_strides[3] = {seq_len, 0, 0};
+    const float* dqkv = qkv.data<float>();
+    const float* dmask = mask.data<float>();
+    float* dout = out.mutable_data<float>();
+    float* dscores = scores.mutable_data<float>();
+
+    Timer t_fused, t_unfused;
+    for (int i = 0; i < FLAGS_warmup + FLAGS_repeats; i++) {
+      if (i >= FLAGS_warmup) t_fused.Start();
+      math::fused_attention(dqkv,
+                            dmask,
+                            mask_strides,
+                            dout,
+                            batch,
+                            seq_len,
+                            head_num,
+                            head_dim,
+                            scale);
+      if (i >= FLAGS_warmup) t_fused.Stop();
+    }
+    for (int i = 0; i < FLAGS_warmup + FLAGS_repeats; i++) {
+      if (i >= FLAGS_warmup) t_unfused.Start();
+      unfused_attention(dqkv,
+                        dmask,
+                        mask_strides,
+                        dout,
+                        dscores,
+                        batch,
+                        seq_len,
+                        head_num,
+                        head_dim,
+                        scale);
+      if (i >= FLAGS_warmup) t_unfused.Stop();
+    }
+    double ops = 4.0 * batch * head_num * seq_len * seq_len * head_dim;
+    LOG(INFO) << "seq_len: " << seq_len << ", fused avg time: "
+              << t_fused.LapTimes().Avg() << " ms, "
+              << ops * 1e-6f / t_fused.LapTimes().Avg()
+              << " GOPs, unfused avg time: " << t_unfused.LapTimes().Avg()
+              << " ms, " << ops * 1e-6f / t_unfused.LapTimes().Avg()
+              << " GOPs, scores of a head: "
+              << seq_len * seq_len * sizeof(float) / 1024 << " KB";
+  }
+}
+
+#endif  // LITE_WITH_X86
@@ -24,6 +24,9 @@
 #include <gtest/gtest.h>
 #include <string.h>
 #include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/core/context.h"
@@ -353,6 +356,165 @@ bool test_gemm_s8u8f32(
   return true;
 }
 
+// The fc of post_quant_dynamic: A is quantized per row by the gemm, B per
+// column offline. The reference quantizes A in the same way and runs in fp32.
+bool test_gemm_s8u8_dynamic(int m, int n, int k, bool has_bias, bool has_relu) {
+  Tensor ta, tb, tc, tbias, tb_scale;
+  ta.Resize({m, k});
+  tb.Resize({k, n});
+  tc.Resize({m, n});
+  tbias.Resize({n});
+  tb_scale.Resize({n});
+  ta.set_precision(PRECISION(kFloat));
+  tb.set_precision(PRECISION(kInt8));
+  tbias.set_precision(PRECISION(kFloat));
+  tb_scale.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -127, 127);
+  fill_tensor_rand(tbias, -1.f, 1.f);
+  fill_tensor_rand(tb_scale, 0.001f, 0.01f);
+  auto a_ptr = ta.data<float>();
+  auto b_ptr = tb.data<int8_t>();
+  auto b_scale = tb_scale.data<float>();
+  auto bias = has_bias ? tbias.data<float>() : nullptr;
+  auto c_ptr = tc.mutable_data<float>();
+
+  std::vector<float> a_quant(m * k);
+  std::vector<float> b_f32(k * n);
+  std::vector<float> c_basic(m * n);
+  for (int i = 0; i < m; i++) {
+    float amax = 0.f;
+    for (int j = 0; j < k; j++) {
+      amax = std::max(amax, std::fabs(a_ptr[i * k + j]));
+    }
+    float inv = amax > 0.f ? 63.f / amax : 0.f;
+    for (int j = 0; j < k; j++) {
+      a_quant[i * k + j] =
+          std::nearbyint(a_ptr[i * k + j] * inv) * (amax / 63.f);
+    }
+  }
+  for (int i = 0; i < k; i++) {
+    for (int j = 0; j < n; j++) {
+      b_f32[i * n + j] = b_ptr[i * n + j] * b_scale[j];
+    }
+  }
+
+  std::vector<uint8_t> packed_b(
+      paddle::lite::x86::math::gemm_s8u8_packed_b_size(n, k));
+  paddle::lite::x86::math::gemm_s8u8_prepack_b(
+      false, n, k, b_ptr, packed_b.data());
+  Timer t0, t1;
+  t0.Start();
+  basic_gemm_fp32(false,
+                  false,
+                  m,
+                  n,
+                  k,
+                  a_quant.data(),
+                  k,
+                  b_f32.data(),
+                  n,
+                  c_basic.data(),
+                  n);
+  t0.Stop();
+  t1.Start();
+  paddle::lite::x86::math::gemm_s8u8_dynamic(
+      m, n, k, a_ptr, packed_b.data(), b_scale, bias, c_ptr, has_relu);
+  t1.Stop();
+#ifdef GEMM_PROFILE
+  LOG(INFO) << "gemm_s8u8_dynamic M: " << m << ", N: " << n << ", K: " << k
+            << ", float time(ms): " << t0.LapTimes().Avg()
+            << ", s8u8 time(ms): " << t1.LapTimes().Avg();
+#endif
+
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float ref = c_basic[i * n + j] + (bias ? bias[j] : 0.f);
+      if (has_relu) ref = std::max(ref, 0.f);
+      if (std::fabs(c_ptr[i * n + j] - ref) > 1e-4f * (1.f + std::fabs(ref))) {
+        LOG(INFO) << "gemm_s8u8_dynamic M: " << m << ", N: " << n
+                  << ", K: " << k << ", diff at " << i << ", " << j
+                  << ", real is " << ref << ", test is " << c_ptr[i * n + j];
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Each micro-kernel the cpu runs against gemm_s8u8_ref, A in [-63, 63] so
+// that the vpmaddubsw pairs do not saturate and all of them sum exactly.
+template <typename TYPE_C>
+bool test_gemm_s8u8_isa(int m, int n, int k, bool trb, int relu_type) {
+  namespace math = paddle::lite::x86::math;
+  std::vector<int8_t> da(m * k);
+  std::vector<int8_t> db(n * k);
+  std::vector<float> scale(m);
+  std::vector<float> bias(m);
+  fill_data_rand<int8_t>(da.data(), -63, 63, m * k);
+  fill_data_rand<int8_t>(db.data(), -127, 127, n * k);
+  fill_data_rand<float>(scale.data(), 0.5f / 63.f, 1.5f / 63.f, m);
+  fill_data_rand<float>(bias.data(), -1.f, 1.f, m);
+  // int8 output is scaled by Sc, relu6 and leaky relu take alpha in its scale
+  const bool s8 = std::is_same<TYPE_C, int8_t>::value;
+  const float Sb = 1 / 127.f;
+  const float Sc = s8 ? 1 / 127.f : 1.f;
+  const float alpha = relu_type == 3 ? 0.1f : 6.f / Sc;
+  math::generate_gemm_s8u8_x86_kern<TYPE_C> gemm(false,
+                                                 trb,
+                                                 m,
+                                                 n,
+                                                 k,
+                                                 da.data(),
+                                                 n,
+                                                 scale.data(),
+                                                 Sb,
+                                                 Sc,
+                                                 bias.data(),
+                                                 relu_type,
+                                                 alpha);
+  std::vector<TYPE_C> dref(m * n);
+  std::vector<TYPE_C> dout(m * n);
+  const math::gemm_s8u8_isa_t best = math::gemm_s8u8_best_isa();
+  math::gemm_s8u8_force_isa(math::gemm_s8u8_ref);
+  gemm.compute(da.data(), db.data(), dref.data());
+  bool ok = true;
+  for (int isa = math::gemm_s8u8_avx2; isa <= best; isa++) {
+    if (!math::gemm_s8u8_force_isa(static_cast<math::gemm_s8u8_isa_t>(isa))) {
+      continue;
+    }
+    std::fill(dout.begin(), dout.end(), static_cast<TYPE_C>(99));
+    gemm.compute(da.data(), db.data(), dout.data());
+    for (int i = 0; i < m * n; i++) {
+      float diff = std::abs(static_cast<float>(dout[i]) - dref[i]);
+      // the +128 of B comes back through the bias, float keeps ~1e-5 of it
+      float tol =
+          s8 ? 1.f : 1e-3f * (1.f + std::abs(static_cast<float>(dref[i])));
+      if (diff > tol) {
+        LOG(INFO) << "isa: " << isa << ", M: " << m << ", N: " << n
+                  << ", K: " << k << ", act: " << relu_type
+                  << ", mismatch at: " << i << ", out: "
+                  << static_cast<float>(dout[i])
+                  << ", ref: " << static_cast<float>(dref[i]);
+        ok = false;
+        break;
+      }
+    }
+#ifdef GEMM_PROFILE
+    Timer t;
+    for (int i = 0; i < 10; i++) {
+      t.Start();
+      gemm.compute(da.data(), db.data(), dout.data());
+      t.Stop();
+    }
+    LOG(INFO) << "isa: " << isa << ", M: " << m << ", N: " << n
+              << ", K: " << k << ", avg time(ms): " << t.LapTimes().Avg();
+#endif
+  }
+  math::gemm_s8u8_force_isa(best);
+  return ok;
+}
+
 TEST(TestX86LiteGemmInt8, gemm_s8u8_compute) {
 #ifdef GEMM_PROFILE
   pthread_t tid = {0};
@@ -413,4 +575,37 @@ TEST(TestX86LiteGemmInt8f32, gemm_s8u8f32_compute) {
   }
 }
 
+TEST(TestX86LiteGemmInt8Dynamic, gemm_s8u8_dynamic_compute) {
+  for (auto &mm : {1, 3, 32, 67}) {
+    for (auto &nn : {1, 31, 33, 300, 1030}) {
+      for (auto &kk : {1, 5, 64, 301}) {
+        for (auto &bias : {true, false}) {
+          for (auto &relu : {true, false}) {
+            auto flag = test_gemm_s8u8_dynamic(mm, nn, kk, bias, relu);
+            if (!flag)
+              LOG(FATAL) << "dynamic quant precision check failed (diff > "
+                            "1e-4)!";
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestX86LiteGemmInt8Isa, gemm_s8u8_isa_compute) {
+  // 1 to 8 rows at a time and all the tails of the packed B
+  for (auto &mm : {1, 2, 7, 8, 13, 64}) {
+    for (auto &nn : {1, 3, 7, 15, 31, 59, 64, 97}) {
+      for (auto &kk : {1, 6, 64, 257}) {
+        for (auto &tb : {true, false}) {
+          for (auto &act : {0, 1, 2, 3}) {
+            EXPECT_TRUE(test_gemm_s8u8_isa<int8_t>(mm, nn, kk, tb, act));
+            EXPECT_TRUE(test_gemm_s8u8_isa<float>(mm, nn, kk, tb, act));
+          }
+        }
+      }
+    }
+  }
+}
+
 #endif  // LITE_WITH_X86
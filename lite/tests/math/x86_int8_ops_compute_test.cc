@@ -0,0 +1,394 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "lite/backends/x86/math/pooling.h"
+#include "lite/kernels/x86/concat_compute.h"
+#include "lite/kernels/x86/elementwise_compute.h"
+#include "lite/kernels/x86/matmul_compute.h"
+#include "lite/kernels/x86/pool_compute.h"
+#include "lite/tests/utils/fill_data.h"
+
+typedef paddle::lite::DDim DDim;
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite_api::PrecisionType;
+namespace math = paddle::lite::x86::math;
+namespace x86 = paddle::lite::kernels::x86;
+
+// The int8 kernels against the fp32 op on the dequantized inputs. An int8
+// output may be one step away from the quantized reference, a float one
+// differs by rounding only.
+
+static void dequant(const Tensor& x, float scale, Tensor* out) {
+  out->Resize(x.dims());
+  const int8_t* dx = x.data<int8_t>();
+  float* dout = out->mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    dout[i] = dx[i] * scale;
+  }
+}
+
+static void fill_int8(Tensor* x, int8_t range) {
+  fill_data_rand(x->mutable_data<int8_t>(),
+                 static_cast<int8_t>(-range),
+                 range,
+                 static_cast<size_t>(x->numel()));
+}
+
+template <typename T>
+static bool check_output(const Tensor& out,
+                         const std::vector<float>& ref,
+                         float out_scale,
+                         const std::string& info) {
+  const T* dout = out.data<T>();
+  for (size_t i = 0; i < ref.size(); i++) {
+    bool ok;
+    if (std::is_same<T, int8_t>::value) {
+      float q = roundf(ref[i] / out_scale);
+      q = q < -127.f ? -127.f : (q > 127.f ? 127.f : q);
+      ok = fabsf(dout[i] - q) <= 1.f;
+    } else {
+      ok = fabsf(dout[i] - ref[i]) <= 1e-4f * (1.f + fabsf(ref[i]));
+    }
+    if (!ok) {
+      LOG(INFO) << info << ", mismatch at: " << i
+                << ", out: " << static_cast<float>(dout[i])
+                << ", ref: " << ref[i];
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename KernelT, typename ParamT>
+static void run_kernel(const ParamT& param) {
+  KernelT kernel;
+  std::unique_ptr<paddle::lite::KernelContext> ctx(
+      new paddle::lite::KernelContext);
+  ctx->As<paddle::lite::X86Context>();
+  kernel.SetContext(std::move(ctx));
+  kernel.SetParam(param);
+  kernel.Run();
+}
+
+template <PrecisionType OutType>
+static bool test_pool_int8(const DDim& dims,
+                           const std::string& pooling_type,
+                           int k,
+                           int stride,
+                           int pad,
+                           bool global) {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  Tensor x, x_fp32, out, out_ref;
+  x.Resize(dims);
+  fill_int8(&x, 127);
+  paddle::lite::operators::PoolParam param;
+  param.pooling_type = pooling_type;
+  param.global_pooling = global;
+  param.ksize = global ? std::vector<int>{static_cast<int>(dims[2]),
+                                          static_cast<int>(dims[3])}
+                       : std::vector<int>{k, k};
+  param.strides = {stride, stride};
+  param.paddings = std::make_shared<std::vector<int>>(4, global ? 0 : pad);
+  param.exclusive = true;
+  param.input_scale = 0.02f;
+  param.output_scale = 0.015f;
+  DDim out_dims = dims;
+  for (int i = 0; i < 2; i++) {
+    out_dims[i + 2] =
+        (dims[i + 2] - param.ksize[i] + 2 * (*param.paddings)[0]) / stride + 1;
+  }
+  if (out_dims[2] < 1 || out_dims[3] < 1) return true;
+
+  dequant(x, param.input_scale, &x_fp32);
+  out_ref.Resize(out_dims);
+  param.x = &x_fp32;
+  param.output = &out_ref;
+  run_kernel<x86::PoolCompute<float>>(param);
+
+  out.Resize(out_dims);
+  param.x = &x;
+  param.output = &out;
+  run_kernel<x86::PoolInt8Compute<OutType>>(param);
+  const float* dref = out_ref.data<float>();
+  return check_output<OutT>(
+      out,
+      std::vector<float>(dref, dref + out_ref.numel()),
+      param.output_scale,
+      "pool2d " + pooling_type + ", input: " + dims.repr() + ", kernel: " +
+          std::to_string(k) + ", stride: " + std::to_string(stride) +
+          ", pad: " + std::to_string(pad));
+}
+
+TEST(TestX86Int8Ops, pool2d_int8) {
+  for (auto& dims : {DDim({1, 3, 7, 9}), DDim({2, 8, 16, 33})}) {
+    for (auto& pooling_type : {"max", "avg"}) {
+      EXPECT_TRUE(test_pool_int8<PRECISION(kInt8)>(
+          dims, pooling_type, 1, 1, 0, true));
+      EXPECT_TRUE(test_pool_int8<PRECISION(kFloat)>(
+          dims, pooling_type, 1, 1, 0, true));
+      for (auto& k : {2, 3}) {
+        for (auto& stride : {1, 2}) {
+          for (auto& pad : {0, 1}) {
+            EXPECT_TRUE(test_pool_int8<PRECISION(kInt8)>(
+                dims, pooling_type, k, stride, pad, false));
+            EXPECT_TRUE(test_pool_int8<PRECISION(kFloat)>(
+                dims, pooling_type, k, stride, pad, false));
+          }
+        }
+      }
+    }
+  }
+}
+
+// x and y are broadcast to out by the paddle axis rule.
+static std::vector<float> elementwise_ref(const Tensor& x,
+                                          const Tensor& y,
+                                          const DDim& out_dims,
+                                          int axis,
+                                          bool is_mul,
+                                          float x_scale,
+                                          float y_scale) {
+  int rank = out_dims.size();
+  std::vector<int64_t> xd(rank, 1);
+  std::vector<int64_t> yd(rank, 1);
+  int y_axis = axis < 0 ? rank - static_cast<int>(y.dims().size()) : axis;
+  for (int i = 0; i < rank; i++) xd[i] = x.dims()[i];
+  for (size_t i = 0; i < y.dims().size(); i++) yd[i + y_axis] = y.dims()[i];
+  std::vector<float> ref(out_dims.production());
+  for (int64_t i = 0; i < out_dims.production(); i++) {
+    int64_t xi = 0;
+    int64_t yi = 0;
+    int64_t rem = i;
+    int64_t x_stride = 1;
+    int64_t y_stride = 1;
+    for (int d = rank - 1; d >= 0; d--) {
+      int64_t idx = rem % out_dims[d];
+      rem /= out_dims[d];
+      xi += (xd[d] == 1 ? 0 : idx) * x_stride;
+      yi += (yd[d] == 1 ? 0 : idx) * y_stride;
+      x_stride *= xd[d];
+      y_stride *= yd[d];
+    }
+    float vx = x.data<int8_t>()[xi] * x_scale;
+    float vy = y.data<int8_t>()[yi] * y_scale;
+    ref[i] = is_mul ? vx * vy : vx + vy;
+  }
+  return ref;
+}
+
+template <PrecisionType OutType>
+static bool test_elementwise_int8(const DDim& x_dims,
+                                  const DDim& y_dims,
+                                  int axis,
+                                  bool is_mul) {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  Tensor x, y, out;
+  x.Resize(x_dims);
+  y.Resize(y_dims);
+  fill_int8(&x, 127);
+  fill_int8(&y, 127);
+  out.Resize(x_dims);
+  paddle::lite::operators::ElementwiseParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.axis = axis;
+  param.x_input_scale = 0.03f;
+  param.y_input_scale = 0.05f;
+  param.output_scale = is_mul ? 0.2f : 0.06f;
+  if (is_mul) {
+    run_kernel<x86::ElementwiseMulInt8Compute<OutType>>(param);
+  } else {
+    run_kernel<x86::ElementwiseAddInt8Compute<OutType>>(param);
+  }
+  auto ref = elementwise_ref(x,
+                             y,
+                             x_dims,
+                             axis,
+                             is_mul,
+                             param.x_input_scale,
+                             param.y_input_scale);
+  return check_output<OutT>(out,
+                            ref,
+                            param.output_scale,
+                            std::string(is_mul ? "mul" : "add") + ", x: " +
+                                x_dims.repr() + ", y: " + y_dims.repr() +
+                                ", axis: " + std::to_string(axis));
+}
+
+TEST(TestX86Int8Ops, elementwise_int8) {
+  DDim x_dims({2, 16, 9, 37});
+  std::vector<std::pair<DDim, int>> ys = {{DDim({2, 16, 9, 37}), -1},
+                                          {DDim({16}), 1},
+                                          {DDim({2, 16, 1, 1}), -1},
+                                          {DDim({9, 37}), -1},
+                                          {DDim({1, 16, 9, 1}), -1},
+                                          {DDim({1}), -1}};
+  for (auto& y : ys) {
+    for (auto is_mul : {false, true}) {
+      EXPECT_TRUE(test_elementwise_int8<PRECISION(kInt8)>(
+          x_dims, y.first, y.second, is_mul));
+      EXPECT_TRUE(test_elementwise_int8<PRECISION(kFloat)>(
+          x_dims, y.first, y.second, is_mul));
+    }
+  }
+  // long enough to be split into blocks
+  EXPECT_TRUE(test_elementwise_int8<PRECISION(kInt8)>(
+      DDim({3, 10000}), DDim({3, 10000}), -1, false));
+}
+
+template <PrecisionType OutType>
+static bool test_concat_int8(int axis, const std::vector<float>& scales) {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  std::vector<Tensor> xs(scales.size());
+  std::vector<Tensor> xs_fp32(scales.size());
+  paddle::lite::operators::ConcatParam param;
+  DDim out_dims({2, 0, 5, 11});
+  for (size_t i = 0; i < xs.size(); i++) {
+    DDim dims({2, 3 + static_cast<int64_t>(i), 5, 11});
+    xs[i].Resize(dims);
+    fill_int8(&xs[i], 127);
+    dequant(xs[i], scales[i], &xs_fp32[i]);
+    param.x.push_back(&xs_fp32[i]);
+    out_dims[1] += dims[1];
+  }
+  Tensor out, out_ref;
+  out_ref.Resize(out_dims);
+  param.output = &out_ref;
+  param.axis = axis;
+  run_kernel<x86::ConcatCompute<float>>(param);
+
+  param.x.clear();
+  for (auto& x : xs) param.x.push_back(&x);
+  param.input_scales = scales;
+  param.output_scale = 0.04f;
+  out.Resize(out_dims);
+  param.output = &out;
+  run_kernel<x86::ConcatInt8Compute<OutType>>(param);
+  const float* dref = out_ref.data<float>();
+  return check_output<OutT>(out,
+                            std::vector<float>(dref, dref + out_ref.numel()),
+                            param.output_scale,
+                            "concat, inputs: " + std::to_string(xs.size()));
+}
+
+TEST(TestX86Int8Ops, concat_int8) {
+  // the same scales are copied
+  EXPECT_TRUE(test_concat_int8<PRECISION(kInt8)>(1, {0.04f, 0.04f}));
+  EXPECT_TRUE(test_concat_int8<PRECISION(kInt8)>(1, {0.02f, 0.04f, 0.05f}));
+  EXPECT_TRUE(test_concat_int8<PRECISION(kFloat)>(1, {0.02f, 0.04f, 0.05f}));
+  EXPECT_TRUE(test_concat_int8<PRECISION(kInt8)>(-3, {0.03f, 0.01f}));
+}
+
+template <PrecisionType OutType>
+static bool test_matmul_int8(const DDim& x_dims,
+                             const DDim& y_dims,
+                             bool trans_x,
+                             bool trans_y,
+                             bool per_column) {
+  using OutT = typename std::
+      conditional<OutType == PRECISION(kInt8), int8_t, float>::type;
+  Tensor x, y, x_fp32, y_fp32, out, out_ref;
+  x.Resize(x_dims);
+  y.Resize(y_dims);
+  // keeps the u8 x s8 pair sums of the AVX2 path from saturating
+  fill_int8(&x, 63);
+  fill_int8(&y, 127);
+  paddle::lite::operators::MatMulParam param;
+  param.transpose_X = trans_x;
+  param.transpose_Y = trans_y;
+  param.alpha = 0.5f;
+  param.input_scale = 0.02f;
+  param.output_scale = 0.5f;
+  int xr = x_dims.size();
+  int yr = y_dims.size();
+  int m = trans_x ? x_dims[xr - 1] : x_dims[xr - 2];
+  int n = trans_y ? y_dims[yr - 2] : y_dims[yr - 1];
+  DDim out_dims = xr >= yr ? x_dims : y_dims;
+  out_dims[out_dims.size() - 2] = m;
+  out_dims[out_dims.size() - 1] = n;
+
+  dequant(x, param.input_scale, &x_fp32);
+  y_fp32.Resize(y_dims);
+  int8_t* dy = y.mutable_data<int8_t>();
+  float* dy_fp32 = y_fp32.mutable_data<float>();
+  if (per_column) {
+    for (int j = 0; j < n; j++) {
+      param.weight_scale.push_back(0.01f + 0.001f * j);
+    }
+    for (int64_t i = 0; i < y.numel(); i++) {
+      int col = trans_y ? (i / y_dims[yr - 1]) % n : i % n;
+      dy_fp32[i] = dy[i] * param.weight_scale[col];
+    }
+  } else {
+    param.weight_scale = {0.03f};
+    for (int64_t i = 0; i < y.numel(); i++) {
+      dy_fp32[i] = dy[i] * param.weight_scale[0];
+    }
+  }
+  out_ref.Resize(out_dims);
+  param.X = &x_fp32;
+  param.Y = &y_fp32;
+  param.Out = &out_ref;
+  run_kernel<x86::MatMulCompute<float>>(param);
+
+  out.Resize(out_dims);
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  run_kernel<x86::MatMulInt8Compute<OutType>>(param);
+  const float* dref = out_ref.data<float>();
+  return check_output<OutT>(
+      out,
+      std::vector<float>(dref, dref + out_ref.numel()),
+      param.output_scale,
+      "matmul, x: " + x_dims.repr() + ", y: " + y_dims.repr() +
+          ", trans_x: " + std::to_string(trans_x) + ", trans_y: " +
+          std::to_string(trans_y) + ", per_column: " +
+          std::to_string(per_column));
+}
+
+TEST(TestX86Int8Ops, matmul_int8) {
+  for (auto trans_x : {false, true}) {
+    for (auto trans_y : {false, true}) {
+      for (auto per_column : {false, true}) {
+        DDim x_dims = trans_x ? DDim({2, 3, 37, 19}) : DDim({2, 3, 19, 37});
+        // batched attention like and a shared weight
+        std::vector<DDim> ys = {trans_y ? DDim({2, 3, 45, 37})
+                                        : DDim({2, 3, 37, 45}),
+                                trans_y ? DDim({45, 37}) : DDim({37, 45})};
+        for (auto& y_dims : ys) {
+          EXPECT_TRUE(test_matmul_int8<PRECISION(kInt8)>(
+              x_dims, y_dims, trans_x, trans_y, per_column));
+          EXPECT_TRUE(test_matmul_int8<PRECISION(kFloat)>(
+              x_dims, y_dims, trans_x, trans_y, per_column));
+        }
+      }
+    }
+  }
+}
+
+#endif  // LITE_WITH_X86
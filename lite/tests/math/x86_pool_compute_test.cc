@@ -0,0 +1,306 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/backends/x86/math/pooling.h"
+#include "lite/core/profile/timer.h"
+#include "lite/kernels/x86/pool_compute.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::DDim DDim;
+typedef paddle::lite::Tensor Tensor;
+typedef paddle::lite::operators::PoolParam PoolParam;
+using paddle::lite::profile::Timer;
+namespace math = paddle::lite::x86::math;
+
+DEFINE_int32(warmup, 1, "warmup times");
+DEFINE_int32(repeats, 10, "repeats times");
+DEFINE_bool(run_benchmark, false, "time the pooling against the reference");
+
+static DDim pool_out_dim(const DDim& dim_in, const PoolParam& param) {
+  DDim dim_out = dim_in;
+  auto& pads = *param.paddings;
+  int round = param.ceil_mode ? 1 : 0;
+  for (int i = 0; i < 2; i++) {
+    if (param.global_pooling) {
+      dim_out[i + 2] = 1;
+    } else if (!param.adaptive) {
+      int stride = param.strides[i];
+      dim_out[i + 2] = (dim_in[i + 2] - param.ksize[i] + pads[2 * i] +
+                        pads[2 * i + 1] + round * (stride - 1)) /
+                           stride +
+                       1;
+    }
+  }
+  return dim_out;
+}
+
+// The scalar Pool2dFunctor the kernel used for every window.
+static void pool_basic(const PoolParam& param, Tensor* out) {
+  paddle::lite::X86Context ctx;
+  std::vector<int> ksize = param.ksize;
+  if (param.global_pooling) {
+    ksize = {static_cast<int>(param.x->dims()[2]),
+             static_cast<int>(param.x->dims()[3])};
+  }
+  if (param.pooling_type == "max") {
+    math::Pool2dFunctor<TARGET(kX86), math::MaxPool<float>, float> pool;
+    pool(ctx,
+         param.x,
+         ksize,
+         param.strides,
+         *param.paddings,
+         math::MaxPool<float>(),
+         true,
+         param.adaptive,
+         out);
+  } else {
+    math::Pool2dFunctor<TARGET(kX86), math::AvgPool<float>, float> pool;
+    pool(ctx,
+         param.x,
+         ksize,
+         param.strides,
+         *param.paddings,
+         math::AvgPool<float>(),
+         param.exclusive,
+         param.adaptive,
+         out);
+  }
+}
+
+static std::string pool_info(const PoolParam& param) {
+  auto& pads = *param.paddings;
+  return "input: " + param.x->dims().repr() + ", pooling_type: " +
+         param.pooling_type + ", kernel: " + std::to_string(param.ksize[0]) +
+         "x" + std::to_string(param.ksize[1]) + ", stride: " +
+         std::to_string(param.strides[0]) + ", pad: " +
+         std::to_string(pads[0]) + "," + std::to_string(pads[2]) +
+         ", global: " + std::to_string(param.global_pooling) +
+         ", adaptive: " + std::to_string(param.adaptive) + ", exclusive: " +
+         std::to_string(param.exclusive);
+}
+
+// Runs the kernel and the reference, the timings go to t_lite / t_basic.
+static bool run_pool(PoolParam param, Timer* t_lite, Timer* t_basic) {
+  Tensor out, out_ref;
+  DDim dim_out = pool_out_dim(param.x->dims(), param);
+  if (dim_out[2] < 1 || dim_out[3] < 1) return true;
+  out.Resize(dim_out);
+  out_ref.Resize(dim_out);
+  param.output = &out;
+
+  paddle::lite::kernels::x86::PoolCompute<float> pool;
+  std::unique_ptr<paddle::lite::KernelContext> ctx(
+      new paddle::lite::KernelContext);
+  ctx->As<paddle::lite::X86Context>();
+  pool.SetContext(std::move(ctx));
+  pool.SetParam(param);
+  int repeats = t_lite ? FLAGS_warmup + FLAGS_repeats : 1;
+  for (int i = 0; i < repeats; i++) {
+    if (t_lite && i >= FLAGS_warmup) t_lite->Start();
+    pool.Run();
+    if (t_lite && i >= FLAGS_warmup) t_lite->Stop();
+  }
+  for (int i = 0; i < repeats; i++) {
+    if (t_basic && i >= FLAGS_warmup) t_basic->Start();
+    pool_basic(param, &out_ref);
+    if (t_basic && i >= FLAGS_warmup) t_basic->Stop();
+  }
+
+  const float* dout = out.data<float>();
+  const float* dref = out_ref.data<float>();
+  for (int i = 0; i < out.numel(); i++) {
+    if (fabsf(dout[i] - dref[i]) > 1e-5f * (1.f + fabsf(dref[i]))) {
+      LOG(INFO) << pool_info(param) << ", mismatch at: " << i
+                << ", out: " << dout[i] << ", ref: " << dref[i];
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestX86Pool, pool_compute) {
+  Tensor x;
+  PoolParam param;
+  param.x = &x;
+  for (auto& chin : {3, 8, 16}) {
+    for (auto& hw : {1, 2, 7, 16, 33}) {
+      x.Resize({2, chin, hw, hw + 3});
+      x.mutable_data<float>();
+      fill_tensor_rand(x, -1.f, 1.f);
+      for (auto& pooling_type : {"max", "avg"}) {
+        param.pooling_type = pooling_type;
+        for (auto& exclusive : {false, true}) {
+          param.exclusive = exclusive;
+          // global and adaptive
+          param.ksize = {1, 1};
+          param.strides = {1, 1};
+          param.paddings = std::make_shared<std::vector<int>>(4, 0);
+          param.global_pooling = true;
+          EXPECT_TRUE(run_pool(param, nullptr, nullptr));
+          param.global_pooling = false;
+          param.adaptive = true;
+          for (auto& size : {1, 3}) {
+            param.ksize = {size, size};
+            EXPECT_TRUE(run_pool(param, nullptr, nullptr));
+          }
+          param.adaptive = false;
+          for (auto& k : {1, 2, 3, 5}) {
+            for (auto& stride : {1, 2}) {
+              for (auto& pad : {0, 1, 2}) {
+                // a window made of padding only has no reference value
+                if (pad >= k) continue;
+                for (auto& ceil_mode : {false, true}) {
+                  param.ksize = {k, k};
+                  param.strides = {stride, stride};
+                  param.paddings =
+                      std::make_shared<std::vector<int>>(4, pad);
+                  param.ceil_mode = ceil_mode;
+                  EXPECT_TRUE(run_pool(param, nullptr, nullptr));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// NCHW16c runs the AVX-512 loop when built with it, the scalar one if not.
+TEST(TestX86Pool, pool_nchwc16) {
+  const int num = 2;
+  const int block = 16;
+  const int cblocks = 2;
+  const int hin = 11;
+  const int win = 13;
+  const std::vector<int> ksize = {3, 3};
+  const std::vector<int> strides = {2, 2};
+  const std::vector<int> paddings = {1, 1, 1, 1};
+  const int hout = (hin + 2 - 3) / 2 + 1;
+  const int wout = (win + 2 - 3) / 2 + 1;
+  Tensor x, out, out_ref;
+  x.Resize({num, cblocks * block, hin, win});
+  out_ref.Resize({num, cblocks * block, hout, wout});
+  x.mutable_data<float>();
+  fill_tensor_rand(x, -1.f, 1.f);
+  std::vector<float> packed_x(x.numel());
+  std::vector<float> packed_out(out_ref.numel());
+  const float* dx = x.data<float>();
+  for (int n = 0; n < num * cblocks; n++) {
+    for (int i = 0; i < hin * win; i++) {
+      for (int c = 0; c < block; c++) {
+        packed_x[(n * hin * win + i) * block + c] =
+            dx[(n * block + c) * hin * win + i];
+      }
+    }
+  }
+  PoolParam param;
+  param.x = &x;
+  param.ksize = ksize;
+  param.strides = strides;
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  for (auto& pooling_type : {"max", "avg"}) {
+    param.pooling_type = pooling_type;
+    param.exclusive = false;
+    pool_basic(param, &out_ref);
+    if (param.pooling_type == "max") {
+      math::pooling_nchwc_max(packed_x.data(),
+                              packed_out.data(),
+                              num,
+                              cblocks,
+                              block,
+                              hin,
+                              win,
+                              hout,
+                              wout,
+                              ksize,
+                              strides,
+                              paddings);
+    } else {
+      math::pooling_nchwc_avg(packed_x.data(),
+                              packed_out.data(),
+                              num,
+                              cblocks,
+                              block,
+                              hin,
+                              win,
+                              hout,
+                              wout,
+                              ksize,
+                              strides,
+                              paddings,
+                              false);
+    }
+    const float* dref = out_ref.data<float>();
+    for (int n = 0; n < num * cblocks; n++) {
+      for (int i = 0; i < hout * wout; i++) {
+        for (int c = 0; c < block; c++) {
+          EXPECT_NEAR(packed_out[(n * hout * wout + i) * block + c],
+                      dref[(n * block + c) * hout * wout + i],
+                      1e-5f);
+        }
+      }
+    }
+  }
+}
+
+TEST(TestX86Pool, pool_benchmark) {
+  if (!FLAGS_run_benchmark) return;
+  struct PoolCase {
+    std::vector<int64_t> dims;
+    std::string pooling_type;
+    int k;
+    int stride;
+    int pad;
+    bool global;
+  };
+  const std::vector<PoolCase> cases = {
+      {{1, 64, 112, 112}, "max", 3, 2, 1, false},
+      {{1, 64, 112, 112}, "max", 2, 2, 0, false},
+      {{1, 256, 56, 56}, "avg", 2, 2, 0, false},
+      {{1, 128, 64, 64}, "max", 3, 1, 1, false},
+      {{1, 256, 38, 38}, "max", 5, 1, 2, false},
+      {{1, 2048, 7, 7}, "avg", 7, 1, 0, true},
+  };
+  for (auto& c : cases) {
+    Tensor x;
+    x.Resize(c.dims);
+    x.mutable_data<float>();
+    fill_tensor_rand(x, -1.f, 1.f);
+    PoolParam param;
+    param.x = &x;
+    param.pooling_type = c.pooling_type;
+    param.ksize = {c.k, c.k};
+    param.strides = {c.stride, c.stride};
+    param.paddings = std::make_shared<std::vector<int>>(4, c.pad);
+    param.global_pooling = c.global;
+    Timer t_lite, t_basic;
+    EXPECT_TRUE(run_pool(param, &t_lite, &t_basic));
+    LOG(INFO) << pool_info(param) << ", avg time: " << t_lite.LapTimes().Avg()
+              << " ms, basic avg time: " << t_basic.LapTimes().Avg() << " ms";
+  }
+}
+
+USE_LITE_KERNEL(pool2d, kX86, kFloat, kNCHW, def);
+
+#endif  // LITE_WITH_X86
@@ -0,0 +1,187 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef LITE_WITH_X86
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <algorithm>
+#include "lite/backends/x86/math/packed_sgemm.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/naive_math_impl.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+namespace math = paddle::lite::x86::math;
+
+enum SgemmTestMode { kPackNone = 0, kPackA, kPackB, kPackAB };
+
+bool test_x86_sgemm(bool tra,
+                    bool trb,
+                    int m,
+                    int n,
+                    int k,
+                    float alpha,
+                    float beta,
+                    SgemmTestMode mode) {
+  int lda = tra ? m : k;
+  int ldb = trb ? k : n;
+  int ldc = n;
+  Tensor ta, tb, tc, tc_basic, ta_packed, tb_packed;
+  ta.Resize({tra ? k : m, lda});
+  tb.Resize({trb ? n : k, ldb});
+  tc.Resize({m, ldc});
+  tc_basic.Resize({m, ldc});
+  ta_packed.Resize({math::sgemm_packed_a_size(m, k)});
+  tb_packed.Resize({math::sgemm_packed_b_size(n, k)});
+
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  fill_tensor_rand(tc, -1.f, 1.f);
+  tc_basic.CopyDataFrom(tc);
+
+  auto da = ta.data<float>();
+  auto db = tb.data<float>();
+  auto dc = tc.mutable_data<float>();
+  auto dc_basic = tc_basic.mutable_data<float>();
+  auto da_packed = ta_packed.mutable_data<float>();
+  auto db_packed = tb_packed.mutable_data<float>();
+
+  basic_gemm<float, float>(tra,
+                           trb,
+                           m,
+                           n,
+                           k,
+                           alpha,
+                           da,
+                           lda,
+                           db,
+                           ldb,
+                           beta,
+                           dc_basic,
+                           ldc,
+                           nullptr,
+                           false,
+                           false);
+
+  switch (mode) {
+    case kPackNone:
+      math::sgemm(tra, trb, m, n, k, alpha, da, lda, db, ldb, beta, dc, ldc);
+      break;
+    case kPackA:
+      math::sgemm_prepack_a(tra, m, k, da, lda, da_packed);
+      math::sgemm_prepacked_a(
+          trb, m, n, k, alpha, da_packed, db, ldb, beta, dc, ldc);
+      break;
+    case kPackB:
+      math::sgemm_prepack_b(trb, n, k, db, ldb, db_packed);
+      math::sgemm_prepacked_b(
+          tra, m, n, k, alpha, da, lda, db_packed, beta, dc, ldc);
+      break;
+    case kPackAB:
+      math::sgemm_prepack_a(tra, m, k, da, lda, da_packed);
+      math::sgemm_prepack_b(trb, n, k, db, ldb, db_packed);
+      math::sgemm_packed(m, n, k, alpha, da_packed, db_packed, beta, dc, ldc);
+      break;
+  }
+
+  float max_err = 0.f;
+  for (int i = 0; i < m * ldc; i++) {
+    max_err = std::max(max_err, std::fabs(dc[i] - dc_basic[i]));
+  }
+  if (max_err > 1e-3f) {
+    LOG(INFO) << "x86 sgemm M: " << m << ", N: " << n << ", K: " << k
+              << ", transA: " << tra << ", transB: " << trb
+              << ", alpha: " << alpha << ", beta: " << beta
+              << ", mode: " << mode << ", max diff: " << max_err;
+    return false;
+  }
+  return true;
+}
+
+TEST(TestX86LiteSgemm, sgemm_compute) {
+  for (auto& m : {1, 3, 6, 13, 64, 101}) {
+    for (auto& n : {1, 5, 16, 33, 255}) {
+      for (auto& k : {1, 7, 256, 300}) {
+        for (auto& tra : {false, true}) {
+          for (auto& trb : {false, true}) {
+            for (auto& beta : {0.f, 0.5f}) {
+              for (auto& mode : {kPackNone, kPackA, kPackB, kPackAB}) {
+                auto flag =
+                    test_x86_sgemm(tra, trb, m, n, k, 0.8f, beta, mode);
+                if (!flag) {
+                  LOG(FATAL) << "sgemm precision check failed (diff > 1e-3)!";
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestX86LiteSgemm, sgemv_compute) {
+  for (auto& m : {1, 7, 64, 300}) {
+    for (auto& n : {1, 9, 257}) {
+      for (auto& tra : {false, true}) {
+        Tensor ta, tx, ty, ty_basic;
+        ta.Resize({m, n});
+        tx.Resize({tra ? m : n});
+        ty.Resize({tra ? n : m});
+        ty_basic.Resize({tra ? n : m});
+        fill_tensor_rand(ta, -1.f, 1.f);
+        fill_tensor_rand(tx, -1.f, 1.f);
+        fill_tensor_rand(ty, -1.f, 1.f);
+        ty_basic.CopyDataFrom(ty);
+        auto dy_basic = ty_basic.mutable_data<float>();
+        // y = A * x is a gemm of (m x n) * (n x 1)
+        basic_gemm<float, float>(tra,
+                                 false,
+                                 tra ? n : m,
+                                 1,
+                                 tra ? m : n,
+                                 1.f,
+                                 ta.data<float>(),
+                                 n,
+                                 tx.data<float>(),
+                                 1,
+                                 0.5f,
+                                 dy_basic,
+                                 1,
+                                 nullptr,
+                                 false,
+                                 false);
+        math::sgemv(tra,
+                    m,
+                    n,
+                    1.f,
+                    ta.data<float>(),
+                    n,
+                    tx.data<float>(),
+                    1,
+                    0.5f,
+                    ty.mutable_data<float>(),
+                    1);
+        auto dy = ty.data<float>();
+        for (int i = 0; i < ty.numel(); i++) {
+          EXPECT_NEAR(dy[i], dy_basic[i], 1e-3f);
+        }
+      }
+    }
+  }
+}
+
+#endif  // LITE_WITH_X86
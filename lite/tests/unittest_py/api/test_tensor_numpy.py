@@ -0,0 +1,118 @@
+# Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import sys
+sys.path.append('../')
+
+import platform
+import unittest
+import weakref
+
+import numpy as np
+from paddlelite.lite import CxxConfig, Place, TargetType, PrecisionType, create_paddle_predictor
+from program_config import TensorConfig, ProgramConfig, OpConfig, create_fake_model
+
+# The numpy arrays aligned to this are shared by the tensors, see tensor_py.h.
+ZERO_COPY_ALIGNMENT = 16
+
+
+def create_scale_predictor():
+    '''  out = 2 * x + 1  '''
+    scale_op = OpConfig(
+        type="scale",
+        inputs={"X": ["x"]},
+        outputs={"Out": ["out"]},
+        attrs={"scale": 2.0,
+               "bias": 1.0,
+               "bias_after_scale": True})
+    program_config = ProgramConfig(
+        ops=[scale_op],
+        weights={},
+        inputs={"x": TensorConfig(shape=[2, 8])},
+        outputs=["out"])
+    model, params = create_fake_model(program_config)
+    config = CxxConfig()
+    config.set_model_buffer(model, len(model), params, len(params))
+    if platform.machine().lower() in ["x86_64", "amd64"]:
+        target = TargetType.X86
+    else:
+        target = TargetType.ARM
+    config.set_valid_places([Place(target, PrecisionType.FP32)])
+    return create_paddle_predictor(config)
+
+
+def new_input(value):
+    x = np.full([2, 8], value, dtype=np.float32)
+    if x.ctypes.data % ZERO_COPY_ALIGNMENT != 0:
+        raise unittest.SkipTest("numpy returned an unaligned array")
+    return x
+
+
+class TestTensorNumpy(unittest.TestCase):
+    def setUp(self):
+        self.predictor = create_scale_predictor()
+        self.input = self.predictor.get_input(0)
+        self.output = self.predictor.get_output(0)
+
+    def run_output(self):
+        self.predictor.run()
+        return self.output.numpy(copy=True)
+
+    def test_from_numpy_shares(self):
+        x = new_input(1.0)
+        self.input.from_numpy(x)
+        np.testing.assert_allclose(self.run_output(), 3.0)
+        # the tensor reads the array, not a copy of it
+        x[...] = 2.0
+        np.testing.assert_allclose(self.run_output(), 5.0)
+
+    def test_from_numpy_keeps_array(self):
+        x = new_input(1.0)
+        ref = weakref.ref(x)
+        self.input.from_numpy(x)
+        del x
+        self.assertIsNotNone(ref())
+        np.testing.assert_allclose(self.run_output(), 3.0)
+        # released once the tensors take another array
+        self.input.from_numpy(new_input(4.0))
+        np.testing.assert_allclose(self.run_output(), 9.0)
+        self.assertIsNone(ref())
+
+    def test_from_numpy_copy(self):
+        x = new_input(1.0)
+        self.input.from_numpy(x, copy=True)
+        x[...] = 2.0
+        np.testing.assert_allclose(self.run_output(), 3.0)
+
+    def test_numpy_copy(self):
+        self.input.from_numpy(new_input(1.0))
+        self.predictor.run()
+        view = self.output.numpy()
+        copy = self.output.numpy(copy=True)
+        # the view follows the next run, the copy does not
+        self.input.from_numpy(new_input(2.0))
+        self.predictor.run()
+        np.testing.assert_allclose(view, 5.0)
+        np.testing.assert_allclose(copy, 3.0)
+
+    def test_numpy_view_outlives_predictor(self):
+        self.input.from_numpy(new_input(1.0))
+        self.predictor.run()
+        view = self.output.numpy()
+        del self.input, self.output, self.predictor
+        np.testing.assert_allclose(view, 3.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -17,11 +17,15 @@
 #include <string.h>
 #include <algorithm>
 #include <climits>
+#include <vector>
 #include "lite/utils/cv/image2tensor.h"
 #include "lite/utils/cv/image_convert.h"
 #include "lite/utils/cv/image_flip.h"
 #include "lite/utils/cv/image_resize.h"
 #include "lite/utils/cv/image_rotate.h"
+#ifdef LITE_WITH_X86
+#include "lite/utils/cv/x86/image_kernels.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -172,6 +176,39 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_to_tensor(
                     scales);
 }
 
+__attribute__((visibility("default"))) void
+ImagePreprocess::image_resize_to_tensor(const uint8_t* src,
+                                        Tensor* dstTensor,
+                                        LayoutType layout,
+                                        float* means,
+                                        float* scales) {
+  int srcw = this->transParam_.iw;
+  int srch = this->transParam_.ih;
+  int dstw = this->transParam_.ow;
+  int dsth = this->transParam_.oh;
+#ifdef LITE_WITH_X86
+  if (fused_resize_to_tensor(src,
+                             dstTensor,
+                             this->srcFormat_,
+                             this->dstFormat_,
+                             srcw,
+                             srch,
+                             dstw,
+                             dsth,
+                             layout,
+                             means,
+                             scales)) {
+    return;
+  }
+#endif
+  // 4 bytes a pixel is the most, and NV12 and NV21 take 1.5
+  std::vector<uint8_t> converted(srcw * srch * 4);
+  std::vector<uint8_t> resized(dstw * dsth * 4);
+  image_convert(src, converted.data());
+  image_resize(converted.data(), resized.data());
+  image_to_tensor(resized.data(), dstTensor, layout, means, scales);
+}
+
 __attribute__((visibility("default"))) void ImagePreprocess::image_crop(
     const uint8_t* src,
     uint8_t* dst,
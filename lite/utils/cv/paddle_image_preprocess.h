@@ -247,6 +247,24 @@ class ImagePreprocess {
                        float* means,
                        float* scales);
 
+  /*
+  * color convert, resize and change image data to tensor data in one call,
+  * the same result as image_convert, image_resize and image_to_tensor
+  * srcFormat_ is converted to dstFormat_ and resized from (iw, ih) to
+  * (ow, oh) of the TransParam. On x86, the conversions which only reorder
+  * the channels, e.g. BGR to RGB, run in one pass with no intermediate image
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+  */
+  void image_resize_to_tensor(const uint8_t* src,
+                              Tensor* dstTensor,
+                              LayoutType layout,
+                              float* means,
+                              float* scales);
+
   /*
   * image crop process
   * color format support 1-channel image, 3-channel image and 4-channel image
@@ -0,0 +1,264 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image2tensor.h"
+#include <vector>
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/cv/x86/image_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+/*
+ * change image data to tensor data
+ * support image format is GRAY, BGR(RGB) and BGRA(RGBA), Data layout is NHWC
+ * and NCHW, the alpha is dropped
+ * param src: input image data
+ * param dstTensor: output tensor data
+ * param srcFormat: input image format, support GRAY, BGR(GRB) and BGRA(RGBA)
+ * param srcw: input image width
+ * param srch: input image height
+ * param layout: output tensor layout，support NHWC and NCHW
+ * param means: means of image
+ * param scales: scales of image
+ */
+void Image2Tensor::choose(const uint8_t* src,
+                          Tensor* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int srcw,
+                          int srch,
+                          float* means,
+                          float* scales) {
+  int channels = 0;
+  if (srcFormat == GRAY) {
+    channels = 1;
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    channels = 3;
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    channels = 4;
+  }
+  if (channels == 0 ||
+      (layout != LayoutType::kNCHW && layout != LayoutType::kNHWC)) {
+    printf("this layout: %d or image format: %d not support \n",
+           static_cast<int>(layout),
+           srcFormat);
+    return;
+  }
+  float* output = dst->mutable_data<float>();
+  const int order[3] = {0, 1, 2};
+  int out_channels = channels == 1 ? 1 : 3;
+  int size = srcw * srch;
+  parallel_rows(srch, [&](int begin, int end) {
+    std::vector<uint8_t> scratch(channels == 4 ? srcw * 3 : 0);
+    for (int i = begin; i < end; i++) {
+      const uint8_t* row = src + i * srcw * channels;
+      if (layout == LayoutType::kNCHW) {
+        float* planes[3];
+        for (int k = 0; k < out_channels; k++) {
+          planes[k] = output + k * size + i * srcw;
+        }
+        row_to_tensor_chw(
+            row, channels, srcw, order, out_channels, planes, means, scales);
+      } else {
+        row_to_tensor_hwc(row,
+                          channels,
+                          srcw,
+                          order,
+                          out_channels,
+                          output + i * srcw * out_channels,
+                          means,
+                          scales,
+                          scratch.data());
+      }
+    }
+  });
+}
+
+#ifdef __SSE4_1__
+// Writes (x - mean) * scale of the low 8 bytes of `x`, with the per lane
+// means and scales.
+static inline void normalize8(__m128i x,
+                              const float* mean,
+                              const float* scale,
+                              float* dst) {
+#ifdef __AVX2__
+  __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x));
+  f = _mm256_mul_ps(_mm256_sub_ps(f, _mm256_loadu_ps(mean)),
+                    _mm256_loadu_ps(scale));
+  _mm256_storeu_ps(dst, f);
+#else
+  __m128 lo = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(x));
+  __m128 hi = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(x, 4)));
+  lo = _mm_mul_ps(_mm_sub_ps(lo, _mm_loadu_ps(mean)), _mm_loadu_ps(scale));
+  hi = _mm_mul_ps(_mm_sub_ps(hi, _mm_loadu_ps(mean + 4)),
+                  _mm_loadu_ps(scale + 4));
+  _mm_storeu_ps(dst, lo);
+  _mm_storeu_ps(dst + 4, hi);
+#endif
+}
+
+// Splits 8 pixels into the low 8 bytes of a register a channel.
+static inline void deinterleave8(const uint8_t* src,
+                                 int channels,
+                                 __m128i* v) {
+  if (channels == 1) {
+    v[0] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+  } else if (channels == 3) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 16));
+    v[0] = _mm_or_si128(
+        _mm_shuffle_epi8(lo,
+                         _mm_setr_epi8(
+                             0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1,
+                             -1, -1, -1)),
+        _mm_shuffle_epi8(hi,
+                         _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, -1, -1,
+                                       -1, -1, -1, -1, -1, -1)));
+    v[1] = _mm_or_si128(
+        _mm_shuffle_epi8(lo,
+                         _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1,
+                                       -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(hi,
+                         _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, -1, -1,
+                                       -1, -1, -1, -1, -1, -1)));
+    v[2] = _mm_or_si128(
+        _mm_shuffle_epi8(lo,
+                         _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1,
+                                       -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(hi,
+                         _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, -1, -1,
+                                       -1, -1, -1, -1, -1, -1)));
+  } else {
+    const __m128i mask =
+        _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    __m128i t0 = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), mask);
+    __m128i t1 = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), mask);
+    __m128i bg = _mm_unpacklo_epi32(t0, t1);
+    __m128i ra = _mm_unpackhi_epi32(t0, t1);
+    v[0] = bg;
+    v[1] = _mm_srli_si128(bg, 8);
+    v[2] = ra;
+    v[3] = _mm_srli_si128(ra, 8);
+  }
+}
+#endif
+
+void row_to_tensor_chw(const uint8_t* src,
+                       int channels,
+                       int width,
+                       const int* order,
+                       int out_channels,
+                       float* const* planes,
+                       const float* means,
+                       const float* scales) {
+  int x = 0;
+#ifdef __SSE4_1__
+  float mean8[3][8];
+  float scale8[3][8];
+  for (int k = 0; k < out_channels; k++) {
+    for (int i = 0; i < 8; i++) {
+      mean8[k][i] = means[k];
+      scale8[k][i] = scales[k];
+    }
+  }
+  __m128i v[4];
+  for (; x + 8 <= width; x += 8) {
+    deinterleave8(src + x * channels, channels, v);
+    for (int k = 0; k < out_channels; k++) {
+      normalize8(v[order[k]], mean8[k], scale8[k], planes[k] + x);
+    }
+  }
+#endif
+  for (; x < width; x++) {
+    const uint8_t* px = src + x * channels;
+    for (int k = 0; k < out_channels; k++) {
+      planes[k][x] = (px[order[k]] - means[k]) * scales[k];
+    }
+  }
+}
+
+void row_to_tensor_hwc(const uint8_t* src,
+                       int channels,
+                       int width,
+                       const int* order,
+                       int out_channels,
+                       float* dst,
+                       const float* means,
+                       const float* scales,
+                       uint8_t* scratch) {
+  if (out_channels == 1) {
+    row_to_tensor_chw(src, channels, width, order, 1, &dst, means, scales);
+    return;
+  }
+  // Reorders the channels to the output ones first.
+  bool keep = order[0] == 0 && order[1] == 1 && order[2] == 2;
+  bool swap = order[0] == 2 && order[1] == 1 && order[2] == 0;
+  if (channels == 1) {
+    hwc1_to_hwc3_row(src, scratch, width);
+    src = scratch;
+  } else if (channels == 3 && swap) {
+    hwc3_trans_row(src, scratch, width);
+    src = scratch;
+  } else if (channels == 4 && keep) {
+    hwc4_to_hwc3_row(src, scratch, width);
+    src = scratch;
+  } else if (channels == 4 && swap) {
+    hwc4_trans_hwc3_row(src, scratch, width);
+    src = scratch;
+  } else if (!(channels == 3 && keep)) {
+    for (int x = 0; x < width; x++) {
+      for (int k = 0; k < 3; k++) {
+        scratch[x * 3 + k] = src[x * channels + order[k]];
+      }
+    }
+    src = scratch;
+  }
+  int x = 0;
+#ifdef __SSE4_1__
+  // 8 pixels are 24 floats, channel i % 3 at the i-th one.
+  float mean24[24];
+  float scale24[24];
+  for (int i = 0; i < 24; i++) {
+    mean24[i] = means[i % 3];
+    scale24[i] = scales[i % 3];
+  }
+  for (; x + 8 <= width; x += 8) {
+    const uint8_t* px = src + x * 3;
+    float* out = dst + x * 3;
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+    __m128i hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(px + 16));
+    normalize8(lo, mean24, scale24, out);
+    normalize8(_mm_srli_si128(lo, 8), mean24 + 8, scale24 + 8, out + 8);
+    normalize8(hi, mean24 + 16, scale24 + 16, out + 16);
+  }
+#endif
+  for (; x < width; x++) {
+    for (int k = 0; k < 3; k++) {
+      dst[x * 3 + k] = (src[x * 3 + k] - means[k]) * scales[k];
+    }
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
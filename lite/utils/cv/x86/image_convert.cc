@@ -0,0 +1,532 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_convert.h"
+#include <math.h>
+#include <string.h>
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/cv/x86/image_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void nv21_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv21_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv12_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv12_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// gray to bgr rgb
+void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgra to bgr or rgba to rgb
+void hwc4_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgr to rgb or rgb to bgr
+void hwc3_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgra to rgb or rgba to bgr
+void hwc4_trans_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgra rgba to gray
+void hwc4_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgr rgb to gray
+void hwc3_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// gray to bgra rgba
+void hwc1_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgr to bgra or rgb to rgba
+void hwc3_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgra to rgba or rgba to bgra
+void hwc4_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgr to rgba or rgb to bgra
+void hwc3_trans_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+
+/*
+ * image color convert, the same formats and results as the arm version
+ * param src: input image data
+ * param dst: output image data
+ * param srcFormat: input image image format support: GRAY, NV12(NV21),
+ * BGR(RGB) and BGRA(RGBA)
+ * param dstFormat: output image image format, support GRAY, BGR(RGB) and
+ * BGRA(RGBA)
+ */
+void ImageConvert::choose(const uint8_t* src,
+                          uint8_t* dst,
+                          ImageFormat srcFormat,
+                          ImageFormat dstFormat,
+                          int srcw,
+                          int srch) {
+  if (srcFormat == dstFormat) {
+    // copy
+    int size = srcw * srch;
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (ceil(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  } else {
+    if (srcFormat == NV12 && (dstFormat == BGR || dstFormat == RGB)) {
+      impl_ = nv12_to_bgr;
+    } else if (srcFormat == NV21 && (dstFormat == BGR || dstFormat == RGB)) {
+      impl_ = nv21_to_bgr;
+    } else if (srcFormat == NV12 && (dstFormat == BGRA || dstFormat == RGBA)) {
+      impl_ = nv12_to_bgra;
+    } else if (srcFormat == NV21 && (dstFormat == BGRA || dstFormat == RGBA)) {
+      impl_ = nv21_to_bgra;
+    } else if ((srcFormat == RGBA && dstFormat == RGB) ||
+               (srcFormat == BGRA && dstFormat == BGR)) {
+      impl_ = hwc4_to_hwc3;
+    } else if ((srcFormat == RGB && dstFormat == RGBA) ||
+               (srcFormat == BGR && dstFormat == BGRA)) {
+      impl_ = hwc3_to_hwc4;
+    } else if ((srcFormat == RGB && dstFormat == BGR) ||
+               (srcFormat == BGR && dstFormat == RGB)) {
+      impl_ = hwc3_trans;
+    } else if ((srcFormat == RGBA && dstFormat == BGRA) ||
+               (srcFormat == BGRA && dstFormat == RGBA)) {
+      impl_ = hwc4_trans;
+    } else if ((srcFormat == RGB && dstFormat == GRAY) ||
+               (srcFormat == BGR && dstFormat == GRAY)) {
+      impl_ = hwc3_to_hwc1;
+    } else if ((srcFormat == GRAY && dstFormat == RGB) ||
+               (srcFormat == GRAY && dstFormat == BGR)) {
+      impl_ = hwc1_to_hwc3;
+    } else if ((srcFormat == RGBA && dstFormat == BGR) ||
+               (srcFormat == BGRA && dstFormat == RGB)) {
+      impl_ = hwc4_trans_hwc3;
+    } else if ((srcFormat == RGB && dstFormat == BGRA) ||
+               (srcFormat == BGR && dstFormat == RGBA)) {
+      impl_ = hwc3_trans_hwc4;
+    } else if ((srcFormat == GRAY && dstFormat == RGBA) ||
+               (srcFormat == GRAY && dstFormat == BGRA)) {
+      impl_ = hwc1_to_hwc4;
+    } else if ((srcFormat == RGBA && dstFormat == GRAY) ||
+               (srcFormat == BGRA && dstFormat == GRAY)) {
+      impl_ = hwc4_to_hwc1;
+    } else {
+      printf("srcFormat: %d, dstFormat: %d does not support! \n",
+             srcFormat,
+             dstFormat);
+      return;
+    }
+  }
+  impl_(src, dst, srcw, srch);
+}
+
+typedef void (*convert_row_func)(const uint8_t* src, uint8_t* dst, int w);
+
+static void convert_rows(const uint8_t* src,
+                         uint8_t* dst,
+                         int srcw,
+                         int srch,
+                         int src_c,
+                         int dst_c,
+                         convert_row_func row) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    row(src + i * srcw * src_c, dst + i * srcw * dst_c, srcw);
+  }
+  LITE_PARALLEL_END();
+}
+
+#ifdef __SSSE3__
+// Stores the low 8 bytes of b, g and r as 8 interleaved pixels.
+static inline void store_hwc3_x8(uint8_t* dst,
+                                 __m128i b,
+                                 __m128i g,
+                                 __m128i r) {
+  const __m128i mbg0 =
+      _mm_setr_epi8(0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5);
+  const __m128i mr0 = _mm_setr_epi8(
+      -1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+  const __m128i mbg1 = _mm_setr_epi8(
+      13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i mr1 = _mm_setr_epi8(
+      -1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+  __m128i bg = _mm_unpacklo_epi64(b, g);
+  __m128i out0 = _mm_or_si128(_mm_shuffle_epi8(bg, mbg0),
+                              _mm_shuffle_epi8(r, mr0));
+  __m128i out1 = _mm_or_si128(_mm_shuffle_epi8(bg, mbg1),
+                              _mm_shuffle_epi8(r, mr1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out0);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), out1);
+}
+
+// Stores the low 8 bytes of b, g and r as 8 pixels with alpha 255.
+static inline void store_hwc4_x8(uint8_t* dst,
+                                 __m128i b,
+                                 __m128i g,
+                                 __m128i r) {
+  __m128i bg = _mm_unpacklo_epi8(b, g);
+  __m128i ra = _mm_unpacklo_epi8(r, _mm_set1_epi8(-1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm_unpacklo_epi16(bg, ra));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16),
+                   _mm_unpackhi_epi16(bg, ra));
+}
+
+// Shuffles `px_step` pixels a step by `mask` and returns the pixels done.
+// The loads and stores take 16 bytes, the bytes stored past the step are
+// rewritten by the next step or the scalar tail.
+static inline int shuffle_row(const uint8_t* src,
+                              uint8_t* dst,
+                              int w,
+                              int src_c,
+                              int dst_c,
+                              int px_step,
+                              __m128i mask,
+                              __m128i fill) {
+  int j = 0;
+  for (; j * src_c + 16 <= w * src_c && j * dst_c + 16 <= w * dst_c;
+       j += px_step) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    x = _mm_or_si128(_mm_shuffle_epi8(x, mask), fill);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), x);
+    src += px_step * src_c;
+    dst += px_step * dst_c;
+  }
+  return j;
+}
+#endif
+
+void hwc3_trans_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+  j = shuffle_row(src, dst, w, 3, 3, 5, mask, _mm_setzero_si128());
+  src += j * 3;
+  dst += j * 3;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[2];
+    dst[1] = src[1];
+    dst[2] = src[0];
+    src += 3;
+    dst += 3;
+  }
+}
+
+static void hwc4_trans_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  j = shuffle_row(src, dst, w, 4, 4, 4, mask, _mm_setzero_si128());
+  src += j * 4;
+  dst += j * 4;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[2];
+    dst[1] = src[1];
+    dst[2] = src[0];
+    dst[3] = src[3];
+    src += 4;
+    dst += 4;
+  }
+}
+
+void hwc4_to_hwc3_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  j = shuffle_row(src, dst, w, 4, 3, 4, mask, _mm_setzero_si128());
+  src += j * 4;
+  dst += j * 3;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    src += 4;
+    dst += 3;
+  }
+}
+
+void hwc4_trans_hwc3_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  j = shuffle_row(src, dst, w, 4, 3, 4, mask, _mm_setzero_si128());
+  src += j * 4;
+  dst += j * 3;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[2];
+    dst[1] = src[1];
+    dst[2] = src[0];
+    src += 4;
+    dst += 3;
+  }
+}
+
+static void hwc3_to_hwc4_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha = _mm_set1_epi32(0xff000000);
+  j = shuffle_row(src, dst, w, 3, 4, 4, mask, alpha);
+  src += j * 3;
+  dst += j * 4;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    dst[3] = 255;
+    src += 3;
+    dst += 4;
+  }
+}
+
+static void hwc3_trans_hwc4_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i mask =
+      _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+  const __m128i alpha = _mm_set1_epi32(0xff000000);
+  j = shuffle_row(src, dst, w, 3, 4, 4, mask, alpha);
+  src += j * 3;
+  dst += j * 4;
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[2];
+    dst[1] = src[1];
+    dst[2] = src[0];
+    dst[3] = 255;
+    src += 3;
+    dst += 4;
+  }
+}
+
+void hwc1_to_hwc3_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  for (; j + 8 <= w; j += 8) {
+    __m128i g = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    store_hwc3_x8(dst, g, g, g);
+    src += 8;
+    dst += 24;
+  }
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[0];
+    dst[1] = src[0];
+    dst[2] = src[0];
+    src++;
+    dst += 3;
+  }
+}
+
+static void hwc1_to_hwc4_row(const uint8_t* src, uint8_t* dst, int w) {
+  int j = 0;
+#ifdef __SSSE3__
+  for (; j + 8 <= w; j += 8) {
+    __m128i g = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    store_hwc4_x8(dst, g, g, g);
+    src += 8;
+    dst += 32;
+  }
+#endif
+  for (; j < w; j++) {
+    dst[0] = src[0];
+    dst[1] = src[0];
+    dst[2] = src[0];
+    dst[3] = 255;
+    src++;
+    dst += 4;
+  }
+}
+
+/*
+ * gray = (15 * c0 + 75 * c1 + 38 * c2) >> 7, the arm weights of
+ * CV_BGR2GRAY
+ */
+static void hwc34_to_hwc1_row(const uint8_t* src,
+                              uint8_t* dst,
+                              int w,
+                              int c) {
+  int j = 0;
+#ifdef __SSSE3__
+  const __m128i weights = _mm_setr_epi8(
+      15, 75, 38, 0, 15, 75, 38, 0, 15, 75, 38, 0, 15, 75, 38, 0);
+  // bgr to bgr0
+  const __m128i mask =
+      _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  // Two loads of 16 bytes, 4 pixels apart.
+  for (; j + 4 + 16 / c <= w; j += 8) {
+    __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * c));
+    if (c == 3) {
+      x0 = _mm_shuffle_epi8(x0, mask);
+      x1 = _mm_shuffle_epi8(x1, mask);
+    }
+    __m128i s0 = _mm_maddubs_epi16(x0, weights);
+    __m128i s1 = _mm_maddubs_epi16(x1, weights);
+    __m128i sum = _mm_srli_epi16(_mm_hadd_epi16(s0, s1), 7);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst),
+                     _mm_packus_epi16(sum, sum));
+    src += 8 * c;
+    dst += 8;
+  }
+#endif
+  for (; j < w; j++) {
+    int sum = src[0] * 15 + src[1] * 75 + src[2] * 38;
+    *dst++ = sum >> 7;
+    src += c;
+  }
+}
+
+static void hwc3_to_hwc1_row(const uint8_t* src, uint8_t* dst, int w) {
+  hwc34_to_hwc1_row(src, dst, w, 3);
+}
+
+static void hwc4_to_hwc1_row(const uint8_t* src, uint8_t* dst, int w) {
+  hwc34_to_hwc1_row(src, dst, w, 4);
+}
+
+void hwc3_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 3, 3, hwc3_trans_row);
+}
+void hwc4_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 4, 4, hwc4_trans_row);
+}
+void hwc4_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 4, 3, hwc4_to_hwc3_row);
+}
+void hwc4_trans_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 4, 3, hwc4_trans_hwc3_row);
+}
+void hwc3_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 3, 4, hwc3_to_hwc4_row);
+}
+void hwc3_trans_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 3, 4, hwc3_trans_hwc4_row);
+}
+void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 1, 3, hwc1_to_hwc3_row);
+}
+void hwc1_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 1, 4, hwc1_to_hwc4_row);
+}
+void hwc3_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 3, 1, hwc3_to_hwc1_row);
+}
+void hwc4_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  convert_rows(src, dst, srcw, srch, 4, 1, hwc4_to_hwc1_row);
+}
+
+/*
+ * nv12(yuv) to BGR, the same 7-bit fixed point as the arm version
+ * R = Y + 1.402*(V-128);
+ * G = Y - 0.34414*(U-128) - 0.71414*(V-128);
+ * B = Y + 1.772*(U-128);
+ * `u_idx` is the index of U in a UV pair, 0 for nv12 and 1 for nv21.
+ */
+static void nv_to_bgr_x(const uint8_t* src,
+                        uint8_t* dst,
+                        int srcw,
+                        int srch,
+                        int u_idx,
+                        int dst_c) {
+  const uint8_t* uv = src + srch * srcw;
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* ptr_y = src + i * srcw;
+    const uint8_t* ptr_uv = uv + (i / 2) * srcw;
+    uint8_t* ptr_out = dst + i * srcw * dst_c;
+    int j = 0;
+#ifdef __SSSE3__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    // Each U and V of a pair is used by 2 pixels.
+    const __m128i mu =
+        u_idx == 0
+            ? _mm_setr_epi8(0, -1, 0, -1, 2, -1, 2, -1, 4, -1, 4, -1, 6, -1, 6,
+                            -1)
+            : _mm_setr_epi8(1, -1, 1, -1, 3, -1, 3, -1, 5, -1, 5, -1, 7, -1, 7,
+                            -1);
+    const __m128i mv =
+        u_idx == 0
+            ? _mm_setr_epi8(1, -1, 1, -1, 3, -1, 3, -1, 5, -1, 5, -1, 7, -1, 7,
+                            -1)
+            : _mm_setr_epi8(0, -1, 0, -1, 2, -1, 2, -1, 4, -1, 4, -1, 6, -1, 6,
+                            -1);
+    for (; j + 8 <= srcw; j += 8) {
+      __m128i y = _mm_unpacklo_epi8(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr_y + j)), zero);
+      __m128i vu =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr_uv + j));
+      __m128i u = _mm_sub_epi16(_mm_shuffle_epi8(vu, mu), bias);
+      __m128i v = _mm_sub_epi16(_mm_shuffle_epi8(vu, mv), bias);
+      __m128i ra = _mm_srai_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(179)), 7);
+      __m128i ga = _mm_srai_epi16(
+          _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(44)),
+                        _mm_mullo_epi16(v, _mm_set1_epi16(91))),
+          7);
+      __m128i ba = _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(227)), 7);
+      __m128i r = _mm_add_epi16(y, ra);
+      __m128i g = _mm_sub_epi16(y, ga);
+      __m128i b = _mm_add_epi16(y, ba);
+      r = _mm_packus_epi16(r, r);
+      g = _mm_packus_epi16(g, g);
+      b = _mm_packus_epi16(b, b);
+      if (dst_c == 3) {
+        store_hwc3_x8(ptr_out + j * 3, b, g, r);
+      } else {
+        store_hwc4_x8(ptr_out + j * 4, b, g, r);
+      }
+    }
+#endif
+    for (; j < srcw; j++) {
+      const uint8_t* pair = ptr_uv + (j & ~1);
+      int u = pair[u_idx] - 128;
+      int v = pair[1 - u_idx] - 128;
+      int ra = (179 * v) >> 7;
+      int ga = (44 * u + 91 * v) >> 7;
+      int ba = (227 * u) >> 7;
+      int y = ptr_y[j];
+      int r = y + ra;
+      int g = y - ga;
+      int b = y + ba;
+      uint8_t* out = ptr_out + j * dst_c;
+      out[0] = b < 0 ? 0 : (b > 255) ? 255 : b;
+      out[1] = g < 0 ? 0 : (g > 255) ? 255 : g;
+      out[2] = r < 0 ? 0 : (r > 255) ? 255 : r;
+      if (dst_c == 4) out[3] = 255;
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void nv12_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_bgr_x(src, dst, srcw, srch, 0, 3);
+}
+void nv21_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_bgr_x(src, dst, srcw, srch, 1, 3);
+}
+void nv12_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_bgr_x(src, dst, srcw, srch, 0, 4);
+}
+void nv21_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_bgr_x(src, dst, srcw, srch, 1, 4);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,137 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_flip.h"
+#include <string.h>
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageFlip::choose(const uint8_t* src,
+                       uint8_t* dst,
+                       ImageFormat srcFormat,
+                       int srcw,
+                       int srch,
+                       FlipParam flip_param) {
+  if (srcFormat == GRAY) {
+    flip_hwc1(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    flip_hwc3(src, dst, srcw, srch, flip_param);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    flip_hwc4(src, dst, srcw, srch, flip_param);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+// Mirrors a row of `w` pixels of `num` channels.
+static void mirror_row(const uint8_t* src, uint8_t* dst, int w, int num) {
+  int x = 0;
+  const uint8_t* src_end = src + w * num;
+#ifdef __SSSE3__
+  if (num == 1) {
+    const __m128i mask =
+        _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; x + 16 <= w; x += 16) {
+      __m128i v = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src_end - x - 16));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+                       _mm_shuffle_epi8(v, mask));
+    }
+  } else if (num == 4) {
+    for (; x + 4 <= w; x += 4) {
+      __m128i v = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src_end - (x + 4) * 4));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4),
+                       _mm_shuffle_epi32(v, 0x1b));
+    }
+  } else if (num == 3) {
+    // 5 pixels of 16 bytes, the last byte is rewritten by the next step
+    const __m128i mask =
+        _mm_setr_epi8(13, 14, 15, 10, 11, 12, 7, 8, 9, 4, 5, 6, 1, 2, 3, 0);
+    for (; x + 6 <= w; x += 5) {
+      __m128i v = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src_end - (x + 5) * 3 - 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 3),
+                       _mm_shuffle_epi8(v, mask));
+    }
+  }
+#endif
+  for (; x < w; x++) {
+    memcpy(dst + x * num, src_end - (x + 1) * num, num);
+  }
+}
+
+/*
+ * X flips the rows upside down, Y mirrors each row and XY does both, the
+ * same as the arm version
+ */
+static void flip_hwc(const uint8_t* src,
+                     uint8_t* dst,
+                     int srcw,
+                     int srch,
+                     int num,
+                     FlipParam flip_param) {
+  if (flip_param != X && flip_param != Y && flip_param != XY) {
+    printf("its doesn't support Flip: %d \n", static_cast<int>(flip_param));
+    return;
+  }
+  int stride = srcw * num;
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* in = src + i * stride;
+    int out_row = flip_param == Y ? i : srch - 1 - i;
+    uint8_t* out = dst + out_row * stride;
+    if (flip_param == X) {
+      memcpy(out, in, stride);
+    } else {
+      mirror_row(in, out, srcw, num);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void flip_hwc1(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc(src, dst, srcw, srch, 1, flip_param);
+}
+
+void flip_hwc3(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc(src, dst, srcw, srch, 3, flip_param);
+}
+
+void flip_hwc4(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc(src, dst, srcw, srch, 4, flip_param);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
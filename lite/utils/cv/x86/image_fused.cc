@@ -0,0 +1,118 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "lite/utils/cv/x86/image_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+static int format_channels(ImageFormat format) {
+  if (format == GRAY) return 1;
+  if (format == BGR || format == RGB) return 3;
+  if (format == BGRA || format == RGBA) return 4;
+  return 0;
+}
+
+static bool is_bgr_order(ImageFormat format) {
+  return format == BGR || format == BGRA;
+}
+
+/*
+ * The resize is per channel, so resizing before reordering the channels
+ * gives the same bytes as converting first. Each output row is resized from
+ * the source in two int16 rows and normalized straight into the tensor, no
+ * intermediate image is kept.
+ */
+bool fused_resize_to_tensor(const uint8_t* src,
+                            Tensor* dst,
+                            ImageFormat srcFormat,
+                            ImageFormat dstFormat,
+                            int srcw,
+                            int srch,
+                            int dstw,
+                            int dsth,
+                            LayoutType layout,
+                            const float* means,
+                            const float* scales) {
+  int channels = format_channels(srcFormat);
+  int dst_channels = format_channels(dstFormat);
+  if (channels == 0 || dst_channels == 0 ||
+      (dst_channels == 1 && channels != 1) ||
+      (layout != LayoutType::kNCHW && layout != LayoutType::kNHWC)) {
+    return false;
+  }
+  // order[k] is the source channel of the tensor channel k
+  int out_channels = dst_channels == 1 ? 1 : 3;
+  int order[3] = {0, 1, 2};
+  if (channels == 1) {
+    order[1] = order[2] = 0;
+  } else if (is_bgr_order(srcFormat) != is_bgr_order(dstFormat)) {
+    order[0] = 2;
+    order[2] = 0;
+  }
+
+  bool same_size = srcw == dstw && srch == dsth;
+  ResizeCoefs coefs;
+  if (!same_size) {
+    compute_resize_coefs(srcw,
+                         srch,
+                         dstw,
+                         dsth,
+                         channels,
+                         static_cast<double>(srcw) / dstw,
+                         static_cast<double>(srch) / dsth,
+                         &coefs);
+  }
+  float* output = dst->mutable_data<float>();
+  int plane = dstw * dsth;
+  parallel_rows(dsth, [&](int begin, int end) {
+    std::vector<uint8_t> scratch(dstw * 3);
+    auto emit = [&](int dy, const uint8_t* row) {
+      if (layout == LayoutType::kNCHW) {
+        float* planes[3];
+        for (int k = 0; k < out_channels; k++) {
+          planes[k] = output + k * plane + dy * dstw;
+        }
+        row_to_tensor_chw(
+            row, channels, dstw, order, out_channels, planes, means, scales);
+      } else {
+        row_to_tensor_hwc(row,
+                          channels,
+                          dstw,
+                          order,
+                          out_channels,
+                          output + dy * dstw * out_channels,
+                          means,
+                          scales,
+                          scratch.data());
+      }
+    };
+    if (same_size) {
+      for (int dy = begin; dy < end; dy++) {
+        emit(dy, src + dy * srcw * channels);
+      }
+    } else {
+      resize_rows(src, coefs, begin, end, emit);
+    }
+  });
+  return true;
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+/*
+ * Row kernels of the x86 image preprocess, shared by the ImageConvert,
+ * ImageResize and Image2Tensor implementations and the fused
+ * resize-to-tensor path. They give the same results as the arm ones.
+ */
+
+// Splits the rows [0, rows) into a chunk per thread and runs
+// `fn(begin, end)` for the chunks in parallel.
+inline void parallel_rows(int rows, const std::function<void(int, int)>& fn) {
+  int chunks = (std::max)((std::min)(ParallelThreadNum(), rows), 1);
+  LITE_PARALLEL_BEGIN(i, tid, chunks) {
+    fn(rows * i / chunks, rows * (i + 1) / chunks);
+  }
+  LITE_PARALLEL_END();
+}
+
+// color convert of a row of `w` pixels, in image_convert.cc
+void hwc1_to_hwc3_row(const uint8_t* src, uint8_t* dst, int w);
+void hwc4_to_hwc3_row(const uint8_t* src, uint8_t* dst, int w);
+void hwc3_trans_row(const uint8_t* src, uint8_t* dst, int w);
+void hwc4_trans_hwc3_row(const uint8_t* src, uint8_t* dst, int w);
+
+// bilinear resize, in image_resize.cc
+struct ResizeCoefs {
+  int w_in{0};  // in pixels
+  int h_in{0};
+  int w_out{0};
+  int h_out{0};
+  int num{1};  // channels
+  std::vector<int> xofs;
+  std::vector<int> yofs;
+  std::vector<int16_t> ialpha;
+  std::vector<int16_t> ibeta;
+};
+void compute_resize_coefs(int w_in,
+                          int h_in,
+                          int w_out,
+                          int h_out,
+                          int num,
+                          double scale_x,
+                          double scale_y,
+                          ResizeCoefs* coefs);
+// Computes the output rows [begin, end) from `src` with the row stride
+// `w_in * num` and hands each of them to `emit(dy, row)`.
+void resize_rows(const uint8_t* src,
+                 const ResizeCoefs& coefs,
+                 int begin,
+                 int end,
+                 const std::function<void(int, const uint8_t*)>& emit);
+
+// normalize, in image2tensor.cc
+// Channel k of the output is `(src[order[k]] - means[k]) * scales[k]`,
+// written to `planes[k]` for chw or interleaved into `dst` for hwc.
+void row_to_tensor_chw(const uint8_t* src,
+                       int channels,
+                       int width,
+                       const int* order,
+                       int out_channels,
+                       float* const* planes,
+                       const float* means,
+                       const float* scales);
+// `scratch` holds `width * 3` bytes, used when the channels are reordered.
+void row_to_tensor_hwc(const uint8_t* src,
+                       int channels,
+                       int width,
+                       const int* order,
+                       int out_channels,
+                       float* dst,
+                       const float* means,
+                       const float* scales,
+                       uint8_t* scratch);
+
+// Converts `srcFormat` to `dstFormat`, resizes and normalizes into `dst` in
+// one pass, in image_fused.cc. Returns false for the conversions which are
+// not a reordering of the channels, e.g. from NV12 or to GRAY.
+bool fused_resize_to_tensor(const uint8_t* src,
+                            Tensor* dst,
+                            ImageFormat srcFormat,
+                            ImageFormat dstFormat,
+                            int srcw,
+                            int srch,
+                            int dstw,
+                            int dsth,
+                            LayoutType layout,
+                            const float* means,
+                            const float* scales);
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,298 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_resize.h"
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/cv/x86/image_kernels.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageResize::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         int dstw,
+                         int dsth) {
+  resize(src, dst, srcFormat, srcw, srch, dstw, dsth);
+}
+
+// The coefficients of the arm version, fixed point with 11 bits.
+void compute_resize_coefs(int w_in,
+                          int h_in,
+                          int w_out,
+                          int h_out,
+                          int num,
+                          double scale_x,
+                          double scale_y,
+                          ResizeCoefs* coefs) {
+  const int resize_coef_bits = 11;
+  const int resize_coef_scale = 1 << resize_coef_bits;
+  auto saturate_cast_short = [](float x) {
+    int v = static_cast<int>(x + (x >= 0.f ? 0.5f : -0.5f));
+    return static_cast<int16_t>(std::min(std::max(v, SHRT_MIN), SHRT_MAX));
+  };
+  coefs->w_in = w_in;
+  coefs->h_in = h_in;
+  coefs->w_out = w_out;
+  coefs->h_out = h_out;
+  coefs->num = num;
+  coefs->xofs.resize(w_out);
+  coefs->yofs.resize(h_out);
+  coefs->ialpha.resize(w_out * 2);
+  coefs->ibeta.resize(h_out * 2);
+  for (int dx = 0; dx < w_out; dx++) {
+    float fx = static_cast<float>((dx + 0.5) * scale_x - 0.5);
+    int sx = floor(fx);
+    fx -= sx;
+    if (sx < 0) {
+      sx = 0;
+      fx = 0.f;
+    }
+    if (sx >= w_in - 1) {
+      sx = w_in - 2;
+      fx = 1.f;
+    }
+    coefs->xofs[dx] = sx * num;
+    coefs->ialpha[dx * 2] = saturate_cast_short((1.f - fx) * resize_coef_scale);
+    coefs->ialpha[dx * 2 + 1] = saturate_cast_short(fx * resize_coef_scale);
+  }
+  for (int dy = 0; dy < h_out; dy++) {
+    float fy = static_cast<float>((dy + 0.5) * scale_y - 0.5);
+    int sy = floor(fy);
+    fy -= sy;
+    if (sy < 0) {
+      sy = 0;
+      fy = 0.f;
+    }
+    if (sy >= h_in - 1) {
+      sy = h_in - 2;
+      fy = 1.f;
+    }
+    coefs->yofs[dy] = sy;
+    coefs->ibeta[dy * 2] = saturate_cast_short((1.f - fy) * resize_coef_scale);
+    coefs->ibeta[dy * 2 + 1] = saturate_cast_short(fy * resize_coef_scale);
+  }
+}
+
+// hresize: rows[dx * num + c] = (S[sx + c] * a0 + S[sx + num + c] * a1) >> 4
+template <int num>
+static void hresize(const uint8_t* src,
+                    const ResizeCoefs& coefs,
+                    int16_t* rows) {
+  const int* xofs = coefs.xofs.data();
+  const int16_t* ialpha = coefs.ialpha.data();
+  for (int dx = 0; dx < coefs.w_out; dx++) {
+    const uint8_t* sp = src + xofs[dx];
+    int a0 = ialpha[dx * 2];
+    int a1 = ialpha[dx * 2 + 1];
+    for (int c = 0; c < num; c++) {
+      rows[c] = (sp[c] * a0 + sp[c + num] * a1) >> 4;
+    }
+    rows += num;
+  }
+}
+
+static void hresize_row(const uint8_t* src,
+                        const ResizeCoefs& coefs,
+                        int16_t* rows) {
+  switch (coefs.num) {
+    case 1:
+      hresize<1>(src, coefs, rows);
+      break;
+    case 2:
+      hresize<2>(src, coefs, rows);
+      break;
+    case 3:
+      hresize<3>(src, coefs, rows);
+      break;
+    default:
+      hresize<4>(src, coefs, rows);
+      break;
+  }
+}
+
+// vresize: D[x] = ((rows0[x] * b0 >> 16) + (rows1[x] * b1 >> 16) + 2) >> 2
+static void vresize_row(const int16_t* rows0,
+                        const int16_t* rows1,
+                        int16_t b0,
+                        int16_t b1,
+                        uint8_t* dst,
+                        int n) {
+  int x = 0;
+#ifdef __AVX2__
+  __m256i vb0 = _mm256_set1_epi16(b0);
+  __m256i vb1 = _mm256_set1_epi16(b1);
+  __m256i v2 = _mm256_set1_epi16(2);
+  for (; x + 32 <= n; x += 32) {
+    __m256i r00 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows0));
+    __m256i r01 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows0 + 16));
+    __m256i r10 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows1));
+    __m256i r11 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows1 + 16));
+    __m256i acc0 = _mm256_add_epi16(_mm256_mulhi_epi16(r00, vb0),
+                                    _mm256_mulhi_epi16(r10, vb1));
+    __m256i acc1 = _mm256_add_epi16(_mm256_mulhi_epi16(r01, vb0),
+                                    _mm256_mulhi_epi16(r11, vb1));
+    acc0 = _mm256_srai_epi16(_mm256_add_epi16(acc0, v2), 2);
+    acc1 = _mm256_srai_epi16(_mm256_add_epi16(acc1, v2), 2);
+    // packus works in the 128-bit lanes
+    __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi16(acc0, acc1),
+                                           0xd8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), out);
+    rows0 += 32;
+    rows1 += 32;
+    dst += 32;
+  }
+#endif
+#ifdef __SSE2__
+  __m128i b0_128 = _mm_set1_epi16(b0);
+  __m128i b1_128 = _mm_set1_epi16(b1);
+  __m128i v2_128 = _mm_set1_epi16(2);
+  for (; x + 8 <= n; x += 8) {
+    __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows0));
+    __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows1));
+    __m128i acc = _mm_add_epi16(_mm_mulhi_epi16(r0, b0_128),
+                                _mm_mulhi_epi16(r1, b1_128));
+    acc = _mm_srai_epi16(_mm_add_epi16(acc, v2_128), 2);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst),
+                     _mm_packus_epi16(acc, acc));
+    rows0 += 8;
+    rows1 += 8;
+    dst += 8;
+  }
+#endif
+  for (; x < n; x++) {
+    int v = (((b0 * *rows0++) >> 16) + ((b1 * *rows1++) >> 16) + 2) >> 2;
+    *dst++ = v < 0 ? 0 : (v > 255 ? 255 : v);
+  }
+}
+
+void resize_rows(const uint8_t* src,
+                 const ResizeCoefs& coefs,
+                 int begin,
+                 int end,
+                 const std::function<void(int, const uint8_t*)>& emit) {
+  int w_in = coefs.w_in * coefs.num;
+  int w_out = coefs.w_out * coefs.num;
+  std::vector<int16_t> rowsbuf(w_out * 2);
+  std::vector<uint8_t> out(w_out);
+  int16_t* rows0 = rowsbuf.data();
+  int16_t* rows1 = rows0 + w_out;
+  int prev_sy1 = -1;
+  for (int dy = begin; dy < end; dy++) {
+    int sy = coefs.yofs[dy];
+    if (sy == prev_sy1) {
+      // hresize one row
+      std::swap(rows0, rows1);
+      hresize_row(src + w_in * (sy + 1), coefs, rows1);
+    } else if (sy + 1 != prev_sy1) {
+      // hresize two rows
+      hresize_row(src + w_in * sy, coefs, rows0);
+      hresize_row(src + w_in * (sy + 1), coefs, rows1);
+    }
+    prev_sy1 = sy + 1;
+    vresize_row(rows0,
+                rows1,
+                coefs.ibeta[dy * 2],
+                coefs.ibeta[dy * 2 + 1],
+                out.data(),
+                w_out);
+    emit(dy, out.data());
+  }
+}
+
+// Resizes the `num`-channel image in a chunk of rows per thread.
+static void resize_image(const uint8_t* src,
+                         uint8_t* dst,
+                         int w_in,
+                         int h_in,
+                         int w_out,
+                         int h_out,
+                         int num,
+                         double scale_x,
+                         double scale_y,
+                         int dst_stride) {
+  ResizeCoefs coefs;
+  compute_resize_coefs(
+      w_in, h_in, w_out, h_out, num, scale_x, scale_y, &coefs);
+  int row_bytes = w_out * num;
+  parallel_rows(h_out, [&](int begin, int end) {
+    resize_rows(src, coefs, begin, end, [&](int dy, const uint8_t* row) {
+      memcpy(dst + dy * dst_stride, row, row_bytes);
+    });
+  });
+}
+
+void resize(const uint8_t* src,
+            uint8_t* dst,
+            ImageFormat srcFormat,
+            int srcw,
+            int srch,
+            int dstw,
+            int dsth) {
+  int size = srcw * srch;
+  if (srcw == dstw && srch == dsth) {
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (static_cast<int>(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  double scale_x = static_cast<double>(srcw) / dstw;
+  double scale_y = static_cast<double>(srch) / dsth;
+  if (srcFormat == GRAY) {
+    resize_image(src, dst, srcw, srch, dstw, dsth, 1, scale_x, scale_y, dstw);
+  } else if (srcFormat == NV12 || srcFormat == NV21) {
+    // y, then the interleaved uv of half the width and height
+    resize_image(src, dst, srcw, srch, dstw, dsth, 1, scale_x, scale_y, dstw);
+    int uv_h = srch / 2;
+    int dst_uv_h = dsth / 2;
+    resize_image(src + srch * srcw,
+                 dst + dsth * dstw,
+                 srcw / 2,
+                 uv_h,
+                 dstw / 2,
+                 dst_uv_h,
+                 2,
+                 scale_x,
+                 static_cast<double>(uv_h) / dst_uv_h,
+                 dstw);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    resize_image(
+        src, dst, srcw, srch, dstw, dsth, 3, scale_x, scale_y, dstw * 3);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    resize_image(
+        src, dst, srcw, srch, dstw, dsth, 4, scale_x, scale_y, dstw * 4);
+  }
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
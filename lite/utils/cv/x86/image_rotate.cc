@@ -0,0 +1,118 @@
+// Copyright (c) 2023 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_rotate.h"
+#include <string.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/cv/bgr_rotate.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void ImageRotate::choose(const uint8_t* src,
+                         uint8_t* dst,
+                         ImageFormat srcFormat,
+                         int srcw,
+                         int srch,
+                         float degree) {
+  if (degree != 90 && degree != 180 && degree != 270) {
+    printf("this degree: %f not support \n", degree);
+    return;
+  }
+  if (srcFormat == GRAY) {
+    rotate_hwc1(src, dst, srcw, srch, degree);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    bgr_rotate_hwc(src, dst, srcw, srch, static_cast<int>(degree));
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    rotate_hwc4(src, dst, srcw, srch, degree);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+    return;
+  }
+}
+
+/*
+ * 90 rotates clockwise and 270 counterclockwise, the same as the arm
+ * version. The 90 and 270 ones go by tiles of the output, so that both the
+ * reads and the writes stay in the cache.
+ */
+template <int num>
+static void rotate_hwc(
+    const uint8_t* src, uint8_t* dst, int w_in, int h_in, int angle) {
+  const int tile = 32;
+  if (angle == 180) {
+    LITE_PARALLEL_BEGIN(i, tid, h_in) {
+      const uint8_t* in = src + (h_in - 1 - i) * w_in * num;
+      uint8_t* out = dst + i * w_in * num;
+      for (int x = 0; x < w_in; x++) {
+        memcpy(out + x * num, in + (w_in - 1 - x) * num, num);
+      }
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
+  if (angle != 90 && angle != 270) return;
+  // the output is h_in wide and w_in high
+  int w_out = h_in;
+  int h_out = w_in;
+  int tiles_y = (h_out + tile - 1) / tile;
+  LITE_PARALLEL_BEGIN(ty, tid, tiles_y) {
+    int y_end = (std::min)(ty * tile + tile, h_out);
+    for (int x0 = 0; x0 < w_out; x0 += tile) {
+      int x_end = (std::min)(x0 + tile, w_out);
+      for (int y = ty * tile; y < y_end; y++) {
+        uint8_t* out = dst + (y * w_out + x0) * num;
+        for (int x = x0; x < x_end; x++) {
+          // 90: out(y, x) = in(h_in - 1 - x, y)
+          // 270: out(y, x) = in(x, w_in - 1 - y)
+          const uint8_t* in =
+              angle == 90 ? src + ((h_in - 1 - x) * w_in + y) * num
+                          : src + (x * w_in + w_in - 1 - y) * num;
+          for (int c = 0; c < num; c++) {
+            out[c] = in[c];
+          }
+          out += num;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void rotate_hwc1(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<1>(src, dst, srcw, srch, static_cast<int>(degree));
+}
+
+void rotate_hwc3(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<3>(src, dst, srcw, srch, static_cast<int>(degree));
+}
+
+void rotate_hwc4(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<4>(src, dst, srcw, srch, static_cast<int>(degree));
+}
+
+void bgr_rotate_hwc(
+    const uint8_t* src, uint8_t* dst, int w_in, int h_in, int angle) {
+  rotate_hwc<3>(src, dst, w_in, h_in, angle);
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
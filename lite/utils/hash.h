@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 namespace paddle {
@@ -25,5 +27,16 @@ inline void CombineHash(const T& from, size_t* to) {
   *to ^= h(from) + 0x9e3779b9 + (*to << 6) + (*to >> 2);
 }
 
+static const uint64_t kHashBytesSeed = 14695981039346656037ULL;
+
+// 64-bit FNV-1a, for the hashes compared in place of the data, so that
+// different data rarely collide. Start with `kHashBytesSeed`.
+inline void HashBytes(const void* data, size_t size, uint64_t* hash) {
+  auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; i++) {
+    *hash = (*hash ^ bytes[i]) * 1099511628211ULL;
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle